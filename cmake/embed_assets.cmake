@@ -0,0 +1,27 @@
+# Write OUTPUT, a C++ source defining embedded_assets[] with the contents of
+# each file in INPUTS, named by its file name.  Run by the build as
+#
+#   cmake -DOUTPUT=<file> -DINPUTS=<file;...> -P embed_assets.cmake
+
+set(source "// Generated by cmake/embed_assets.cmake, do not edit\n\n#include \"assets.h\"\n\n")
+set(table "")
+set(index 0)
+
+# Sixteen bytes to a line
+string(REPEAT "0x..," 16 line)
+foreach(input IN LISTS INPUTS)
+  get_filename_component(name ${input} NAME)
+  file(READ ${input} hex HEX)
+  string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+  string(REGEX REPLACE "(${line})" "\\1\n    " bytes "${bytes}")
+
+  string(APPEND source "// ${name}\nstatic constexpr unsigned char asset_${index}[] = {\n    ${bytes}\n};\n\n")
+  string(APPEND table "    {\"${name}\", asset_${index}, sizeof asset_${index}},\n")
+  math(EXPR index "${index} + 1")
+endforeach()
+string(APPEND source "const EmbeddedAsset embedded_assets[] = {\n${table}    {nullptr, nullptr, 0},\n};\n")
+
+# Untouched if unchanged, so nothing rebuilds for nothing
+file(WRITE ${OUTPUT}.tmp "${source}")
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different ${OUTPUT}.tmp ${OUTPUT})
+file(REMOVE ${OUTPUT}.tmp)
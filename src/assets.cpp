@@ -0,0 +1,39 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "assets.h"
+#include "cfg.h"
+
+#include <cstring>
+#include <string>
+
+using namespace std;
+
+unique_ptr<Image> load_bitmap(const char* name) {
+    const auto path = string(cfg_data_dir()) + "/assets/" + name;
+    if (auto image = Image::readbmp(path.c_str())) {
+        return image;
+    }
+
+    for (auto asset = embedded_assets; asset->name; ++asset) {
+        if (strcmp(asset->name, name) == 0) {
+            return Image::readbmp(asset->data, asset->size);
+        }
+    }
+    return nullptr;
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,43 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include "image.h"
+
+#include <cstddef>
+#include <memory>
+
+// A file from assets/, built into the program by cmake/embed_assets.cmake
+struct EmbeddedAsset {
+    const char*          name;  // File name, as "pieces.bmp"
+    const unsigned char* data;
+    std::size_t          size;
+};
+
+// Every one built in, then one with a null name
+extern const EmbeddedAsset embedded_assets[];
+
+// Bitmap such as "pieces.bmp": the user's own, from assets in the data
+// directory, if there is one.  Otherwise the one built in.  Null if there's
+// neither, or it isn't a bitmap
+std::unique_ptr<Image> load_bitmap(const char* name);
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -3,33 +3,177 @@
 
 #include "board.h"
 #include "boardserial.h"
+#include "cfg.h"
+#include "utility/latency.h"
+#include "utility/sleep.h"
+#include "utility/trace.h"
 
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
 
+#include <sys/eventfd.h>
+#include <unistd.h>
+
 using namespace std;
 using namespace thc;
 
-// Return battery status
-int Board::batterylevel() {
-    const auto charging = boardserial.chargingstate();
+// How long the reader thread rests between polls of an idle board
+static const int POLL_INTERVAL_MS = 20;
+
+// How long shadow occupancy goes unchecked by a full scan of the fields.
+// Anything the events don't account for, e.g., a piece slid from one field
+// to the next, is noticed within this long
+static const auto RESCAN_INTERVAL = chrono::milliseconds(1000);
+
+// Serial round trip for field events, and how long they then wait for the
+// game loop
+static LatencyHistogram readdata_latency{"readdata"};
+static LatencyHistogram queued_latency{"read_actions"};
+
+Board::Board() : wakeup{eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)} {
+    if (wakeup < 0) {
+        perror("eventfd");
+    }
+}
+
+Board::~Board() {
+    stop_reading();
+    if (wakeup >= 0) {
+        close(wakeup);
+    }
+}
+
+void Board::start_reading() {
+    if (reader.joinable() || wakeup < 0) {
+        return;
+    }
+    reading = true;
+    reader  = thread(&Board::read_events, this);
+}
+
+void Board::stop_reading() {
+    if (!reader.joinable()) {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(output);
+        reading = false;
+    }
+    output_queued.notify_one();
+    reader.join();
+
+    // Nobody else will send it
+    lock_guard<mutex> lock(serial);
+    send_output();
+
+    // Anything still queued is picked up by the next read_actions()
+}
+
+// Reader thread: poll the board and queue whatever it reports
+void Board::read_events() {
+    TRACE_THREAD("board");
+
+    ActionList actions;
+    while (reading) {
+        actions.clear();
+        Bitmap boardstate = 0;
+        {
+            lock_guard<mutex> lock(serial);
+            poll_actions(actions);
+            boardstate = shadow;
+        }
+
+        if (actions.empty()) {
+            // Rest, unless there's output to send
+            unique_lock<mutex> lock(output);
+            output_queued.wait_for(lock, chrono::milliseconds(POLL_INTERVAL_MS), [this] {
+                return !reading || queued_leds || !queued_sounds.empty();
+            });
+            continue;
+        }
+
+        for (const auto& action : actions) {
+            // Never drop an event, wait for the game loop to catch up
+            while (!events.push(Event{action, boardstate, last_read})) {
+                if (!reading) {
+                    return;
+                }
+                sleep_ms(POLL_INTERVAL_MS);
+            }
+        }
+
+        const uint64_t one = 1;
+        if (write(wakeup, &one, sizeof one) != sizeof one) {
+            perror("write");
+        }
+    }
+}
+
+void Board::wake() {
+    const uint64_t one = 1;
+    if (wakeup >= 0 && write(wakeup, &one, sizeof one) != sizeof one) {
+        perror("write");
+    }
+}
+
+bool Board::sample_due() const {
+    const auto interval = chrono::duration<double>(cfg_battery_interval());
+    return idle && LatencyHistogram::Clock::now().time_since_epoch() - battery_at.load() >= interval;
+}
+
+bool Board::scan_due() const {
+    return !shadow_valid || LatencyHistogram::Clock::now() - scanned >= RESCAN_INTERVAL;
+}
+
+void Board::rescanned(Bitmap boardstate) {
+    shadow       = boardstate;
+    shadow_valid = true;
+    scanned      = LatencyHistogram::Clock::now();
+}
+
+// Follow events from first on, false if one doesn't fit, as when a piece is
+// lifted from an empty field
+bool Board::track(const ActionList& actions, size_t first) {
+    for (auto i = first; i < actions.size(); ++i) {
+        const auto& action = actions[i];
+        if (action.lift != SQUARE_INVALID) {
+            const auto bit = 1ull << action.lift;
+            shadow_valid = shadow_valid && (shadow & bit);
+            shadow &= ~bit;
+        }
+        if (action.place != SQUARE_INVALID) {
+            const auto bit = 1ull << action.place;
+            shadow_valid = shadow_valid && !(shadow & bit);
+            shadow |= bit;
+        }
+    }
+    return shadow_valid;
+}
+
+int Board::batterylevel() const {
+    const auto charging = battery.load();
     if (charging == -1) {
         return -1;
     }
     return charging & 31;
 }
 
-// Return charging status
-int Board::charging() {
-    const auto charging = boardserial.chargingstate();
+int Board::charging() const {
+    const auto charging = battery.load();
     if (charging == -1) {
         return -1;
     }
     return (charging >> 5 & 7) == 1;
 }
 
+LatencyHistogram::Clock::time_point Board::battery_sampled() const {
+    return LatencyHistogram::Clock::time_point{battery_at.load()};
+}
+
 static Bitmap reverse_bits(Bitmap value) {
     Bitmap reversed = 0;
     for (auto i = 0; i < 64; ++i) {
@@ -41,13 +185,118 @@ static Bitmap reverse_bits(Bitmap value) {
 
 // Read current state of board fields
 Bitmap Board::getstate() {
-    const auto boardstate = boardserial.boardstate();
+    // Save a round trip when the reader thread has just read it, or when
+    // events have kept track of it since the last scan
+    Bitmap boardstate;
+    if (state_fresh) {
+        boardstate  = state;
+        state_fresh = false;
+    }
+    else {
+        lock_guard<mutex> lock(serial);
+        if (scan_due()) {
+            rescanned(boardserial.boardstate());
+        }
+        boardstate = shadow;
+    }
     return reversed ? reverse_bits(boardstate) : boardstate;
 }
 
 int Board::read_actions(ActionList& actions) {
+    const auto first = actions.size();
+
+    if (reader.joinable() || !events.empty()) {
+        // Reset wakeup before draining, so events queued meanwhile wake us
+        // again
+        uint64_t count;
+        (void)read(wakeup, &count, sizeof count);
+
+        Event event;
+        while (events.pop(event)) {
+            actions.push_back(event.action);
+            state       = event.boardstate;
+            state_fresh = true;
+            queued_latency.record_since(event.read_at);
+            latency_origin(event.read_at);
+        }
+    }
+    else {
+        lock_guard<mutex> lock(serial);
+        if (poll_actions(actions) > 0) {
+            latency_origin(last_read);
+        }
+    }
+
+    if (reversed) {
+        for (auto i = first; i < actions.size(); ++i) {
+            auto& action = actions[i];
+            if (action.lift != SQUARE_INVALID) {
+                action.lift = rotate_square(action.lift);
+            }
+            if (action.place != SQUARE_INVALID) {
+                action.place = rotate_square(action.place);
+            }
+        }
+    }
+
+    return actions.size() - first;
+}
+
+// Ask the board for field events, and in the same round trip whatever else
+// is due.  Caller holds serial
+int Board::poll_actions(ActionList& actions) {
+    const auto first = actions.size();
+
+    // A scan goes out after the request for field events, so it's the state
+    // after them
+    const auto rescan = scan_due();
+    const auto sample = sample_due();
+
+    auto fields = boardserial.send_readdata();
+    BoardSerial::Reply state;
+    BoardSerial::Reply charging;
+    if (rescan) {
+        state = boardserial.send_boardstate();
+    }
+    if (sample) {
+        charging = boardserial.send_chargingstate();
+    }
+
     uint8_t buf[256];
-    const auto num_read = boardserial.readdata(buf, sizeof buf);
+    const auto start    = LatencyHistogram::Clock::now();
+    const auto num_read = boardserial.readdata(fields, buf, sizeof buf);
+    last_read = LatencyHistogram::Clock::now();
+    readdata_latency.record(last_read - start);
+    TRACE_RECORD("readdata", start, last_read);
+
+    // Only once field events are in, while other replies are on the way
+    send_output();
+
+    const auto n = parse_actions(buf, num_read, actions);
+    if (rescan) {
+        rescanned(boardserial.boardstate(state));
+    }
+    else if (num_read == 0 || !track(actions, first)) {
+        // Events may have been lost, or don't fit what we have, so don't
+        // pass them on with a boardstate we can't believe
+        rescanned(boardserial.boardstate());
+    }
+
+    if (sample) {
+        // On failure keep what we had, and try again next time
+        const auto status = boardserial.chargingstate(charging);
+        if (status != -1) {
+            battery    = status;
+            battery_at = LatencyHistogram::Clock::now().time_since_epoch();
+        }
+    }
+    idle = n == 0;
+
+    return n;
+}
+
+// Field events from a readdata reply
+int Board::parse_actions(const uint8_t* buf, int num_read, ActionList& actions) {
     if (num_read <= 6) {
         // Failed to read data packet
         return 0;
@@ -58,20 +307,14 @@ int Board::read_actions(ActionList& actions) {
         switch (buf[i++]) {
         case 64:  // Lift
             if (0 <= buf[i] && buf[i] < 64) {
-                auto lift = static_cast<Square>(buf[i++]);
-                if (reversed) {
-                    lift = rotate_square(lift);
-                }
+                const auto lift = static_cast<Square>(buf[i++]);
                 actions.push_back(Action{lift, SQUARE_INVALID});
                 ++n;
             }
             break;
         case 65:  // Place
             if (0 <= buf[i] && buf[i] < 64) {
-                auto place = static_cast<Square>(buf[i++]);
-                if (reversed) {
-                    place = rotate_square(place);
-                }
+                const auto place = static_cast<Square>(buf[i++]);
                 actions.push_back(Action{SQUARE_INVALID, place});
                 ++n;
             }
@@ -85,38 +328,91 @@ int Board::read_actions(ActionList& actions) {
 }
 
 int Board::leds_off() {
-    return boardserial.leds_off();
+    return show(Leds{Leds::OFF, {}});
 }
 
 int Board::led_flash() {
-    return boardserial.led_flash();
+    return show(Leds{Leds::FLASH, {}});
 }
 
 int Board::led(Square square) {
     if (reversed) {
         square = rotate_square(square);
     }
-    return boardserial.led(square);
+    return show(Leds{Leds::SQUARE, {square}});
 }
 
 int Board::led_array(const vector<Square>& squares) {
-    int rotated_squares[squares.size()];
-    for (auto i = 0; i != squares.size(); ++i) {
-        if (reversed) {
-            rotated_squares[i] = rotate_square(squares[i]);
-        } else {
-            rotated_squares[i] = squares[i];
-        }
+    Leds leds{Leds::SQUARES, {}};
+    for (auto square : squares) {
+        leds.squares.push_back(reversed ? rotate_square(square) : square);
     }
-    return boardserial.led_array(rotated_squares, squares.size());
+    return show(std::move(leds));
 }
 
 int Board::led_from_to(Square from, Square to) {
-    if (reversed) {
-        from = rotate_square(from);
-        to   = rotate_square(to);
+    return led_array({from, to});
+}
+
+int Board::show(Leds leds) {
+    {
+        lock_guard<mutex> lock(output);
+        if (reading) {
+            queued_leds = std::move(leds);
+            output_queued.notify_one();
+            return 0;
+        }
+    }
+
+    lock_guard<mutex> lock(serial);
+    return write_leds(leds);
+}
+
+int Board::play_sound(Sound sound) {
+    {
+        lock_guard<mutex> lock(output);
+        if (reading) {
+            queued_sounds.push_back(sound);
+            output_queued.notify_one();
+            return 0;
+        }
+    }
+
+    lock_guard<mutex> lock(serial);
+    return boardserial.play_sound(sound);
+}
+
+// Caller holds serial
+int Board::write_leds(const Leds& leds) {
+    switch (leds.kind) {
+    case Leds::OFF:
+        return boardserial.leds_off();
+    case Leds::FLASH:
+        return boardserial.led_flash();
+    case Leds::SQUARE:
+        return boardserial.led(leds.squares.front());
+    case Leds::SQUARES:
+    default:
+        return boardserial.led_array(leds.squares.data(), leds.squares.size());
+    }
+}
+
+// Whatever output is queued, LEDs first.  Caller holds serial
+void Board::send_output() {
+    optional<Leds> leds;
+    deque<Sound>   sounds;
+    {
+        lock_guard<mutex> lock(output);
+        leds.swap(queued_leds);
+        sounds.swap(queued_sounds);
+    }
+
+    if (leds) {
+        write_leds(*leds);
+    }
+    for (auto sound : sounds) {
+        boardserial.play_sound(sound);
     }
-    return boardserial.led_from_to(from, to);
 }
 
 // This file is part of the Raccoon's Centaur Mods (RCM).
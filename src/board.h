@@ -7,20 +7,110 @@
 
 #include "boardserial.h"
 #include "chess/chess.h"
+#include "utility/latency.h"
+#include "utility/ring.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <vector>
 
 class Board {
     BoardSerial boardserial;
+    std::mutex  serial;  // One round trip at a time
+
+    // Field events, as read by the reader thread, with the boardstate after
+    // them.  Squares are as the board reports them, not reversed
+    struct Event {
+        Action action;
+        Bitmap boardstate;
+        LatencyHistogram::Clock::time_point read_at;
+    };
+
+    Ring<Event, 256>  events;
+    std::atomic<bool> reading{false};
+    std::thread       reader;
+    int               wakeup{-1};  // eventfd, readable when events are queued
+
+    // Boardstate that came with the latest events, until it's used
+    Bitmap state{0};
+    bool   state_fresh{false};
+
+    // When the board last answered for field events
+    LatencyHistogram::Clock::time_point last_read;
+
+    // Occupancy, from the last full scan of the fields and every event since,
+    // so a scan is only needed now and then.  Guarded by serial
+    Bitmap shadow{0};
+    bool   shadow_valid{false};
+    LatencyHistogram::Clock::time_point scanned;
+
+    // Battery and charging status as last sampled, and when.  Sampled only
+    // after a poll with no events, so it never holds up a move
+    std::atomic<int>                               battery{-1};
+    std::atomic<LatencyHistogram::Clock::duration> battery_at{};
+    bool idle{true};  // Guarded by serial
+
+    // LED frame, as the board numbers squares
+    struct Leds {
+        enum Kind { OFF, FLASH, SQUARE, SQUARES } kind;
+        std::vector<int> squares;
+    };
+
+    // Output for the reader thread to send after its next requests, so
+    // reading never waits behind it.  A newer frame replaces one not yet
+    // sent, sounds play in turn
+    std::mutex                   output;
+    std::condition_variable      output_queued;
+    std::optional<Leds>          queued_leds;
+    std::deque<Sound>            queued_sounds;
+
+    void read_events();
+    int poll_actions(ActionList& actions);
+    int show(Leds leds);
+    int write_leds(const Leds& leds);
+    void send_output();
+
+    // Caller holds serial for all of these
+    bool scan_due() const;
+    bool sample_due() const;
+    void rescanned(Bitmap boardstate);
+    bool track(const ActionList& actions, std::size_t first);
+    static int parse_actions(const std::uint8_t* buf, int num_read, ActionList& actions);
 
 public:
     static const Bitmap STARTING_POSITION = 0xffff00000000ffff;
 
     bool reversed{false};
 
-    // Return battery and charging status
-    int batterylevel();
-    int charging();
+    Board();
+    Board(const Board&) = delete;
+    Board& operator=(const Board&) = delete;
+    ~Board();
+
+    // Poll the board for field events on a thread of our own, so they're
+    // queued as they happen.  Until then read_actions() asks the board itself
+    void start_reading();
+    void stop_reading();
+
+    // Becomes readable when field events are waiting for read_actions()
+    int wakeup_fd() const { return wakeup; }
+
+    // Make wakeup_fd() readable without events, for whoever's waiting on it
+    // to look for other work.  From any thread
+    void wake();
+
+    // Return battery and charging status, as last sampled while polling for
+    // field events, see cfg_battery_interval().  -1 until then.  These never
+    // wait on the board
+    int batterylevel() const;
+    int charging() const;
+    LatencyHistogram::Clock::time_point battery_sampled() const;
 
     // Read current state of board fields
     // MSB: H1=63 G1 F1 ... A1, H2 G2 ... A2, ..., H8 G8 ... A8=0
@@ -29,23 +119,17 @@ public:
     // Return number of actions read
     int read_actions(ActionList& actions);
 
+    // While reading these return once the frame is queued, and 0 means only
+    // that.  Otherwise they return once it's sent
     int leds_off();
     int led_flash();
     int led(thc::Square square);
     int led_array(const std::vector<thc::Square>& squares);
     int led_from_to(thc::Square from, thc::Square to);
-};
 
-inline thc::Square rotate_square(thc::Square square) {
-    // square  == 8 * (7 - row) + col
-    //         == 56 - 8 * row + col
-    //         == 56 - (8 * row - col)
-    // rotated == 8 * row + (7 - col)
-    //         == 7 + (8 * row - col)
-    // square + rotated == 63
-    // et voila
-    return static_cast<thc::Square>(63 - square);
-}
+    // Returns once queued, while reading, otherwise once sent
+    int play_sound(Sound sound);
+};
 
 #endif
 
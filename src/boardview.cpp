@@ -0,0 +1,96 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "boardview.h"
+#include "assets.h"
+
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+using namespace thc;
+
+BoardView::BoardView(const unique_ptr<Game>& game, const bool& reversed)
+    : game{game},
+      reversed{reversed},
+      pieces{load_bitmap("pieces.bmp")}
+{
+    bounds = {0, 0, 8 * SQUARE_SIZE, 8 * SQUARE_SIZE};
+    invalidate();
+    if (!pieces) {
+        throw runtime_error("Failed to load pieces.bmp");
+    }
+
+    // First of any repeats, as strchr() would find
+    const string sprites = " PRNBQKprnbqk?! ";
+    for (auto i = static_cast<int>(sprites.size()) - 1; i >= 0; --i) {
+        sprite[sprites[i]] = i;
+    }
+}
+
+char BoardView::piece_at(int screen_square) const {
+    auto square = static_cast<Square>(screen_square);
+    if (reversed) {
+        square = rotate_square(square);
+    }
+    return game->at(square) & 127;
+}
+
+Rect BoardView::square_rect(int screen_square) const {
+    const auto x = bounds.left + screen_square % 8 * SQUARE_SIZE;
+    const auto y = bounds.top  + screen_square / 8 * SQUARE_SIZE;
+    return {x, y, x + SQUARE_SIZE, y + SQUARE_SIZE};
+}
+
+// Any square whose piece has moved on or off it
+bool BoardView::invalid() const {
+    if (View::invalid()) {
+        return true;
+    }
+    for (auto i = 0; i != 64; ++i) {
+        if (drawn[i] != piece_at(i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Rect BoardView::render(Context& context) {
+    if (!atlas || !atlas->matches(context.rotate, context.foreground, context.background)) {
+        atlas = make_unique<TileAtlas>(*pieces, context.rotate, context.foreground, context.background);
+        invalidate();
+    }
+    const auto columns = pieces->width / TileAtlas::TILE_SIZE;
+
+    Rect rendered{};
+    for (auto i = 0; i != 64; ++i) {
+        const auto rect  = square_rect(i);
+        const auto piece = piece_at(i);
+        if (drawn[i] == piece && !dirty.intersects(rect)) {
+            continue;
+        }
+
+        const auto color = (i / 8 + i % 8) % 2;  // Row of the sheet
+        context.drawtile(rect.left, rect.top, *atlas, color * columns + sprite[piece]);
+        drawn[i] = piece;
+        rendered.unite(rect);
+    }
+
+    dirty = {};
+    return rendered;
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,61 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef BOARDVIEW_H
+#define BOARDVIEW_H
+
+#include "chess/chess.h"
+#include "graphics.h"
+#include "image.h"
+
+#include <array>
+#include <memory>
+
+// The pieces of a game, a square at a time, redrawing only squares whose
+// pieces have changed.  It looks at the game, and which way up the board
+// is, each time it's asked, so whoever owns them can swap the game out
+class BoardView : public View {
+public:
+    static constexpr int SQUARE_SIZE = TileAtlas::TILE_SIZE;
+
+    // Throws std::runtime_error if there's no pieces.bmp
+    BoardView(const std::unique_ptr<Game>& game, const bool& reversed);
+
+    Rect render(Context& context) override;
+    bool invalid() const override;
+
+private:
+    const std::unique_ptr<Game>& game;
+    const bool&                  reversed;
+
+    std::unique_ptr<Image>     pieces;
+    std::unique_ptr<TileAtlas> atlas;  // Of pieces, as the context last drawn to
+
+    // Column of each piece in pieces, on its row of square color
+    std::array<int, 128> sprite{};
+
+    // Piece last drawn on each square of the screen, which isn't
+    // necessarily that square of the board
+    std::array<char, 64> drawn{};
+
+    char piece_at(int screen_square) const;
+    Rect square_rect(int screen_square) const;
+};
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -2,84 +2,63 @@
 // See license at end of file
 
 #include "centaur.h"
+#include "boardview.h"
 #include "cfg.h"
+#include "utility/latency.h"
+#include "utility/trace.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <string>
 
 using namespace std;
 using namespace thc;
 
 struct Centaur centaur;
 
-//
-// Board view
-//
-
-class BoardView : public View {
-private:
-    unique_ptr<Image> pieces;
-
-public:
-    BoardView();
-    void render(Context& context) override;
-};
-
-BoardView::BoardView()
-    : pieces{Image::readbmp("assets/pieces.bmp")}
-{
-    bounds = {0, 0, 128, 128};
-    if (!pieces) {
-        throw runtime_error("Failed to load pieces.bmp");
-    }
-}
-
-void BoardView::render(Context& context) {
-    const auto sprites     = " PRNBQKprnbqk?! ";
-    const auto square_size = 16;
-
-    const auto left = bounds.left;
-    const auto top  = bounds.top;
-    for (auto r = 0; r != 8; ++r) {
-        const auto y_dst = top + r * square_size;
-
-        for (auto c = 0; c != 8; ++c) {
-            const auto x_dst = left + c * square_size;
-            const auto y_src = (r + c) % 2 ? square_size : 0;  // Square color
-
-            Square square = static_cast<Square>(8 * r + c);
-            if (centaur.reversed()) {
-                square = rotate_square(square);
-            }
-
-            const auto piece  = centaur.game->at(square);
-            const auto sprite = strchr(sprites, piece);
-            const auto x_src  = (sprite - sprites) * square_size;
-            context.drawimage(x_dst, y_dst, *pieces, x_src, y_src, square_size, square_size);
-        }
-    }
-}
+// Reading moves from the board: the usual case, and a missed move
+static LatencyHistogram read_move_latency{"read_move"};
+static LatencyHistogram reconstruction_latency{"reconstruction"};
 
 //
 // Centaur view
 //
 
 class CentaurView : public View {
-    BoardView board_view;
+    BoardView board_view{centaur.game, centaur.board.reversed};
 
 public:
     CentaurView();
-    void render(Context& context) override;
+    Rect render(Context& context) override;
+    bool invalid() const override;
 };
 
 CentaurView::CentaurView() {
     bounds = {0, 0, 128, 296};
+    invalidate();
 }
 
-void CentaurView::render(Context& context) {
-    board_view.render(context);
+bool CentaurView::invalid() const {
+    return View::invalid() || board_view.invalid();
+}
+
+// Background first, under whatever's drawn over it
+Rect CentaurView::render(Context& context) {
+    auto rendered = dirty;
+    if (!dirty.empty()) {
+        context.eraserect(dirty.left, dirty.top, dirty.right - 1, dirty.bottom - 1);
+        board_view.invalidate(dirty);
+        dirty = {};
+    }
+
+    rendered.unite(board_view.render(context));
+    return rendered;
 }
 
 static CentaurView centaur_view;
@@ -88,25 +67,112 @@ static CentaurView centaur_view;
 // Centaur
 //
 
+GameEvent game_event(const Game& game, bool quiet, bool whole) {
+    GameEvent event;
+    event.generation = game.generation();
+    event.ply        = game.history.size() - 1;
+    event.key        = game.current()->key();
+    event.timestamp  = time(nullptr);
+    event.quiet      = quiet;
+
+    const auto before = game.previous();
+    const auto after  = game.current();
+    if (before) {
+        for (const auto& movepair : before->moves_played) {
+            if (movepair.second == after) {
+                event.uci = movepair.uci;
+                event.san = movepair.san;
+                break;
+            }
+        }
+    }
+    if (whole || event.uci.empty()) {
+        event.snapshot = game.snapshot();
+    }
+    return event;
+}
+
+bool GameFollower::follow(const GameEvent& event) {
+    if (!event.snapshot.empty()) {
+        try {
+            followed.snapshot(event.snapshot);
+            synced = true;
+        }
+        catch (const domain_error&) {
+            synced = false;
+        }
+    }
+    else if (synced && followed.history.size() == event.ply) {
+        try {
+            followed.play_uci_move(event.uci);
+            synced = followed.current()->key() == event.key;
+        }
+        catch (const domain_error&) {
+            synced = false;
+        }
+    }
+    else {
+        synced = false;
+    }
+
+    if (!synced) {
+        centaur.resync();
+    }
+    return synced;
+}
+
+// Whatever's changed, drawn now, and any frame that makes, and any change
+// to the game that wasn't notified, published
 void Centaur::render() {
     screen.render(centaur_view);
+
+    if (game && (game->generation() != published || resyncing)) {
+        publish_game(*game, true);
+    }
+
+    const auto frame = screen.frame();
+    if (frame != published_frame) {
+        published_frame = frame;
+        events.screen.publish({frame, time(nullptr)});
+    }
 }
 
-void Centaur::on_changed(Game&) {
-    render();
+void Centaur::on_changed(Game& game) {
+    publish_game(game, false);
 }
 
-void Centaur::set_game(unique_ptr<Game> game) {
-    if (centaur.game) {
-        centaur.game->unobserve(this);
+// Only the move, if it's one played onto the game as last published, and
+// nobody's asked for the whole game since
+void Centaur::publish_game(const Game& game, bool quiet) {
+    const auto ply    = game.history.size() - 1;
+    const auto before = game.previous();
+    const auto whole  = resyncing.exchange(false) || game.identity() != published_identity ||
+        ply != published_ply + 1 || !before || before->key() != published_key;
+
+    published          = game.generation();
+    published_identity = game.identity();
+    published_ply      = ply;
+    published_key      = game.current()->key();
+    if (events.game.subscribed()) {
+        events.game.publish(game_event(game, quiet, whole));
     }
-    centaur.game = std::move(game);
-    centaur.game->observe(this);
+}
+
+void Centaur::resync() {
+    resyncing = true;
+    board.wake();
+}
+
+// Changes to whichever game is current are published, see replace_game()
+void Centaur::set_game(unique_ptr<Game> game) {
+    centaur.reconstruction.reset();
+    replace_game(centaur.game, std::move(game), *this);
 }
 
 Centaur::Centaur() {
     set_game(make_unique<Game>());
     clear_feedback();
+    show_leds();
 }
 
 bool Centaur::reversed() const {
@@ -117,133 +183,111 @@ void Centaur::reversed(bool reversed) {
     board.reversed = reversed;
 }
 
-int Centaur::batterylevel() {
+int Centaur::batterylevel() const {
     return board.batterylevel();
 }
 
-int Centaur::charging() {
+int Centaur::charging() const {
     return board.charging();
 }
 
+LatencyHistogram::Clock::time_point Centaur::battery_sampled() const {
+    return board.battery_sampled();
+}
+
 Bitmap Centaur::getstate() {
-    return board.getstate();
+    const auto boardstate = board.getstate();
+    if (boardstate != mirrored) {
+        mirrored = boardstate;
+        events.board.publish({{}, boardstate});
+    }
+    return boardstate;
 }
 
 // Extend actions history with any new actions read from board.  Return total
-// number of unprocessed actions in history.
+// number of unprocessed actions in history.  A lift is the start of a move,
+// so the display had better be awake for it.
 int Centaur::update_actions() {
+    const auto seen = actions.size();
     board.read_actions(actions);
+    for (auto i = seen; i < actions.size(); ++i) {
+        if (actions[i].lift != SQUARE_INVALID) {
+            screen.prewarm();
+            break;
+        }
+    }
+    if (actions.size() > seen) {
+        events.board.publish({ActionList(actions.begin() + seen, actions.end()), mirrored});
+    }
     return actions.size();
 }
 
+bool Centaur::command(RemoteCommand command) {
+    if (!commands.push(command)) {
+        return false;
+    }
+    board.wake();
+    return true;
+}
+
+void Centaur::start_reading() {
+    board.start_reading();
+}
+
+void Centaur::stop_reading() {
+    board.stop_reading();
+}
+
+int Centaur::wakeup_fd() const {
+    return board.wakeup_fd();
+}
+
 // Pull any outstanding action events from board and discard them.
 void Centaur::purge_actions() {
     while (update_actions()) {
         actions.clear();
     }
+    reconstruction.reset();
 }
 
 void Centaur::clear_feedback() {
-    board.leds_off();
+    leds.off();
 }
 
 void Centaur::led(Square square) {
-    board.led(square);
+    leds.light(square);
 }
 
 void Centaur::led_from_to(Square from, Square to) {
-    board.led_from_to(from, to);
+    leds.light(from, to);
 }
 
 void Centaur::show_feedback(Bitmap diff) {
-    static auto old_square1 = SQUARE_INVALID;
-    static auto old_square2 = SQUARE_INVALID;
-
-    auto square1 = SQUARE_INVALID;
-    auto square2 = SQUARE_INVALID;
-
     switch (__builtin_popcountll(diff)) {
-    case 1:
-        square1 = static_cast<Square>(__builtin_ctzll(diff));
-        if (old_square1 == square1 && old_square2 == SQUARE_INVALID) {
-            board.led_flash();
+    case 1: {
+        const auto square = static_cast<Square>(__builtin_ctzll(diff));
+        if (leds.showing(square)) {
+            leds.flash();
         } else {
-            old_square1 = square1;
-            old_square2 = SQUARE_INVALID;
-            board.led(square1);
+            leds.light(square);
         }
         break;
-    case 2:
-        square1 = static_cast<Square>(__builtin_ctzll(diff));
-        square2 = static_cast<Square>(__builtin_ctzll(diff & ~(1ull << square1)));
-        if (old_square1 != square1 || old_square2 != square2) {
-            old_square1 = square1;
-            old_square2 = square2;
-            board.led_from_to(square1, square2);
-        }
+    }
+    case 2: {
+        const auto square1 = static_cast<Square>(__builtin_ctzll(diff));
+        const auto square2 = static_cast<Square>(__builtin_ctzll(diff & ~(1ull << square1)));
+        leds.light(square1, square2);
         break;
+    }
     case 0:   // No change
     default:  // Too many changes
-        old_square1 = SQUARE_INVALID;
-        old_square2 = SQUARE_INVALID;
-        board.leds_off();
+        leds.off();
         break;
     }
 }
 
-// Try to reconstruct earliest move from provided action history
-static bool
-history_read_move(
-    Game&  game,
-    Bitmap boardstate,
-    ActionList::const_iterator& begin,  // in/out: Next unused action
-    ActionList::const_iterator  end,    // Limit of unused actions
-    MoveList&       candidates,
-    optional<Move>& takeback)
-{
-    // Reconstruct boardstate from last known position
-    auto state = game.bitmap();
-
-    // History of simulated actions, grows as we consume provided history
-    ActionList local_actions;
-
-    // Walk through history updating simulated boardstate, trying to read a
-    // move at each step.
-    while (begin != end) {
-        // Consume next action from history
-        const auto action = *begin++;
-
-        // Add action to simulated history
-        local_actions.push_back(action);
-
-        // Update boardstate to match simulated action
-        if (action.lift != SQUARE_INVALID) {
-            state &= ~(1ull << action.lift);
-        }
-        else if (action.place != SQUARE_INVALID) {
-            state |= 1ull << action.place;
-        }
-
-        // Are we able to read a move?
-        const auto maybe_valid =
-            game.read_move(state, local_actions, candidates, takeback);
-
-        if (!candidates.empty() || takeback.has_value()) {
-            // Yes, we read a move.
-            return true;
-        }
-
-        // We can accept an incomplete move only at the very end (otherwise we
-        // might imagine a nonsense sequence of incomplete moves and make no
-        // progress)
-        if (maybe_valid && begin == end && state == boardstate) {
-            return true;
-        }
-    }
-
-    // We got nuthin'
-    assert(begin == end);
-    return false;
+void Centaur::show_leds() {
+    leds.show();
 }
 
 bool Centaur::read_move(
@@ -255,11 +299,17 @@ bool Centaur::read_move(
     assert(boardstate != Board::STARTING_POSITION);
 
     // Try to read a move
-    auto maybe_valid = game->read_move(boardstate, actions, candidates, takeback);
+    bool maybe_valid;
+    {
+        LatencyTimer timer{read_move_latency};
+        TRACE_SPAN("read_move");
+        maybe_valid = game->read_move(boardstate, actions, candidates, takeback);
+    }
 
     if (!candidates.empty() || takeback.has_value()) {
         // 5x5, we won't need to review actions history
         actions.clear();
+        reconstruction.reset();
         clear_feedback();
         return true;
     }
@@ -282,111 +332,47 @@ bool Centaur::read_move(
     // actions should map out a clear path from the last known board position
     // to the current position.  Otherwise we simply don't have any way to
     // interpret them.
-    auto begin = actions.cbegin();
-    auto end   = actions.cend();
-    for (; begin != end; ++begin) {
-        const ActionList tail{begin, end};
-
-        // For any given tail, we'll read and simulate the available moves.
-        Game copy{*game};
-        auto step_valid = true;
-
-        auto tail_begin = tail.cbegin();
-        auto tail_end   = tail.cend();
-        while (tail_begin != tail_end) {
-            MoveList       local_candidates;
-            optional<Move> local_takeback;
-
-            const auto pre_begin = tail_begin;
-            step_valid = history_read_move(
-                copy,
-                boardstate,
-                tail_begin,        // in/out: Next unused action
-                tail_end,
-                local_candidates,
-                local_takeback);
-
-            // LOOP VARIANT
-            // history_read_move() always consumes at least one action, so
-            // we're guaranteed to make progress, and the loop will terminate
-            assert(pre_begin != tail_begin);
-
-            if (!step_valid) {
-                // Consumed everything but unable to read any moves from history
-                assert(tail_begin == tail_end);
-                break;
-            }
-
-            if (local_candidates.empty() && !local_takeback.has_value()) {
-                // Should only get an incomplete move at end of actions history
-                assert(tail_begin == tail_end);
-                break;
-            }
-
-            // N.B., there can be more than one candidate move only in the case
-            // of pawn promotion.  Should this happen here, in simulation,
-            // assume we promote to queen.  Conveniently, the queen promotion
-            // will be the first candidate.  (While it is possible to try each
-            // promotion in case any of them yield a valid history, that is an
-            // exercise for another day.)
-
-            // Simulate move on local copy of game
-            if (local_takeback.has_value() && !local_candidates.empty()) {
-                copy.revise_move(*local_takeback, local_candidates.front());
-            }
-            else if (local_takeback.has_value()) {
-                copy.play_takeback(*local_takeback);
-            }
-            else if (!local_candidates.empty()) {
-                copy.play_move(local_candidates.front());
-            }
-        }
-
-        if (step_valid && copy.bitmap() == boardstate) {
-            // Reconstruction makes some kind of sense, we've found our tail
-            break;
-        }
+    Reconstructed reconstructed;
+    bool found;
+    {
+        LatencyTimer timer{reconstruction_latency};
+        TRACE_SPAN("reconstruction");
+        found = reconstruction.find_tail(*game, actions, boardstate, reconstructed);
     }
-
-    // If reconstruction failed--there's no tail that makes any kind of sense--we
-    // have to insist the user has made an illegal move
-    if (begin == end) {
-        // We're out of options and must wait for the board to be restored.  If
-        // the boardstate does not differ too much from the last known position,
-        // we can provide some feedback.
-        show_feedback(game->bitmap() ^ boardstate);
+    if (!found) {
+        // If reconstruction failed--there's no tail that makes any kind of
+        // sense--we have to insist the user has made an illegal move.  We're
+        // out of options and must wait for the board to be restored.  If the
+        // boardstate does not differ too much from the last known position,
+        // we can provide some feedback.  (Unless reconstruction just ran out
+        // of time, in which case we'll hear more on the next call.)
+        if (!reconstruction.busy()) {
+            show_feedback(game->bitmap() ^ boardstate);
+        }
         return false;
     }
 
     // On the other hand, if reconstruction succeeded, we'll now process the
     // first reconstructed move.  (Subsequent moves will emerge from repeated
-    // calls to this method.)
-
-    // Delete "noise" actions preceeding reconstructed tail
-    actions.erase(actions.cbegin(), begin);
-
-    begin = actions.cbegin();
-    end   = actions.cend();
-    maybe_valid = history_read_move(
-        *game,
-        boardstate,
-        begin,       // in/out: Next unused action
-        end,
-        candidates,
-        takeback);
-
-    // Must be true, we just simulated it
-    assert(maybe_valid);
+    // calls to this method.)  Delete "noise" actions preceeding reconstructed
+    // tail, and consume actions used in reconstruction
+    actions.erase(actions.cbegin(), actions.cbegin() + reconstructed.end);
+    reconstruction.reset();
 
-    if (!candidates.empty() || takeback.has_value()) {
-        // Got reconstructed move, consume actions used in reconstruction
-        actions.erase(actions.cbegin(), begin);
+    if (reconstructed.move) {
+        candidates.push_back(*reconstructed.move);
     }
+    takeback = reconstructed.takeback;
 
     clear_feedback();
     return true;
 }
 
+// Reconstruction ran out of time, and wants to be called again
+bool Centaur::reconstructing() const {
+    return reconstruction.busy();
+}
+
 // This file is part of the Raccoon's Centaur Mods (RCM).
 //
 // RCM is free software: you can redistribute it and/or modify
@@ -6,31 +6,130 @@
 #define CENTAUR_H
 
 #include "board.h"
+#include "leds.h"
 #include "screen.h"
+#include "utility/eventbus.h"
+#include "utility/ring.h"
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
 #include <optional>
+#include <string>
 #include <vector>
 
+// What's changed, as events for subscribers to take on threads of their own
+// (see EventBus), each as the game's thread saw it, so nothing needs to
+// look back at what changed
+
+// A move played or taken back, or a new game.  Quiet if it wasn't notified,
+// e.g., a game set up, and was caught up with on rendering.  A move played
+// onto the game as last published is just the move, so nothing the length
+// of the game is made on the game's thread as it's played; anything else
+// has the whole game, as a snapshot (see Game::snapshot()).  Subscribers
+// wanting more than the move follow the game with one of their own (see
+// GameFollower)
+struct GameEvent {
+    std::uint64_t     generation{0};
+    std::size_t       ply{0};
+    thc::zobrist::Key key{0};  // Of the position now
+    std::string       uci;     // Of the move just played, empty if that's not what changed
+    std::string       san;
+    std::string       snapshot;  // Empty if it's just the move
+    std::time_t       timestamp{0};
+    bool              quiet{false};
+};
+
+// A frame drawn
+struct ScreenEvent {
+    unsigned    generation{0};
+    std::time_t timestamp{0};
+};
+
+// The board as it's read: new actions, or a boardstate read that's
+// different
+struct BoardEvent {
+    ActionList actions;  // Just read, none if it's only the boardstate
+    Bitmap     boardstate{0};
+};
+
+// The engine's analysis of the game's position, as the game loop last had it
+struct AnalysisEvent {
+    UCIAnalysis analysis;
+    std::time_t timestamp{0};
+};
+
+struct CentaurEvents {
+    EventBus<GameEvent>     game;
+    EventBus<ScreenEvent>   screen;
+    EventBus<BoardEvent>    board;
+    EventBus<AnalysisEvent> analysis;
+};
+
+// The event for game as it is now, whole or, if it's a move just played,
+// only the move
+GameEvent game_event(const Game& game, bool quiet = false, bool whole = true);
+
+// A game kept up with from its events, on the subscriber's thread, so its
+// PGN, say, is made there instead of on the game's.  Should an event not
+// follow from the game as it's kept, e.g., the first after subscribing,
+// the whole game's asked for again (see Centaur::resync()), and events are
+// passed over until it comes
+class GameFollower {
+public:
+    // Whether the game is now as the event has it
+    bool follow(const GameEvent& event);
+
+    const Game& game() const { return followed; }
+
+private:
+    Game followed;
+    bool synced{false};
+};
+
+// What the web app may ask of the game
+enum RemoteCommand : std::uint8_t {
+    REMOTE_TAKEBACK,
+    REMOTE_NEW_GAME,
+};
+
 class Centaur : public Observer<Game> {
 public:
     Board  board;
+    Leds   leds{board};
     Screen screen;
 
     std::unique_ptr<Game> game;
     std::unique_ptr<View> screen_view;
     ActionList            actions;
+    Reconstruction        reconstruction;  // Of actions, when we've missed a move
+    CentaurEvents         events;
+
+    // From the one thread serving WebSockets to the game loop, which is
+    // woken for them
+    Ring<RemoteCommand, 16> commands;
+    bool command(RemoteCommand);
 
     Centaur();
 
     bool reversed() const;
     void reversed(bool);
 
+    // Changes to the game are published as they happen, and drawn once
+    // there's a moment, on render(), so moves wait on nobody
     void on_changed(Game&) override;
     void render();
     void set_game(std::unique_ptr<Game>);
 
-    int batterylevel();
-    int charging();
+    // Have the whole game published on the next render(), from any thread,
+    // for a subscriber that's lost track of it
+    void resync();
+
+    // Cached, see Board
+    int batterylevel() const;
+    int charging() const;
+    LatencyHistogram::Clock::time_point battery_sampled() const;
 
     // Read current state of board fields
     // MSB: H1=63 G1 F1 ... A1, H2 G2 ... A2, ..., H8 G8 ... A8=0
@@ -39,15 +138,34 @@ public:
     int update_actions();
     void purge_actions();
 
+    // Queue field events from a thread of our own, see Board
+    void start_reading();
+    void stop_reading();
+    int wakeup_fd() const;
+
     bool read_move(
         Bitmap    boardstate,
         MoveList& candidates,
         std::optional<thc::Move>& takeback);
+    bool reconstructing() const;
 
+    // LEDs change together, on show_leds()
     void clear_feedback();
     void led(thc::Square);
     void led_from_to(thc::Square, thc::Square);
     void show_feedback(Bitmap);
+    void show_leds();
+
+private:
+    Bitmap            mirrored{0};       // Boardstate as last published
+    std::uint64_t     published{0};      // Game's generation, ditto
+    std::uint64_t     published_identity{0};
+    std::size_t       published_ply{0};  // And where it was
+    thc::zobrist::Key published_key{0};
+    unsigned          published_frame{0};
+    std::atomic<bool> resyncing{false};  // See resync()
+
+    void publish_game(const Game&, bool quiet);
 };
 
 extern Centaur centaur;
@@ -11,20 +11,93 @@
 // (https://github.com/DGTCentaurMods/DGTCentaurMods/blob/37ca9c25ab4fd34acffabe0bc665e30e4e9d89b0/LICENSE.md).
 
 #include "boardserial.h"
-#include "../utility/sleep.h"
+#include "../cfg.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cerrno>
 #include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <stdexcept>
 
+#include <fcntl.h>
+#include <poll.h>
 #include <sys/file.h>
 #include <termios.h>
 #include <unistd.h>
 
 using namespace std;
 
+// How long to wait for the board to answer a request.  At 1Mbaud even the
+// largest reply (boardstate, 135 bytes) takes under 2ms on the wire
+static const long REPLY_TIMEOUT_MS = 50;
+
+// Startup is allowed longer, the board may still be waking
+static const long STARTUP_TIMEOUT_MS = 2000;
+
+// Packet header {id, length >> 7, length & 127}, then length counts the
+// whole packet including the header and the trailing checksum.  IDs all have
+// the high bit set, and the length bytes never do, which is how we find the
+// start of a packet in noise
+static const int HEADER_LEN = 3;
+static const int MIN_PACKET_LEN = HEADER_LEN + 1;
+
+// Reply to boardstate is {id, 1, 7, addr, addr, ?}, two bytes per field,
+// checksum.  It has never been checked against its checksum
+static const int BOARDSTATE_LEN = 6 + 2 * 64 + 1;
+
+// A request written, or about to be, and its reply once that arrives
+struct BoardSerial::Pending {
+    bool (*matches)(const uint8_t* data, int length);
+    long deadline{0};                   // Zero until written
+    int  length{-1};                    // Negative until answered
+    array<uint8_t, 256> data;
+};
+
+// Replies, by what they look like
+static bool is_fields(const uint8_t* data, int length) {
+    return length >= 6 && (data[0] == 131 || data[0] == 133);
+}
+
+static bool is_boardstate(const uint8_t*, int length) {
+    return length == BOARDSTATE_LEN;
+}
+
+static bool is_charging(const uint8_t* data, int length) {
+    return length == 7 && data[0] == 181;
+}
+
+static bool is_buttons(const uint8_t* data, int length) {
+    return length >= 6 && data[0] == 177;
+}
+
+static long now_ms() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+// Wait until fd is ready for events or deadline passes
+static bool wait_for(int fd, short events, long deadline) {
+    for (;;) {
+        const auto remaining = deadline - now_ms();
+        if (remaining <= 0) {
+            return false;
+        }
+
+        struct pollfd pfd = {fd, events, 0};
+        const auto rc = poll(&pfd, 1, static_cast<int>(remaining));
+        if (rc > 0) {
+            return true;
+        }
+        if (rc < 0 && errno != EINTR) {
+            perror("poll");
+            return false;
+        }
+    }
+}
+
 // Shutdown serial connection to board
 BoardSerial::~BoardSerial() {
     if (fd >= 0) {
@@ -34,7 +107,7 @@ BoardSerial::~BoardSerial() {
 }
 
 static int open_serial(const char* serial_port) {
-    const auto fd = open(serial_port, O_RDWR);
+    const auto fd = open(serial_port, O_RDWR | O_NONBLOCK | O_CLOEXEC);
     if (fd < 0) {
         perror("open");
         return -1;
@@ -55,9 +128,9 @@ static int open_serial(const char* serial_port) {
     cfmakeraw(&serial);
     cfsetspeed(&serial, B1000000);
 
-    // Blocking read with 0.2s timeout
+    // Non-blocking reads, poll() does the waiting
     serial.c_cc[VMIN]  = 0;
-    serial.c_cc[VTIME] = 2; // deciseconds
+    serial.c_cc[VTIME] = 0;
 
     if (tcsetattr(fd, TCSAFLUSH, &serial) != 0) {
         perror("tcsetattr");
@@ -72,39 +145,25 @@ error:
     return -1;
 }
 
-static int read_serial(int fd, uint8_t* buf, int len) {
+// Read whatever arrives before deadline, up to len bytes.  Returns as soon as
+// there's anything at all
+static int read_serial(int fd, uint8_t* buf, int len, long deadline) {
     assert(fd >= 0);
     assert(buf != NULL && len >= 0);
 
-    auto receiving = buf;
-    auto remaining = len;
-
-    auto total_read = 0;
-    auto num_read   = 0;
-    while (num_read < remaining) {
-        num_read = read(fd, receiving, remaining);
-        if (num_read == 0) {
-            break;
+    while (wait_for(fd, POLLIN, deadline)) {
+        const auto num_read = read(fd, buf, len);
+        if (num_read > 0) {
+            return num_read;
         }
-        if (num_read < 0) {
-            if (errno != EAGAIN) {
-                perror("read");
-                goto error;
+        if (num_read < 0 && errno != EAGAIN && errno != EINTR) {
+            perror("read");
+            printf("read_serial error: flushing\n");
+            if (tcflush(fd, TCIFLUSH) != 0) {
+                perror("tcflush");
             }
-            num_read = 0;
+            return 0;
         }
-        total_read += num_read;
-        receiving  += num_read;
-        remaining  -= num_read;
-        assert(remaining >= 0);
-    }
-
-    return total_read;
-
-error:
-    printf("read_serial error: flushing\n");
-    if (tcflush(fd, TCIFLUSH) != 0) {
-        perror("tcflush");
     }
     return 0;
 }
@@ -116,14 +175,12 @@ error:
 static void clear_serial(int fd) {
     // Wait for any pending writes to complete
     tcdrain(fd);
-    sleep_ms(100);
 
-    // Read anything there is to read
+    // Read anything there is to read, until the line goes quiet
     uint8_t buf[256];
-    while (read_serial(fd, buf, sizeof buf) > 0) {
+    while (read_serial(fd, buf, sizeof buf, now_ms() + 100) > 0) {
         // Discard bufferred data
         tcflush(fd, TCIFLUSH);
-        sleep_ms(100);
     }
 }
 
@@ -140,76 +197,105 @@ static bool valid_checksum(const uint8_t* buf, int len) {
     return buf[len - 1] == checksum(buf, len - 1);
 }
 
-// Read packet with defined length
-static int read_packet(int fd, uint8_t* data, int length) {
+bool BoardSerial::receive(size_t n, long deadline) {
+    assert(n <= rx.size());
+    while (rx_len < n) {
+        const auto num_read = read_serial(fd, rx.data() + rx_len, rx.size() - rx_len, deadline);
+        if (num_read <= 0) {
+            return false;
+        }
+        rx_len += num_read;
+    }
+    return true;
+}
+
+// Frame one packet out of the byte stream.  Anything that can't be the start
+// of a packet is dropped a byte at a time, so we pick up again at the next
+// packet instead of waiting out the deadline on garbage
+int BoardSerial::read_packet(uint8_t* data, int length, long deadline, int unchecked_len) {
     assert(fd >= 0);
     assert(data != NULL && length >= 256);
 
-    // Read packet header {id, 0|1, len}
-    const auto HEADER_LEN = 3;
-
-    auto receiving  = data;
-    auto packet_len = HEADER_LEN;
-    auto total_read = 0;
-    auto num_read   = 0;
-    const auto timeout = time(NULL) + 2;
-    while (total_read < packet_len && time(NULL) < timeout) {
-        num_read    = read_serial(fd, receiving, length);
-        total_read += num_read;
-        receiving  += num_read;
-        length     -= num_read;
-        if (total_read >= HEADER_LEN) {
-            packet_len = data[HEADER_LEN - 1];
+    const auto drop = [this](size_t n) {
+        memmove(rx.data(), rx.data() + n, rx_len - n);
+        rx_len -= n;
+    };
+
+    for (;;) {
+        if (!receive(HEADER_LEN, deadline)) {
+            break;
         }
-    }
 
-    if (total_read != packet_len || !valid_checksum(data, total_read)) {
-        printf("bad packet\n");
-        return 0;
-    }
+        const auto packet_len = rx[1] << 7 | rx[2];
+        if (!(rx[0] & 0x80) || rx[1] > 1 || (rx[2] & 0x80) ||
+            packet_len < MIN_PACKET_LEN || packet_len > length)
+        {
+            drop(1);
+            continue;
+        }
 
-    // printf("READ[%d]:", total_read);
-    // for (int i = 0; i != total_read; ++i) {
-    //     printf(" %d", data[i]);
-    // }
-    // printf("\n");
+        if (!receive(packet_len, deadline)) {
+            break;
+        }
+
+        if (packet_len != unchecked_len && !valid_checksum(rx.data(), packet_len)) {
+            printf("bad packet\n");
+            drop(1);
+            continue;
+        }
+
+        // printf("READ[%d]:", packet_len);
+        // for (int i = 0; i != packet_len; ++i) {
+        //     printf(" %d", rx[i]);
+        // }
+        // printf("\n");
 
-    return total_read;
+        memcpy(data, rx.data(), packet_len);
+        drop(packet_len);
+        if (recorder) {
+            recorder->record(packetlog::FROM_BOARD, data, packet_len);
+        }
+        return packet_len;
+    }
+
+    // Whatever's left is a partial packet that's not going to be finished
+    rx_len = 0;
+    return 0;
 }
 
 // Receive packet with specific ID
-static int recv_packet(int fd, int id, uint8_t* data, int length) {
-    const auto timeout = time(NULL) + 2;
-    while (time(NULL) < timeout) {
-        const auto num_read = read_packet(fd, data, length);
-        if (num_read > 0 && data[0] == id) {
+int BoardSerial::recv_packet(int id, uint8_t* data, int length, long deadline) {
+    int num_read;
+    while ((num_read = read_packet(data, length, deadline)) > 0) {
+        if (data[0] == id) {
             return num_read;
         }
     }
     return 0;
 }
 
+// Write buf, which may hold several packets back to back
 static int write_serial(int fd, const uint8_t* buf, int len) {
     assert(fd >= 0);
     assert(buf != NULL && len >= 1);
-    assert(valid_checksum(buf, len));
+
+    const auto deadline = now_ms() + REPLY_TIMEOUT_MS;
 
     auto sending   = buf;
     auto remaining = len;
 
     auto total_written = 0;
-    auto num_written   = 0;
-    while (num_written < remaining) {
-        num_written = write(fd, sending, remaining);
-        if (num_written == 0) {
-            break;
-        }
+    while (remaining > 0) {
+        const auto num_written = write(fd, sending, remaining);
         if (num_written < 0) {
-            if (errno != EAGAIN) {
+            if (errno == EAGAIN || errno == EINTR) {
+                if (wait_for(fd, POLLOUT, deadline)) {
+                    continue;
+                }
+            } else {
                 perror("write");
-                goto error;
             }
-            num_written = 0;
+            goto error;
         }
         total_written += num_written;
         sending   += num_written;
@@ -246,12 +332,17 @@ void BoardSerial::read_address() {
     addr[1] = 0;
 
     const uint8_t request[4] = {135, 0, 0, 7};
-    write_serial(fd, request, 4);
 
+    // Ask again every so often, in case the board wasn't listening yet
     uint8_t buf[256];
-    const auto timeout = time(NULL) + 2;
-    while (time(NULL) < timeout) {
-        if (recv_packet(fd, 135, buf, sizeof buf) != 6) {
+    const auto deadline = now_ms() + STARTUP_TIMEOUT_MS;
+    while (now_ms() < deadline) {
+        write_serial(fd, request, 4);
+        if (recorder) {
+            recorder->record(packetlog::TO_BOARD, request, 4);
+        }
+        const auto retry = min(deadline, now_ms() + 10 * REPLY_TIMEOUT_MS);
+        if (recv_packet(135, buf, sizeof buf, retry) != 6) {
             continue;
         }
 
@@ -267,6 +358,16 @@ void BoardSerial::read_address() {
 
 // Initialize serial connection to board
 BoardSerial::BoardSerial() {
+    // Optional, the board works without it
+    if (const auto path = cfg_serial_record()) {
+        try {
+            recorder = make_unique<PacketRecorder>(path);
+        }
+        catch (const runtime_error& e) {
+            printf("%s\n", e.what());
+        }
+    }
+
     // Open device
     fd = open_serial("/dev/serial0");
     if (fd < 0) {
@@ -306,37 +407,156 @@ void BoardSerial::build_packet(uint8_t* buf, int addr_pos, int len) {
     add_checksum(buf, len);
 }
 
+void BoardSerial::queue(const uint8_t* buf, int len) {
+    outgoing.insert(outgoing.end(), buf, buf + len);
+    if (recorder) {
+        recorder->record(packetlog::TO_BOARD, buf, len);
+    }
+}
+
 int BoardSerial::write_board(uint8_t* buf, int addr_pos, int len) {
     build_packet(buf, addr_pos, len);
-    const auto num_written = write_serial(fd, buf, len);
+    queue(buf, len);
+    return flush();
+}
+
+BoardSerial::Reply BoardSerial::send(
+    uint8_t* buf,
+    int      addr_pos,
+    int      len,
+    bool   (*matches)(const uint8_t*, int))
+{
+    build_packet(buf, addr_pos, len);
+    queue(buf, len);
+
+    Reply reply;
+    reply.pending = make_shared<Pending>();
+    reply.pending->matches = matches;
+    pending.push_back(reply.pending);
+    return reply;
+}
+
+// All queued requests go out in one write, replies are timed from when it
+// completes
+int BoardSerial::flush() {
+    if (outgoing.empty()) {
+        return 0;
+    }
+
+    const auto len         = static_cast<int>(outgoing.size());
+    const auto num_written = write_serial(fd, outgoing.data(), len);
+    outgoing.clear();
+
+    const auto deadline = now_ms() + REPLY_TIMEOUT_MS;
+    for (auto& request : pending) {
+        if (request->deadline == 0) {
+            request->deadline = deadline;
+        }
+    }
+
     return num_written == len ? 0 : 1;
 }
 
-// Read battery and charging status
-int BoardSerial::chargingstate() {
-    uint8_t request[4] = {152};
-    write_board(request, 1, sizeof request);
+int BoardSerial::wait(Reply& reply, uint8_t* data, int length) {
+    const auto request = std::move(reply.pending);
+    if (!request) {
+        return 0;
+    }
+    assert(length >= static_cast<int>(request->data.size()));
+
+    flush();
 
     uint8_t buf[256];
-    const auto timeout = time(NULL) + 2;
-    while (time(NULL) < timeout) {
-        if (recv_packet(fd, 181, buf, sizeof buf) == 7) {
-            break;
+    while (request->length < 0) {
+        const auto expecting_boardstate = any_of(pending.begin(), pending.end(), [](const auto& p) {
+            return p->matches == is_boardstate;
+        });
+        const auto num_read = read_packet(
+            buf, sizeof buf, request->deadline, expecting_boardstate ? BOARDSTATE_LEN : 0);
+
+        if (num_read == 0) {
+            // Nothing more is coming in time for anything that's overdue
+            const auto now = now_ms();
+            for (auto p = pending.begin(); p != pending.end();) {
+                if ((*p)->deadline <= now) {
+                    (*p)->length = 0;
+                    p = pending.erase(p);
+                } else {
+                    ++p;
+                }
+            }
+            continue;
         }
+
+        // The board answers in order, so the oldest request it could be for
+        const auto match = find_if(pending.begin(), pending.end(), [&](const auto& p) {
+            return p->matches(buf, num_read);
+        });
+        if (match == pending.end()) {
+            // Unsolicited, or for a request that's already given up
+            continue;
+        }
+        memcpy((*match)->data.data(), buf, num_read);
+        (*match)->length = num_read;
+        pending.erase(match);
     }
 
+    memcpy(data, request->data.data(), request->length);
+    return request->length;
+}
+
+BoardSerial::Reply BoardSerial::send_chargingstate() {
+    uint8_t request[4] = {152};
+    return send(request, 1, sizeof request, is_charging);
+}
+
+BoardSerial::Reply BoardSerial::send_boardstate() {
+    uint8_t request[7] = {240, 0, 7, 0, 0, 127, 0};
+    return send(request, 3, sizeof request, is_boardstate);
+}
+
+BoardSerial::Reply BoardSerial::send_readdata() {
+    uint8_t request[4] = {131};
+    return send(request, 1, sizeof request, is_fields);
+}
+
+BoardSerial::Reply BoardSerial::send_buttons() {
+    uint8_t request[4] = {148};
+    return send(request, 1, sizeof request, is_buttons);
+}
+
+// Read battery and charging status
+int BoardSerial::chargingstate() {
+    auto reply = send_chargingstate();
+    return chargingstate(reply);
+}
+
+int BoardSerial::chargingstate(Reply& reply) {
+    uint8_t buf[256];
+    if (wait(reply, buf, sizeof buf) != 7) {
+        return -1;
+    }
     return buf[5];
 }
 
 // Read current state of board fields
 Bitmap BoardSerial::boardstate() {
-    uint8_t request[7] = {240, 0, 7, 0, 0, 127, 0};
-    write_board(request, 3, sizeof request);
+    auto reply = send_boardstate();
+    return boardstate(reply);
+}
 
+Bitmap BoardSerial::boardstate(Reply& reply) {
     uint8_t buf[256];
-    size_t num_read = 0;
-    while (num_read < 128 + 7) {
-        num_read = read_serial(fd, buf, sizeof buf);
+    auto num_read = wait(reply, buf, sizeof buf);
+
+    // One retry, since there's no good answer without it
+    if (num_read != BOARDSTATE_LEN) {
+        auto retry = send_boardstate();
+        num_read = wait(retry, buf, sizeof buf);
+    }
+    if (num_read != BOARDSTATE_LEN) {
+        printf("No boardstate from serial\n");
+        return 0;
     }
 
     Bitmap boardstate = 0;
@@ -356,36 +576,25 @@ Bitmap BoardSerial::boardstate() {
 
 // Read field events from board
 int BoardSerial::readdata(uint8_t* buf, int len) {
+    auto reply = send_readdata();
+    return readdata(reply, buf, len);
+}
+
+int BoardSerial::readdata(Reply& reply, uint8_t* buf, int len) {
     assert(fd >= 0);
     assert(buf && len >= 256);
-
-    uint8_t request[4] = {131};
-    write_board(request, 1, sizeof request);
-
-    const auto timeout = time(NULL) + 2;
-    while (time(NULL) < timeout) {
-        const auto num_read = read_packet(fd, buf, len);
-        if (num_read >= 6 && (buf[0] == 131 || buf[0] == 133)) {
-            return num_read;
-        }
-    }
-
-    return 0;
+    return wait(reply, buf, len);
 }
 
 void BoardSerial::buttons(Buttons& press, Buttons& release) {
-    uint8_t request[4] = {148};
-    write_board(request, 1, sizeof request);
+    auto reply = send_buttons();
+    buttons(reply, press, release);
+}
 
+void BoardSerial::buttons(Reply& reply, Buttons& press, Buttons& release) {
     uint8_t buf[256];
-    const auto timeout = time(NULL) + 2;
-    while (time(NULL) < timeout) {
-        if (recv_packet(fd, 177, buf, sizeof buf) >= 6) {
-            break;
-        }
-    }
-
-    if (buf[0] != 177 || buf[2] < 16) {
+    const auto num_read = wait(reply, buf, sizeof buf);
+    if (num_read < 6 || buf[2] < 16) {
         press   = Buttons();
         release = Buttons();
         return;
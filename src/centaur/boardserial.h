@@ -7,9 +7,15 @@
 #ifndef BOARDSERIAL_H
 #define BOARDSERIAL_H
 
+#include "../utility/packetlog.h"
+
 #include <array>
 #include <bitset>
+#include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
 
 using Bitmap = std::uint64_t;
 
@@ -39,10 +45,29 @@ enum Sound {
 };
 
 class BoardSerial {
+    struct Pending;
+
     int fd{-1};
     std::array<std::uint8_t, 2> addr{0, 0};
 
+    // Received but not yet framed, which may be the start of the next packet
+    std::array<std::uint8_t, 512> rx;
+    std::size_t rx_len{0};
+
+    // Requests not yet written, and those awaiting replies, oldest first
+    std::vector<std::uint8_t>            outgoing;
+    std::deque<std::shared_ptr<Pending>> pending;
+
+    // Every packet both ways, when asked for by cfg_serial_record()
+    std::unique_ptr<PacketRecorder> recorder;
+
 public:
+    // A request on its way to the board, see send_*() below
+    class Reply {
+        friend class BoardSerial;
+        std::shared_ptr<Pending> pending;
+    };
+
     // Shutdown serial connection to board
     ~BoardSerial() noexcept;
 
@@ -63,6 +88,21 @@ public:
     // Read button events from board
     void buttons(Buttons& press, Buttons& release);
 
+    // Pipelined queries.  send_*() queues a request and returns at once.
+    // Queued requests are written together, as soon as any reply is wanted,
+    // and replies are matched to requests by packet ID as they arrive, so
+    // several queries cost about one round trip.  Then each reply is read
+    // (once) with the call of the same name
+    Reply send_chargingstate();
+    Reply send_boardstate();
+    Reply send_readdata();
+    Reply send_buttons();
+
+    int    chargingstate(Reply& reply);
+    Bitmap boardstate(Reply& reply);
+    int    readdata(Reply& reply, std::uint8_t* buf, int len);
+    void   buttons(Reply& reply, Buttons& press, Buttons& release);
+
     int leds_off();
     int led_flash();
     int led(int square);
@@ -74,8 +114,32 @@ public:
 private:
     void read_address();
 
+    // Read one whole packet, or return 0 once deadline (CLOCK_MONOTONIC ms)
+    // passes.  Packets failing their checksum are skipped, except ones of
+    // unchecked_len
+    int read_packet(std::uint8_t* data, int length, long deadline, int unchecked_len = 0);
+
+    // Read packets until one with this ID arrives
+    int recv_packet(int id, std::uint8_t* data, int length, long deadline);
+
+    // Fill rx until it holds at least n bytes
+    bool receive(std::size_t n, long deadline);
+
     void build_packet(std::uint8_t* buf, int addr_pos, int len);
+    void queue(const std::uint8_t* buf, int len);
+
+    // Queue request, and write everything queued
     int write_board(std::uint8_t* buf, int addr_pos, int len);
+
+    // Queue request expecting a reply that matches
+    Reply send(std::uint8_t* buf, int addr_pos, int len, bool (*matches)(const std::uint8_t*, int));
+
+    // Write queued requests
+    int flush();
+
+    // Read until reply arrives and copy it to data, returning its length, or
+    // 0 if it won't.  Either way the reply is used up
+    int wait(Reply& reply, std::uint8_t* data, int length);
 };
 
 #endif
@@ -13,6 +13,9 @@
 #include "epd2in9d.h"
 
 #include <alloca.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <stdexcept>
@@ -102,11 +105,25 @@ void Spi::send_data(int data) {
     send_byte(data, 1);
 }
 
+// Largest single transfer, as for spidev's default buffer
+static constexpr size_t SPI_CHUNK = 4096;
+
+// Chip select held low across chunks, so it's one transfer to the display
 int Spi::send_array(const uint8_t* buf, size_t len) {
     gpioWrite(PIN_COMMAND_DATA, 1);
     gpioWrite(PIN_CLEAR_TO_SEND, 0);
 
-    auto num_written = spiWrite(handle, (char*)buf, len);
+    auto num_written = 0;
+    for (size_t sent = 0; sent < len; ) {
+        const auto chunk = min(len - sent, SPI_CHUNK);
+        const auto n = spiWrite(handle, (char*)buf + sent, chunk);
+        if (n < 0) {
+            num_written = n;
+            break;
+        }
+        num_written += n;
+        sent += chunk;
+    }
     gpioWrite(PIN_CLEAR_TO_SEND, 1);
 
     return num_written;
@@ -141,18 +158,54 @@ enum Command {
     COMMAND_PTIN  = 0x91,  // Partial In
 };
 
+// Fallback if an edge is missed: ask again this often
+static constexpr auto BUSY_POLL = chrono::milliseconds(100);
+
+static const uint8_t RESOLUTION[] = {
+    SCREEN_WIDTH,         // HRES: Horizontal resolution
+    SCREEN_HEIGHT / 256,  // VRES: Vertical resolution
+    SCREEN_HEIGHT % 256,
+};
+
 Epd2in9d::~Epd2in9d() {
-    sleep();
+    if (awake) {
+        sleep();
+    }
+    gpioSetAlertFuncEx(PIN_BUSY, nullptr, nullptr);
 }
 
 Epd2in9d::Epd2in9d() {
+    gpioSetAlertFuncEx(PIN_BUSY, &Epd2in9d::on_busy, this);
 }
 
+// On pigpio's thread
+void Epd2in9d::on_busy(int, int level, uint32_t, void* self) {
+    if (level != 1) {
+        return;
+    }
+    auto epd = static_cast<Epd2in9d*>(self);
+    {
+        lock_guard<mutex> lock(epd->busy_mutex);
+        epd->ready = true;
+    }
+    epd->busy_cond.notify_all();
+}
+
+// BUSY is low while the controller works.  Sleep until it rises rather
+// than spin on the status command, which refreshes keep up for seconds
 void Epd2in9d::read_busy() {
-    do {
+    unique_lock<mutex> lock(busy_mutex);
+    ready = false;
+    for (;;) {
         spi.send_command(COMMAND_FLG);
-    } while ((gpioRead(PIN_BUSY) & 1) == 0);
-    delay_ms(20);
+        if (ready || (gpioRead(PIN_BUSY) & 1) != 0) {
+            return;
+        }
+        busy_cond.wait_for(lock, BUSY_POLL, [this] { return ready; });
+        if (ready) {
+            return;
+        }
+    }
 }
 
 void Epd2in9d::sleep() {
@@ -165,6 +218,7 @@ void Epd2in9d::sleep() {
 
     // Reinit after sleep/wake
     lut_ready = false;
+    awake     = false;
 
     // Wait at least 2s before doing anything else
     delay_ms(2000);
@@ -180,10 +234,7 @@ void Epd2in9d::wake() {
 	spi.send_command(COMMAND_PSR);
 	spi.send_data(0x1f);
 
-	spi.send_command(COMMAND_TRES);
-	spi.send_data(SCREEN_WIDTH);         // HRES: Horizontal resolution
-	spi.send_data(SCREEN_HEIGHT / 256);  // VRES: Vertical resolution
-	spi.send_data(SCREEN_HEIGHT % 256);
+	spi.send(COMMAND_TRES, RESOLUTION);
 
     // WBmode: VBDF 17|D7  VBDW 97  VBDB 57  WBRmode: VBDF F7  VBDW 77  VBDB 37  VBDR B7
 	spi.send_command(COMMAND_CDI);
@@ -191,6 +242,7 @@ void Epd2in9d::wake() {
 
     // Reinit after sleep/wake
     lut_ready = false;
+    awake     = true;
 }
 
 // Look-Up Time
@@ -263,17 +315,15 @@ void Epd2in9d::init_lut() {
     }
     lut_ready = true;
 
-    spi.send_command(COMMAND_PWR);
-    spi.send_data(0x03);
-    spi.send_data(0x00);
-    spi.send_data(0x2b);
-    spi.send_data(0x2b);
-    spi.send_data(0x03);
+    const uint8_t power[] = {0x03, 0x00, 0x2b, 0x2b, 0x03};
+    spi.send(COMMAND_PWR, power);
 
-    spi.send_command(COMMAND_BTST);
-    spi.send_data(0x17);  // BT_PHA[7:0]
-    spi.send_data(0x17);  // BT_PHB[7:0]
-    spi.send_data(0x17);  // BT_PHC[5:0]
+    const uint8_t booster[] = {
+        0x17,  // BT_PHA[7:0]
+        0x17,  // BT_PHB[7:0]
+        0x17,  // BT_PHC[5:0]
+    };
+    spi.send(COMMAND_BTST, booster);
 
     spi.send_command(COMMAND_PON);
     read_busy();
@@ -286,10 +336,7 @@ void Epd2in9d::init_lut() {
     spi.send_command(COMMAND_PLL);
     spi.send_data(0x3a);
 
-    spi.send_command(COMMAND_TRES);
-    spi.send_data(SCREEN_WIDTH);         // HRES: Horizontal Resolution
-    spi.send_data(SCREEN_HEIGHT / 256);  // VRES: Vertical Resoltion
-    spi.send_data(SCREEN_HEIGHT % 256);
+    spi.send(COMMAND_TRES, RESOLUTION);
 
     spi.send_command(COMMAND_VDCS);
     spi.send_data(0x12);
@@ -302,7 +349,7 @@ void Epd2in9d::init_lut() {
 
 void Epd2in9d::refresh_screen(void) {
     spi.send_command(COMMAND_DRF);
-    delay_ms(10);  // Must be at least 200us
+    gpioDelay(200);  // Must be at least 200us
     read_busy();
 }
 
@@ -332,6 +379,11 @@ static const uint8_t black_buffer[SCREEN_BYTES] = {PIXEL_BLACK};
 
 // Fully refresh display
 void Epd2in9d::display(const uint8_t* data) {
+    // Back from the partial update LUTs to the full refresh ones in OTP
+    if (lut_ready) {
+        wake();
+    }
+
     spi.send_command(COMMAND_DTM1);
     spi.send_array(black_buffer, SCREEN_BYTES);
 
@@ -343,19 +395,37 @@ void Epd2in9d::display(const uint8_t* data) {
 
 // Partially update display
 void Epd2in9d::update(const uint8_t* data) {
+    update(data, 0, SCREEN_HEIGHT - 1, 0, WIDTH_BYTES - 1);
+}
+
+void Epd2in9d::update(const uint8_t* data, int first_row, int last_row, int first_byte, int last_byte) {
+    assert(0 <= first_row && first_row <= last_row && last_row < SCREEN_HEIGHT);
+    assert(0 <= first_byte && first_byte <= last_byte && last_byte < WIDTH_BYTES);
+
     init_lut();
     spi.send_command(COMMAND_PTIN);
-    spi.send_command(COMMAND_PTL);
-    spi.send_data(0);                        // HRST: Horizontal Start
-    spi.send_data(SCREEN_WIDTH - 1);         // HRED: Horizontal End
-
-    spi.send_data(0);                        // VRST: Vertical Start
-    spi.send_data(0);
-    spi.send_data(SCREEN_HEIGHT / 256);      // VRED: Vertical End
-    spi.send_data(SCREEN_HEIGHT % 256 - 1);
+    const uint8_t window_setting[] = {
+        static_cast<uint8_t>(8 * first_byte),      // HRST: Horizontal Start
+        static_cast<uint8_t>(8 * last_byte + 7),   // HRED: Horizontal End
+        static_cast<uint8_t>(first_row / 256),     // VRST: Vertical Start
+        static_cast<uint8_t>(first_row % 256),
+        static_cast<uint8_t>(last_row / 256),      // VRED: Vertical End
+        static_cast<uint8_t>(last_row % 256),
+    };
+    spi.send(COMMAND_PTL, window_setting);
+
+    // Window rows back to back, in one transfer
+    const auto window_bytes = last_byte - first_byte + 1;
+    const auto window_rows  = last_row - first_row + 1;
+    const auto window = (uint8_t*)alloca(window_bytes * window_rows);
+    for (auto row = 0; row < window_rows; ++row) {
+        memcpy(window + row * window_bytes,
+               data + (first_row + row) * WIDTH_BYTES + first_byte,
+               window_bytes);
+    }
 
     spi.send_command(COMMAND_DTM2);
-    spi.send_array(data, SCREEN_BYTES);
+    spi.send_array(window, window_bytes * window_rows);
     refresh_screen();
 }
 
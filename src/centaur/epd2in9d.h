@@ -7,7 +7,10 @@
 #ifndef EPD2IN9D_H
 #define EPD2IN9D_H
 
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
+#include <mutex>
 
 #define SCREEN_WIDTH  128
 #define SCREEN_HEIGHT 296
@@ -38,6 +41,13 @@ public:
     void send_data(int data);
     int  send_array(const std::uint8_t* buf, std::size_t len);
 
+    // Command and its parameters, the parameters in one transfer
+    template <std::size_t N>
+    void send(int command, const std::uint8_t (&data)[N]) {
+        send_command(command);
+        send_array(data, N);
+    }
+
 private:
     void send_byte(int value, int command_data);
 };
@@ -50,6 +60,12 @@ private:
 class Epd2in9d {
     Spi  spi;
     bool lut_ready{false};
+    bool awake{false};
+
+    // BUSY has risen since the last command, as told by pigpio
+    std::mutex              busy_mutex;
+    std::condition_variable busy_cond;
+    bool                    ready{false};
 
 public:
     ~Epd2in9d();
@@ -69,7 +85,13 @@ public:
     // minimal changes necessary to display the new image.
     void update(const std::uint8_t* data);
 
+    // Partially update just the window of rows first_row to last_row, and of
+    // bytes (8 pixels each) first_byte to last_byte in each row.  data is the
+    // whole image, as for update(data)
+    void update(const std::uint8_t* data, int first_row, int last_row, int first_byte, int last_byte);
+
 private:
+    static void on_busy(int gpio, int level, std::uint32_t tick, void* self);
     void read_busy();
     void lut_tables();
     void init_lut();
@@ -5,6 +5,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #include <errno.h>
 #include <sys/stat.h>
@@ -69,6 +70,140 @@ int cfg_port(void) {
     return s_port ? atoi(s_port) : 80;
 }
 
+const char *cfg_app_dir(void) {
+    static char *app_dir = NULL;
+    if (!app_dir) {
+        const char *s_dir = getenv("RCM_APP_DIR");
+        if (s_dir) {
+            app_dir = strdup(s_dir);
+        } else {
+            asprintf(&app_dir, "%s/app", cfg_data_dir());
+        }
+    }
+    return app_dir;
+}
+
+int cfg_http_threads(void) {
+    const char *s_threads = getenv("RCM_HTTP_THREADS");
+    return s_threads ? atoi(s_threads) : 2;
+}
+
+int cfg_http_body_limit(void) {
+    const char *s_limit = getenv("RCM_HTTP_BODY_LIMIT");
+    return s_limit ? atoi(s_limit) : 1024 * 1024;
+}
+
+double cfg_battery_interval(void) {
+    const char *s_interval = getenv("RCM_BATTERY_INTERVAL");
+    return s_interval ? atof(s_interval) : 60.0;
+}
+
+const char *cfg_serial_record(void) {
+    return getenv("RCM_SERIAL_RECORD");
+}
+
+const char *cfg_serial_replay(void) {
+    return getenv("RCM_SERIAL_REPLAY");
+}
+
+double cfg_replay_speed(void) {
+    const char *s_speed = getenv("RCM_REPLAY_SPEED");
+    return s_speed ? atof(s_speed) : 1.0;
+}
+
+int cfg_full_refresh_partials(void) {
+    const char *s_partials = getenv("RCM_FULL_REFRESH_PARTIALS");
+    return s_partials ? atoi(s_partials) : 50;
+}
+
+double cfg_full_refresh_area(void) {
+    const char *s_area = getenv("RCM_FULL_REFRESH_AREA");
+    return s_area ? atof(s_area) : 4.0;
+}
+
+double cfg_screen_idle(void) {
+    const char *s_idle = getenv("RCM_SCREEN_IDLE");
+    return s_idle ? atof(s_idle) : 300.0;
+}
+
+const char *cfg_engine_path(void) {
+    const char *s_path = getenv("RCM_ENGINE");
+    return s_path ? s_path : "/usr/games/stockfish";
+}
+
+int cfg_engine_processes(void) {
+    const char *s_processes = getenv("RCM_ENGINE_PROCESSES");
+    return s_processes ? atoi(s_processes) : 2;
+}
+
+int cfg_engine_threads(void) {
+    const char *s_threads = getenv("RCM_ENGINE_THREADS");
+    return s_threads ? atoi(s_threads) : 2;
+}
+
+int cfg_engine_hash(void) {
+    const char *s_hash = getenv("RCM_ENGINE_HASH");
+    return s_hash ? atoi(s_hash) : 192;
+}
+
+int cfg_engine_cache(void) {
+    const char *s_cache = getenv("RCM_ENGINE_CACHE");
+    return s_cache ? atoi(s_cache) : 4096;
+}
+
+int cfg_engine_reuse_depth(void) {
+    const char *s_depth = getenv("RCM_ENGINE_REUSE_DEPTH");
+    return s_depth ? atoi(s_depth) : 10;
+}
+
+const char *cfg_book(void) {
+    return getenv("RCM_BOOK");
+}
+
+double cfg_review_idle(void) {
+    const char *s_idle = getenv("RCM_REVIEW_IDLE");
+    return s_idle ? atof(s_idle) : 60.0;
+}
+
+int cfg_review_movetime(void) {
+    const char *s_movetime = getenv("RCM_REVIEW_MOVETIME");
+    return s_movetime ? atoi(s_movetime) : 1000;
+}
+
+const char *cfg_soak_pgn(void) {
+    return getenv("RCM_SOAK_PGN");
+}
+
+double cfg_soak_speed(void) {
+    const char *s_speed = getenv("RCM_SOAK_SPEED");
+    return s_speed ? atof(s_speed) : 10.0;
+}
+
+unsigned cfg_soak_seed(void) {
+    const char *s_seed = getenv("RCM_SOAK_SEED");
+    return s_seed ? strtoul(s_seed, NULL, 10) : 1;
+}
+
+int cfg_soak_plies(void) {
+    const char *s_plies = getenv("RCM_SOAK_PLIES");
+    return s_plies ? atoi(s_plies) : 200;
+}
+
+int cfg_soak_elo(void) {
+    const char *s_elo = getenv("RCM_SOAK_ELO");
+    return s_elo ? atoi(s_elo) : 1400;
+}
+
+int cfg_soak_clients(void) {
+    const char *s_clients = getenv("RCM_SOAK_CLIENTS");
+    return s_clients ? atoi(s_clients) : 2;
+}
+
+double cfg_soak_report(void) {
+    const char *s_report = getenv("RCM_SOAK_REPORT");
+    return s_report ? atof(s_report) : 60.0;
+}
+
 
 // This file is part of the Raccoon's Centaur Mods (RCM).
 //
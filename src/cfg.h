@@ -8,6 +8,72 @@
 const char *cfg_data_dir(void);
 int cfg_port(void);
 
+// Web app served over HTTP, as built into app/dist
+const char *cfg_app_dir(void);
+
+// Threads serving HTTP, however many clients there are
+int cfg_http_threads(void);
+
+// Largest request body buffered for a handler, in bytes.  Endpoints that
+// stream their bodies take any size
+int cfg_http_body_limit(void);
+
+// Seconds between samples of battery and charging status
+double cfg_battery_interval(void);
+
+// Log of serial traffic with the board to record to, or replay from.  NULL
+// for neither
+const char *cfg_serial_record(void);
+const char *cfg_serial_replay(void);
+
+// How much faster than recorded to replay, 0 for as fast as possible
+double cfg_replay_speed(void);
+
+// Partial updates of the e-paper display before a full refresh clears their
+// ghosting, whichever comes first of a count and of the area they've changed
+// in screens' worth
+int cfg_full_refresh_partials(void);
+double cfg_full_refresh_area(void);
+
+// Seconds without updates before the e-paper display goes to sleep
+double cfg_screen_idle(void);
+
+// UCI engine to play and analyse with, how many processes of it to run, and
+// the threads and hash (in MB) they have between them
+const char *cfg_engine_path(void);
+int cfg_engine_processes(void);
+int cfg_engine_threads(void);
+int cfg_engine_hash(void);
+
+// Evaluations the engine keeps in memory (the database keeps them all), and
+// how deep a search needs to have been to play its move again unsearched
+int cfg_engine_cache(void);
+int cfg_engine_reuse_depth(void);
+
+// Polyglot opening book for the computer to play from, NULL for none
+const char *cfg_book(void);
+
+// Seconds without anything happening on the board before saved games are
+// reviewed (as they are anyway on charge, unless someone's being coached),
+// and milliseconds to search each position of them
+double cfg_review_idle(void);
+int cfg_review_movetime(void);
+
+// Soak testing, see `rcm soak`.  Games for the simulated board (BOARD=sim)
+// to play, NULL for the engine's against itself only, how much faster than
+// a person it handles the pieces (0 for as fast as the board's read), the
+// seed for its fumbles, and the most plies it plays of a game
+const char *cfg_soak_pgn(void);
+double cfg_soak_speed(void);
+unsigned cfg_soak_seed(void);
+int cfg_soak_plies(void);
+
+// The computer's strength on both sides, simulated web clients, and seconds
+// between reports
+int cfg_soak_elo(void);
+int cfg_soak_clients(void);
+double cfg_soak_report(void);
+
 #endif
 
 // This file is part of the Raccoon's Centaur Mods (RCM).
@@ -5,8 +5,14 @@
 #ifndef CHESS_H
 #define CHESS_H
 
+#include "chess_archive.h"
+#include "chess_book.h"
 #include "chess_engine.h"
 #include "chess_game.h"
+#include "chess_hands.h"
+#include "chess_pgn.h"
+#include "chess_reconstruction.h"
+#include "chess_review.h"
 #include "chess_uci.h"
 
 #endif
@@ -0,0 +1,423 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "chess_archive.h"
+#include "chess_pgn.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace thc;
+
+static constexpr char        MAGIC[4]    = {'R', 'C', 'M', 'A'};
+static constexpr std::size_t HEADER_SIZE = 40;
+
+//
+// Encoding
+//
+
+uint16_t archive::encode(Move move) {
+    const unsigned promotion = move.is_promotion() ? 1 + move.special - SPECIAL_PROMOTION_QUEEN : 0;
+    return move.src | move.dst << 6 | promotion << 12;
+}
+
+bool archive::decode(const Position& position, uint16_t token, Move& move) {
+    const auto src       = static_cast<Square>(token & 0x3f);
+    const auto dst       = static_cast<Square>(token >> 6 & 0x3f);
+    const auto promotion = token >> 12;
+
+    MoveList moves;
+    const_cast<Position&>(position).GenLegalMoveList(moves, BB(src), BB(dst));
+    for (auto candidate : moves) {
+        if (archive::encode(candidate) >> 12 == promotion) {
+            move = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void put_u16(string& out, uint16_t value) {
+    out += static_cast<char>(value);
+    out += static_cast<char>(value >> 8);
+}
+
+static void put_u32(string& out, uint32_t value) {
+    put_u16(out, static_cast<uint16_t>(value));
+    put_u16(out, static_cast<uint16_t>(value >> 16));
+}
+
+static void put_u64(string& out, uint64_t value) {
+    put_u32(out, static_cast<uint32_t>(value));
+    put_u32(out, static_cast<uint32_t>(value >> 32));
+}
+
+static void put_string(string& out, string_view value) {
+    const auto length = min<size_t>(value.size(), 0xffff);
+    put_u16(out, static_cast<uint16_t>(length));
+    out.append(value.data(), length);
+}
+
+static uint64_t get_le(const unsigned char* p, int bytes) {
+    uint64_t value = 0;
+    for (auto i = 0; i < bytes; ++i) {
+        value |= uint64_t{p[i]} << 8 * i;
+    }
+    return value;
+}
+
+// Bounds checked reads from the mapped file
+struct Cursor {
+    const unsigned char* p;
+    const unsigned char* end;
+
+    const unsigned char* take(size_t n) {
+        if (static_cast<size_t>(end - p) < n) {
+            throw domain_error("Invalid archive");
+        }
+        auto begin = p;
+        p += n;
+        return begin;
+    }
+
+    uint16_t u16() { return static_cast<uint16_t>(get_le(take(2), 2)); }
+    uint32_t u32() { return static_cast<uint32_t>(get_le(take(4), 4)); }
+
+    string_view str() {
+        const auto n = u16();
+        return {reinterpret_cast<const char*>(take(n)), n};
+    }
+};
+
+//
+// Writing
+//
+
+ArchiveWriter::ArchiveWriter(const char* path) : file{fopen(path, "wb")}, offset{0} {
+    if (!file) {
+        throw runtime_error(string("Failed to create ") + path);
+    }
+
+    // Header is filled in by finish()
+    write(string(HEADER_SIZE, '\0'));
+}
+
+ArchiveWriter::~ArchiveWriter() {
+    if (file) {
+        try {
+            finish();
+        }
+        catch (const runtime_error&) {
+            // Nowhere to report it
+        }
+    }
+}
+
+void ArchiveWriter::write(const string& bytes) {
+    if (fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+        throw runtime_error("Failed to write archive");
+    }
+    offset += bytes.size();
+}
+
+// Tokens for every line from position, in the order PGN writes them
+static void write_line(
+    string&      out,
+    uint32_t&    count,
+    PositionPtr  before,
+    vector<zobrist::Key>& keys)
+{
+    while (!before->moves_played.empty()) {
+        const auto& movepair = before->moves_played.front();
+        put_u16(out, archive::encode(movepair.first));
+        keys.push_back(movepair.second->key());
+        ++count;
+
+        for (auto v = before->moves_played.begin() + 1; v != before->moves_played.end(); ++v) {
+            put_u16(out, archive::VARIATION_BEGIN);
+            put_u16(out, archive::encode(v->first));
+            keys.push_back(v->second->key());
+            count += 2;
+            write_line(out, count, v->second, keys);
+            put_u16(out, archive::VARIATION_END);
+            ++count;
+        }
+
+        before = movepair.second;
+    }
+}
+
+void ArchiveWriter::add(const Game& game) {
+    const auto start = game.start();
+
+    record.clear();
+    put_u16(record, static_cast<uint16_t>(min<size_t>(game.tags.size(), 0xffff)));
+    auto n = 0;
+    for (const auto& tag : game.tags) {
+        if (n++ == 0xffff) {
+            break;
+        }
+        put_string(record, tag.first);
+        put_string(record, tag.second);
+    }
+
+    static const auto standard = Position{}.fen();
+    const auto fen = start->fen();
+    put_string(record, fen == standard ? "" : fen);
+
+    // Count isn't known until the moves are written
+    string tokens;
+    uint32_t count = 0;
+    vector<zobrist::Key> game_keys{start->key()};
+    write_line(tokens, count, start, game_keys);
+    put_u32(record, count);
+    record += tokens;
+
+    offsets.push_back(offset);
+    write(record);
+
+    sort(game_keys.begin(), game_keys.end());
+    game_keys.erase(unique(game_keys.begin(), game_keys.end()), game_keys.end());
+    for (auto key : game_keys) {
+        keys.emplace_back(key, static_cast<uint32_t>(offsets.size() - 1));
+    }
+}
+
+void ArchiveWriter::finish() {
+    if (!file) {
+        return;
+    }
+
+    const auto table = offset;
+    string bytes;
+    for (auto game : offsets) {
+        put_u64(bytes, game);
+    }
+    write(bytes);
+
+    const auto index = offset;
+    sort(keys.begin(), keys.end());
+    bytes.clear();
+    for (const auto& key : keys) {
+        put_u64(bytes, key.first);
+        put_u32(bytes, key.second);
+    }
+    write(bytes);
+
+    string header{MAGIC, sizeof MAGIC};
+    put_u32(header, archive::VERSION);
+    put_u64(header, offsets.size());
+    put_u64(header, table);
+    put_u64(header, keys.size());
+    put_u64(header, index);
+
+    auto f = file;
+    file = nullptr;
+    const auto ok = fseek(f, 0, SEEK_SET) == 0 &&
+        fwrite(header.data(), 1, header.size(), f) == header.size();
+    if (fclose(f) != 0 || !ok) {
+        throw runtime_error("Failed to write archive");
+    }
+}
+
+//
+// Reading
+//
+
+Archive::Archive(const char* path) {
+    const auto fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw runtime_error(string("Failed to open ") + path);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw runtime_error(string("Failed to open ") + path);
+    }
+
+    length = static_cast<size_t>(st.st_size);
+    if (length < HEADER_SIZE) {
+        close(fd);
+        throw domain_error("Invalid archive");
+    }
+
+    auto map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        throw runtime_error(string("Failed to map ") + path);
+    }
+    data = static_cast<const unsigned char*>(map);
+
+    const auto ngames = get_le(data + 8,  8);
+    const auto nkeys  = get_le(data + 24, 8);
+    table = get_le(data + 16, 8);
+    index = get_le(data + 32, 8);
+
+    const auto fits = [this](uint64_t offset, uint64_t count, uint64_t size) {
+        return offset <= length && count <= (length - offset) / size;
+    };
+    if (!equal(MAGIC, MAGIC + sizeof MAGIC, data) ||
+        get_le(data + 4, 4) != archive::VERSION ||
+        !fits(table, ngames, 8) ||
+        !fits(index, nkeys, 12))
+    {
+        munmap(const_cast<unsigned char*>(data), length);
+        throw domain_error("Invalid archive");
+    }
+    games     = static_cast<size_t>(ngames);
+    key_count = static_cast<size_t>(nkeys);
+}
+
+Archive::~Archive() {
+    munmap(const_cast<unsigned char*>(data), length);
+}
+
+uint64_t Archive::game_offset(size_t i) const {
+    if (i >= games) {
+        throw out_of_range("No such game in archive");
+    }
+    const auto offset = get_le(data + table + 8 * i, 8);
+    if (offset > length) {
+        throw domain_error("Invalid archive");
+    }
+    return offset;
+}
+
+vector<pair<string_view, string_view>> Archive::tags(size_t i) const {
+    Cursor in{data + game_offset(i), data + length};
+
+    vector<pair<string_view, string_view>> tags;
+    const auto n = in.u16();
+    tags.reserve(n);
+    for (auto t = 0; t < n; ++t) {
+        const auto name = in.str();
+        tags.emplace_back(name, in.str());
+    }
+    return tags;
+}
+
+void Archive::load(size_t i, Game& game) const {
+    Cursor in{data + game_offset(i), data + length};
+
+    const auto ntags = in.u16();
+    for (auto t = 0; t < ntags; ++t) {
+        in.str();
+        in.str();
+    }
+
+    game.fen(in.str());
+
+    vector<vector<PositionPtr>> saved;
+    const auto count = in.u32();
+    for (uint32_t t = 0; t < count; ++t) {
+        const auto token = in.u16();
+        if (token == archive::VARIATION_BEGIN) {
+            if (game.history.size() < 2) {
+                throw domain_error("Invalid archive");
+            }
+            saved.push_back(game.history);
+            game.play_takeback();
+            continue;
+        }
+
+        if (token == archive::VARIATION_END) {
+            if (saved.empty()) {
+                throw domain_error("Invalid archive");
+            }
+            game.history = std::move(saved.back());
+            saved.pop_back();
+            continue;
+        }
+
+        Move move{a8, a8};
+        if (!archive::decode(*game.current(), token, move)) {
+            throw domain_error("Invalid archive");
+        }
+        game.play_move(move);
+    }
+    if (!saved.empty()) {
+        throw domain_error("Invalid archive");
+    }
+
+    // After the moves, whose first notification dates the game to today
+    game.tags.clear();
+    for (const auto& tag : tags(i)) {
+        game.tags[string(tag.first)] = string(tag.second);
+    }
+}
+
+vector<size_t> Archive::find(zobrist::Key key) const {
+    const auto entry_key = [this](size_t n) { return get_le(data + index + 12 * n, 8); };
+
+    // First entry for key
+    size_t lo = 0;
+    size_t hi = key_count;
+    while (lo < hi) {
+        const auto mid = lo + (hi - lo) / 2;
+        if (entry_key(mid) < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    vector<size_t> found;
+    for (; lo < key_count && entry_key(lo) == key; ++lo) {
+        found.push_back(get_le(data + index + 12 * lo + 8, 4));
+    }
+    return found;
+}
+
+//
+// Conversion
+//
+
+size_t pgn_to_archive(PgnReader& reader, ArchiveWriter& writer) {
+    size_t rejected = 0;
+    PgnGame pgn;
+    Game    game;
+    for (;;) {
+        try {
+            if (!reader.next(pgn)) {
+                break;
+            }
+            game.pgn(pgn);
+        }
+        catch (const domain_error&) {
+            ++rejected;
+            continue;
+        }
+        writer.add(game);
+    }
+    return rejected;
+}
+
+void archive_to_pgn(const Archive& archive, ostream& out) {
+    Game game;
+    for (size_t i = 0; i < archive.size(); ++i) {
+        archive.load(i, game);
+        out << game.pgn() << "\n\n";
+    }
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,126 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef CHESS_ARCHIVE_H
+#define CHESS_ARCHIVE_H
+
+#include "chess_game.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// A collection of games in a compact binary form that's read in place from
+// a mapped file, so browsing a large collection doesn't go through PGN and
+// SAN.  All numbers are little-endian:
+//
+//   header    "RCMA", u32 version, u64 game count, u64 offset of the game
+//             table, u64 key count, u64 offset of the key index
+//   games     u16 tag count, then each tag as u16 length + name and u16
+//             length + value; u16 length + FEN of the start position
+//             (empty for the standard start); u32 token count, then the
+//             moves as u16 tokens in PGN order (see below)
+//   table     u64 offset of each game
+//   index     u64 key and u32 game for every position in every game, by key
+//
+// A move token is src | dst << 6 | promotion << 12, where promotion is 0 or
+// 1-4 for queen, rook, bishop, knight.  Variations are bracketed by
+// VARIATION_BEGIN and VARIATION_END, as by parentheses in PGN
+namespace archive {
+
+constexpr std::uint32_t VERSION         = 1;
+constexpr std::uint16_t VARIATION_BEGIN = 0xffff;
+constexpr std::uint16_t VARIATION_END   = 0xfffe;
+
+std::uint16_t encode(thc::Move move);
+
+// The legal move in position a token stands for, false if there's none
+bool decode(const Position& position, std::uint16_t token, thc::Move& move);
+
+}
+
+class ArchiveWriter {
+public:
+    // Throws std::runtime_error if the file can't be created
+    explicit ArchiveWriter(const char* path);
+    ArchiveWriter(const ArchiveWriter&) = delete;
+    ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+    ~ArchiveWriter();
+
+    void add(const Game& game);
+
+    // Write the table and index.  Throws std::runtime_error on failure
+    void finish();
+
+    std::size_t size() const { return offsets.size(); }
+
+private:
+    std::FILE*                 file;
+    std::uint64_t              offset;
+    std::vector<std::uint64_t> offsets;
+    std::vector<std::pair<thc::zobrist::Key, std::uint32_t>> keys;
+    std::string                record;
+
+    void write(const std::string& bytes);
+};
+
+class Archive {
+public:
+    // Throws std::runtime_error if the file can't be read, std::domain_error
+    // if it isn't an archive
+    explicit Archive(const char* path);
+    Archive(const Archive&) = delete;
+    Archive& operator=(const Archive&) = delete;
+    ~Archive();
+
+    std::size_t size() const { return games; }
+
+    // Tags straight from the file, good for as long as the archive
+    std::vector<std::pair<std::string_view, std::string_view>> tags(std::size_t i) const;
+
+    // Replay game into Position nodes.  Throws std::domain_error if the
+    // game is corrupt
+    void load(std::size_t i, Game& game) const;
+
+    // Games reaching the position with this key, in any line, in order
+    std::vector<std::size_t> find(thc::zobrist::Key key) const;
+
+private:
+    const unsigned char* data{nullptr};
+    std::size_t          length{0};
+    std::size_t          games{0};
+    std::uint64_t        table{0};
+    std::size_t          key_count{0};
+    std::uint64_t        index{0};
+
+    std::uint64_t game_offset(std::size_t i) const;
+};
+
+// Add every valid game from reader to writer, returning how many weren't
+std::size_t pgn_to_archive(PgnReader& reader, ArchiveWriter& writer);
+
+// Write every game as PGN, separated by blank lines
+void archive_to_pgn(const Archive& archive, std::ostream& out);
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,93 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef CHESS_BOOK_H
+#define CHESS_BOOK_H
+
+#include "chess_position.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+// Opening books in Polyglot's format, read in place from a mapped file.  All
+// numbers are big-endian, and the entries sorted by key:
+//
+//   entry     u64 key, u16 move, u16 weight, u32 learn
+//
+// A move is to-file | to-row << 3 | from-file << 6 | from-row << 9 |
+// promotion << 12, rows from White's side, promotion 0 or 1-4 for knight,
+// bishop, rook, queen.  Castling is the king taking its own rook
+namespace polyglot {
+
+// Polyglot's keys are its own, not thc::zobrist's: 768 for pieces, by
+// piece (black pawn, white pawn, black knight, ... white king), row and
+// file; 4 for castling, White's kingside first; 8 for an en passant file;
+// and 1 for White to move
+constexpr std::size_t RANDOM_SIZE = 781;
+using Random = std::array<std::uint64_t, RANDOM_SIZE>;
+
+// Polyglot's own table, which books are made with
+extern const Random RANDOM64;
+
+// Position's key in a book made with the table
+std::uint64_t key(const Random& random, const thc::ChessPosition& position);
+
+}
+
+class Book {
+public:
+    struct Entry {
+        thc::Move     move;
+        std::uint16_t weight;
+    };
+
+    // Throws std::runtime_error if the file can't be read, std::domain_error
+    // if it isn't a book
+    Book(const char* path, const polyglot::Random& random = polyglot::RANDOM64);
+    Book(const Book&) = delete;
+    Book& operator=(const Book&) = delete;
+    ~Book();
+
+    std::size_t size() const { return entries; }
+
+    // The book's legal moves in position, as weighted
+    std::vector<Entry> find(const Position& position) const;
+
+    // One of the book's moves, more likely the more it's weighted, chance
+    // in [0, 1) picking which.  The stronger the player (0 for full
+    // strength), the more weight counts, so the weak wander off the main
+    // lines.  None out of book, or if they're all weighted 0
+    std::optional<thc::Move> move(const Position& position, int elo, double chance) const;
+
+    // Ditto, by chance
+    std::optional<thc::Move> move(const Position& position, int elo);
+
+private:
+    const unsigned char* data{nullptr};
+    std::size_t          length{0};
+    std::size_t          entries{0};
+    polyglot::Random     random;
+    std::mt19937_64      chance;
+};
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -4,26 +4,273 @@
 #include "chess_engine.h"
 #include "chess.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 using namespace std;
 using namespace thc;
 
-Engine::Engine(string_view name) {
-    char *argv[] = {(char*)"stockfish", NULL};
-    uci = UCIEngine::execvp("/usr/games/stockfish", argv);
+Engine::Engine(const char* path, Budget budget, EvalStore* store)
+    : store{store},
+      cache{max(1u, budget.cache)},
+      budget{budget}
+{
+    // Not more processes than cores, nor than threads to go round
+    const auto cores     = max(1u, std::thread::hardware_concurrency());
+    resources.cores      = cores;
+    const auto processes = clamp(budget.processes, 1u, max(1u, min(cores, budget.threads)));
+    const auto threads   = max(1u, budget.threads / processes);
+    const auto hash      = max(16u, budget.hash / processes);
+
+    ready = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (ready < 0) {
+        throw runtime_error("Engine: eventfd() failed");
+    }
+
+    char *argv[] = {const_cast<char*>(path), NULL};
+    while (pool.size() < processes) {
+        auto uci = UCIEngine::execvp(path, argv, threads, hash, ready);
+        if (!uci) {
+            break;
+        }
+        pool.push_back(std::move(uci));
+    }
+    if (pool.empty()) {
+        close(ready);
+        throw runtime_error("Engine: can't start any engine");
+    }
+}
+
+Engine::~Engine() {
+    // Their threads write to ready until they're gone
+    pool.clear();
+    close(ready);
+}
+
+void Engine::wake() {
+    const uint64_t one = 1;
+    if (write(ready, &one, sizeof one) != sizeof one) {
+        perror("write");
+    }
+}
+
+// UCI_Elo of Stockfish at its weakest, and what full strength counts as
+static constexpr int ELO_MIN  = 1320;
+static constexpr int ELO_FULL = 3190;
+
+// Battery levels, of 20, below which thinking is cut further
+static constexpr int BATTERY_LOW = 4;
+
+UCIAllowance Engine::allow(const Budget& budget, size_t processes, const Resources& resources, int elo) {
+    processes = max<size_t>(1, processes);
+
+    UCIAllowance allowance;
+
+    // A core for the screen, the board and the web, when there's more than
+    // one
+    const auto cores = max(1u, resources.cores > 1 ? resources.cores - 1 : 1);
+    allowance.threads = max<unsigned>(1, min<unsigned>(budget.threads / processes, cores / processes));
+
+    // Powers of two, so small changes in what's free don't resize it (and
+    // clear it) every move
+    auto hash = max<unsigned>(16, budget.hash / processes);
+    if (resources.memory) {
+        hash = min<unsigned>(hash, max<unsigned>(16, resources.memory / 4 / processes));
+    }
+    allowance.hash = 16;
+    while (allowance.hash * 2 <= hash) {
+        allowance.hash *= 2;
+    }
+
+    // A quarter second at the weakest, doubling every 300 points, to 8 s
+    // for full strength
+    const auto strength = elo > 0 ? clamp(elo, ELO_MIN, ELO_FULL) : ELO_FULL;
+    allowance.movetime = min(8000u, static_cast<unsigned>(250 * exp2((strength - ELO_MIN) / 300.0)));
+
+    const auto on_battery = resources.charging == 0;
+    if (on_battery) {
+        allowance.threads   = 1;
+        allowance.movetime /= 2;
+    }
+    if (on_battery && resources.battery >= 0 && resources.battery < BATTERY_LOW) {
+        allowance.movetime /= 2;
+    }
+    allowance.movetime = max(100u, allowance.movetime);
+    return allowance;
+}
+
+UCIEngine& Engine::process(Priority priority) {
+    return *pool[min<size_t>(priority, pool.size() - 1)];
+}
+
+bool Engine::blocked(Priority priority) {
+    for (auto before = 0; before < priority; ++before) {
+        const auto urgent = static_cast<Priority>(before);
+        if (pending[urgent] && &process(urgent) == &process(priority)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Engine::send(Priority priority, unique_ptr<UCIMessage> request) {
+    if (blocked(priority)) {
+        // Any request would stop the engine, so it waits its turn
+        deferred[priority] = std::move(request);
+        return;
+    }
+    if (priority < ANALYSIS) {
+        ++pending[priority];
+        answered[priority] = false;
+    }
+    process(priority).send(std::move(request));
+}
+
+void Engine::collect() {
+    // Reset before collecting, so whatever comes in meanwhile wakes the
+    // caller again
+    uint64_t count;
+    (void)read(ready, &count, sizeof count);
+
+    for (auto& uci : pool) {
+        for (auto response = uci->receive(); response; response = uci->receive()) {
+            // Found whatever was asked, and only the latest asked for counts,
+            // any before were pre-empted
+            if (auto play = dynamic_cast<UCIPlayMessage*>(response.get())) {
+                const auto hint     = dynamic_cast<UCIHintMessage*>(play) != nullptr;
+                const auto priority = hint ? HINT : PLAY;
+                if (play->move && (hint || play->elo == 0)) {
+                    // Weakened, the move's meant to vary, and needn't be
+                    // the line's, so it's never kept
+                    remember(play->key, 0, archive::encode(*play->move), play->info);
+                }
+                if (pending[priority] && --pending[priority] == 0 && !answered[priority]) {
+                    answered[priority] = true;
+                    (hint ? hinted : played) = play->move;
+                }
+            }
+            else if (auto analyse = dynamic_cast<UCIAnalyseMessage*>(response.get())) {
+                const auto& best = analyse->found.line[0];
+                if (analyse->found.lines && best.pv_length) {
+                    remember(analyse->key, 0, best.pv[0], best);
+                }
+            }
+        }
+    }
+
+    for (auto priority : {HINT, ANALYSIS}) {
+        if (deferred[priority] && !blocked(priority)) {
+            send(priority, std::move(deferred[priority]));
+        }
+    }
+}
+
+// Strengths of a position share its key, mixed up to not collide
+uint64_t Engine::slot(zobrist::Key key, int strength) {
+    return key ^ static_cast<uint64_t>(strength) * 0x9e3779b97f4a7c15;
+}
+
+// A move searched deep enough before, from memory or the store
+optional<Move> Engine::cached(const Game& game, int strength) {
+    const auto key = game.current()->key();
+    auto found = cache.find(slot(key, strength));
+    if (!found || found->key != key || found->strength != strength) {
+        Evaluation stored;
+        if (!store || !store->recall(key, strength, stored)) {
+            return nullopt;
+        }
+        found = &cache.put(slot(key, strength), stored);
+    }
+    if (found->info.depth < reuse_depth) {
+        return nullopt;
+    }
+
+    char text[6];
+    uci_text(found->move, text);
+    try {
+        return game.uci_move(text);
+    }
+    catch (const logic_error&) {
+        // Another position, with the same key
+        return nullopt;
+    }
+}
+
+// What a search found, kept unless what's cached went deeper
+void Engine::remember(zobrist::Key key, int strength, uint16_t move, const UCIInfo& info) {
+    const auto found = cache.find(slot(key, strength));
+    if (found && found->key == key && found->strength == strength && found->info.depth > info.depth) {
+        return;
+    }
+
+    const Evaluation evaluation{key, strength, move, info};
+    cache.put(slot(key, strength), evaluation);
+    if (store) {
+        store->remember(evaluation);
+    }
 }
 
 void Engine::play(const Game& game, int elo) {
-    uci->send(make_unique<UCIPlayMessage>(&game, elo));
+    played = book ? book->move(*game.current(), elo) : nullopt;
+    if (!played && elo == 0) {
+        played = cached(game, 0);
+    }
+    if (played) {
+        answered[PLAY] = true;
+        wake();
+        return;
+    }
+    auto request = make_unique<UCIPlayMessage>(game, elo);
+    request->allowance = allow(budget, pool.size(), resources, elo);
+    send(PLAY, std::move(request));
 }
 
 optional<Move> Engine::move() {
-    auto response = uci->receive();
-    if (auto play = dynamic_cast<UCIPlayMessage*>(response.get())) {
-        return play->move;
+    collect();
+    return std::exchange(played, nullopt);
+}
+
+void Engine::hint(const Game& game) {
+    hinted = cached(game, 0);
+    if (hinted) {
+        answered[HINT] = true;
+        wake();
+        return;
     }
-    return nullopt;
+    auto request = make_unique<UCIHintMessage>(game, 0);
+    request->allowance = allow(budget, pool.size(), resources, 0);
+    send(HINT, std::move(request));
+}
+
+optional<Move> Engine::hint_move() {
+    collect();
+    return std::exchange(hinted, nullopt);
+}
+
+void Engine::analyse(const Game& game, unsigned multipv, unsigned movetime) {
+    auto request = make_unique<UCIAnalyseMessage>(game, multipv, movetime);
+    request->allowance = allow(budget, pool.size(), resources, 0);
+    if (resources.charging != 0) {
+        // On charge, it may go on for as long as it's asked
+        request->allowance.movetime = 0;
+    }
+    send(ANALYSIS, std::move(request));
+}
+
+const UCIAnalysis* Engine::analysis() {
+    // And whatever's waited on the computer's move, now it's done
+    collect();
+
+    auto& uci = process(ANALYSIS);
+    return uci.analysis.take() ? &uci.analysis.front() : nullptr;
 }
 
 // This file is part of the Raccoon's Centaur Mods (RCM).
@@ -6,30 +6,156 @@
 #define CHESS_ENGINE_H
 
 #include "../thc/thc.h"
+#include "../utility/lru.h"
+#include "chess_book.h"
+#include "chess_uci.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
-#include <string_view>
+#include <vector>
 
 class Game;
-class UCIEngine;
 
-// Higher-level interface to UCI engines
+// What a search found best in a position, at a strength
+struct Evaluation {
+    thc::zobrist::Key key{0};
+    int               strength{0};  // UCI_Elo, 0 for full strength
+    std::uint16_t     move{0};      // As archive::encode() has it
+    UCIInfo           info;         // Of the line it heads
+};
+
+// Where evaluations are kept from one run to the next
+class EvalStore {
+public:
+    virtual ~EvalStore() = default;
+
+    // The evaluation of the position at the strength, false if there's none
+    virtual bool recall(thc::zobrist::Key key, int strength, Evaluation& evaluation) = 0;
+
+    // Keep it, unless there's one searched deeper
+    virtual void remember(const Evaluation& evaluation) = 0;
+};
+
+// What the machine has to give searches, as last seen
+struct Resources {
+    unsigned cores{1};
+    unsigned memory{0};     // MB available, 0 if unknown
+    int      charging{-1};  // As Board::charging(), -1 if unknown
+    int      battery{-1};   // As Board::batterylevel(), 20 for full, ditto
+};
+
+// A pool of engine processes, each with a part to play.  The computer plays
+// from any opening book before anything is searched.  What they find at
+// full strength is cached, by position, and a move searched deep enough
+// before is played, or hinted, again without searching.  Weakened, the
+// computer searches every time, so it doesn't play the same game over.  The
+// computer's moves have one process to themselves, so its hash stays warm
+// for the game and nothing else holds it up.  Hints and coaching analysis
+// share what's left, a hint pre-empting any analysis.  With only the one
+// process, everything else waits for the computer to move
 class Engine {
-    std::unique_ptr<UCIEngine> uci;
+public:
+    // What the processes get between them, spread evenly.  Hash in MB,
+    // and evaluations cached in memory (more in any store) as cache
+    struct Budget {
+        unsigned processes{2};
+        unsigned threads{2};
+        unsigned hash{192};
+        unsigned cache{4096};
+    };
+
+    // Moves cached from searches at least this deep are played again
+    unsigned reuse_depth{10};
+
+    // Where the computer's moves come from while it's in book, if anywhere
+    std::unique_ptr<Book> book;
+
+    // What one of processes may spend on a search at elo (0 for full
+    // strength), within the budget and what the machine has.  A core is
+    // left for everything else, hash to a power of two that fits in a
+    // quarter of available memory, and time grows with elo, to seconds
+    // for full strength.  Off charge, and more so on a low battery, less
+    // of each
+    static UCIAllowance allow(const Budget& budget, std::size_t processes, const Resources& resources, int elo);
+
+private:
+    enum Priority { PLAY, HINT, ANALYSIS, PRIORITIES };
+
+    std::vector<std::unique_ptr<UCIEngine>> pool;
+
+    // Asked for, not yet answered, so not to be pre-empted by anything less
+    // urgent on the same process.  Answered from the cache, whatever the
+    // engine says to any asked before is too late
+    unsigned pending[ANALYSIS]{};
+    bool     answered[ANALYSIS]{};
+
+    // Waiting on something more urgent, the latest of each
+    std::unique_ptr<UCIMessage> deferred[PRIORITIES];
+
+    std::optional<thc::Move> played;
+    std::optional<thc::Move> hinted;
+
+    EvalStore* store;
+    LRU<std::uint64_t, Evaluation> cache;  // By slot()
+
+    int ready{-1};  // eventfd, see wakeup_fd()
+    void wake();
+
+    Budget    budget;
+    Resources resources;
+
+    UCIEngine& process(Priority priority);
+    bool       blocked(Priority priority);
+    void       send(Priority priority, std::unique_ptr<UCIMessage> request);
+    void       collect();
+
+    static std::uint64_t slot(thc::zobrist::Key key, int strength);
+    std::optional<thc::Move> cached(const Game& game, int strength);
+    void remember(thc::zobrist::Key key, int strength, std::uint16_t move, const UCIInfo& info);
 
 public:
-    Engine(std::string_view name);
+    // Start engines from the executable at path, as many as the budget and
+    // the machine's cores allow, keeping what they find in any store
+    Engine(const char* path, Budget budget, EvalStore* store = nullptr);
+    ~Engine();
 
     // Prevent accidental copying
     Engine(const Engine&) = delete;
     Engine& operator=(const Engine&) = delete;
 
+    // Processes running
+    std::size_t size() const { return pool.size(); }
+
+    // For callers who wait for themselves: readable once there may be a
+    // move, hint or analysis to take, until they've asked for it
+    int wakeup_fd() const { return ready; }
+
+    // What searches may spend from now on, as the machine has changed, see
+    // allow()
+    void govern(const Resources& resources) { this->resources = resources; }
+
     // Request engine to select a move
     void play(const Game& game, int elo);
 
     // Ask if engine has a move ready
     std::optional<thc::Move> move();
+
+    // The best move in the game's position at full strength, for a human
+    void hint(const Game& game);
+
+    // Ask if there's a hint ready
+    std::optional<thc::Move> hint_move();
+
+    // Have the engine analyse the game's position, its multipv best lines,
+    // for movetime milliseconds, or 0 for as long as it's asked for nothing
+    // else (but off charge, no longer than a hint would think).  Hints and
+    // later analyses pre-empt it
+    void analyse(const Game& game, unsigned multipv, unsigned movetime = 0);
+
+    // The latest of any analysis, if there's been more since last asked
+    const UCIAnalysis* analysis();
 };
 
 #endif
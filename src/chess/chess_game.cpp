@@ -2,7 +2,10 @@
 // See license at end of file
 
 #include "chess_game.h"
+#include "chess_archive.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdio>
 #include <cstdlib>
@@ -10,16 +13,31 @@
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <utility>
 
 using namespace std;
 using namespace thc;
 
+// Shared by every game, so no two states of any games have the same
+static atomic<uint64_t> generations{0};
+
+void Game::touch() {
+    stamp = ++generations;
+}
+
 // Reset game to initial state
 void Game::clear() {
     history.clear();
+    pool      = make_shared<Pool>();
+    positions = decltype(positions){PoolAllocator<Position>{pool}};
+    parents   = decltype(parents){PoolAllocator<Position>{pool}};
+    revision = make_shared<uint64_t>(0);
+    movetext_end.reset();
     started  = 0;
     rowid    = 0;
     settings = "";
+    log.clear();
+    log_valid = false;
 
     tags.clear();
     tags["Event"]  = "?";
@@ -29,12 +47,16 @@ void Game::clear() {
     tags["White"]  = "?";
     tags["Black"]  = "?";
     tags["Result"] = "*";
+    touch();
+    ident = stamp;
 }
 
 // Set start position from FEN string
 void Game::fen(string_view fen) {
     clear();
-    history.push_back(make_shared<Position>(fen));
+    history.push_back(make_position(fen, pool));
+    index_position(start(), nullptr);
+    touch();
 }
 
 // Because we support takebacks and multiple variations, the position on the
@@ -46,7 +68,7 @@ bool Game::recover_history(PositionPtr target) {
         return true;
     }
 
-    for (auto movepair : current()->moves_played) {
+    for (const auto& movepair : current()->moves_played) {
         history.push_back(movepair.second);
         if (recover_history(target)) {
             return true;
@@ -58,14 +80,67 @@ bool Game::recover_history(PositionPtr target) {
 }
 
 void Game::recover_position(string_view fen) {
-    auto start = this->start();
+    auto start  = this->start();
+    auto target = make_shared<Position>(fen);
+
+    // Usually the index knows the position, and the way back to the start
+    history.clear();
+    for (auto position = find_position(*target, false); position; ) {
+        history.push_back(position);
+        auto parent = parents.find(position.get());
+        position = parent != parents.end() ? parent->second : nullptr;
+    }
+    reverse(history.begin(), history.end());
+    if (!history.empty() && history.front() == start) {
+        return;
+    }
+
     history.clear();
     history.push_back(start);
-    if (!recover_history(make_shared<Position>(fen))) {
+    if (!recover_history(target)) {
         throw domain_error("Invalid position");
     }
 }
 
+void Game::index_position(PositionPtr position, PositionPtr parent) {
+    positions.insert({position->key(), position});
+    if (parent) {
+        parents.insert({position.get(), parent});
+    }
+}
+
+// Forget a position no longer reached from parent, along with anything only
+// reached through it
+void Game::forget_position(PositionPtr position, PositionPtr parent) {
+    auto found = parents.find(position.get());
+    if (found == parents.end() || found->second != parent) {
+        return;
+    }
+    parents.erase(found);
+
+    auto range = positions.equal_range(position->key());
+    for (auto p = range.first; p != range.second; ++p) {
+        if (p->second == position) {
+            positions.erase(p);
+            break;
+        }
+    }
+
+    for (const auto& movepair : position->moves_played) {
+        forget_position(movepair.second, position);
+    }
+}
+
+PositionPtr Game::find_position(const Position& position, bool transposition) const {
+    auto range = positions.equal_range(position.key());
+    for (auto p = range.first; p != range.second; ++p) {
+        if (transposition ? transposes(*p->second, position) : *p->second == position) {
+            return p->second;
+        }
+    }
+    return nullptr;
+}
+
 Game::Game(string_view pgn, string_view fen) {
     clear();
     this->observe(this);
@@ -81,6 +156,40 @@ Game::Game(string_view pgn, string_view fen) {
     }
 }
 
+unique_ptr<Game> Game::sandbox() const {
+    auto copy = make_unique<Game>();
+    copy->clear();
+    copy->tags    = tags;
+    copy->started = started;
+
+    PositionPtr before;
+    PositionPtr copy_before;
+    for (const auto& position : history) {
+        auto node = allocate_shared<Position>(
+            PoolAllocator<Position>{copy->pool},
+            static_cast<const ChessRules&>(*position),
+            copy->pool);
+
+        if (before) {
+            const auto& movepairs = before->moves_played;
+            const auto movepair = find_if(
+                movepairs.begin(),
+                movepairs.end(),
+                [&position](const MovePair& pair) { return pair.second == position; });
+            assert(movepair != movepairs.end());
+            copy_before->moves_played.push_back(
+                {movepair->first, node, movepair->san, movepair->uci});
+        }
+
+        copy->history.push_back(node);
+        copy->index_position(node, copy_before);
+        before      = position;
+        copy_before = node;
+    }
+
+    return copy;
+}
+
 void Game::on_changed(Game&) {
     if (started > 0) {
         return;
@@ -92,8 +201,17 @@ void Game::on_changed(Game&) {
     tags["Date"] = date.str();
 }
 
-string& Game::tag(const string& key) {
-    return tags[key];
+string Game::tag(const string& key) const {
+    const auto tag = tags.find(key);
+    return tag != tags.end() ? tag->second : string{};
+}
+
+void Game::tag(const string& key, string value) {
+    const auto [tag, added] = tags.try_emplace(key);
+    if (added || tag->second != value) {
+        tag->second = std::move(value);
+        touch();
+    }
 }
 
 PositionPtr Game::current() const {
@@ -116,6 +234,30 @@ string Game::fen() const {
     return current()->fen();
 }
 
+string Game::uci_position() const {
+    static const auto STARTPOS = Position{}.fen();
+
+    string position;
+    if (const auto fen = start()->fen(); fen != STARTPOS) {
+        position = "fen " + fen;
+    } else {
+        position = "startpos";
+    }
+    if (history.size() > 1) {
+        position += " moves";
+    }
+    for (size_t i = 1; i < history.size(); ++i) {
+        for (const auto& movepair : history[i - 1]->moves_played) {
+            if (movepair.second == history[i]) {
+                position += ' ';
+                position += movepair.uci;
+                break;
+            }
+        }
+    }
+    return position;
+}
+
 MoveList Game::legal_moves() const {
     return current()->legal_moves();
 }
@@ -129,7 +271,37 @@ Move Game::uci_move(string_view uci_move) const {
 }
 
 void Game::play_move(Move move) {
-    history.push_back(current()->play_move(move));
+    const auto before = current();
+    auto after = before->move_played(move);
+    if (!after) {
+        // Only a new position at the end of the main line leaves the rest
+        // of the movetext as it was (a shared one may be written elsewhere)
+        const auto extends = movetext_valid() && before == movetext_end &&
+            before->moves_played.empty();
+
+        after = before->play_move(move);
+        auto transposed = find_position(*after, true);
+        if (transposed) {
+            before->share_move_played(move, transposed);
+            after = transposed;
+        }
+        else {
+            index_position(after, before);
+        }
+        ++*revision;
+
+        if (extends && !transposed) {
+            ostringstream out;
+            write_move(out, before, before->moves_played.front(), movetext_show_number);
+            movetext += out.str();
+            movetext_end         = after;
+            movetext_show_number = false;
+            movetext_revision    = *revision;
+        }
+    }
+    history.push_back(after);
+    append_log(archive::encode(move));
+    touch();
     changed();
 }
 
@@ -147,6 +319,8 @@ void Game::play_uci_move(string_view uci_move) {
 void Game::play_takeback() {
     if (history.size() > 1) {
         history.pop_back();
+        append_log(0);
+        touch();
         changed();
     }
 }
@@ -164,10 +338,48 @@ void Game::play_takeback(Move takeback) {
 // legitimately be taken as a rook move until the player moves the king.
 void Game::revise_move(Move takeback, Move move) {
     play_takeback(takeback);
-    current()->remove_move_played(takeback);
+    if (auto removed = current()->move_played(takeback)) {
+        current()->remove_move_played(takeback);
+        forget_position(removed, current());
+        ++*revision;
+        append_log(-archive::encode(takeback));
+    }
     play_move(move);
 }
 
+void Game::append_log(int32_t move) {
+    if (log_valid) {
+        log.push_back({move, time(NULL)});
+    }
+}
+
+bool Game::replay(const vector<LogEntry>& entries) {
+    for (const auto& entry : entries) {
+        const auto code = static_cast<uint16_t>(entry.move < 0 ? -entry.move : entry.move);
+
+        Move move{a8, a8};
+        if (entry.move == 0) {
+            if (history.size() < 2) {
+                return false;
+            }
+            play_takeback();
+        }
+        else if (!archive::decode(*current(), code, move)) {
+            return false;
+        }
+        else if (entry.move > 0) {
+            play_move(move);
+        }
+        else if (auto removed = current()->move_played(move)) {
+            current()->remove_move_played(move);
+            forget_position(removed, current());
+            ++*revision;
+            append_log(entry.move);
+        }
+    }
+    return true;
+}
+
 // Here we try to interpret the move at a higher-level than the position,
 // taking into account the context of the game.  So yes, the boardstate
 // might represent a move or a move in-progress, but it could also be the
@@ -188,23 +400,33 @@ bool Game::read_move(
 
     // Can boardstate be reached by a legal move?
     auto maybe_valid = current()->read_move(boardstate, actions, candidates);
+    if (!candidates.empty()) {
+        return true;
+    }
+
+    // Back exactly as it was before the last move is taking it back, even
+    // if some move might still be on its way there (a piece of the other
+    // side's to the square a capture's taken back from, say)
+    if (auto before = this->previous(); before && before->bitmap() == boardstate) {
+        takeback = before->find_move_played(current());
+        return true;
+    }
     if (maybe_valid) {
         return true;
     }
 
     // Is this the completion of a castling move?
     if (auto before = this->previous()) {
-        for (auto castle : before->castle_moves()) {
-            Position after{*before};
-            after.PushMove(castle);
-            if (!after.is_legal()) {
-                // castle_moves() doesn't check legality, so do it here
+        const auto diff = boardstate ^ before->bitmap();
+        for (const auto& indexed : before->move_index()) {
+            const auto castle = indexed.move;
+            if (castle.special < SPECIAL_WK_CASTLING || castle.special > SPECIAL_BQ_CASTLING) {
                 continue;
             }
 
-            if (after.bitmap() != boardstate) {
+            if (indexed.delta != diff) {
                 // Castling may still be in-progress
-                maybe_valid = maybe_valid || before->incomplete(boardstate, after);
+                maybe_valid = maybe_valid || (diff & ~indexed.changed) == 0;
                 continue;
             }
 
@@ -255,10 +477,10 @@ void Game::write_tags(ostream& out) const {
 }
 
 void Game::write_move(
-    ostream&    out,
-    PositionPtr before,
-    Move        move,
-    bool        show_move_number) const
+    ostream&        out,
+    PositionPtr     before,
+    const MovePair& movepair,
+    bool            show_move_number) const
 {
     if (!show_move_number && before->WhiteToPlay()) {
         out << " ";
@@ -271,7 +493,7 @@ void Game::write_move(
     } else {
         out << " ";
     }
-    out << const_cast<Position*>(before.get())->move_san(move);
+    out << movepair.san;
 }
 
 void Game::write_moves(ostream& out, PositionPtr before, bool is_first_move) const {
@@ -282,15 +504,15 @@ void Game::write_moves(ostream& out, PositionPtr before, bool is_first_move) con
             break;
         }
 
-        auto movepair = *begin;
-        write_move(out, before, movepair.first, show_move_number);
+        const auto& movepair = *begin;
+        write_move(out, before, movepair, show_move_number);
         show_move_number = false;
 
         ++begin;
         for (; begin != before->moves_played.cend(); ++begin) {
             out << " (";
-            auto variation = *begin;
-            write_move(out, before, variation.first, true);
+            const auto& variation = *begin;
+            write_move(out, before, variation, true);
             write_moves(out, variation.second, false);
             out << ") ";
             show_move_number = true;
@@ -301,7 +523,31 @@ void Game::write_moves(ostream& out, PositionPtr before, bool is_first_move) con
 }
 
 void Game::write_movetext(ostream& out) const {
+    if (!movetext_valid()) {
+        update_movetext();
+    }
+    out << movetext;
+}
+
+bool Game::movetext_valid() const {
+    return movetext_end && movetext_revision == *revision;
+}
+
+void Game::update_movetext() const {
+    ostringstream out;
     write_moves(out, start(), true);
+    movetext = out.str();
+
+    // Where the next move on the main line goes, and whether it needs its
+    // number (first move, or after a variation)
+    PositionPtr before;
+    movetext_end = start();
+    while (!movetext_end->moves_played.empty()) {
+        before       = movetext_end;
+        movetext_end = movetext_end->moves_played.front().second;
+    }
+    movetext_show_number = !before || before->moves_played.size() > 1;
+    movetext_revision    = *revision;
 }
 
 void Game::write_pgn(ostream& out) const {
@@ -319,130 +565,128 @@ string Game::pgn() const {
 // Read PGN
 //
 
-static void skip_whitespace(char*& pgn) {
-    while (isspace(*pgn)) {
-        ++pgn;
+static void skip_whitespace(string_view& pgn) {
+    while (!pgn.empty() && isspace(static_cast<unsigned char>(pgn.front()))) {
+        pgn.remove_prefix(1);
     }
 }
 
-static char* read_string(char*& pgn) {
-    skip_whitespace(pgn);
-    if (*pgn != '"') {
-        return nullptr;
-    }
-    ++pgn;
-
-    auto begin = pgn;
-    auto end   = begin;
-    while (*pgn && *pgn != '"') {
-        if (*pgn == '\\') {
-            ++pgn;
-        }
-        *end++ = *pgn++;
-    }
-
-    if (*pgn != '"') {
-        return nullptr;
-    }
-
-    *end = '\0';
-    ++pgn;
-    return begin;
+static bool at_delimiter(string_view pgn) {
+    return pgn.empty() || isspace(static_cast<unsigned char>(pgn.front())) || strchr("(){};", pgn.front());
 }
 
-static char* read_symbol(char*& pgn) {
+static string_view read_symbol(string_view& pgn) {
     skip_whitespace(pgn);
-    if (!isalpha(*pgn)) {
-        return nullptr;
+    if (pgn.empty() || !isalpha(static_cast<unsigned char>(pgn.front()))) {
+        return {};
     }
 
-    auto begin = pgn;
-    while (*pgn && (isalnum(*pgn) || strchr("_+#=:-", *pgn))) {
-        ++pgn;
+    size_t n = 0;
+    while (n < pgn.size() &&
+           (isalnum(static_cast<unsigned char>(pgn[n])) || strchr("_+#=:-", pgn[n])))
+    {
+        ++n;
     }
 
-    return begin;
+    auto symbol = pgn.substr(0, n);
+    pgn.remove_prefix(n);
+    return symbol;
 }
 
-static char* read_tag(char** value, char*& pgn) {
+static int read_move_number(string_view& pgn) {
     skip_whitespace(pgn);
-    if (*pgn != '[') {
-        return nullptr;
-    }
-    ++pgn;
 
-    auto name = read_symbol(pgn);
-    if (!name) {
-        return nullptr;
-    }
-
-    *value = read_string(pgn);
-    if (!*value) {
-        return nullptr;
+    auto n = 0;
+    while (!pgn.empty() && isdigit(static_cast<unsigned char>(pgn.front()))) {
+        n = n * 10 + (pgn.front() - '0');
+        pgn.remove_prefix(1);
     }
 
     skip_whitespace(pgn);
-    if (*pgn != ']') {
-        return nullptr;
+    while (!pgn.empty() && pgn.front() == '.') {
+        pgn.remove_prefix(1);
     }
-    ++pgn;
 
-    return name;
+    return n;
 }
 
-void Game::read_tags(char*& pgn) {
-    tags.clear();
-
-    char* value = nullptr;
-    char* name  = read_tag(&value, pgn);
-    while (name) {
-        tags[name] = value;
-        value = nullptr;
-        name  = read_tag(&value, pgn);
+// Comments, annotations and results don't change the game
+static bool skip_commentary(string_view& pgn) {
+    auto skip_to = [&pgn](char c) {
+        const auto end = pgn.find(c);
+        pgn.remove_prefix(end == string_view::npos ? pgn.size() : end + 1);
+        return end != string_view::npos || c == '\n';
+    };
+
+    switch (pgn.front()) {
+    case '{':
+        return skip_to('}');
+    case ';':
+        return skip_to('\n');
+    case '$':
+    case '!':
+    case '?':
+        do {
+            pgn.remove_prefix(1);
+        } while (!at_delimiter(pgn));
+        return true;
     }
-}
-
-static int read_move_number(char*& pgn) {
-    skip_whitespace(pgn);
 
-    auto n = 0;
-    while (isdigit(*pgn)) {
-        n = n * 10 + (*pgn++ - '0');
+    for (auto result : {"1-0", "0-1", "1/2-1/2", "*"}) {
+        const auto n = strlen(result);
+        if (pgn.substr(0, n) == result && at_delimiter(pgn.substr(n))) {
+            pgn.remove_prefix(n);
+            return true;
+        }
     }
+    return false;
+}
 
-    skip_whitespace(pgn);
-    while (*pgn == '.') {
-        ++pgn;
+void Game::read_tags(const PgnGame& game) {
+    tags.clear();
+    for (const auto& tag : game.tags) {
+        tags[string(tag.first)] = pgn_unescape(tag.second);
     }
-
-    return n;
 }
 
-bool Game::read_movetext(char*& pgn) {
-    while (*pgn) {
-        skip_whitespace(pgn);
-        if (*pgn == ')') {
+bool Game::read_movetext(string_view& pgn) {
+    while (skip_whitespace(pgn), !pgn.empty()) {
+        if (pgn.front() == ')') {
             return true;
         }
 
-        if (*pgn == '(') {
+        if (pgn.front() == '(') {
             auto save_history = history;
             play_takeback();
-            ++pgn;
+            pgn.remove_prefix(1);
             if (!read_movetext(pgn)) {
                 return false;
             }
-            if (*pgn != ')') {
+            if (pgn.empty() || pgn.front() != ')') {
                 return false;
             }
-            ++pgn;
+            pgn.remove_prefix(1);
             history = save_history;
             continue;
         }
 
+        // Commentary that wasn't skipped but was read from is unterminated
+        const auto before = pgn.size();
+        if (skip_commentary(pgn)) {
+            continue;
+        }
+        if (pgn.size() != before) {
+            return false;
+        }
+
         (void)read_move_number(pgn);
+        skip_whitespace(pgn);
+        if (!pgn.empty() && skip_commentary(pgn)) {
+            continue;
+        }
+
         auto san = read_symbol(pgn);
-        if (!san) {
+        if (san.empty()) {
             return false;
         }
 
@@ -456,18 +700,249 @@ bool Game::read_movetext(char*& pgn) {
     return true;
 }
 
-void Game::pgn(string_view pgn) {
+void Game::pgn(const PgnGame& game) {
     clear();
-    history.push_back(make_shared<Position>());
-
-    auto copy = strdup(pgn.data());
-    auto working = copy;
-    read_tags(working);
-    auto ok = read_movetext(working);
-    free(copy);
-    if (!ok) {
+    history.push_back(make_position({}, pool));
+    index_position(start(), nullptr);
+
+    auto movetext = game.movetext;
+    if (!read_movetext(movetext) || !movetext.empty()) {
         throw domain_error("Invalid PGN");
     }
+
+    // After the moves, whose first notification dates the game to today
+    read_tags(game);
+    touch();
+}
+
+void Game::pgn(string_view pgn) {
+    PgnReader reader{pgn};
+    PgnGame   game;
+    if (reader.next(game)) {
+        this->pgn(game);
+    } else {
+        this->pgn(PgnGame{});
+    }
+}
+
+//
+// Snapshots
+//
+
+// Numbers are little-endian, and counts and nodes are varints (7 bits a byte,
+// low first, the high bit set on all but the last):
+//
+//   header   "RCMS", u32 version
+//   tags     count, then each as u16 length + name and u16 length + value
+//   start    u16 length + FEN
+//   edges    count, then each move played as the node it's played from,
+//            the node it reaches, u32 low half of that node's key, the
+//            move's src, dst, special and capture as bytes, then u8
+//            length + SAN
+//   history  count, then the node of each position
+//
+// Nodes are numbered as they're first reached, the start being 0, so an edge
+// to the next number is to a new node.  Edges come in the order of the nodes
+// they're from, and then in the order they were played, so the main line is
+// still first
+static constexpr char     SNAPSHOT_MAGIC[4] = {'R', 'C', 'M', 'S'};
+static constexpr uint32_t SNAPSHOT_VERSION  = 1;
+
+static void put_le(string& out, uint64_t value, int bytes) {
+    for (auto i = 0; i < bytes; ++i) {
+        out += static_cast<char>(value >> 8 * i);
+    }
+}
+
+static void put_varint(string& out, uint64_t value) {
+    for (; value >= 0x80; value >>= 7) {
+        out += static_cast<char>(value | 0x80);
+    }
+    out += static_cast<char>(value);
+}
+
+static void put_str(string& out, string_view value, int bytes) {
+    const auto length = min<size_t>(value.size(), (size_t{1} << 8 * bytes) - 1);
+    put_le(out, length, bytes);
+    out.append(value.data(), length);
+}
+
+namespace {
+
+// Bounds checked reads
+struct SnapshotReader {
+    string_view in;
+
+    string_view take(size_t n) {
+        if (in.size() < n) {
+            throw domain_error("Invalid snapshot");
+        }
+        const auto bytes = in.substr(0, n);
+        in.remove_prefix(n);
+        return bytes;
+    }
+
+    uint64_t get(int bytes) {
+        const auto p = take(bytes);
+        uint64_t value = 0;
+        for (auto i = 0; i < bytes; ++i) {
+            value |= uint64_t{static_cast<unsigned char>(p[i])} << 8 * i;
+        }
+        return value;
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (auto shift = 0; shift < 64; shift += 7) {
+            const auto byte = get(1);
+            value |= (byte & 0x7f) << shift;
+            if (byte < 0x80) {
+                return value;
+            }
+        }
+        throw domain_error("Invalid snapshot");
+    }
+
+    string_view str(int bytes) {
+        return take(get(bytes));
+    }
+};
+
+}
+
+string Game::snapshot() const {
+    string out{SNAPSHOT_MAGIC, sizeof SNAPSHOT_MAGIC};
+    put_le(out, SNAPSHOT_VERSION, 4);
+
+    put_varint(out, tags.size());
+    for (const auto& tag : tags) {
+        put_str(out, tag.first,  2);
+        put_str(out, tag.second, 2);
+    }
+    put_str(out, start()->fen(), 2);
+
+    // Numbering nodes as they're reached
+    unordered_map<const Position*, uint32_t> numbers{{start().get(), 0}};
+    vector<const Position*> nodes{start().get()};
+    string   edges;
+    uint32_t count = 0;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        for (const auto& movepair : nodes[i]->moves_played) {
+            const auto after = movepair.second.get();
+            const auto [number, reached] = numbers.emplace(after, static_cast<uint32_t>(nodes.size()));
+            if (reached) {
+                nodes.push_back(after);
+            }
+
+            const auto& move = movepair.first;
+            put_varint(edges, i);
+            put_varint(edges, number->second);
+            put_le(edges, after->key(), 4);
+            edges += static_cast<char>(move.src);
+            edges += static_cast<char>(move.dst);
+            edges += static_cast<char>(move.special);
+            edges += move.capture;
+            put_str(edges, movepair.san, 1);
+            ++count;
+        }
+    }
+    put_varint(out, count);
+    out += edges;
+
+    put_varint(out, history.size());
+    for (const auto& position : history) {
+        put_varint(out, numbers.at(position.get()));
+    }
+    return out;
+}
+
+void Game::snapshot(string_view snapshot) {
+    SnapshotReader in{snapshot};
+    if (in.take(sizeof SNAPSHOT_MAGIC) != string_view{SNAPSHOT_MAGIC, sizeof SNAPSHOT_MAGIC} ||
+        in.get(4) != SNAPSHOT_VERSION)
+    {
+        throw domain_error("Invalid snapshot");
+    }
+
+    map<string, string> saved_tags;
+    for (auto n = in.varint(); n > 0; --n) {
+        const auto name = in.str(2);
+        saved_tags[string(name)] = string(in.str(2));
+    }
+
+    clear();
+    history.push_back(make_position(in.str(2), pool));
+    index_position(start(), nullptr);
+
+    // Each move played just as it was, checked only by the key it reached
+    vector<PositionPtr> nodes{start()};
+    for (auto n = in.varint(); n > 0; --n) {
+        const auto from  = in.varint();
+        const auto to    = in.varint();
+        const auto key   = in.get(4);
+        const auto bytes = in.take(4);
+        const auto san   = in.str(1);
+
+        const Move move{
+            static_cast<Square>(static_cast<unsigned char>(bytes[0])),
+            static_cast<Square>(static_cast<unsigned char>(bytes[1])),
+            static_cast<SPECIAL>(static_cast<unsigned char>(bytes[2])),
+            bytes[3]};
+        if (from >= nodes.size() || to > nodes.size() ||
+            move.src >= SQUARE_INVALID || move.dst >= SQUARE_INVALID ||
+            move.special > SPECIAL_BEN_PASSANT)
+        {
+            throw domain_error("Invalid snapshot");
+        }
+
+        const auto before = nodes[from];
+        auto after = to < nodes.size() ? nodes[to] : nullptr;
+        if (!after) {
+            auto node = allocate_shared<Position>(
+                PoolAllocator<Position>{pool}, static_cast<const ChessRules&>(*before), pool);
+            node->PlayMove(move);
+            after = node;
+            index_position(after, before);
+            nodes.push_back(after);
+        }
+        if (static_cast<uint32_t>(after->key()) != key) {
+            throw domain_error("Invalid snapshot");
+        }
+        before->moves_played.push_back({move, after, string(san), move.uci()});
+    }
+
+    vector<PositionPtr> path;
+    for (auto n = in.varint(); n > 0; --n) {
+        const auto node = in.varint();
+        if (node >= nodes.size() ||
+            (path.empty() ? node != 0 : !path.back()->find_move_played(nodes[node])))
+        {
+            throw domain_error("Invalid snapshot");
+        }
+        path.push_back(nodes[node]);
+    }
+    if (path.empty() || !in.in.empty()) {
+        throw domain_error("Invalid snapshot");
+    }
+    history = std::move(path);
+
+    // As the moves' first notification would have dated the game to today
+    tags = std::move(saved_tags);
+    if (nodes.size() > 1) {
+        started = time(nullptr);
+    }
+    ++*revision;
+    touch();
+}
+
+unique_ptr<Game> replace_game(unique_ptr<Game>& game, unique_ptr<Game> next, Observer<Game>& observer) {
+    if (game) {
+        game->unobserve(&observer);
+    }
+    swap(game, next);
+    game->observe(&observer);
+    observer.on_changed(*game);
+    return next;
 }
 
 // This file is part of the Raccoon's Centaur Mods (RCM).
@@ -5,14 +5,18 @@
 #ifndef CHESS_GAME_H
 #define CHESS_GAME_H
 
+#include "chess_pgn.h"
 #include "chess_position.h"
 #include "../utility/model.h"
 
+#include <cstdint>
 #include <ctime>
+#include <memory>
 #include <map>
 #include <optional>
 #include <ostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <sqlite3.h>
@@ -25,19 +29,61 @@ public:
     std::string   settings;  // Opaque
     std::map<std::string, std::string> tags;
 
+    // A move played, taken back or struck from the record, as the move log
+    // keeps it (see db.h), with moves coded as in archives
+    struct LogEntry {
+        std::int32_t move;   // Code played, 0 for a takeback, minus the code struck
+        std::time_t  clock;
+    };
+
+    // What's been done to the game since whoever saves it took the log and
+    // set log_valid, so saving can append to what's written instead of
+    // rewriting it.  Anything else that changes the game (which the log
+    // can't say) clears log_valid, and nothing is logged until it's set
+    std::vector<LogEntry> log;
+    bool log_valid{false};
+
     explicit Game(std::string_view pgn = {}, std::string_view fen = {});
     Game(const Game&) = default;
 
+    // A game with a graph of its own, holding just the positions in history
+    // (and no observers), for trying out moves without touching this one
+    std::unique_ptr<Game> sandbox() const;
+
     // Re-initialize to start new game
     void clear();
 
     // Initialize new game with starting position given as FEN
     void fen(std::string_view fen);
 
-    // Restore game from PGN
+    // Restore game from PGN, the first game if there are several
     void pgn(std::string_view pgn);
 
-    std::string& tag(const std::string& key);
+    // Restore game from one game of a PGN file
+    void pgn(const PgnGame& game);
+
+    // Graph, tags and current position, compactly, as they are in memory, so
+    // restoring them plays no SAN and searches for nothing, and resuming a
+    // game takes no longer however long it is
+    std::string snapshot() const;
+
+    // Restore game from a snapshot.  Throws std::domain_error if it isn't
+    // one, or not of this version
+    void snapshot(std::string_view snapshot);
+
+    // Tag's value, empty if it has none.  Only setting a different value
+    // changes the game
+    std::string tag(const std::string& key) const;
+    void tag(const std::string& key, std::string value);
+
+    // Changes whenever the game does, and is never the same for two states
+    // of any games, so it can tell whether anything's changed since
+    std::uint64_t generation() const { return stamp; }
+
+    // The same from when the game's cleared for another until it's next
+    // cleared, however it changes meanwhile, and never the same for two
+    // games
+    std::uint64_t identity() const { return ident; }
 
     void on_changed(Game&) override;
 
@@ -66,6 +112,11 @@ public:
     // Parse move given in pure coordinate notation (as used in UCI)
     thc::Move uci_move(std::string_view uci_move) const;
 
+    // History as a UCI position command has it, e.g., "startpos moves e2e4",
+    // or the start's FEN if it isn't the standard one, so an engine sees
+    // repetitions
+    std::string uci_position() const;
+
     void play_move(thc::Move move);
     void play_san_move(std::string_view san_move);
     void play_uci_move(std::string_view uci_move);
@@ -75,6 +126,9 @@ public:
 
     void revise_move(thc::Move takeback, thc::Move move);
 
+    // Do over what was logged, false at the first entry that doesn't apply
+    bool replay(const std::vector<LogEntry>& entries);
+
     bool read_move(
         Bitmap            boardstate,
         const ActionList& actions,
@@ -82,26 +136,73 @@ public:
         std::optional<thc::Move>& takeback);
 
 private:
+    std::uint64_t stamp{0};
+    std::uint64_t ident{0};
+    void touch();
+
+    void append_log(std::int32_t move);
+
     // Write PGN
     void write_tags(std::ostream&) const;
     void write_move(
         std::ostream&,
-        PositionPtr before,
-        thc::Move   move,
-        bool        show_move_number) const;
+        PositionPtr     before,
+        const MovePair& movepair,
+        bool            show_move_number) const;
     void write_moves(std::ostream&, PositionPtr before, bool is_first_move) const;
     void write_movetext(std::ostream&) const;
     void write_pgn(std::ostream&) const;
 
+    // Movetext is cached, and patched as moves are appended to the main line.
+    // Anything else that changes the graph bumps its revision, which is
+    // shared with copies of the game because they share the graph too
+    std::shared_ptr<std::uint64_t> revision;
+    mutable std::string   movetext;
+    mutable PositionPtr   movetext_end;  // Last position on the main line
+    mutable bool          movetext_show_number{true};
+    mutable std::uint64_t movetext_revision{0};
+
+    bool movetext_valid() const;
+    void update_movetext() const;
+
     // Read PGN
-    void read_tags(char*&);
-    bool read_movetext(char*&);
+    void read_tags(const PgnGame&);
+    bool read_movetext(std::string_view&);
 
     // Restore from PGN and FEN
     bool recover_history(PositionPtr target);
     void recover_position(std::string_view fen);
+
+    // Positions, their moves played and the indexes below all come from one
+    // pool, shared with copies of the game because they share the graph
+    std::shared_ptr<Pool> pool;
+
+    // Every position in the graph by key, so transpositions can share nodes
+    // and a position can be found without searching the graph
+    std::unordered_multimap<
+        thc::zobrist::Key, PositionPtr,
+        std::hash<thc::zobrist::Key>, std::equal_to<thc::zobrist::Key>,
+        PoolAllocator<std::pair<const thc::zobrist::Key, PositionPtr>>> positions;
+
+    // The position each was first reached from, none for the start
+    std::unordered_map<
+        const Position*, PositionPtr,
+        std::hash<const Position*>, std::equal_to<const Position*>,
+        PoolAllocator<std::pair<const Position* const, PositionPtr>>> parents;
+
+    void index_position(PositionPtr position, PositionPtr parent);
+    void forget_position(PositionPtr position, PositionPtr parent);
+
+    // Position in the graph equal to (or transposing to) this one, or null
+    PositionPtr find_position(const Position& position, bool transposition) const;
 };
 
+// Put next in game's place, observed by observer instead of the game it
+// replaces, and tell observer of it, as a different game is a change too.
+// Returns the game replaced, no longer observed
+std::unique_ptr<Game> replace_game(
+    std::unique_ptr<Game>& game, std::unique_ptr<Game> next, Observer<Game>& observer);
+
 #endif
 
 // This file is part of the Raccoon's Centaur Mods (RCM).
@@ -0,0 +1,143 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "chess_hands.h"
+
+using namespace std;
+using namespace thc;
+
+namespace hands {
+
+static Action lift(Square square) {
+    return Action{square, SQUARE_INVALID};
+}
+
+static Action place(Square square) {
+    return Action{SQUARE_INVALID, square};
+}
+
+// The rook's move, when the king castles
+static bool castling_rook(const Move& move, Square& from, Square& to) {
+    switch (move.special) {
+    case SPECIAL_WK_CASTLING: from = h1; to = f1; return true;
+    case SPECIAL_WQ_CASTLING: from = a1; to = d1; return true;
+    case SPECIAL_BK_CASTLING: from = h8; to = f8; return true;
+    case SPECIAL_BQ_CASTLING: from = a8; to = d8; return true;
+    default:                  return false;
+    }
+}
+
+// The square of whatever move takes, if anything.  En passant takes the pawn
+// beside it
+static Square captured(const Move& move) {
+    switch (move.special) {
+    case SPECIAL_WEN_PASSANT: return SOUTH(move.dst);
+    case SPECIAL_BEN_PASSANT: return NORTH(move.dst);
+    default:                  return move.capture != ' ' ? move.dst : SQUARE_INVALID;
+    }
+}
+
+ActionList move(Move move, unsigned handling) {
+    ActionList actions;
+    if (handling & NUDGE) {
+        actions.push_back(lift(move.src));
+        actions.push_back(place(move.src));
+    }
+
+    Square rook_from, rook_to;
+    if (castling_rook(move, rook_from, rook_to)) {
+        const ActionList king{lift(move.src), place(move.dst)};
+        const ActionList rook{lift(rook_from), place(rook_to)};
+        const auto& first  = handling & ROOK_FIRST ? rook : king;
+        const auto& second = handling & ROOK_FIRST ? king : rook;
+        actions.insert(actions.end(), first.begin(), first.end());
+        actions.insert(actions.end(), second.begin(), second.end());
+        return actions;
+    }
+
+    const auto taken = captured(move);
+    if (taken != SQUARE_INVALID && handling & CAPTURED_FIRST) {
+        actions.push_back(lift(taken));
+        actions.push_back(lift(move.src));
+    }
+    else {
+        actions.push_back(lift(move.src));
+        if (taken != SQUARE_INVALID) {
+            actions.push_back(lift(taken));
+        }
+    }
+    actions.push_back(place(move.dst));
+    return actions;
+}
+
+bool takeback(Move move, ActionList& actions) {
+    Square rook_from, rook_to;
+    if (castling_rook(move, rook_from, rook_to) || move.is_promotion() ||
+        move.special == SPECIAL_WEN_PASSANT || move.special == SPECIAL_BEN_PASSANT)
+    {
+        return false;
+    }
+
+    actions = {lift(move.dst), place(move.src)};
+    if (move.capture != ' ') {
+        actions.push_back(place(move.dst));
+    }
+    return true;
+}
+
+Bitmap apply(Bitmap boardstate, const ActionList& actions) {
+    for (const auto& action : actions) {
+        if (action.lift != SQUARE_INVALID) {
+            boardstate &= ~(1ULL << action.lift);
+        }
+        else {
+            boardstate |= 1ULL << action.place;
+        }
+    }
+    return boardstate;
+}
+
+Reader::Reader(string_view fen) : game{{}, fen}, boardstate{game.bitmap()} {
+}
+
+void Reader::read(const ActionList& handled) {
+    for (const auto& action : handled) {
+        actions.push_back(action);
+        boardstate = apply(boardstate, {action});
+
+        MoveList       candidates;
+        optional<Move> takeback;
+        game.read_move(boardstate, actions, candidates, takeback);
+        if (candidates.empty() && !takeback) {
+            continue;
+        }
+
+        actions.clear();
+        if (takeback && !candidates.empty()) {
+            game.revise_move(*takeback, candidates.front());
+        }
+        else if (takeback) {
+            game.play_takeback(*takeback);
+        }
+        else {
+            game.play_move(candidates.front());
+        }
+    }
+}
+
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,70 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef CHESS_HANDS_H
+#define CHESS_HANDS_H
+
+#include "chess_game.h"
+#include "chess_position.h"
+
+#include <string_view>
+
+// What a player's hands do on the board to make a move, or take one back,
+// as the board reports it, for simulating play.  Squares are the game's,
+// not reversed
+namespace hands {
+
+// Ways of handling the pieces, any of them together.  Tidily, the moving
+// piece is lifted, anything it takes lifted after it, and it's put down;
+// a castling king goes first
+enum Handling : unsigned {
+    TIDY           = 0,
+    CAPTURED_FIRST = 1 << 0,  // Take the captured piece off before lifting the one taking it
+    ROOK_FIRST     = 1 << 1,  // Castle with the rook, then the king
+    NUDGE          = 1 << 2,  // Pick up the moving piece and put it back first
+};
+
+// Actions making move, handled so
+ActionList move(thc::Move move, unsigned handling = TIDY);
+
+// Actions undoing move, just played, false if they can't be read as a
+// takeback (castling, en passant and promotion, whose pieces don't go
+// simply back)
+bool takeback(thc::Move move, ActionList& actions);
+
+// Boardstate after actions
+Bitmap apply(Bitmap boardstate, const ActionList& actions);
+
+// What the game loop makes of actions, as it reads them an action at a
+// time, each move or takeback played as soon as it's read.  No missed moves
+// are looked for, see Reconstruction
+class Reader {
+public:
+    Game       game;
+    Bitmap     boardstate;
+    ActionList actions;  // Since the last move read
+
+    explicit Reader(std::string_view fen = {});
+
+    void read(const ActionList& handled);
+};
+
+}
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,304 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "chess_pgn.h"
+
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+static constexpr auto npos = string_view::npos;
+
+void PgnGame::clear() {
+    tags.clear();
+    movetext = {};
+}
+
+string pgn_unescape(string_view value) {
+    string unescaped;
+    unescaped.reserve(value.size());
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '\\' && i + 1 < value.size()) {
+            ++i;
+        }
+        unescaped += value[i];
+    }
+    return unescaped;
+}
+
+PgnReader::PgnReader(string_view text) : text{text} {
+}
+
+PgnReader::PgnReader(int fd, size_t size) : fd{fd}, eof{false} {
+    buffer.resize(size > 0 ? size : default_size);
+}
+
+PgnReader::PgnReader(void* map, size_t size)
+    : text{static_cast<const char*>(map), size}, map{map}, map_size{size} {
+}
+
+PgnReader::~PgnReader() {
+    if (map) {
+        munmap(map, map_size);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+unique_ptr<PgnReader> PgnReader::open(const char* path) {
+    const auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw runtime_error(string("Failed to open ") + path);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        const auto size = static_cast<size_t>(st.st_size);
+        auto map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            ::close(fd);
+            madvise(map, size, MADV_SEQUENTIAL);
+            return unique_ptr<PgnReader>(new PgnReader(map, size));
+        }
+    }
+
+    return make_unique<PgnReader>(fd);
+}
+
+string_view PgnReader::pending() const {
+    if (buffer.empty()) {
+        return text;
+    }
+    return {buffer.data() + read_pos, write_pos - read_pos};
+}
+
+void PgnReader::consume(size_t length) {
+    if (buffer.empty()) {
+        text.remove_prefix(length);
+    } else {
+        read_pos += length;
+    }
+}
+
+// Make room for, then read, more text.  Views handed out by the last call to
+// next() are invalidated
+void PgnReader::fill() {
+    if (read_pos > 0) {
+        memmove(buffer.data(), buffer.data() + read_pos, write_pos - read_pos);
+        write_pos -= read_pos;
+        read_pos   = 0;
+    }
+
+    // A game bigger than the buffer, so grow it
+    if (write_pos == buffer.size()) {
+        buffer.resize(2 * buffer.size());
+    }
+
+    for (;;) {
+        const auto n = ::read(fd, buffer.data() + write_pos, buffer.size() - write_pos);
+        if (n > 0) {
+            write_pos += n;
+            return;
+        }
+        if (n == 0) {
+            eof = true;
+            return;
+        }
+        if (errno != EINTR) {
+            throw runtime_error("Failed to read PGN");
+        }
+    }
+}
+
+static bool is_delimiter(char c) {
+    return isspace(static_cast<unsigned char>(c)) || strchr("(){};[]", c);
+}
+
+static bool is_result(string_view token) {
+    return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+}
+
+// Length of the first game in text, or npos if it may not all be there yet.
+// A game ends after its result, or failing that where the next game's tags
+// start, or else at end of input
+static size_t game_length(string_view text, bool eof) {
+    const auto incomplete = eof ? text.size() : npos;
+
+    auto movetext   = false;
+    auto line_start = true;
+    auto depth      = 0;
+    size_t i = 0;
+    while (i < text.size()) {
+        const auto c = text[i];
+        if (c == '\n') {
+            line_start = true;
+            ++i;
+            continue;
+        }
+        if (isspace(static_cast<unsigned char>(c))) {
+            ++i;
+            continue;
+        }
+
+        const auto at_line_start = line_start;
+        line_start = false;
+
+        if (c == '[' && !movetext) {
+            // Tag pair, skip over the (possibly escaped) string value
+            auto quoted = false;
+            for (++i; i < text.size() && (quoted || text[i] != ']'); ++i) {
+                if (quoted && text[i] == '\\') {
+                    ++i;
+                } else if (text[i] == '"') {
+                    quoted = !quoted;
+                }
+            }
+            if (i >= text.size()) {
+                return incomplete;
+            }
+            ++i;
+            continue;
+        }
+
+        if (c == '[' && at_line_start) {
+            return i;
+        }
+
+        movetext = true;
+        if (c == '{' || c == ';') {
+            // Comments may contain anything, including results
+            const auto end = text.find(c == '{' ? '}' : '\n', i);
+            if (end == npos) {
+                return incomplete;
+            }
+            i = end + 1;
+            line_start = c == ';';
+            continue;
+        }
+
+        if (is_delimiter(c)) {
+            depth += c == '(' ? 1 : c == ')' ? -1 : 0;
+            ++i;
+            continue;
+        }
+
+        auto end = i;
+        while (end < text.size() && !is_delimiter(text[end])) {
+            ++end;
+        }
+        if (end == text.size() && !eof) {
+            // Token may continue in the next read
+            return npos;
+        }
+        if (depth <= 0 && is_result(text.substr(i, end - i))) {
+            return end;
+        }
+        i = end;
+    }
+
+    return incomplete;
+}
+
+static void skip_whitespace(string_view& text) {
+    while (!text.empty() && isspace(static_cast<unsigned char>(text.front()))) {
+        text.remove_prefix(1);
+    }
+}
+
+static string_view read_symbol(string_view& text) {
+    size_t n = 0;
+    while (n < text.size() &&
+           (isalnum(static_cast<unsigned char>(text[n])) || strchr("_+#=:-", text[n])))
+    {
+        ++n;
+    }
+    auto symbol = text.substr(0, n);
+    text.remove_prefix(n);
+    return symbol;
+}
+
+static bool read_tags(PgnGame& game, string_view& text) {
+    for (skip_whitespace(text); !text.empty() && text.front() == '['; skip_whitespace(text)) {
+        text.remove_prefix(1);
+        skip_whitespace(text);
+        const auto name = read_symbol(text);
+        if (name.empty() || !isalpha(static_cast<unsigned char>(name.front()))) {
+            return false;
+        }
+
+        skip_whitespace(text);
+        if (text.empty() || text.front() != '"') {
+            return false;
+        }
+        size_t n = 1;
+        while (n < text.size() && text[n] != '"') {
+            n += text[n] == '\\' ? 2 : 1;
+        }
+        if (n >= text.size()) {
+            return false;
+        }
+        const auto value = text.substr(1, n - 1);
+        text.remove_prefix(n + 1);
+
+        skip_whitespace(text);
+        if (text.empty() || text.front() != ']') {
+            return false;
+        }
+        text.remove_prefix(1);
+
+        game.tags.emplace_back(name, value);
+    }
+    return true;
+}
+
+bool PgnReader::next(PgnGame& game) {
+    game.clear();
+    for (;;) {
+        auto unread = pending();
+        const auto blank = unread.size();
+        skip_whitespace(unread);
+        consume(blank - unread.size());
+
+        const auto length = game_length(unread, eof);
+        if (length == npos) {
+            fill();
+            continue;
+        }
+        if (length == 0) {
+            return false;
+        }
+
+        auto text = unread.substr(0, length);
+        consume(length);
+        if (!read_tags(game, text)) {
+            throw domain_error("Invalid PGN");
+        }
+        game.movetext = text;
+        ++games;
+        return true;
+    }
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,91 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef CHESS_PGN_H
+#define CHESS_PGN_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// One game from a PGN file.  Nothing is copied, the views point into the
+// reader's buffer and are only good until the reader's next call to next()
+struct PgnGame {
+    // Tag pairs in file order, values still escaped (see pgn_unescape)
+    std::vector<std::pair<std::string_view, std::string_view>> tags;
+
+    // Everything after the tags, up to and including the result
+    std::string_view movetext;
+
+    void clear();
+};
+
+// Tag value with '\' escapes removed
+std::string pgn_unescape(std::string_view value);
+
+// Read a PGN file one game at a time.  Memory stays flat however many games
+// there are: a mapped file is only ever viewed, and a stream is read through
+// one buffer that's reused for every game (and only grows when a single game
+// doesn't fit).
+class PgnReader {
+public:
+    static constexpr std::size_t default_size = 64 * 1024;
+
+    // Games already in memory, which must outlive the reader
+    explicit PgnReader(std::string_view text);
+
+    // Games read from a file descriptor, which the reader closes
+    explicit PgnReader(int fd, std::size_t size = default_size);
+
+    PgnReader(const PgnReader&) = delete;
+    PgnReader& operator=(const PgnReader&) = delete;
+    ~PgnReader();
+
+    // Maps regular files, streams anything else (pipes, say)
+    static std::unique_ptr<PgnReader> open(const char* path);
+
+    // Next game, or false at end of input.  Throws std::domain_error if the
+    // tags are malformed, std::runtime_error if reading fails
+    bool next(PgnGame& game);
+
+    // Games returned so far
+    std::size_t count() const { return games; }
+
+private:
+    std::string buffer;       // Streaming only
+    std::size_t read_pos{0};  // Start of unread text in buffer
+    std::size_t write_pos{0}; // End of text in buffer
+    std::string_view text;    // Unread text otherwise
+    void*       map{nullptr};
+    std::size_t map_size{0};
+    int         fd{-1};
+    bool        eof{true};
+    std::size_t games{0};
+
+    PgnReader(void* map, std::size_t size);
+
+    std::string_view pending() const;
+    void consume(std::size_t length);
+    void fill();
+};
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
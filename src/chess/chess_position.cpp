@@ -5,25 +5,46 @@
 
 #include <algorithm>
 #include <cassert>
-#include <cstring>
 
 using namespace std;
 using namespace thc;
 
 bool operator==(const Position& lhs, const Position& rhs) {
-    return lhs.white == rhs.white &&
+    // Equal pieces have equal keys, so that's a cheap early out
+    return lhs.piece_key == rhs.piece_key &&
+        lhs.white == rhs.white &&
         lhs.half_move_clock == rhs.half_move_clock &&
         lhs.full_move_count == rhs.full_move_count &&
         lhs.d == rhs.d &&
-        memcmp(lhs.squares, rhs.squares, sizeof lhs.squares) == 0;
+        difference_mask(lhs.squares, rhs.squares) == 0;
 }
 
-Position::Position(string_view fen) {
+bool transposes(const Position& lhs, const Position& rhs) {
+    // Keys only see en passant targets (and castling rights) that matter
+    return lhs.key() == rhs.key() &&
+        lhs.half_move_clock == rhs.half_move_clock &&
+        lhs.full_move_count == rhs.full_move_count &&
+        difference_mask(lhs.squares, rhs.squares) == 0 &&
+        lhs.same_history(rhs);
+}
+
+Position::Position(string_view fen, shared_ptr<Pool> pool)
+    : moves_played{PoolAllocator<MovePair>{std::move(pool)}}
+{
     if (!fen.empty()) {
         Forsyth(fen.data());
     }
 }
 
+Position::Position(const ChessRules& rules, shared_ptr<Pool> pool)
+    : ChessRules{rules}, moves_played{PoolAllocator<MovePair>{std::move(pool)}}
+{
+}
+
+PositionPtr make_position(string_view fen, shared_ptr<Pool> pool) {
+    return allocate_shared<Position>(PoolAllocator<Position>{pool}, fen, pool);
+}
+
 PositionPtr Position::move_played(Move move) const {
     // Find move in moves_played
     auto existing = find_if(
@@ -41,10 +62,17 @@ PositionPtr Position::play_move(Move move) const {
         return existing;
     }
 
-    auto after = make_shared<Position>(*this);
-    after->moves_played.clear();
+    // The new node comes from the same pool as this one, and starts without
+    // this one's moves played (or its cached move index)
+    const auto& pool = moves_played.get_allocator().pool;
+    auto after = allocate_shared<Position>(
+        PoolAllocator<Position>{pool}, static_cast<const ChessRules&>(*this), pool);
+
+    // Needs the position before the move, and it's cheaper to ask now than
+    // on every export
+    auto san = after->move_san(move);
     after->PlayMove(move);
-    moves_played.push_back({move, after});
+    moves_played.push_back({move, after, std::move(san), move.uci()});
     return after;
 }
 
@@ -78,31 +106,13 @@ void Position::remove_move_played(Move move) const {
     );
 }
 
-Bitmap Position::bitmap() const {
-    Bitmap bitmap{0};
-    Bitmap mask{1};
-    for (auto sq = a8; sq <= h1; ++sq) {
-        if (!IsEmptySquare(at(sq))) {
-            bitmap |= mask;
-        }
-        mask <<= 1;
-    }
-    return bitmap;
-}
-
-// Bitmap of the differences between two positions (*not* the difference of
-// their bitmaps!), so takes into account when a square is occupied by a
-// different piece
-Bitmap Position::difference_bitmap(const Position& other) const {
-    Bitmap bitmap{0};
-    Bitmap mask{1};
-    for (auto sq = a8; sq <= h1; ++sq) {
-        if (at(sq) != other.at(sq)) {
-            bitmap |= mask;
+void Position::share_move_played(Move move, PositionPtr after) const {
+    for (auto& pair : moves_played) {
+        if (pair.first == move) {
+            assert(transposes(*pair.second, *after));
+            pair.second = after;
         }
-        mask <<= 1;
     }
-    return bitmap;
 }
 
 // Legal moves in this position
@@ -131,6 +141,25 @@ MoveList Position::castle_moves() const {
     return result;
 }
 
+// Squares changed by a move are its source and destination, plus the pawn
+// taken en passant or the rook moved when castling.  Of those, only the
+// destinations (of king and rook) are occupied afterwards.
+Position::Footprint Position::footprint(Move move) const {
+    auto changed  = BB(move.src) | BB(move.dst);
+    auto occupied = BB(move.dst);
+    switch (move.special) {
+    case SPECIAL_WEN_PASSANT: changed |= BB(SOUTH(move.dst)); break;
+    case SPECIAL_BEN_PASSANT: changed |= BB(NORTH(move.dst)); break;
+    case SPECIAL_WK_CASTLING: changed |= BB(h1) | BB(f1); occupied |= BB(f1); break;
+    case SPECIAL_WQ_CASTLING: changed |= BB(a1) | BB(d1); occupied |= BB(d1); break;
+    case SPECIAL_BK_CASTLING: changed |= BB(h8) | BB(f8); occupied |= BB(f8); break;
+    case SPECIAL_BQ_CASTLING: changed |= BB(a8) | BB(d8); occupied |= BB(d8); break;
+    default:
+        break;
+    }
+    return {(bitmap() & ~changed) | occupied, changed};
+}
+
 // A boardstate might represent a transition into a new position only if the
 // differences between the boardstate and the resulting position are confined
 // to those squares that differ between the two positions.
@@ -142,6 +171,70 @@ bool Position::incomplete(Bitmap boardstate, const Position& after) const {
     return (diff & ~difference_bitmap(after)) == 0;
 }
 
+// Occupancy delta of each legal move.  The key check guards against the
+// position having been changed with PushMove() since it was built.
+const vector<Position::IndexedMove>& Position::move_index() const {
+    const auto current = key();
+    if (index.valid && index.key == current) {
+        return index.moves;
+    }
+
+    const auto occupied = bitmap();
+    index.moves.clear();
+    index.changed = 0;
+    for (auto move : legal_moves()) {
+        const auto after = footprint(move);
+        index.moves.push_back({occupied ^ after.bitmap, after.changed, move});
+        index.changed |= after.changed;
+    }
+    stable_sort(
+        index.moves.begin(),
+        index.moves.end(),
+        [](const IndexedMove& lhs, const IndexedMove& rhs) {
+            return lhs.delta < rhs.delta;
+        }
+    );
+    index.key   = current;
+    index.valid = true;
+    return index.moves;
+}
+
+MoveList Position::moves_to(Bitmap boardstate) const {
+    const auto& moves = move_index();
+    const auto delta  = boardstate ^ bitmap();
+    auto p = lower_bound(
+        moves.begin(),
+        moves.end(),
+        delta,
+        [](const IndexedMove& lhs, Bitmap delta) {
+            return lhs.delta < delta;
+        }
+    );
+
+    MoveList result;
+    for (; p != moves.end() && p->delta == delta; ++p) {
+        result.push_back(p->move);
+    }
+    return result;
+}
+
+bool Position::incomplete(Bitmap boardstate) const {
+    const auto& moves = move_index();
+    const auto diff = boardstate ^ bitmap();
+
+    // Quick rejection: nothing touches some of these squares
+    if (diff & ~index.changed) {
+        return false;
+    }
+    return any_of(
+        moves.begin(),
+        moves.end(),
+        [diff](const IndexedMove& indexed) {
+            return (diff & ~indexed.changed) == 0;
+        }
+    );
+}
+
 // Construct list of candidate moves in this position that match the given
 // boardstate.  The return indicates if there are any viable candidates:
 // - true if any candidates are found OR if the boardstate could be in
@@ -149,21 +242,8 @@ bool Position::incomplete(Bitmap boardstate, const Position& after) const {
 // - false if the boardstate is incompatible with all legal moves in this
 //   position.
 bool Position::read_moves(Bitmap boardstate, MoveList& candidates) const {
-    auto maybe_valid = false;
-    Position after{*this};
-
-    candidates.clear();
-    for (auto move : legal_moves()) {
-        after.PushMove(move);
-        if (after.bitmap() == boardstate) {
-            candidates.push_back(move);
-            maybe_valid = true;
-        }
-        else if (!maybe_valid) {
-            maybe_valid = incomplete(boardstate, after);
-        }
-        after.PopMove(move);
-    }
+    candidates = moves_to(boardstate);
+    const auto maybe_valid = !candidates.empty() || incomplete(boardstate);
 
     assert(maybe_valid || candidates.empty());
     return maybe_valid;
@@ -202,8 +282,18 @@ bool Position::read_move(
         return true;
     }
 
-    // For a capture, history should show a place on the target square
+    // For a capture, history should show a place on the target square, and
+    // before it a lift of the piece taken, which en passant takes from
+    // beside it
     for (auto move : captures) {
+        auto taken = move.dst;
+        if (move.special == SPECIAL_WEN_PASSANT) {
+            taken = SOUTH(move.dst);
+        }
+        else if (move.special == SPECIAL_BEN_PASSANT) {
+            taken = NORTH(move.dst);
+        }
+
         auto got_lift  = false;
         auto got_place = false;
         for (auto p = actions.rbegin(); p != actions.rend(); ++p) {
@@ -211,7 +301,7 @@ bool Position::read_move(
                 got_place = move.dst == p->place;
             }
             else if (!got_lift) {
-                got_lift  = move.dst == p->lift;
+                got_lift  = taken == p->lift;
             }
         }
         if (got_lift && got_place) {
@@ -6,6 +6,7 @@
 #define CHESS_POSITION_H
 
 #include "../thc/thc.h"
+#include "../utility/pool.h"
 
 #include <cstdint>
 #include <memory>
@@ -27,19 +28,43 @@ struct Action {
 // Sequence of actions from oldest to newest.
 using ActionList = std::vector<Action>;
 
+// The square opposite, as the board sees it turned round
+inline thc::Square rotate_square(thc::Square square) {
+    // square  == 8 * (7 - row) + col
+    //         == 56 - 8 * row + col
+    //         == 56 - (8 * row - col)
+    // rotated == 8 * row + (7 - col)
+    //         == 7 + (8 * row - col)
+    // square + rotated == 63
+    // et voila
+    return static_cast<thc::Square>(63 - square);
+}
+
 class Position;
 using PositionPtr = std::shared_ptr<const Position>;
 
-using MoveList = std::vector<thc::Move>;
+using MoveList = thc::MoveList;
+
+// Represents both a move and the resulting position, along with the text of
+// the move, worked out once when it's first played.
+struct MovePair {
+    thc::Move   first;
+    PositionPtr second;
+    std::string san;
+    std::string uci;
+};
 
-// Represents both a move and the resulting position.
-using MovePair = std::pair<thc::Move, PositionPtr>;
+using MovePairList = std::vector<MovePair, PoolAllocator<MovePair>>;
 
 class Position : public thc::ChessRules {
 public:
-    mutable std::vector<MovePair> moves_played;
+    // Shares the position's pool, as do positions played from it
+    mutable MovePairList moves_played;
+
+    explicit Position(std::string_view fen = {}, std::shared_ptr<Pool> pool = nullptr);
 
-    explicit Position(std::string_view fen = {});
+    // Same position as rules, with nothing played from it yet
+    Position(const thc::ChessRules& rules, std::shared_ptr<Pool> pool);
 
     // If move has previously been played in this position, return the shared
     // resulting position.
@@ -51,15 +76,51 @@ public:
     std::optional<thc::Move> find_move_played(PositionPtr after) const;
     void remove_move_played(thc::Move move) const;
 
-    Bitmap bitmap() const;
-    Bitmap difference_bitmap(const Position& other) const;
+    // Have a move already played lead to an equivalent position instead,
+    // so transpositions share nodes
+    void share_move_played(thc::Move move, PositionPtr after) const;
+
+    // Bitmap and Bitboard share a layout, so the occupancy is just the union
+    // of the bitboards kept up to date by PushMove() and PopMove()
+    Bitmap bitmap() const { return bitboards.occupied(); }
+
+    // Bitmap of the differences between two positions (*not* the difference
+    // of their bitmaps!), so takes into account when a square is occupied by
+    // a different piece
+    Bitmap difference_bitmap(const Position& other) const {
+        return bitboards.difference(other.bitboards);
+    }
 
     MoveList legal_moves() const;
     MoveList castle_moves() const;
 
+    // Effect of a move on the board, worked out without playing it
+    struct Footprint {
+        Bitmap bitmap;   // occupied squares afterwards
+        Bitmap changed;  // squares whose contents change
+    };
+    Footprint footprint(thc::Move move) const;
+
+    // A legal move, filed under the change it makes to the occupancy bitmap
+    struct IndexedMove {
+        Bitmap    delta;    // bitmap() before XOR bitmap() after
+        Bitmap    changed;  // squares whose contents change
+        thc::Move move;
+    };
+
+    // Legal moves ordered by delta (otherwise in legal_moves() order), built
+    // on first use and cached with the position
+    const std::vector<IndexedMove>& move_index() const;
+
+    // Legal moves resulting in exactly boardstate
+    MoveList moves_to(Bitmap boardstate) const;
+
     // True if boardstate might represent a transition into position `after`
     bool incomplete(Bitmap boardstate, const Position& after) const;
 
+    // True if boardstate might represent a transition into any legal move
+    bool incomplete(Bitmap boardstate) const;
+
     // Yield list of legal moves matching both boardstate and action history.
     bool read_move(
         Bitmap            boardstate,
@@ -67,6 +128,19 @@ public:
         MoveList&         candidates) const;
 
 private:
+    // A cache, so copies of the position start without one
+    struct MoveIndex {
+        bool              valid{false};
+        thc::zobrist::Key key{0};      // key() it was built for
+        Bitmap            changed{0};  // union of all moves' changed squares
+        std::vector<IndexedMove> moves;
+
+        MoveIndex() = default;
+        MoveIndex(const MoveIndex&) {}
+        MoveIndex& operator=(const MoveIndex&) { valid = false; return *this; }
+    };
+    mutable MoveIndex index;
+
     // Yield list of legal moves matching boardstate.
     bool read_moves(Bitmap boardstate, MoveList& candidates) const;
 };
@@ -74,6 +148,14 @@ private:
 // True if two positions are equivalent, without considering moves played.
 bool operator==(const Position& lhs, const Position& rhs);
 
+// True if two positions are the same for all future play, so like == but
+// ignoring an en passant target that can't be taken, and with the same
+// earlier positions that could still be repeated.
+bool transposes(const Position& lhs, const Position& rhs);
+
+// New position allocated from pool (or the heap, without one)
+PositionPtr make_position(std::string_view fen = {}, std::shared_ptr<Pool> pool = nullptr);
+
 #endif
 
 // This file is part of the Raccoon's Centaur Mods (RCM).
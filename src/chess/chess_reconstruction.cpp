@@ -0,0 +1,212 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "chess_reconstruction.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+using namespace thc;
+
+// Update boardstate to match action
+static void apply_action(Bitmap& state, const Action& action) {
+    if (action.lift != SQUARE_INVALID) {
+        state &= ~(1ull << action.lift);
+    }
+    else if (action.place != SQUARE_INVALID) {
+        state |= 1ull << action.place;
+    }
+}
+
+//
+// Reconstruction
+//
+
+auto Reconstruction::Line::copy() const -> Line {
+    return Line{game->sandbox(), state, pending, maybe_valid, explained, first};
+}
+
+// Actions read as moves, or that might yet be
+size_t Reconstruction::Line::score() const {
+    return explained + (maybe_valid ? pending.size() : 0);
+}
+
+// Whether the line makes some kind of sense, ending where the board is now.
+// We can accept an incomplete move only at the very end (otherwise we might
+// imagine a nonsense sequence of incomplete moves and make no progress)
+bool Reconstruction::Line::explains(Bitmap boardstate) const {
+    const auto step_valid = pending.empty() || (maybe_valid && state == boardstate);
+    return step_valid && game->bitmap() == boardstate;
+}
+
+// Extend every line by action, branching wherever it can be read more than
+// one way, and keep the best
+void Reconstruction::Simulation::feed(const Action& action) {
+    // A way to go on from a line: a move read (possibly one of several
+    // candidates, or a takeback), or nothing yet
+    struct Branch {
+        size_t         line;
+        optional<Move> move;
+        optional<Move> takeback;
+        size_t         score;
+    };
+    vector<Branch> branches;
+
+    for (size_t i = 0; i < lines.size(); ++i) {
+        auto& line = lines[i];
+        line.pending.push_back(action);
+        apply_action(line.state, action);
+
+        MoveList       candidates;
+        optional<Move> takeback;
+        line.maybe_valid = line.game->read_move(line.state, line.pending, candidates, takeback);
+
+        // Candidates are in order of preference, queen promotion first
+        const auto read = line.explained + line.pending.size();
+        for (auto move : candidates) {
+            branches.push_back(Branch{i, move, takeback, read});
+        }
+        if (candidates.empty() && takeback.has_value()) {
+            branches.push_back(Branch{i, nullopt, takeback, read});
+        }
+        branches.push_back(Branch{i, nullopt, nullopt, line.score()});
+    }
+
+    stable_sort(
+        branches.begin(),
+        branches.end(),
+        [](const Branch& lhs, const Branch& rhs) { return lhs.score > rhs.score; });
+    if (branches.size() > WIDTH) {
+        branches.resize(WIDTH);
+    }
+
+    // The last branch from each line can have it, the others need copies
+    vector<size_t> last(lines.size(), branches.size());
+    for (size_t b = 0; b < branches.size(); ++b) {
+        last[branches[b].line] = b;
+    }
+
+    vector<Line> extended;
+    extended.reserve(branches.size());
+    for (size_t b = 0; b < branches.size(); ++b) {
+        const auto& branch = branches[b];
+        auto& parent = lines[branch.line];
+        extended.push_back(last[branch.line] == b ? std::move(parent) : parent.copy());
+
+        if (!branch.move && !branch.takeback) {
+            continue;
+        }
+
+        auto& line = extended.back();
+        if (branch.takeback && branch.move) {
+            line.game->revise_move(*branch.takeback, *branch.move);
+        }
+        else if (branch.takeback) {
+            line.game->play_takeback(*branch.takeback);
+        }
+        else {
+            line.game->play_move(*branch.move);
+        }
+
+        line.explained  += line.pending.size();
+        line.pending.clear();
+        line.state       = line.game->bitmap();
+        line.maybe_valid = true;
+        if (!line.first) {
+            line.first = Reconstructed{begin, next, branch.move, branch.takeback};
+        }
+    }
+
+    lines = std::move(extended);
+}
+
+void Reconstruction::reset() {
+    base_game = nullptr;
+    base.reset();
+    base_depth = 0;
+    started    = 0;
+    seen       = 0;
+    unfinished = false;
+    simulations.clear();
+}
+
+bool Reconstruction::find_tail(
+    const Game&       game,
+    const ActionList& actions,
+    Bitmap            boardstate,
+    Reconstructed&    reconstructed,
+    chrono::microseconds budget)
+{
+    const auto deadline = chrono::steady_clock::now() + budget;
+    unfinished = false;
+
+    // Simulations only hold while game and the history they were fed stay put
+    if (&game != base_game ||
+        game.current() != base ||
+        game.history.size() != base_depth ||
+        actions.size() < seen)
+    {
+        reset();
+        base_game  = &game;
+        base       = game.current();
+        base_depth = game.history.size();
+    }
+    seen = actions.size();
+
+    // Only the latest tails are worth starting, or keeping
+    const auto oldest = seen > WINDOW ? seen - WINDOW : 0;
+    simulations.erase(
+        simulations.begin(),
+        find_if(
+            simulations.begin(),
+            simulations.end(),
+            [oldest](const Simulation& simulation) { return simulation.begin >= oldest; }));
+
+    started = max(started, oldest);
+    for (; started < seen; ++started) {
+        Line line{game.sandbox(), game.bitmap()};
+        simulations.push_back(Simulation{started, started, {}});
+        simulations.back().lines.push_back(std::move(line));
+    }
+
+    // Longest tails first, so any tail that's caught up has every longer
+    // tail caught up too
+    for (auto& simulation : simulations) {
+        while (simulation.next < seen) {
+            if (chrono::steady_clock::now() >= deadline) {
+                unfinished = true;
+                return false;
+            }
+            ++simulation.next;
+            simulation.feed(actions[simulation.next - 1]);
+        }
+
+        for (const auto& line : simulation.lines) {
+            if (line.explains(boardstate)) {
+                if (line.first) {
+                    reconstructed = *line.first;
+                } else {
+                    reconstructed = Reconstructed{simulation.begin, simulation.begin, nullopt, nullopt};
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
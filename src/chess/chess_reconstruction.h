@@ -0,0 +1,106 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef CHESS_RECONSTRUCTION_H
+#define CHESS_RECONSTRUCTION_H
+
+#include "chess_game.h"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+// First move of a reconstructed tail
+struct Reconstructed {
+    std::size_t begin{0};  // Actions before this are noise
+    std::size_t end{0};    // Actions up to here make the move, if any
+    std::optional<thc::Move> move;
+    std::optional<thc::Move> takeback;
+};
+
+// Search for moves we missed: the longest tail of the actions history that
+// maps out a path from the last known position to the current boardstate.
+//
+// Every tail is simulated in a sandbox that's kept from one call to the
+// next and fed only the actions appended since, so a long run of noise
+// costs a bounded amount of work per action instead of replaying every tail
+// from scratch.  Tails starting more than WINDOW actions back are dropped.
+//
+// Some actions can be read more than one way: as any of several promotions,
+// or as a move now or part of a move still to come (the rook of a castling
+// move, say).  So each tail follows up to WIDTH lines, those explaining the
+// most actions, and ties go to the first candidate, read as soon as possible.
+class Reconstruction {
+public:
+    static constexpr std::size_t WINDOW = 32;
+    static constexpr std::size_t WIDTH  = 8;
+
+    // Most time spent on one call.  Whatever's left is simulated next time
+    static constexpr std::chrono::microseconds BUDGET{5000};
+
+    // Forget all simulations.  Required whenever actions are removed from
+    // history, since tails are known by where they start
+    void reset();
+
+    // Last search ran out of time, worth calling again soon
+    bool busy() const { return unfinished; }
+
+    // Find the longest tail that reconstructs boardstate from game, and how
+    // it starts
+    bool find_tail(
+        const Game&       game,
+        const ActionList& actions,
+        Bitmap            boardstate,
+        Reconstructed&    reconstructed,
+        std::chrono::microseconds budget = BUDGET);
+
+private:
+    struct Line {
+        std::unique_ptr<Game> game;       // Moves read so far
+        Bitmap                state{0};   // Simulated boardstate
+        ActionList            pending{};  // Actions since last move read
+        bool                  maybe_valid{true};
+        std::size_t           explained{0};  // Actions read as moves
+        std::optional<Reconstructed> first{};  // Earliest move read
+
+        Line copy() const;
+        std::size_t score() const;
+        bool explains(Bitmap boardstate) const;
+    };
+
+    struct Simulation {
+        std::size_t       begin;  // First action of tail
+        std::size_t       next;   // Next action to feed
+        std::vector<Line> lines;  // Best first
+
+        void feed(const Action& action);
+    };
+
+    const Game*             base_game{nullptr};
+    PositionPtr             base;
+    std::size_t             base_depth{0};
+    std::size_t             started{0};   // Tails started so far
+    std::size_t             seen{0};      // Actions at last call
+    bool                    unfinished{false};
+    std::vector<Simulation> simulations;  // Longest tail first
+};
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,201 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "chess_review.h"
+#include "chess_archive.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace thc;
+
+// How long past its movetime a search may take before it's asked for
+// again, as being lost, and how long to wait for more games once there
+// are none
+static const auto SEARCH_SLACK = chrono::seconds(10);
+static const auto RESCAN       = chrono::seconds(60);
+
+// What a mate is worth, less the moves to it
+static constexpr int MATE = 10000;
+
+static int centipawns(const UCIInfo& info) {
+    if (!info.mate) {
+        return info.score;
+    }
+    return info.score > 0 ? MATE - info.score : -MATE - info.score;
+}
+
+// What a mate or a stalemate is, for the side to move, with nothing
+// to search
+static bool over(const Game& game, UCIInfo& info) {
+    ChessRules rules = *game.current();
+    TERMINAL terminal;
+    if (!rules.Evaluate(terminal) || terminal == NOT_TERMINAL) {
+        return false;
+    }
+    info      = UCIInfo{};
+    info.mate = terminal == TERMINAL_WCHECKMATE || terminal == TERMINAL_BCHECKMATE;
+    return true;
+}
+
+Review::Review(ReviewStore& store, unsigned movetime)
+    : store{store},
+      movetime{movetime}
+{
+}
+
+// The next game to review, positioned where any review of it left off.
+// Games that can't be loaded are as good as reviewed
+bool Review::start() {
+    while (store.next_review(before, reviewing)) {
+        before = reviewing.rowid;
+
+        auto saved = store.review_game(reviewing.rowid);
+        if (!saved) {
+            store.review(ReviewRow{.game = reviewing.rowid});
+            continue;
+        }
+
+        line.clear();
+        const auto& history = saved->history;
+        for (size_t i = 0; i + 1 < history.size(); ++i) {
+            const auto move = history[i]->find_move_played(history[i + 1]);
+            if (!move) {
+                break;
+            }
+            line.push_back(*move);
+        }
+
+        game = make_unique<Game>(string_view{}, saved->start()->fen());
+        ply  = min<uint32_t>(reviewing.plies, line.size());
+        for (uint32_t i = 0; i < ply; ++i) {
+            game->play_move(line[i]);
+        }
+        searched_before = false;
+        loss_before     = reviewing.loss;
+        waiting         = false;
+        return true;
+    }
+    return false;
+}
+
+// The position at ply as found: the row of the move to it is complete,
+// and the game goes on to the next
+void Review::next(const UCIInfo& info) {
+    if (searched_before) {
+        const auto mover  = game->history[game->history.size() - 2]->WhiteToPlay() ? 0 : 1;
+        const auto loss   = max(0, centipawns(info_before) + centipawns(info));
+        const auto error  = reviewing.error[mover];
+        const auto chance = reviewing.opportunity[mover];
+
+        auto flag = ReviewRow::NONE;
+        if (error && loss >= error) {
+            flag = ReviewRow::ERROR;
+        }
+        else if (chance && loss >= chance && loss_before >= chance) {
+            flag = ReviewRow::OPPORTUNITY;
+        }
+
+        store.review({
+            .game  = reviewing.rowid,
+            .ply   = ply - 1,
+            .key   = static_cast<int64_t>(game->history[game->history.size() - 2]->key()),
+            .move  = archive::encode(line[ply - 1]),
+            .best  = info_before.pv_length ? info_before.pv[0] : uint16_t{0},
+            .score = info_before.score,
+            .mate  = info_before.mate,
+            .depth = info_before.depth,
+            .loss  = loss,
+            .flag  = flag,
+        });
+        loss_before = loss;
+    }
+
+    if (ply == line.size()) {
+        // And the end, which completes it
+        store.review({
+            .game  = reviewing.rowid,
+            .ply   = ply,
+            .key   = static_cast<int64_t>(game->current()->key()),
+            .best  = info.pv_length ? info.pv[0] : uint16_t{0},
+            .score = info.score,
+            .mate  = info.mate,
+            .depth = info.depth,
+        });
+        game.reset();
+        return;
+    }
+
+    info_before     = info;
+    searched_before = true;
+    game->play_move(line[ply++]);
+}
+
+bool Review::step(Engine& engine, bool allowed) {
+    if (!allowed) {
+        // Whatever it was searching, the engine's wanted for something else
+        waiting = false;
+        return false;
+    }
+
+    const auto now = clock::now();
+    if (!game && now < rescan) {
+        return false;
+    }
+    for (;;) {
+        if (!game && !start()) {
+            // From the newest again, in a while
+            before = 0;
+            rescan = now + RESCAN;
+            return false;
+        }
+
+        UCIInfo info;
+        if (!over(*game, info)) {
+            break;
+        }
+        next(info);
+    }
+
+    if (!waiting || now >= deadline) {
+        engine.analyse(*game, 1, movetime);
+        waiting  = true;
+        deadline = now + chrono::milliseconds(movetime) + SEARCH_SLACK;
+    }
+    return true;
+}
+
+void Review::found(const UCIAnalysis& analysis) {
+    if (!waiting || !game || !analysis.done || analysis.key != game->current()->key()) {
+        return;
+    }
+    waiting = false;
+
+    // No line, no score, if the engine found no move at all
+    next(analysis.lines ? analysis.line[0] : UCIInfo{});
+}
+
+Review::clock::time_point Review::due() const {
+    if (!game) {
+        return rescan;
+    }
+    if (!waiting) {
+        return clock::time_point{};
+    }
+    return deadline;
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,126 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef CHESS_REVIEW_H
+#define CHESS_REVIEW_H
+
+#include "chess_engine.h"
+#include "chess_game.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// What review found of a ply of a game's main line: how the position
+// stood, for the side to move, and what the move played from it cost them
+struct ReviewRow {
+    // Moves that cost at least the player's error threshold are errors.
+    // Those costing at least their opportunity threshold, just after the
+    // other player's move cost as much, missed an opportunity
+    enum Flag : std::uint8_t { NONE, OPPORTUNITY, ERROR };
+
+    std::int64_t  game{0};   // Its rowid
+    std::uint32_t ply{0};
+    std::int64_t  key{0};    // Position::key(), as signed, how SQLite has it
+    std::uint16_t move{0};   // Played, archive::encode, 0 at the end
+    std::uint16_t best{0};   // What the engine would play, ditto, 0 for none
+    int           score{0};  // Centipawns, or moves to mate
+    bool          mate{false};
+    unsigned      depth{0};
+    int           loss{0};   // Centipawns, 0 at the end
+    Flag          flag{NONE};
+};
+
+// A game to review, with its players' coaching thresholds in centipawns, 0
+// for none (see Player), and where any review of it before left off
+struct ReviewGame {
+    std::int64_t  rowid{0};
+    int           error[2]{};        // White's, then Black's
+    int           opportunity[2]{};
+    std::uint32_t plies{0};          // Rows reviewed already
+    int           loss{0};           // The last of them
+};
+
+// Where games to review come from, and what's found of them goes
+class ReviewStore {
+public:
+    virtual ~ReviewStore() = default;
+
+    // The newest finished game played on the board, older than before (0 for
+    // any), that isn't reviewed to the end.  False if there's none
+    virtual bool next_review(std::int64_t before, ReviewGame& game) = 0;
+
+    // The game as saved, null if it can't be loaded
+    virtual std::unique_ptr<Game> review_game(std::int64_t rowid) = 0;
+
+    // Keep a row, the row at the end making the game's review complete.
+    // Rows of a game come in order, so its review resumes after the last
+    // kept
+    virtual void review(const ReviewRow& row) = 0;
+};
+
+// Analysis of saved games, ply by ply, with whatever the engine's pool
+// isn't doing for the game on the board.  One position at a time is
+// searched, for movetime, and each ply kept as it's found, so a review
+// picks up near enough where it was when the power went
+class Review {
+public:
+    Review(ReviewStore& store, unsigned movetime);
+
+    // Go on with the review, if allowed, else leave off, letting whatever
+    // else wants the engine have it.  True while a search is the review's
+    bool step(Engine& engine, bool allowed);
+
+    // An analysis the engine's published, which is heeded if it's the end
+    // of a search for the review
+    void found(const UCIAnalysis& analysis);
+
+    // When step() next has something to do of its own accord, not on an
+    // answer from the engine: a search to start, or to ask for again once
+    // the engine's overdue, or another look for games
+    std::chrono::steady_clock::time_point due() const;
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    ReviewStore&    store;
+    const unsigned  movetime;
+
+    ReviewGame              reviewing;
+    std::unique_ptr<Game>   game;  // At the ply being searched
+    std::vector<thc::Move>  line;  // Main line of the game as saved
+    std::uint32_t           ply{0};
+    std::int64_t            before{0};  // Where to look for the next game
+
+    // The position before, as found, and what the move to it cost
+    bool    searched_before{false};
+    UCIInfo info_before;
+    int     loss_before{0};
+
+    bool              waiting{false};
+    clock::time_point deadline;  // For the search, to ask again
+    clock::time_point rescan;    // For more games, once there were none
+
+    bool start();
+    void next(const UCIInfo& info);
+};
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
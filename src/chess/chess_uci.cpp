@@ -4,30 +4,187 @@
 #include "chess_uci.h"
 #include "chess.h"
 #include "../utility/buffer.h"
+#include "../utility/trace.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
-#include <cstring>
-#include <ctime>
 #include <stdexcept>
 
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 
 using namespace std;
 using namespace thc;
 
-char* UCIEngine::getline() {
-    return buffer.getline(1000 /* milliseconds */);
+// How long an engine has to answer uci, or stop
+static const long REPLY_TIMEOUT_MS = 5000;
+
+static long now_ms() {
+    return chrono::duration_cast<chrono::milliseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//
+// Parsing
+//
+
+uint16_t uci_token(string_view move) {
+    if (move.size() < 4 || move.size() > 5) {
+        return 0;
+    }
+
+    unsigned squares[2];
+    for (auto i = 0; i < 2; ++i) {
+        const auto file = move[2 * i];
+        const auto rank = move[2 * i + 1];
+        if (file < 'a' || file > 'h' || rank < '1' || rank > '8') {
+            return 0;
+        }
+        squares[i] = ('8' - rank) * 8 + (file - 'a');
+    }
+
+    unsigned promotion = 0;
+    if (move.size() == 5) {
+        const auto found = string_view{"qrbn"}.find(move[4]);
+        if (found == string_view::npos) {
+            return 0;
+        }
+        promotion = 1 + found;
+    }
+    return static_cast<uint16_t>(squares[0] | squares[1] << 6 | promotion << 12);
+}
+
+size_t uci_text(uint16_t token, char (&text)[6]) {
+    size_t n = 0;
+    for (auto square : {token & 0x3f, token >> 6 & 0x3f}) {
+        text[n++] = static_cast<char>('a' + square % 8);
+        text[n++] = static_cast<char>('8' - square / 8);
+    }
+    if (const auto promotion = token >> 12 & 0xf; promotion >= 1 && promotion <= 4) {
+        text[n++] = "qrbn"[promotion - 1];
+    }
+    text[n] = '\0';
+    return n;
+}
+
+bool uci_parse_info(string_view line, UCIInfo& info) {
+    UCITokens tokens{line};
+    if (tokens.next() != "info") {
+        return false;
+    }
+
+    info = UCIInfo{};
+    auto scored = false;
+    for (auto word = tokens.next(); !word.empty(); word = tokens.next()) {
+        auto ok = true;
+        if (word == "depth") {
+            ok = tokens.next(info.depth);
+        }
+        else if (word == "seldepth") {
+            ok = tokens.next(info.seldepth);
+        }
+        else if (word == "multipv") {
+            ok = tokens.next(info.multipv) && info.multipv > 0;
+        }
+        else if (word == "score") {
+            const auto kind = tokens.next();
+            info.mate = kind == "mate";
+            ok = (info.mate || kind == "cp") && tokens.next(info.score);
+            scored = ok;
+        }
+        else if (word == "lowerbound") {
+            info.bound = UCIInfo::LOWER;
+        }
+        else if (word == "upperbound") {
+            info.bound = UCIInfo::UPPER;
+        }
+        else if (word == "nodes") {
+            ok = tokens.next(info.nodes);
+        }
+        else if (word == "nps") {
+            ok = tokens.next(info.nps);
+        }
+        else if (word == "time") {
+            ok = tokens.next(info.time);
+        }
+        else if (word == "pv") {
+            // The rest of the line, as much as fits
+            for (auto move = tokens.next(); !move.empty(); move = tokens.next()) {
+                const auto token = uci_token(move);
+                if (!token) {
+                    return false;
+                }
+                if (info.pv_length < UCIInfo::MAX_PV) {
+                    info.pv[info.pv_length++] = token;
+                }
+            }
+        }
+        else if (word == "string" || word == "currline" || word == "refutation") {
+            // Free text, or moves that aren't the line
+            break;
+        }
+        // And anything else, e.g., hashfull, currmove, wdl, is skipped a
+        // word at a time
+        if (!ok) {
+            return false;
+        }
+    }
+    return scored;
+}
+
+optional<string_view> UCIEngine::getline(long timeout_ms) {
+    const auto deadline = now_ms() + timeout_ms;
+    for (;;) {
+        if (auto line = buffer.try_getline()) {
+            return line;
+        }
+
+        auto wait = -1L;
+        if (timeout_ms >= 0) {
+            wait = max(0L, deadline - now_ms());
+        }
+
+        // Once the engine's gone, its descriptor is -1 and poll() skips it
+        struct pollfd fds[] = {
+            {buffer.descriptor(), POLLIN, 0},
+            {wakeup,              POLLIN, 0},
+        };
+        const auto rc = poll(fds, 2, static_cast<int>(wait));
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("poll");
+            buffer.close();
+            return nullopt;
+        }
+        if (rc == 0) {
+            return nullopt;
+        }
+        if (fds[1].revents & POLLIN) {
+            uint64_t count;
+            (void)read(wakeup, &count, sizeof count);
+            return nullopt;
+        }
+        if (fds[0].revents && !buffer.fill()) {
+            return nullopt;
+        }
+    }
 }
 
-char* UCIEngine::expect(const char* startswith) {
-    auto line = getline();
-    if (line && strncmp(line, startswith, strlen(startswith)) == 0) {
+optional<string_view> UCIEngine::expect(string_view command, long timeout_ms) {
+    auto line = getline(timeout_ms);
+    if (line && UCITokens{*line}.next() == command) {
         return line;
     }
-    return nullptr;
+    return nullopt;
 }
 
 void UCIEngine::printf(const char* format, ...) {
@@ -35,17 +192,27 @@ void UCIEngine::printf(const char* format, ...) {
 
     va_list args;
     va_start(args, format);
-
-    va_list trace_args;
-    va_copy(trace_args, args);
-    printf("uci_printf: ");
-    vprintf(format, trace_args);
-    va_end(trace_args);
-
     vdprintf(write_fd, format, args);
     va_end(args);
 }
 
+bool UCIEngine::closed() const {
+    return buffer.descriptor() < 0;
+}
+
+void UCIEngine::option(string_view name, string_view value) {
+    auto found = options.find(name);
+    if (found != options.end() && found->second == value) {
+        return;
+    }
+    if (found == options.end()) {
+        found = options.emplace(string{name}, string{}).first;
+    }
+    found->second = value;
+    printf("setoption name %.*s value %.*s\n",
+        int(name.size()), name.data(), int(value.size()), value.data());
+}
+
 unique_ptr<UCIMessage> UCIEngine::read_request() {
     const lock_guard<std::mutex> lock{mutex};
     if (request_queue.empty()) {
@@ -62,8 +229,18 @@ UCIMessage* UCIEngine::peek_request() {
 }
 
 void UCIEngine::send_response(unique_ptr<UCIMessage> response) {
-    const lock_guard<std::mutex> lock{mutex};
-    response_queue.push(std::move(response));
+    {
+        const lock_guard<std::mutex> lock{mutex};
+        response_queue.push(std::move(response));
+    }
+    ready();
+}
+
+void UCIEngine::ready() {
+    const uint64_t one = 1;
+    if (notify >= 0 && write(notify, &one, sizeof one) != sizeof one) {
+        perror("write");
+    }
 }
 
 bool UCIEngine::handle_request(unique_ptr<UCIMessage> request) {
@@ -75,16 +252,16 @@ bool UCIEngine::handle_request(unique_ptr<UCIMessage> request) {
 }
 
 void UCIEngine::engine_thread() {
+    TRACE_THREAD("engine");
+
     for (;;) {
-        unique_ptr<UCIMessage> request;
-        {
-            unique_lock<std::mutex> lock{mutex};
+        auto request = read_request();
+        while (!request) {
+            // Nothing the engine says meanwhile is of any use
+            getline();
             request = read_request();
-            while (!request) {
-                cond.wait(lock);
-                request = read_request();
-            }
         }
+        TRACE_SPAN("uci_exchange");
         if (!handle_request(std::move(request))) {
             break;
         }
@@ -97,38 +274,43 @@ void UCIEngine::engine_thread() {
 }
 
 UCIEngine::~UCIEngine() {
-    if (write_fd >= 0) {
+    if (thread.joinable()) {
         quit();
     }
+    close(wakeup);
 }
 
-UCIEngine::UCIEngine(int read_fd, int write_fd)
+UCIEngine::UCIEngine(int read_fd, int write_fd, unsigned threads, unsigned hash, int notify)
     : buffer{8192, read_fd},
       write_fd{write_fd},
-      thread{&UCIEngine::engine_thread, this}
+      wakeup{eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)},
+      notify{notify},
+      threads{threads},
+      hash{hash}
 {
     assert(read_fd  >= 0);
     assert(write_fd >= 0);
+    if (wakeup < 0) {
+        close(write_fd);
+        throw runtime_error("UCIEngine: eventfd() failed");
+    }
+    thread = std::thread{&UCIEngine::engine_thread, this};
     send(make_unique<UCIMessage>());
 }
 
-unique_ptr<UCIEngine> UCIEngine::execvp(const char* file, char *const argv[]) {
+unique_ptr<UCIEngine> UCIEngine::execvp(
+    const char* file, char *const argv[], unsigned threads, unsigned hash, int notify)
+{
     assert(file && *file);
     assert(argv);
 
-    // Debug out-of-control threads
-    static bool once_only = false;
-    if (once_only) {
-        throw runtime_error("UCIEngine::execvp() called more than once");
-    }
-    once_only = true;
-
     pid_t pid = -1;
 
     int  pipe_fds[] = {-1, -1, -1, -1};
     int *const read_pipe  = pipe_fds + 0;
     int *const write_pipe = pipe_fds + 2;
-    if (pipe(read_pipe) != 0 || pipe(write_pipe) != 0) {
+    // Close-on-exec, so other engines started later don't hold them open
+    if (pipe2(read_pipe, O_CLOEXEC) != 0 || pipe2(write_pipe, O_CLOEXEC) != 0) {
         goto error;
     }
 
@@ -140,7 +322,7 @@ unique_ptr<UCIEngine> UCIEngine::execvp(const char* file, char *const argv[]) {
     if (pid > 0) {
         close(read_pipe[1]);
         close(write_pipe[0]);
-        return make_unique<UCIEngine>(read_pipe[0], write_pipe[1]);
+        return make_unique<UCIEngine>(read_pipe[0], write_pipe[1], threads, hash, notify);
     }
 
     dup2(read_pipe[1], STDOUT_FILENO);
@@ -149,7 +331,8 @@ unique_ptr<UCIEngine> UCIEngine::execvp(const char* file, char *const argv[]) {
         close(pipe_fds[i]);
     }
 
-    execvp(file, argv);
+    // N.B., not this execvp(), which would fork again
+    ::execvp(file, argv);
     _exit(EXIT_FAILURE);
 
 error:
@@ -162,9 +345,15 @@ error:
 }
 
 void UCIEngine::send(unique_ptr<UCIMessage> request) {
-    const lock_guard<std::mutex> lock{mutex};
-    request_queue.push(std::move(request));
-    cond.notify_one();
+    {
+        const lock_guard<std::mutex> lock{mutex};
+        request_queue.push(std::move(request));
+    }
+
+    const uint64_t one = 1;
+    if (write(wakeup, &one, sizeof one) != sizeof one) {
+        perror("write");
+    }
 }
 
 unique_ptr<UCIMessage> UCIEngine::receive() {
@@ -182,19 +371,51 @@ void UCIEngine::quit() {
     thread.join();
 }
 
-bool UCIMessage::handle_exchange(UCIEngine& engine) {
-    engine.printf("uci\n");
-    const auto timeout = time(NULL) + 5;
-    while (time(NULL) < timeout) {
-        if (auto line = engine.expect("uciok")) {
-            goto success;
+// Expect a command within REPLY_TIMEOUT_MS, skipping any other lines
+static bool expect_reply(UCIEngine& engine, string_view command) {
+    const auto deadline = now_ms() + REPLY_TIMEOUT_MS;
+    for (auto remaining = REPLY_TIMEOUT_MS; remaining > 0 && !engine.closed(); remaining = deadline - now_ms()) {
+        if (engine.expect(command, remaining)) {
+            return true;
         }
     }
     return false;
+}
+
+// Stop a search and wait out its bestmove, which would otherwise be taken
+// for the next search's
+static bool stop_search(UCIEngine& engine) {
+    engine.printf("stop\n");
+    return expect_reply(engine, "bestmove");
+}
+
+void UCIEngine::allow(const UCIAllowance& allowance) {
+    if (allowance.threads) {
+        option("Threads", to_string(allowance.threads));
+    }
+    if (allowance.hash) {
+        option("Hash", to_string(allowance.hash));
+    }
+}
+
+bool UCIEngine::new_game(uint64_t identity) {
+    if (identity == game_identity) {
+        return true;
+    }
+    game_identity = identity;
+    printf("ucinewgame\n");
+    printf("isready\n");
+    return expect_reply(*this, "readyok");
+}
+
+bool UCIMessage::handle_exchange(UCIEngine& engine) {
+    engine.printf("uci\n");
+    if (!expect_reply(engine, "uciok")) {
+        return false;
+    }
 
-success:
-    engine.printf("setoption name Threads value 2\n");
-    engine.printf("setoption name Hash value 192\n");
+    engine.option("Threads", to_string(engine.threads));
+    engine.option("Hash", to_string(engine.hash));
     return true;
 }
 
@@ -202,21 +423,53 @@ bool UCIQuitMessage::handle_exchange(UCIEngine& engine) {
     return false;
 }
 
-bool UCIPlayMessage::expect_bestmove(UCIEngine& engine) {
-    engine.printf("setoption MultiPV 1\n");
-    engine.printf("position fen %s\n", game->fen().data());
+UCIPlayMessage::UCIPlayMessage(const Game& game, int elo)
+    : elo{elo},
+      identity{game.identity()},
+      position{game.uci_position()},
+      rules{*game.current()},
+      white{game.WhiteToPlay()},
+      key{game.current()->key()}
+{
+}
 
-    char color = game->WhiteToPlay() ? 'w' : 'b';
-    engine.printf("go %ctime 60000 %cinc 600\n", color, color);
+bool UCIPlayMessage::expect_bestmove(UCIEngine& engine) {
+    engine.option("MultiPV", "1");
+    engine.printf("position %s\n", position.c_str());
+
+    if (allowance.movetime) {
+        engine.printf("go movetime %u\n", allowance.movetime);
+    } else {
+        char color = white ? 'w' : 'b';
+        engine.printf("go %ctime 60000 %cinc 600\n", color, color);
+    }
 
+    info = UCIInfo{};
+    UCIInfo next;
     for (;;) {
         if (engine.peek_request()) {
-            return true;
+            // Wanted for something else, so no move
+            return stop_search(engine);
+        }
+        if (engine.closed()) {
+            return false;
         }
 
-        if (auto line = engine.expect("bestmove ")) {
+        auto line = engine.getline();
+        if (!line) {
+            continue;
+        }
+        if (uci_parse_info(*line, next) && next.bound == UCIInfo::EXACT && next.multipv == 1) {
+            info = next;
+            continue;
+        }
+        UCITokens tokens{*line};
+        if (tokens.next() == "bestmove") {
+            // Whatever it'd ponder, after, is no matter.  Read against the
+            // position asked about, which key is of, whatever the game's
+            // done since
             try {
-                move = game->uci_move(line + 9);
+                move = rules.uci_move(tokens.next());
                 return true;
             }
             catch (const logic_error&) {
@@ -227,16 +480,94 @@ bool UCIPlayMessage::expect_bestmove(UCIEngine& engine) {
 }
 
 bool UCIPlayMessage::handle_exchange(UCIEngine& engine) {
-    engine.printf("setoption name UCI_Elo value %d\n", elo);
-    engine.printf("setoption name UCI_LimitStrength value true\n");
+    if (!engine.new_game(identity)) {
+        return false;
+    }
+    engine.allow(allowance);
+    engine.option("UCI_Elo", to_string(elo));
+    engine.option("UCI_LimitStrength", "true");
     return expect_bestmove(engine);
 }
 
 bool UCIHintMessage::handle_exchange(UCIEngine& engine) {
-    engine.printf("setoption name UCI_LimitStrength value false\n");
+    if (!engine.new_game(identity)) {
+        return false;
+    }
+    engine.allow(allowance);
+    engine.option("UCI_LimitStrength", "false");
     return expect_bestmove(engine);
 }
 
+UCIAnalyseMessage::UCIAnalyseMessage(const Game& game, unsigned multipv, unsigned movetime)
+    : identity{game.identity()},
+      position{game.uci_position()},
+      key{game.current()->key()},
+      multipv{std::clamp<unsigned>(multipv, 1, UCIAnalysis::MAX_LINES)},
+      movetime{movetime}
+{
+}
+
+bool UCIAnalyseMessage::handle_exchange(UCIEngine& engine) {
+    if (!engine.new_game(identity)) {
+        return false;
+    }
+    engine.allow(allowance);
+    engine.option("UCI_LimitStrength", "false");
+    engine.option("MultiPV", to_string(multipv));
+    engine.printf("position %s\n", position.c_str());
+
+    auto movetime = this->movetime;
+    if (allowance.movetime && (!movetime || movetime > allowance.movetime)) {
+        movetime = allowance.movetime;
+    }
+    if (movetime) {
+        engine.printf("go movetime %u\n", movetime);
+    } else {
+        engine.printf("go infinite\n");
+    }
+
+    // Lines as they're found, published whole whenever one's done and not
+    // just bounded, so whoever's asked gets the best so far
+    found = UCIAnalysis{};
+    found.key = key;
+    auto publish = [&] {
+        engine.analysis.back() = found;
+        engine.analysis.publish();
+        engine.ready();
+    };
+
+    UCIInfo info;
+    auto stopped  = false;
+    auto deadline = 0L;
+    for (;;) {
+        if (!stopped && engine.peek_request()) {
+            // Wanted for something else, this search is over
+            engine.printf("stop\n");
+            stopped  = true;
+            deadline = now_ms() + REPLY_TIMEOUT_MS;
+        }
+        const auto timeout = stopped ? deadline - now_ms() : -1L;
+        if ((stopped && timeout <= 0) || engine.closed()) {
+            return false;
+        }
+
+        auto line = engine.getline(timeout);
+        if (!line) {
+            continue;
+        }
+        if (UCITokens{*line}.next() == "bestmove") {
+            found.done = true;
+            publish();
+            return true;
+        }
+        if (uci_parse_info(*line, info) && info.bound == UCIInfo::EXACT && info.multipv <= multipv) {
+            found.line[info.multipv - 1] = info;
+            found.lines = max<size_t>(found.lines, info.multipv);
+            publish();
+        }
+    }
+}
+
 // This file is part of the Raccoon's Centaur Mods (RCM).
 //
 // RCM is free software: you can redistribute it and/or modify
@@ -7,43 +7,174 @@
 
 #include "../thc/thc.h"
 #include "../utility/buffer.h"
+#include "../utility/triplebuffer.h"
 
-#include <condition_variable>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <string>
+#include <string_view>
 #include <thread>
 
 class Game;
 class UCIMessage;
 
+// One line of analysis, as an engine's info reports it.  Fixed size, so
+// reading one allocates nothing
+struct UCIInfo {
+    static constexpr std::size_t MAX_PV = 16;
+
+    enum Bound : std::uint8_t { EXACT, LOWER, UPPER };
+
+    unsigned      depth{0};
+    unsigned      seldepth{0};
+    unsigned      multipv{1};
+    bool          mate{false};   // Score is moves to mate, not centipawns
+    int           score{0};      // From the side to move, negative if losing
+    Bound         bound{EXACT};
+    std::uint64_t nodes{0};
+    std::uint64_t nps{0};
+    unsigned      time{0};       // Milliseconds
+    std::uint8_t  pv_length{0};
+    std::uint16_t pv[MAX_PV]{};  // Moves as archive::encode() has them
+};
+
+// The fields of a line from an engine, separated by spaces or tabs, one at a
+// time, as views of the line, so nothing's copied
+class UCITokens {
+public:
+    explicit UCITokens(std::string_view line) : line{line} {}
+
+    // Next field, consuming it, empty at the end
+    std::string_view next() {
+        const auto start = line.find_first_not_of(" \t\r");
+        if (start == std::string_view::npos) {
+            line = {};
+            return {};
+        }
+        line.remove_prefix(start);
+        const auto field = line.substr(0, line.find_first_of(" \t\r"));
+        line.remove_prefix(field.size());
+        return field;
+    }
+
+    // Next field as a number, false if it isn't one
+    template <typename T>
+    bool next(T& value) {
+        const auto field = next();
+        const auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+        return !field.empty() && ec == std::errc{} && end == field.data() + field.size();
+    }
+
+    // What's left, e.g., the free text after info string
+    std::string_view rest() const { return line; }
+
+private:
+    std::string_view line;
+};
+
+// Fill in info from an info line, false if it isn't one with a score, like
+// info string or info currmove
+bool uci_parse_info(std::string_view line, UCIInfo& info);
+
+// The move a UCI engine writes, e.g., e7e8q, as archive::encode() has it, 0
+// if it isn't one
+std::uint16_t uci_token(std::string_view move);
+
+// And back, into text of 4 or 5 characters and a terminating nul, returning
+// its length
+std::size_t uci_text(std::uint16_t token, char (&text)[6]);
+
+// The best lines found so far of one position, by multipv
+struct UCIAnalysis {
+    static constexpr std::size_t MAX_LINES = 4;
+
+    thc::zobrist::Key key{0};  // Of the position analysed
+    std::size_t       lines{0};
+    UCIInfo           line[MAX_LINES];
+    bool              done{false};  // Search over, nothing more to come
+};
+
+// What a search may spend.  Zero for threads or hash leaves them as they
+// are, and for movetime leaves it to the engine's own time management
+struct UCIAllowance {
+    unsigned threads{0};
+    unsigned hash{0};      // MB
+    unsigned movetime{0};  // Milliseconds
+};
+
 class UCIEngine {
-    std::mutex              mutex;  // Lock request and response queues
-    std::condition_variable cond;   // Signal new request
-    std::thread             thread;
+    std::mutex mutex;  // Lock request and response queues
     std::queue<std::unique_ptr<UCIMessage>> request_queue;
     std::queue<std::unique_ptr<UCIMessage>> response_queue;
     Buffer buffer;
     int    write_fd;
+    int    wakeup;  // eventfd, readable when a request is queued
+    int    notify;  // Whoever's, written when there's a response or analysis, -1 for none
+
+    // What the engine's been told, so it's told only what's changed.  The
+    // engine's thread's own
+    std::uint64_t game_identity{0};
+    std::map<std::string, std::string, std::less<>> options;
 
 public:
-    char* expect(const char* startswith);
-    char* getline();
+    // Written by analyses, on the engine's thread, for whoever asked
+    TripleBuffer<UCIAnalysis> analysis;
+
+    // Engine options, as it was started with
+    const unsigned threads;
+    const unsigned hash;  // MB
+
+private:
+    std::thread thread;  // Started once all the above is ready
+
+public:
+    // Next line from the engine, waiting no longer than timeout_ms, or -1
+    // for as long as it takes, good until the next.  None if none came in
+    // time, if a request came, see peek_request(), or if the engine's gone,
+    // see closed()
+    std::optional<std::string_view> getline(long timeout_ms = -1);
+
+    // Ditto, if its first field is command, else none
+    std::optional<std::string_view> expect(std::string_view command, long timeout_ms = -1);
+
     void  printf(const char* format, ...);
+    bool  closed() const;
+
+    // Set an option, unless it's set already
+    void option(std::string_view name, std::string_view value);
+
+    // Set Threads and Hash as allowed
+    void allow(const UCIAllowance& allowance);
+
+    // Start a new game, unless it's the game the engine's playing already,
+    // so it keeps what it's found of this one.  False if the engine isn't
+    // ready for it
+    bool new_game(std::uint64_t identity);
 
     std::unique_ptr<UCIMessage> read_request();
     UCIMessage* peek_request();
     void send_response(std::unique_ptr<UCIMessage> response);
+
+    // Wake whoever's waiting on notify, as there's something for them
+    void ready();
     bool handle_request(std::unique_ptr<UCIMessage> request);
 
     void engine_thread();
 
 public:
-    static std::unique_ptr<UCIEngine> execvp(const char* file, char *const argv[]);
+    // Notify, if any, is an eventfd for whoever takes responses to wait on
+    static std::unique_ptr<UCIEngine> execvp(
+        const char* file, char *const argv[], unsigned threads = 2, unsigned hash = 192, int notify = -1);
 
     ~UCIEngine();
-    UCIEngine(int read_fd, int write_fd);
+    UCIEngine(int read_fd, int write_fd, unsigned threads = 2, unsigned hash = 192, int notify = -1);
 
     void send(std::unique_ptr<UCIMessage> request);
     std::unique_ptr<UCIMessage> receive();
@@ -62,13 +193,22 @@ public:
     bool handle_exchange(UCIEngine& engine) override;
 };
 
+// The computer's move, or a hint, in the game as it is.  What's needed of
+// the game is copied, as it goes on, or is replaced by a new one, while the
+// engine thinks
 class UCIPlayMessage : public UCIMessage {
 public:
-    const Game* game;
-    int         elo;
+    int               elo;
+    std::uint64_t     identity;  // Of the game
+    std::string       position;  // Its history, for the engine
+    thc::ChessRules   rules;     // Asked about, a copy, as the game goes on
+    bool              white;     // To play
+    thc::zobrist::Key key;       // Of the position asked about
+    UCIAllowance      allowance;
+    UCIInfo           info;      // The last line found, what move is best by
     std::optional<thc::Move> move;
 
-    UCIPlayMessage(const Game* game, int elo) : game{game}, elo{elo} {}
+    UCIPlayMessage(const Game& game, int elo);
     bool handle_exchange(UCIEngine& engine) override;
 
 protected:
@@ -77,6 +217,24 @@ protected:
 
 class UCIHintMessage : public UCIPlayMessage {
 public:
+    using UCIPlayMessage::UCIPlayMessage;
+    bool handle_exchange(UCIEngine& engine) override;
+};
+
+// Analyse a position at full strength, publishing what's found to the
+// engine's analysis as it improves, until movetime is up (0 to go on
+// without limit) or there's another request
+class UCIAnalyseMessage : public UCIMessage {
+public:
+    std::uint64_t     identity;  // Of the game
+    std::string       position;  // Its history, a copy, as the game goes on without us
+    thc::zobrist::Key key;
+    unsigned          multipv;
+    unsigned          movetime;  // Milliseconds
+    UCIAllowance      allowance;  // Its movetime, if any, as movetime's limit
+    UCIAnalysis       found;      // As last published
+
+    UCIAnalyseMessage(const Game& game, unsigned multipv, unsigned movetime);
     bool handle_exchange(UCIEngine& engine) override;
 };
 
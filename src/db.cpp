@@ -4,13 +4,25 @@
 #include "db.h"
 #include "cfg.h"
 #include "chess/chess.h"
+#include "utility/latency.h"
+#include "utility/trace.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <numeric>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
@@ -25,148 +37,1440 @@ static auto SCHEMA =
     "  white    TEXT,"
     "  black    TEXT,"
     "  result   TEXT,"
-    "  pgn      TEXT,"  // Full game, including variations
-    "  fen      TEXT,"  // Identifies current position
-    "  settings TEXT"   // JSON string describing game settings
-    ");";
+    "  pgn      TEXT,"  // Full game, including variations, as of the log
+    "  fen      TEXT,"  // Identifies current position, ditto
+    "  settings TEXT,"  // JSON string describing game settings
+    "  snapshot BLOB"   // Game::snapshot(), ditto, null for imports
+    ");"
+    // For listing and filtering, newest first within each key
+    "CREATE INDEX IF NOT EXISTS games_date   ON games (date);"
+    "CREATE INDEX IF NOT EXISTS games_white  ON games (white);"
+    "CREATE INDEX IF NOT EXISTS games_black  ON games (black);"
+    "CREATE INDEX IF NOT EXISTS games_result ON games (result);"
+    // Games played on the board, to be reviewed, however many are imported
+    "CREATE INDEX IF NOT EXISTS games_played ON games (result) WHERE snapshot IS NOT NULL;"
+    // What's been done to each game since its PGN was written, appended
+    // as it happens, see MoveLogRow
+    "CREATE TABLE IF NOT EXISTS moves ("
+    "  game   INTEGER NOT NULL,"  // Its rowid
+    "  node   INTEGER NOT NULL,"
+    "  parent INTEGER NOT NULL,"
+    "  move   INTEGER NOT NULL,"  // See Game::LogEntry
+    "  clock  INTEGER,"           // Unix time
+    "  PRIMARY KEY (game, node)"
+    ") WITHOUT ROWID;"
+    // Each position along each game's main line, for the explorer, see
+    // PositionRow.  Looked up by key, and replaced by game from a ply on
+    "CREATE TABLE IF NOT EXISTS positions ("
+    "  key    INTEGER NOT NULL,"  // Zobrist
+    "  game   INTEGER NOT NULL,"  // Its rowid
+    "  ply    INTEGER NOT NULL,"
+    "  move   INTEGER,"           // Played from it, null at the end
+    "  PRIMARY KEY (key, game, ply)"
+    ") WITHOUT ROWID;"
+    "CREATE INDEX IF NOT EXISTS positions_game ON positions (game, ply);"
+    // Each game's tags, as words to search (FTS5), rows numbered as games
+    "CREATE VIRTUAL TABLE IF NOT EXISTS search USING fts5("
+    "  event, site, date, round, white, black, result,"
+    "  tags,"  // Values of any others
+    "  tokenize = 'unicode61 remove_diacritics 2'"
+    ");"
+    // What the engine found best in positions, so it needn't search again,
+    // see Evaluation
+    "CREATE TABLE IF NOT EXISTS evaluations ("
+    "  key      INTEGER NOT NULL,"  // Zobrist
+    "  strength INTEGER NOT NULL,"  // UCI_Elo, 0 for full strength
+    "  move     INTEGER NOT NULL,"  // As archive::encode()
+    "  score    INTEGER NOT NULL,"  // Centipawns, or moves to mate
+    "  mate     INTEGER NOT NULL,"
+    "  depth    INTEGER NOT NULL,"
+    "  pv       BLOB,"              // Moves as move is, 2 bytes each, little-endian
+    "  PRIMARY KEY (key, strength)"
+    ") WITHOUT ROWID;"
+    // What review found of each ply of games' main lines, see ReviewRow.
+    // A game's reviewed to the end once it has a row with no move
+    "CREATE TABLE IF NOT EXISTS reviews ("
+    "  game  INTEGER NOT NULL,"  // Its rowid
+    "  ply   INTEGER NOT NULL,"
+    "  key   INTEGER NOT NULL,"  // Zobrist
+    "  move  INTEGER,"           // Played, as archive::encode(), null at the end
+    "  best  INTEGER,"           // What the engine would, ditto, null for none
+    "  score INTEGER NOT NULL,"  // Centipawns, or moves to mate, for the side to move
+    "  mate  INTEGER NOT NULL,"
+    "  depth INTEGER NOT NULL,"
+    "  loss  INTEGER NOT NULL,"  // Centipawns the move cost
+    "  flag  INTEGER NOT NULL,"  // ReviewRow::Flag
+    "  PRIMARY KEY (game, ply)"
+    ") WITHOUT ROWID;";
+
+// Tuning for an SD card: WAL appends instead of rewriting pages, and only
+// checkpoints need sync, so a crash loses at most the last transactions but
+// never corrupts.  Reads come from the page cache, or mapped, not read
+static auto PRAGMAS =
+    "PRAGMA journal_mode = WAL;"
+    "PRAGMA synchronous  = NORMAL;"
+    "PRAGMA cache_size   = -2048;"          // KiB
+    "PRAGMA mmap_size    = 67108864;";      // Bytes
+
+static auto INSERT_GAME =
+    "INSERT INTO games"
+    "  (event, site, date, round, white, black, result, pgn, fen, settings)"
+    " VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+
+static auto INSERT_SEARCH =
+    "INSERT INTO search"
+    "  (rowid, event, site, date, round, white, black, result, tags)"
+    " VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?)";
+
+static auto INSERT_POSITION =
+    "INSERT OR REPLACE INTO positions (key, game, ply, move) VALUES(?, ?, ?, ?)";
+
+static auto INSERT_EVALUATION =
+    "INSERT INTO evaluations (key, strength, move, score, mate, depth, pv)"
+    " VALUES(?, ?, ?, ?, ?, ?, ?)"
+    " ON CONFLICT (key, strength) DO UPDATE SET"
+    "  move = excluded.move, score = excluded.score, mate = excluded.mate,"
+    "  depth = excluded.depth, pv = excluded.pv"
+    " WHERE excluded.depth >= evaluations.depth";
+
+static auto INSERT_REVIEW =
+    "INSERT OR REPLACE INTO reviews"
+    "  (game, ply, key, move, best, score, mate, depth, loss, flag)"
+    " VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+
+// Log entries a game's PGN is written after, instead of appending more
+static constexpr size_t COMPACT_LOG = 256;
+
+// How long the writer waits for a burst of saves to finish, e.g., a
+// takeback and the move replacing it, to write them as one
+static const auto WRITE_BEHIND = chrono::milliseconds(250);
 
 Database::~Database() {
+    {
+        lock_guard<mutex> lock(write_mutex);
+        write_stop = true;
+    }
+    write_cond.notify_one();
+    writer.join();
+
+    for (auto stmt : stmts) {
+        sqlite3_finalize(stmt);
+    }
+    for (auto stmt : list_stmts) {
+        sqlite3_finalize(stmt);
+    }
+    for (auto stmt : explore_stmts) {
+        sqlite3_finalize(stmt);
+    }
+    sqlite3_finalize(search_stmt);
+    sqlite3_finalize(review_stmt);
+    if (list_db) {
+        sqlite3_close(list_db);
+    }
+    sqlite3_close(write_db);
     sqlite3_close(db);
 }
 
-Database::Database() {
+static sqlite3* open_database() {
     char* path = nullptr;
     asprintf(&path, "%s/rcm.db", cfg_data_dir());
-    if (sqlite3_open(path, &db) != SQLITE_OK) {
+    sqlite3* db = nullptr;
+    const auto rc = sqlite3_open(path, &db);
+    free(path);
+    if (rc != SQLITE_OK) {
+        sqlite3_close(db);
         throw runtime_error("Failed to open database");
     }
+    sqlite3_exec(db, PRAGMAS, nullptr, nullptr, nullptr);
     sqlite3_exec(db, SCHEMA, nullptr, nullptr, nullptr);
+
+    // Columns added since, which fail harmlessly once they're there
+    sqlite3_exec(db, "ALTER TABLE games ADD COLUMN snapshot BLOB", nullptr, nullptr, nullptr);
+
+    // Connections share the file, and the one writer, with other threads
+    sqlite3_busy_timeout(db, 5000);
+    return db;
 }
 
-int Database::insert_game(Game& game) {
-    auto sql =
-        "INSERT INTO games"
-        "  (event, site, date, round, white, black, result, pgn, fen, settings)"
-        " VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+Database::Database() {
+    db       = open_database();
+    write_db = open_database();
+
     sqlite3_stmt* stmt = nullptr;
-    auto rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
-        return 1;
+    if (sqlite3_prepare_v2(db, "SELECT MAX(rowid) FROM games", -1, &stmt, nullptr) == SQLITE_OK) {
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            last_rowid = sqlite3_column_int64(stmt, 0);
+        }
+        sqlite3_finalize(stmt);
     }
 
-    sqlite3_bind_text(stmt,  1, game.tag("Event").data(),  -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt,  2, game.tag("Site").data(),   -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt,  3, game.tag("Date").data(),   -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt,  4, game.tag("Round").data(),  -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt,  5, game.tag("White").data(),  -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt,  6, game.tag("Black").data(),  -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt,  7, game.tag("Result").data(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt,  8, game.pgn().data(),         -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt,  9, game.fen().data(),         -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 10, game.settings.data(),      -1, SQLITE_STATIC);
+    // Games saved before they were searchable, by their Seven Tag Roster
+    sqlite3_exec(db,
+        "INSERT INTO search (rowid, event, site, date, round, white, black, result)"
+        " SELECT rowid, event, site, date, round, white, black, result FROM games"
+        " WHERE rowid > (SELECT IFNULL(MAX(rowid), 0) FROM search)",
+        nullptr, nullptr, nullptr);
 
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+    index_saved_games();
+
+    writer = thread(&Database::write_behind, this);
+}
+
+// Statement prepared on first use and kept, null if it can't be.  Kept
+// statements go back to the cache, reset, as their Statement goes out of
+// scope
+static sqlite3_stmt* prepare(sqlite3* conn, sqlite3_stmt*& stmt, const char* sql) {
+    if (!stmt && sqlite3_prepare_v3(
+            conn, sql, -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr) != SQLITE_OK)
+    {
+        sqlite3_finalize(stmt);
+        stmt = nullptr;
+    }
+    return stmt;
+}
+
+namespace {
+
+// Use of a kept statement, which it resets and unbinds when done
+struct Statement {
+    sqlite3_stmt* stmt;
+
+    explicit Statement(sqlite3_stmt* stmt) : stmt{stmt} {}
+    Statement(const Statement&) = delete;
+    Statement& operator=(const Statement&) = delete;
+    ~Statement() {
+        if (stmt) {
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+        }
+    }
+
+    operator sqlite3_stmt*() const { return stmt; }
+};
+
+}
+
+// Seven Tag Roster, PGN, FEN, settings and snapshot as parameters 1 to 11
+static void bind_record(sqlite3_stmt* stmt, const GameRecord& record) {
+    for (auto i = 0; i < 7; ++i) {
+        sqlite3_bind_text(stmt, i + 1, record.str[i].data(), -1, SQLITE_STATIC);
+    }
+    sqlite3_bind_text(stmt,  8, record.pgn.data(),      -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt,  9, record.fen.data(),      -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 10, record.settings.data(), -1, SQLITE_STATIC);
+    sqlite3_bind_blob(stmt, 11, record.snapshot.data(),
+        static_cast<int>(record.snapshot.size()), SQLITE_STATIC);
+}
 
-    game.rowid = sqlite3_last_insert_rowid(db);
-    return rc != SQLITE_DONE;
+// Where the game's row is, if it's been moved
+sqlite3_int64 Database::row_of(sqlite3_int64 rowid) const {
+    const auto found = moved.find(rowid);
+    return found != moved.end() ? found->second : rowid;
 }
 
-int Database::update_game(Game& game) {
+// A new game goes in as the row it was numbered, unless another connection
+// has taken that one since, when it goes in as a new row and is written
+// there from then on
+bool Database::insert_game(const GameRecord& record) {
+    auto sql =
+        "INSERT INTO games"
+        "  (event, site, date, round, white, black, result, pgn, fen, settings,"
+        "   snapshot, rowid)"
+        " VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+    Statement stmt{prepare(write_db, stmts[INSERT], sql)};
+    if (!stmt) {
+        return false;
+    }
+
+    bind_record(stmt, record);
+    sqlite3_bind_int64(stmt, 12, record.rowid);
+    auto rc = sqlite3_step(stmt);
+    if (rc == SQLITE_CONSTRAINT) {
+        sqlite3_reset(stmt);
+        sqlite3_bind_null(stmt, 12);
+        rc = sqlite3_step(stmt);
+        if (rc == SQLITE_DONE) {
+            const auto rowid = sqlite3_last_insert_rowid(write_db);
+            moved[record.rowid] = rowid;
+
+            // And new games are numbered after it
+            auto last = last_rowid.load();
+            while (last < rowid && !last_rowid.compare_exchange_weak(last, rowid)) {
+            }
+        }
+    }
+    return rc == SQLITE_DONE;
+}
+
+bool Database::update_game(const GameRecord& record) {
     auto sql =
         "UPDATE games SET"
         "  event = ?, site  = ?, date     = ?, round = ?,"
         "  white = ?, black = ?, result   = ?,"
-        "  pgn   = ?, fen   = ?, settings = ?"
+        "  pgn   = ?, fen   = ?, settings = ?, snapshot = ?"
         " WHERE rowid = ?";
-    sqlite3_stmt* stmt = nullptr;
-    auto rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
-        return 1;
-    }
-
-    sqlite3_bind_text( stmt,  1, game.tag("Event").data(),  -1, SQLITE_STATIC);
-    sqlite3_bind_text( stmt,  2, game.tag("Site").data(),   -1, SQLITE_STATIC);
-    sqlite3_bind_text( stmt,  3, game.tag("Date").data(),   -1, SQLITE_STATIC);
-    sqlite3_bind_text( stmt,  4, game.tag("Round").data(),  -1, SQLITE_STATIC);
-    sqlite3_bind_text( stmt,  5, game.tag("White").data(),  -1, SQLITE_STATIC);
-    sqlite3_bind_text( stmt,  6, game.tag("Black").data(),  -1, SQLITE_STATIC);
-    sqlite3_bind_text( stmt,  7, game.tag("Result").data(), -1, SQLITE_STATIC);
-    sqlite3_bind_text( stmt,  8, game.pgn().data(),         -1, SQLITE_STATIC);
-    sqlite3_bind_text( stmt,  9, game.fen().data(),         -1, SQLITE_STATIC);
-    sqlite3_bind_text( stmt, 10, game.settings.data(),      -1, SQLITE_STATIC);
-    sqlite3_bind_int64(stmt, 11, game.rowid);
-
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    return rc != SQLITE_DONE;
+    Statement stmt{prepare(write_db, stmts[UPDATE], sql)};
+    if (!stmt) {
+        return false;
+    }
+
+    bind_record(stmt, record);
+    sqlite3_bind_int64(stmt, 12, row_of(record.rowid));
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        return false;
+    }
+
+    // Gone, or never written because its insert failed
+    return sqlite3_changes(write_db) > 0 || insert_game(record);
 }
 
-int Database::save_game(Game& game) {
-    return game.rowid ? update_game(game) : insert_game(game);
+// Just the tags and settings, leaving the PGN and FEN where they are
+bool Database::update_tags(const GameRecord& record) {
+    auto sql =
+        "UPDATE games SET"
+        "  event = ?, site  = ?, date     = ?, round = ?,"
+        "  white = ?, black = ?, result   = ?, settings = ?"
+        " WHERE rowid = ?";
+    Statement stmt{prepare(write_db, stmts[UPDATE_TAGS], sql)};
+    if (!stmt) {
+        return false;
+    }
+
+    for (auto i = 0; i < 7; ++i) {
+        sqlite3_bind_text(stmt, i + 1, record.str[i].data(), -1, SQLITE_STATIC);
+    }
+    sqlite3_bind_text(stmt, 8, record.settings.data(), -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 9, row_of(record.rowid));
+    return sqlite3_step(stmt) == SQLITE_DONE;
 }
 
-unique_ptr<Game> Database::load_game(sqlite3_int64 rowid) {
-    assert(rowid > 0);
+// Written with the PGN, the log so far is the PGN's
+bool Database::clear_log(sqlite3_int64 rowid) {
+    Statement stmt{prepare(write_db, stmts[CLEAR_LOG], "DELETE FROM moves WHERE game = ?")};
+    if (!stmt) {
+        return false;
+    }
 
-    auto sql = "SELECT pgn, fen, settings FROM games WHERE rowid = ?";
-    sqlite3_stmt* stmt = nullptr;
-    auto rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
-        return nullptr;
+    sqlite3_bind_int64(stmt, 1, row_of(rowid));
+    return sqlite3_step(stmt) == SQLITE_DONE;
+}
+
+bool Database::append_log(sqlite3_int64 rowid, const MoveLogRow& row) {
+    auto sql = "INSERT INTO moves (game, node, parent, move, clock) VALUES(?, ?, ?, ?, ?)";
+    Statement stmt{prepare(write_db, stmts[APPEND_LOG], sql)};
+    if (!stmt) {
+        return false;
     }
 
+    sqlite3_bind_int64(stmt, 1, row_of(rowid));
+    sqlite3_bind_int64(stmt, 2, row.node);
+    sqlite3_bind_int64(stmt, 3, row.parent);
+    sqlite3_bind_int(  stmt, 4, row.move);
+    sqlite3_bind_int64(stmt, 5, row.clock);
+    return sqlite3_step(stmt) == SQLITE_DONE;
+}
+
+// Game's key and ply, then the move, as parameters 1 to 4
+static void bind_position(sqlite3_stmt* stmt, sqlite3_int64 rowid, const PositionRow& row) {
+    sqlite3_bind_int64(stmt, 1, row.key);
+    sqlite3_bind_int64(stmt, 2, rowid);
+    sqlite3_bind_int64(stmt, 3, row.ply);
+    if (row.move) {
+        sqlite3_bind_int(stmt, 4, row.move);
+    } else {
+        sqlite3_bind_null(stmt, 4);
+    }
+}
+
+// The game's positions from where they changed on, replacing those there
+bool Database::index_positions(const GameRecord& record) {
+    const auto rowid = row_of(record.rowid);
+    {
+        auto sql = "DELETE FROM positions WHERE game = ? AND ply >= ?";
+        Statement stmt{prepare(write_db, stmts[CLEAR_POSITIONS], sql)};
+        if (!stmt) {
+            return false;
+        }
+
+        sqlite3_bind_int64(stmt, 1, rowid);
+        sqlite3_bind_int64(stmt, 2, record.positions_from);
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            return false;
+        }
+    }
+
+    Statement stmt{prepare(write_db, stmts[INDEX_POSITION], INSERT_POSITION)};
+    if (!stmt) {
+        return false;
+    }
+    for (const auto& row : record.positions) {
+        bind_position(stmt, rowid, row);
+        const auto rc = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        if (rc != SQLITE_DONE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Seven Tag Roster and the others as parameters 2 to 9, after the rowid
+static void bind_tags(sqlite3_stmt* stmt, sqlite3_int64 rowid, const string (&str)[7], const string& tags) {
     sqlite3_bind_int64(stmt, 1, rowid);
-    rc = sqlite3_step(stmt);
+    for (auto i = 0; i < 7; ++i) {
+        sqlite3_bind_text(stmt, i + 2, str[i].data(), -1, SQLITE_STATIC);
+    }
+    sqlite3_bind_text(stmt, 9, tags.data(), -1, SQLITE_STATIC);
+}
 
-    if (rc != SQLITE_ROW) {
-        sqlite3_finalize(stmt);
-        return nullptr;
+// The game's tags as they're searched, replacing what they were
+bool Database::index_tags(const GameRecord& record) {
+    const auto rowid = row_of(record.rowid);
+    {
+        Statement stmt{prepare(write_db, stmts[CLEAR_SEARCH], "DELETE FROM search WHERE rowid = ?")};
+        if (!stmt) {
+            return false;
+        }
+
+        sqlite3_bind_int64(stmt, 1, rowid);
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            return false;
+        }
+    }
+
+    Statement stmt{prepare(write_db, stmts[INDEX_SEARCH], INSERT_SEARCH)};
+    if (!stmt) {
+        return false;
+    }
+
+    bind_tags(stmt, rowid, record.str, record.tags);
+    return sqlite3_step(stmt) == SQLITE_DONE;
+}
+
+// Whole, then anything logged since, or just what's changed
+bool Database::write_game(const GameRecord& record) {
+    if (record.full) {
+        const auto ok = record.fresh ? insert_game(record) : update_game(record);
+        if (!ok || !clear_log(record.rowid)) {
+            return false;
+        }
+    }
+    else if (record.tagged && !update_tags(record)) {
+        return false;
+    }
+    if (record.tagged && !index_tags(record)) {
+        return false;
     }
+    for (const auto& row : record.moves) {
+        if (!append_log(record.rowid, row)) {
+            return false;
+        }
+    }
+    return record.positions_from < 0 || index_positions(record);
+}
+
+bool Database::write_evaluation(const Evaluation& evaluation) {
+    Statement stmt{prepare(write_db, stmts[REMEMBER], INSERT_EVALUATION)};
+    if (!stmt) {
+        return false;
+    }
+
+    const auto& info = evaluation.info;
+    unsigned char pv[2 * UCIInfo::MAX_PV];
+    for (size_t i = 0; i < info.pv_length; ++i) {
+        pv[2 * i]     = info.pv[i] & 0xff;
+        pv[2 * i + 1] = info.pv[i] >> 8;
+    }
+    sqlite3_bind_int64(stmt, 1, static_cast<sqlite3_int64>(evaluation.key));
+    sqlite3_bind_int(stmt, 2, evaluation.strength);
+    sqlite3_bind_int(stmt, 3, evaluation.move);
+    sqlite3_bind_int(stmt, 4, info.score);
+    sqlite3_bind_int(stmt, 5, info.mate);
+    sqlite3_bind_int(stmt, 6, static_cast<int>(info.depth));
+    sqlite3_bind_blob(stmt, 7, pv, 2 * info.pv_length, SQLITE_STATIC);
+    return sqlite3_step(stmt) == SQLITE_DONE;
+}
+
+bool Database::write_review(const ReviewRow& row) {
+    Statement stmt{prepare(write_db, stmts[REVIEW], INSERT_REVIEW)};
+    if (!stmt) {
+        return false;
+    }
+
+    const auto bind_move = [&](int i, uint16_t move) {
+        if (move) {
+            sqlite3_bind_int(stmt, i, move);
+        } else {
+            sqlite3_bind_null(stmt, i);
+        }
+    };
+    sqlite3_bind_int64(stmt, 1, row.game);
+    sqlite3_bind_int64(stmt, 2, row.ply);
+    sqlite3_bind_int64(stmt, 3, row.key);
+    bind_move(4, row.move);
+    bind_move(5, row.best);
+    sqlite3_bind_int(stmt, 6, row.score);
+    sqlite3_bind_int(stmt, 7, row.mate);
+    sqlite3_bind_int(stmt, 8, static_cast<int>(row.depth));
+    sqlite3_bind_int(stmt, 9, row.loss);
+    sqlite3_bind_int(stmt, 10, row.flag);
+    return sqlite3_step(stmt) == SQLITE_DONE;
+}
+
+// Every record, evaluation and review row in one transaction, or none of
+// them
+bool Database::write_games(
+    const vector<GameRecord>& records,
+    const vector<Evaluation>& evaluations,
+    const vector<ReviewRow>&  reviews)
+{
+    TRACE_SPAN("write_games");
+
+    if (sqlite3_exec(write_db, "BEGIN", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        return false;
+    }
+    for (const auto& record : records) {
+        if (!write_game(record)) {
+            sqlite3_exec(write_db, "ROLLBACK", nullptr, nullptr, nullptr);
+            return false;
+        }
+    }
+    for (const auto& evaluation : evaluations) {
+        if (!write_evaluation(evaluation)) {
+            sqlite3_exec(write_db, "ROLLBACK", nullptr, nullptr, nullptr);
+            return false;
+        }
+    }
+    for (const auto& row : reviews) {
+        if (!write_review(row)) {
+            sqlite3_exec(write_db, "ROLLBACK", nullptr, nullptr, nullptr);
+            return false;
+        }
+    }
+    return sqlite3_exec(write_db, "COMMIT", nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+// The newer of two saves of a game, after the older, as one
+static void merge(GameRecord& older, GameRecord&& newer) {
+    if (newer.full) {
+        // Still to be inserted, if it was
+        newer.fresh = newer.fresh || older.fresh;
+        older = std::move(newer);
+        return;
+    }
+
+    older.moves.insert(older.moves.end(), newer.moves.begin(), newer.moves.end());
+    if (newer.positions_from >= 0) {
+        // The older's positions up to where the newer's start
+        auto& rows = older.positions;
+        rows.erase(remove_if(rows.begin(), rows.end(), [&](const PositionRow& row) {
+            return row.ply >= newer.positions_from;
+        }), rows.end());
+        rows.insert(rows.end(), newer.positions.begin(), newer.positions.end());
+        older.positions_from = older.positions_from < 0 ?
+            newer.positions_from : min(older.positions_from, newer.positions_from);
+    }
+    if (newer.tagged) {
+        for (auto i = 0; i < 7; ++i) {
+            older.str[i] = std::move(newer.str[i]);
+        }
+        older.tags     = std::move(newer.tags);
+        older.settings = std::move(newer.settings);
+        older.tagged   = true;
+    }
+}
+
+// Queue a record, after any older one of the same game.  Caller holds
+// write_mutex
+void Database::enqueue(GameRecord&& record) {
+    auto queued_record = find_if(queued.begin(), queued.end(), [&](const GameRecord& r) {
+        return r.rowid == record.rowid;
+    });
+    if (queued_record == queued.end()) {
+        queued.push_back(std::move(record));
+    } else {
+        merge(*queued_record, std::move(record));
+    }
+    retrying = false;
+}
+
+// The writer's thread: whatever's been saved, each game as last saved, once
+// any burst of saves is over.  What fails to be written is tried again with
+// the next burst, or a flush, unless there's none coming, and only the first
+// of a run of failures is logged (a full card fails every time)
+void Database::write_behind() {
+    TRACE_THREAD("db_writer");
+
+    vector<GameRecord> records;
+    vector<Evaluation> evaluations;
+    vector<ReviewRow>  reviews;
+    auto               failing = false;
+    unique_lock<mutex> lock(write_mutex);
+    for (;;) {
+        write_cond.wait(lock, [this] { return write_stop || (!idle() && (!retrying || write_now)); });
+        if (idle()) {
+            break;
+        }
+        write_cond.wait_for(lock, WRITE_BEHIND, [this] { return write_stop || write_now; });
 
-    auto pgn = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
-    auto fen = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+        records.swap(queued);
+        evaluations.swap(remembered);
+        reviews.swap(reviewed);
+        writing = true;
+        lock.unlock();
+
+        const auto ok = write_games(records, evaluations, reviews);
+        if (!ok && !failing) {
+            cerr << "save_game: " << sqlite3_errmsg(write_db) << endl;
+        }
+        failing = !ok;
+
+        lock.lock();
+        failures += !ok;
+        const auto saved_since = !idle();
+        if (!ok && !write_stop) {
+            // Ahead of anything saved since
+            for (auto& record : records) {
+                auto queued_record = find_if(queued.begin(), queued.end(), [&](const GameRecord& r) {
+                    return r.rowid == record.rowid;
+                });
+                if (queued_record == queued.end()) {
+                    queued.push_back(std::move(record));
+                } else {
+                    merge(record, std::move(*queued_record));
+                    *queued_record = std::move(record);
+                }
+            }
+            remembered.insert(remembered.begin(), evaluations.begin(), evaluations.end());
+            reviewed.insert(reviewed.begin(), reviews.begin(), reviews.end());
+        }
+        retrying = !ok && !write_stop && !saved_since;
+        records.clear();
+        evaluations.clear();
+        reviews.clear();
+        writing = false;
+        written_cond.notify_all();
+    }
+}
+
+static LatencyHistogram save_game_latency{"save_game"};
+
+static const char *const STR[7] = {
+    "Event", "Site", "Date", "Round", "White", "Black", "Result"
+};
+
+// The game's log as rows, numbered on from where its log is up to, false
+// if it doesn't follow on from there.  Shortest is how far back into the
+// history the log went
+static bool log_rows(
+    const Game&         game,
+    GameLog&            log,
+    vector<MoveLogRow>& rows,
+    size_t&             shortest)
+{
+    shortest = log.path.size();
+    for (const auto& entry : game.log) {
+        MoveLogRow row{log.next++, log.path.back(), entry.move, entry.clock};
+        if (entry.move > 0) {
+            log.path.push_back(row.node);
+        }
+        else if (entry.move == 0) {
+            if (log.path.size() < 2) {
+                return false;
+            }
+            log.path.pop_back();
+            row.parent = log.path.back();
+            shortest   = min(shortest, log.path.size());
+        }
+        rows.push_back(row);
+    }
+    return log.path.size() == game.history.size();
+}
+
+// Values of the tags other than the Seven Tag Roster, one a line
+static string other_tags(const Game& game) {
+    string tags;
+    for (const auto& [key, value] : game.tags) {
+        if (find(begin(STR), end(STR), key) == end(STR)) {
+            tags += value;
+            tags += '\n';
+        }
+    }
+    return tags;
+}
+
+// Positions of the game's history from ply on, each with the move played
+// from it
+static void position_rows(const Game& game, size_t ply, vector<PositionRow>& rows) {
+    const auto& history = game.history;
+    for (; ply < history.size(); ++ply) {
+        PositionRow row{static_cast<int64_t>(history[ply]->key()), static_cast<uint32_t>(ply), 0};
+        if (ply + 1 < history.size()) {
+            if (const auto move = history[ply]->find_move_played(history[ply + 1])) {
+                row.move = archive::encode(*move);
+            }
+        }
+        rows.push_back(row);
+    }
+}
+
+int Database::save_game(Game& game) {
+    LatencyTimer timer{save_game_latency};
+    TRACE_SPAN("save_game");
+
+    GameRecord record;
+    if (!game.rowid) {
+        // Numbered now, so the game has its rowid before it's written
+        game.rowid   = ++last_rowid;
+        record.fresh = true;
+    }
+    record.rowid = game.rowid;
+    for (auto i = 0; i < 7; ++i) {
+        const auto tag = game.tags.find(STR[i]);
+        if (tag != game.tags.end()) {
+            record.str[i] = tag->second;
+        }
+    }
+    record.tags     = other_tags(game);
+    record.settings = game.settings;
+
+    // Appended to the log, unless that's not all that happened, or it's
+    // grown long enough to write the PGN instead
+    auto& log = logs[game.rowid];
+    size_t shortest = 0;
+    record.full = record.fresh || !game.log_valid || log.path.empty() ||
+        log.entries + game.log.size() > COMPACT_LOG ||
+        !log_rows(game, log, record.moves, shortest);
+    if (record.full) {
+        record.pgn      = game.pgn();
+        record.fen      = game.fen();
+        record.snapshot = game.snapshot();
+        record.tagged   = true;
+        record.moves.clear();
+
+        // Nodes of the history, as it's written
+        log.path.resize(game.history.size());
+        iota(log.path.begin(), log.path.end(), 1u);
+        log.next    = static_cast<uint32_t>(log.path.size()) + 1;
+        log.entries = 0;
+
+        record.positions_from = 0;
+        position_rows(game, 0, record.positions);
+    } else {
+        log.entries += record.moves.size();
+        if (!record.moves.empty()) {
+            // The last position kept now has a different move from it
+            record.positions_from = static_cast<int64_t>(shortest) - 1;
+            position_rows(game, shortest - 1, record.positions);
+        }
+        record.tagged = record.settings != log.settings || record.tags != log.tags ||
+            !equal(begin(record.str), end(record.str), begin(log.str));
+    }
+    for (auto i = 0; i < 7; ++i) {
+        log.str[i] = record.str[i];
+    }
+    log.tags     = record.tags;
+    log.settings = record.settings;
+
+    game.log.clear();
+    game.log_valid = true;
+    if (!record.full && !record.tagged && record.moves.empty()) {
+        return 0;
+    }
+
+    {
+        lock_guard<mutex> lock(write_mutex);
+        enqueue(std::move(record));
+    }
+    write_cond.notify_one();
+    return 0;
+}
+
+void Database::flush() {
+    unique_lock<mutex> lock(write_mutex);
+    const auto failed = failures;
+    write_now = true;
+    write_cond.notify_one();
+    written_cond.wait(lock, [&] {
+        return (idle() && !writing) || failures != failed;
+    });
+    write_now = false;
+}
+
+// Game from a row of rowid, pgn, fen, settings and snapshot.  From the
+// snapshot, unless there's none, or it isn't of the position the FEN is,
+// when from the PGN and FEN
+static unique_ptr<Game> row_game(sqlite3_stmt* stmt) {
+    auto pgn = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+    auto fen = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
 
     unique_ptr<Game> game;
+    auto snapshot = static_cast<const char*>(sqlite3_column_blob(stmt, 4));
+    if (snapshot) {
+        try {
+            game = make_unique<Game>();
+            game->snapshot({snapshot, static_cast<size_t>(sqlite3_column_bytes(stmt, 4))});
+            if (game->fen() != (fen ? fen : "")) {
+                game.reset();
+            }
+        }
+        catch (const logic_error&) {
+            game.reset();
+        }
+    }
+
     try {
-        game = make_unique<Game>(pgn, fen);
+        if (!game) {
+            game = make_unique<Game>(pgn ? pgn : "", fen ? fen : "");
+        }
     }
     catch (const logic_error&) {
         // Ignore
     }
 
     if (!game) {
-        sqlite3_finalize(stmt);
         return nullptr;
     }
 
-    game->rowid    = rowid;
+    game->rowid    = sqlite3_column_int64(stmt, 0);
     game->settings = "";
-    if (sqlite3_column_bytes(stmt, 2) > 0) {
-        game->settings = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+    if (sqlite3_column_bytes(stmt, 3) > 0) {
+        game->settings = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+    }
+    return game;
+}
+
+// Whatever's in the log since the game's PGN was written, played over it.
+// Its next save, with nothing to append to, writes the PGN
+void Database::replay_log(Game& game) {
+    auto sql = "SELECT move, clock FROM moves WHERE game = ? ORDER BY node";
+    Statement stmt{prepare(db, stmts[LOAD_LOG], sql)};
+    if (!stmt) {
+        return;
     }
 
-    sqlite3_finalize(stmt);
+    sqlite3_bind_int64(stmt, 1, game.rowid);
+    vector<Game::LogEntry> entries;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        entries.push_back({sqlite3_column_int(stmt, 0), time_t(sqlite3_column_int64(stmt, 1))});
+    }
+    if (!entries.empty()) {
+        (void)game.replay(entries);
+    }
+}
+
+// A game and its log, from the same snapshot of the database
+unique_ptr<Game> Database::load_row(sqlite3_stmt* stmt) {
+    sqlite3_exec(db, "BEGIN", nullptr, nullptr, nullptr);
+    auto game = sqlite3_step(stmt) == SQLITE_ROW ? row_game(stmt) : nullptr;
+    if (game) {
+        replay_log(*game);
+    }
+    sqlite3_exec(db, "COMMIT", nullptr, nullptr, nullptr);
     return game;
 }
 
-unique_ptr<Game> Database::load_latest(void) {
-    const char* sql = "SELECT MAX(rowid) FROM games";
+// The database's user_version once games saved before positions were
+// indexed have been
+static constexpr int POSITIONS_INDEXED = 1;
+
+// Games saved before positions were indexed, as they are with their logs,
+// once.  Games whose PGN can't be read are left out, as they are of
+// imports
+void Database::index_saved_games() {
     sqlite3_stmt* stmt = nullptr;
-    auto rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
+    auto version = 0;
+    if (sqlite3_prepare_v2(db, "PRAGMA user_version", -1, &stmt, nullptr) == SQLITE_OK &&
+        sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        version = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    if (version >= POSITIONS_INDEXED) {
+        return;
+    }
+
+    auto sql =
+        "SELECT rowid, pgn, fen, settings, snapshot FROM games"
+        " WHERE NOT EXISTS (SELECT 1 FROM positions WHERE game = games.rowid)";
+    sqlite3_stmt* insert = nullptr;
+    stmt = nullptr;
+    if (sqlite3_exec(db, "BEGIN", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        return;
+    }
+    auto ok = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) == SQLITE_OK &&
+        sqlite3_prepare_v2(db, INSERT_POSITION, -1, &insert, nullptr) == SQLITE_OK;
+
+    vector<PositionRow> rows;
+    auto rc = SQLITE_DONE;
+    while (ok && (rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        const auto game = row_game(stmt);
+        if (!game) {
+            continue;
+        }
+        replay_log(*game);
+
+        rows.clear();
+        position_rows(*game, 0, rows);
+        for (const auto& row : rows) {
+            bind_position(insert, game->rowid, row);
+            ok = ok && sqlite3_step(insert) == SQLITE_DONE;
+            sqlite3_reset(insert);
+        }
+    }
+    ok = ok && rc == SQLITE_DONE;
+    sqlite3_finalize(insert);
+    sqlite3_finalize(stmt);
+
+    // Or tried again next time
+    const auto pragma = "PRAGMA user_version = " + to_string(POSITIONS_INDEXED);
+    if (!ok || sqlite3_exec(db, pragma.c_str(), nullptr, nullptr, nullptr) != SQLITE_OK) {
+        cerr << "index_saved_games: " << sqlite3_errmsg(db) << endl;
+        sqlite3_exec(db, "ROLLBACK", nullptr, nullptr, nullptr);
+        return;
+    }
+    sqlite3_exec(db, "COMMIT", nullptr, nullptr, nullptr);
+}
+
+unique_ptr<Game> Database::load_game(sqlite3_int64 rowid) {
+    assert(rowid > 0);
+
+    auto sql = "SELECT rowid, pgn, fen, settings, snapshot FROM games WHERE rowid = ?";
+    Statement stmt{prepare(db, stmts[LOAD], sql)};
+    if (!stmt) {
         return nullptr;
     }
 
-    rc = sqlite3_step(stmt);
-    if (rc != SQLITE_ROW) {
-        sqlite3_finalize(stmt);
+    sqlite3_bind_int64(stmt, 1, rowid);
+    return load_row(stmt);
+}
+
+// One query, straight down the rowid
+unique_ptr<Game> Database::load_latest(void) {
+    auto sql = "SELECT rowid, pgn, fen, settings, snapshot FROM games ORDER BY rowid DESC LIMIT 1";
+    Statement stmt{prepare(db, stmts[LATEST], sql)};
+    if (!stmt) {
         return nullptr;
     }
 
-    sqlite3_int64 rowid = sqlite3_column_int64(stmt, 0);
+    return load_row(stmt);
+}
+
+//
+// Evaluations
+//
+
+bool Database::recall(uint64_t key, int strength, Evaluation& evaluation) {
+    auto sql = "SELECT move, score, mate, depth, pv FROM evaluations WHERE key = ? AND strength = ?";
+    Statement stmt{prepare(db, stmts[RECALL], sql)};
+    if (!stmt) {
+        return false;
+    }
+
+    sqlite3_bind_int64(stmt, 1, static_cast<sqlite3_int64>(key));
+    sqlite3_bind_int(stmt, 2, strength);
+    if (sqlite3_step(stmt) != SQLITE_ROW) {
+        return false;
+    }
+
+    evaluation          = Evaluation{};
+    evaluation.key      = key;
+    evaluation.strength = strength;
+    evaluation.move     = static_cast<uint16_t>(sqlite3_column_int(stmt, 0));
+
+    auto& info = evaluation.info;
+    info.score = sqlite3_column_int(stmt, 1);
+    info.mate  = sqlite3_column_int(stmt, 2) != 0;
+    info.depth = static_cast<unsigned>(sqlite3_column_int(stmt, 3));
+
+    const auto pv = static_cast<const unsigned char*>(sqlite3_column_blob(stmt, 4));
+    const auto n  = min<size_t>(sqlite3_column_bytes(stmt, 4) / 2, UCIInfo::MAX_PV);
+    for (size_t i = 0; pv && i < n; ++i) {
+        info.pv[i] = static_cast<uint16_t>(pv[2 * i] | pv[2 * i + 1] << 8);
+    }
+    info.pv_length = static_cast<uint8_t>(pv ? n : 0);
+    return true;
+}
+
+void Database::remember(const Evaluation& evaluation) {
+    {
+        lock_guard<mutex> lock(write_mutex);
+        remembered.push_back(evaluation);
+        retrying = false;
+    }
+    write_cond.notify_one();
+}
+
+//
+// Reviews
+//
+
+bool Database::next_review(int64_t before, ReviewGame& game) {
+    // Played on the board, and finished, with where any review's up to
+    auto sql =
+        "SELECT g.rowid,"
+        "  IFNULL(json_extract(g.settings, '$.white.error'), 0),"
+        "  IFNULL(json_extract(g.settings, '$.black.error'), 0),"
+        "  IFNULL(json_extract(g.settings, '$.white.opportunity'), 0),"
+        "  IFNULL(json_extract(g.settings, '$.black.opportunity'), 0),"
+        "  (SELECT COUNT(*) FROM reviews WHERE game = g.rowid),"
+        "  (SELECT loss FROM reviews WHERE game = g.rowid ORDER BY ply DESC LIMIT 1)"
+        " FROM (SELECT rowid, CASE WHEN json_valid(settings) THEN settings END AS settings"
+        "       FROM games"
+        "       WHERE rowid < ? AND snapshot IS NOT NULL"
+        "         AND result IN ('1-0', '0-1', '1/2-1/2')) AS g"
+        " WHERE NOT EXISTS (SELECT 1 FROM reviews WHERE game = g.rowid AND move IS NULL)"
+        " ORDER BY g.rowid DESC LIMIT 1";
+    Statement stmt{prepare(db, stmts[NEXT_REVIEW], sql)};
+    if (!stmt) {
+        return false;
+    }
+
+    sqlite3_bind_int64(stmt, 1, before ? before : numeric_limits<sqlite3_int64>::max());
+    if (sqlite3_step(stmt) != SQLITE_ROW) {
+        return false;
+    }
+
+    game                = ReviewGame{};
+    game.rowid          = sqlite3_column_int64(stmt, 0);
+    game.error[0]       = max(0, sqlite3_column_int(stmt, 1));
+    game.error[1]       = max(0, sqlite3_column_int(stmt, 2));
+    game.opportunity[0] = max(0, sqlite3_column_int(stmt, 3));
+    game.opportunity[1] = max(0, sqlite3_column_int(stmt, 4));
+    game.plies          = static_cast<uint32_t>(sqlite3_column_int64(stmt, 5));
+    game.loss           = sqlite3_column_int(stmt, 6);
+    return true;
+}
+
+unique_ptr<Game> Database::review_game(int64_t rowid) {
+    return load_game(rowid);
+}
+
+void Database::review(const ReviewRow& row) {
+    {
+        lock_guard<mutex> lock(write_mutex);
+        reviewed.push_back(row);
+        retrying = false;
+    }
+    write_cond.notify_one();
+}
+
+vector<ReviewRow> Database::load_review(sqlite3_int64 rowid) {
+    auto sql =
+        "SELECT ply, key, move, best, score, mate, depth, loss, flag"
+        " FROM reviews WHERE game = ? ORDER BY ply";
+
+    lock_guard<mutex> lock(list_mutex);
+    if (!list_db) {
+        list_db = open_database();
+    }
+    Statement stmt{prepare(list_db, review_stmt, sql)};
+    if (!stmt) {
+        throw runtime_error("Failed to prepare review");
+    }
+
+    vector<ReviewRow> rows;
+    sqlite3_bind_int64(stmt, 1, rowid);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        auto& row = rows.emplace_back();
+        row.game  = rowid;
+        row.ply   = static_cast<uint32_t>(sqlite3_column_int64(stmt, 0));
+        row.key   = sqlite3_column_int64(stmt, 1);
+        row.move  = static_cast<uint16_t>(sqlite3_column_int(stmt, 2));
+        row.best  = static_cast<uint16_t>(sqlite3_column_int(stmt, 3));
+        row.score = sqlite3_column_int(stmt, 4);
+        row.mate  = sqlite3_column_int(stmt, 5) != 0;
+        row.depth = static_cast<unsigned>(sqlite3_column_int(stmt, 6));
+        row.loss  = sqlite3_column_int(stmt, 7);
+        row.flag  = static_cast<ReviewRow::Flag>(sqlite3_column_int(stmt, 8));
+    }
+    return rows;
+}
+
+//
+// Listing
+//
+
+// Summary from a row of rowid and the Seven Tag Roster
+static GameSummary row_summary(sqlite3_stmt* stmt) {
+    GameSummary game;
+    game.rowid = sqlite3_column_int64(stmt, 0);
+    for (int i = 0; i != 7; ++i) {
+        auto text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i + 1));
+        game.str[i] = text ? text : "";
+    }
+    return game;
+}
+
+vector<GameSummary>
+Database::list_games(sqlite3_int64 before, int limit, const GameFilter& filter) {
+    // Each filter is an equality on an indexed column, and an index keeps
+    // rowids in order within a key, so no page sorts or scans the table
+    const pair<const char*, const char*> filters[] = {
+        {"date",   filter.date},
+        {"white",  filter.white},
+        {"black",  filter.black},
+        {"result", filter.result},
+    };
+
+    // A statement kept for each combination of filters
+    unsigned filtered = 0;
+    string sql = "SELECT rowid, event, site, date, round, white, black, result"
+                 " FROM games WHERE rowid < ?";
+    for (size_t i = 0; i != size(filters); ++i) {
+        if (filters[i].second) {
+            filtered |= 1u << i;
+            sql += " AND ";
+            sql += filters[i].first;
+            sql += " = ?";
+        }
+    }
+    sql += " ORDER BY rowid DESC LIMIT ?";
+
+    lock_guard<mutex> lock(list_mutex);
+    if (!list_db) {
+        list_db = open_database();
+    }
+
+    Statement stmt{prepare(list_db, list_stmts[filtered], sql.c_str())};
+    if (!stmt) {
+        throw runtime_error("Failed to prepare listing");
+    }
+
+    int n = 1;
+    sqlite3_bind_int64(stmt, n++, before > 0 ? before : numeric_limits<sqlite3_int64>::max());
+    for (const auto& [column, value] : filters) {
+        if (value) {
+            sqlite3_bind_text(stmt, n++, value, -1, SQLITE_STATIC);
+        }
+    }
+    sqlite3_bind_int(stmt, n++, limit);
+
+    vector<GameSummary> games;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        games.push_back(row_summary(stmt));
+    }
+    return games;
+}
+
+//
+// Searching
+//
+
+// The query as FTS5 has it, each word a quoted prefix, in its column if it
+// names one, so nothing typed is taken for query syntax
+static string search_query(const char* text) {
+    static const char *const columns[] = {
+        "event", "site", "date", "round", "white", "black", "result", "tags"
+    };
+
+    string query;
+    string_view rest{text};
+    while (!rest.empty()) {
+        const auto start = rest.find_first_not_of(" \t\n");
+        if (start == string_view::npos) {
+            break;
+        }
+        rest.remove_prefix(start);
+        auto word = rest.substr(0, rest.find_first_of(" \t\n"));
+        rest.remove_prefix(word.size());
+
+        if (const auto colon = word.find(':'); colon != string_view::npos && colon + 1 < word.size()) {
+            const auto column = word.substr(0, colon);
+            if (find(begin(columns), end(columns), column) != end(columns)) {
+                query.append(column).append(" : ");
+                word.remove_prefix(colon + 1);
+            }
+        }
+
+        query += '"';
+        for (auto c : word) {
+            query += c;
+            if (c == '"') {
+                query += '"';
+            }
+        }
+        query += "\"* ";
+    }
+    return query;
+}
+
+vector<GameSummary> Database::search_games(const char *text, int limit, int offset) {
+    // Ranked and paged on the index, then just those rows read
+    auto sql =
+        "SELECT g.rowid, g.event, g.site, g.date, g.round, g.white, g.black, g.result"
+        " FROM (SELECT rowid, rank FROM search WHERE search MATCH ?"
+        "       ORDER BY rank LIMIT ? OFFSET ?) AS s"
+        " JOIN games AS g ON g.rowid = s.rowid"
+        " ORDER BY s.rank";
+
+    const auto query = search_query(text ? text : "");
+    if (query.empty()) {
+        return {};
+    }
+
+    lock_guard<mutex> lock(list_mutex);
+    if (!list_db) {
+        list_db = open_database();
+    }
+
+    Statement stmt{prepare(list_db, search_stmt, sql)};
+    if (!stmt) {
+        throw runtime_error("Failed to prepare search");
+    }
+
+    sqlite3_bind_text(stmt, 1, query.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_int( stmt, 2, limit);
+    sqlite3_bind_int( stmt, 3, offset);
+
+    vector<GameSummary> games;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        games.push_back(row_summary(stmt));
+    }
+    return games;
+}
+
+//
+// Opening explorer
+//
+
+Explorer Database::explore(uint64_t key, int limit) {
+    // Positions are keyed first, so each of these reads just the rows of
+    // the one position, a game counting once for each move played from it
+    static const char *const sql[3] = {
+        "SELECT COUNT(DISTINCT game) FROM positions WHERE key = ?",
+
+        "SELECT p.move, COUNT(*),"
+        "  SUM(g.result = '1-0'), SUM(g.result = '1/2-1/2'), SUM(g.result = '0-1')"
+        " FROM (SELECT DISTINCT game, move FROM positions WHERE key = ?) AS p"
+        " JOIN games AS g ON g.rowid = p.game"
+        " GROUP BY p.move ORDER BY COUNT(*) DESC, p.move",
+
+        "SELECT g.rowid, g.event, g.site, g.date, g.round, g.white, g.black, g.result"
+        " FROM (SELECT DISTINCT game FROM positions WHERE key = ?"
+        "       ORDER BY game DESC LIMIT ?) AS p"
+        " JOIN games AS g ON g.rowid = p.game"
+        " ORDER BY g.rowid DESC",
+    };
+
+    lock_guard<mutex> lock(list_mutex);
+    if (!list_db) {
+        list_db = open_database();
+    }
+
+    Statement count{prepare(list_db, explore_stmts[0], sql[0])};
+    Statement moves{prepare(list_db, explore_stmts[1], sql[1])};
+    Statement recent{prepare(list_db, explore_stmts[2], sql[2])};
+    if (!count || !moves || !recent) {
+        throw runtime_error("Failed to prepare explorer");
+    }
+
+    Explorer explorer;
+    sqlite3_bind_int64(count, 1, static_cast<sqlite3_int64>(key));
+    if (sqlite3_step(count) == SQLITE_ROW) {
+        explorer.games = sqlite3_column_int64(count, 0);
+    }
+
+    sqlite3_bind_int64(moves, 1, static_cast<sqlite3_int64>(key));
+    while (sqlite3_step(moves) == SQLITE_ROW) {
+        auto& move = explorer.moves.emplace_back();
+        move.move  = static_cast<uint16_t>(sqlite3_column_int(moves, 0));
+        move.games = sqlite3_column_int64(moves, 1);
+        move.white = sqlite3_column_int64(moves, 2);
+        move.draws = sqlite3_column_int64(moves, 3);
+        move.black = sqlite3_column_int64(moves, 4);
+    }
+
+    sqlite3_bind_int64(recent, 1, static_cast<sqlite3_int64>(key));
+    sqlite3_bind_int(  recent, 2, limit);
+    while (sqlite3_step(recent) == SQLITE_ROW) {
+        explorer.recent.push_back(row_summary(recent));
+    }
+    return explorer;
+}
+
+//
+// Bulk import
+//
+
+// Games parsed, then inserted in one transaction, at a time
+static constexpr size_t IMPORT_BATCH = 1000;
+
+namespace {
+
+struct ImportGame {
+    // Copied from the reader, whose views only last until its next game
+    vector<pair<string, string>> tags;
+    string movetext;
+
+    // Filled in by the workers
+    bool   valid{false};
+    string str[7];
+    string others;  // Values of the other tags
+    string pgn;
+    string fen;
+    vector<PositionRow> positions;
+
+    void parse();
+};
+
+}
+
+void ImportGame::parse() {
+    PgnGame pgn_game;
+    for (const auto& tag : tags) {
+        pgn_game.tags.emplace_back(tag.first, tag.second);
+    }
+    pgn_game.movetext = movetext;
+
+    try {
+        Game game;
+        game.pgn(pgn_game);
+        for (auto i = 0; i < 7; ++i) {
+            const auto tag = game.tags.find(STR[i]);
+            str[i] = tag != game.tags.end() ? tag->second : "";
+        }
+        others = other_tags(game);
+        pgn    = game.pgn();
+        fen    = game.fen();
+        positions.clear();
+        position_rows(game, 0, positions);
+        valid  = true;
+    }
+    catch (const logic_error&) {
+        valid = false;
+    }
+}
+
+// Parse a batch of games, each thread taking every nth
+static void parse_games(vector<ImportGame>& games, size_t n, unsigned threads) {
+    vector<thread> workers;
+    for (unsigned t = 1; t < threads && t < n; ++t) {
+        workers.emplace_back([&games, n, threads, t]() {
+            for (size_t i = t; i < n; i += threads) {
+                games[i].parse();
+            }
+        });
+    }
+    for (size_t i = 0; i < n; i += threads) {
+        games[i].parse();
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+static bool insert_games(
+    sqlite3*            db,
+    sqlite3_stmt*       stmt,
+    sqlite3_stmt*       search_stmt,
+    sqlite3_stmt*       index_stmt,
+    vector<ImportGame>& games,
+    size_t              n,
+    ImportStats&        stats)
+{
+    if (sqlite3_exec(db, "BEGIN", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        return false;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        const auto& game = games[i];
+        if (!game.valid) {
+            ++stats.rejected;
+            continue;
+        }
+
+        for (auto j = 0; j < 7; ++j) {
+            sqlite3_bind_text(stmt, j + 1, game.str[j].data(), -1, SQLITE_STATIC);
+        }
+        sqlite3_bind_text(stmt,  8, game.pgn.data(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt,  9, game.fen.data(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 10, "",              -1, SQLITE_STATIC);
+
+        auto rc = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+
+        const auto rowid = sqlite3_last_insert_rowid(db);
+        if (rc == SQLITE_DONE) {
+            bind_tags(search_stmt, rowid, game.str, game.others);
+            rc = sqlite3_step(search_stmt);
+            sqlite3_reset(search_stmt);
+        }
+        for (auto row = game.positions.begin(); rc == SQLITE_DONE && row != game.positions.end(); ++row) {
+            bind_position(index_stmt, rowid, *row);
+            rc = sqlite3_step(index_stmt);
+            sqlite3_reset(index_stmt);
+        }
+        if (rc != SQLITE_DONE) {
+            sqlite3_exec(db, "ROLLBACK", nullptr, nullptr, nullptr);
+            return false;
+        }
+        ++stats.imported;
+    }
+
+    return sqlite3_exec(db, "COMMIT", nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+ImportStats Database::import_games(PgnReader& reader, unsigned threads) {
+    if (threads == 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+
+    auto import_db = open_database();
+
+    sqlite3_stmt* stmt        = nullptr;
+    sqlite3_stmt* search_stmt = nullptr;
+    sqlite3_stmt* index_stmt  = nullptr;
+    if (sqlite3_prepare_v2(import_db, INSERT_GAME,     -1, &stmt,        nullptr) != SQLITE_OK ||
+        sqlite3_prepare_v2(import_db, INSERT_SEARCH,   -1, &search_stmt, nullptr) != SQLITE_OK ||
+        sqlite3_prepare_v2(import_db, INSERT_POSITION, -1, &index_stmt,  nullptr) != SQLITE_OK)
+    {
+        sqlite3_finalize(search_stmt);
+        sqlite3_finalize(stmt);
+        sqlite3_close(import_db);
+        throw runtime_error("Failed to prepare import");
+    }
+
+    ImportStats stats;
+    vector<ImportGame> games(IMPORT_BATCH);
+    PgnGame pgn_game;
+    auto ok  = true;
+    auto eof = false;
+    while (ok && !eof) {
+        size_t n = 0;
+        while (n < IMPORT_BATCH && !eof) {
+            try {
+                eof = !reader.next(pgn_game);
+            }
+            catch (const domain_error&) {
+                // Bad tags, skip the game
+                ++stats.rejected;
+                continue;
+            }
+            if (eof) {
+                break;
+            }
+
+            auto& game = games[n++];
+            game.tags.clear();
+            for (const auto& tag : pgn_game.tags) {
+                game.tags.emplace_back(tag.first, tag.second);
+            }
+            game.movetext = pgn_game.movetext;
+        }
+
+        parse_games(games, n, threads);
+        ok = insert_games(import_db, stmt, search_stmt, index_stmt, games, n, stats);
+    }
+
+    sqlite3_finalize(index_stmt);
+    sqlite3_finalize(search_stmt);
     sqlite3_finalize(stmt);
-    return rowid > 0 ? load_game(rowid) : nullptr;
+    sqlite3_close(import_db);
+    if (!ok) {
+        throw runtime_error("Failed to import games");
+    }
+    return stats;
 }
 
 // This file is part of the Raccoon's Centaur Mods (RCM).
@@ -5,25 +5,238 @@
 #ifndef DB_H
 #define DB_H
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <sqlite3.h>
 
+#include "chess/chess_engine.h"
+#include "chess/chess_review.h"
+
 struct Game;
+class PgnReader;
+
+// A saved game's Seven Tag Roster, read without parsing its PGN
+struct GameSummary {
+    sqlite3_int64 rowid{0};
+    std::string   str[7];  // Event, Site, Date, Round, White, Black, Result
+};
+
+// An entry in a game's move log, what's been done to it since its PGN was
+// last written (see Game::LogEntry).  Nodes number the entries, and are the
+// nodes of the positions moves played reach.  The positions of the game's
+// history, as it was written, are nodes 1 on.  The parent is the node of the
+// position the entry was done from, or for a takeback, went back to
+struct MoveLogRow {
+    std::uint32_t node;
+    std::uint32_t parent;
+    std::int32_t  move;
+    std::int64_t  clock;
+};
+
+// A position a game reached, filed under its Position::key() (as signed, how
+// SQLite has it), with the move played from it, 0 if the game ended there
+struct PositionRow {
+    std::int64_t  key;
+    std::uint32_t ply;
+    std::uint16_t move;  // archive::encode
+};
+
+// A game as it's saved, taken on the game thread to be written on another.
+// Whole, or appended to its move log, or both, being saves of both kinds
+// written together
+struct GameRecord {
+    sqlite3_int64 rowid{0};
+    bool          fresh{false};   // Not yet inserted
+    bool          full{false};    // With PGN and FEN, starting a new log
+    bool          tagged{false};  // Tags or settings to be written
+    std::string   str[7];         // Seven Tag Roster
+    std::string   tags;           // Values of the others, one a line
+    std::string   pgn;
+    std::string   fen;
+    std::string   settings;
+    std::string   snapshot;       // With the PGN, see Game::snapshot()
+    std::vector<MoveLogRow> moves;  // To append to the log
+    std::int64_t  positions_from{-1};  // Ply its positions change from, if any
+    std::vector<PositionRow> positions;  // From there on
+};
+
+// Where a game's move log is up to, as written or queued
+struct GameLog {
+    std::vector<std::uint32_t> path;  // Nodes of the game's history
+    std::uint32_t next{1};            // Node of the next entry
+    std::size_t   entries{0};         // Since its PGN
+    std::string   str[7];             // As last saved
+    std::string   tags;
+    std::string   settings;
+};
+
+// Games to list, those whose tags equal each that's given
+struct GameFilter {
+    const char *date{nullptr};
+    const char *white{nullptr};
+    const char *black{nullptr};
+    const char *result{nullptr};
+};
+
+// What's been played from a position, over every saved game reaching it
+struct ExplorerMove {
+    std::uint16_t move;  // archive::encode, 0 for games ending there
+    std::size_t   games{0};
+    std::size_t   white{0};  // Of those, won by white
+    std::size_t   draws{0};
+    std::size_t   black{0};
+};
 
-class Database {
-    sqlite3 *db;
+struct Explorer {
+    std::size_t               games{0};
+    std::vector<ExplorerMove> moves;   // Most played first
+    std::vector<GameSummary>  recent;  // Newest first
+};
+
+struct ImportStats {
+    std::size_t imported{0};
+    std::size_t rejected{0};  // Not valid PGN
+};
+
+class Database : public EvalStore, public ReviewStore {
+    // Statements kept, inserts and updates on write_db for the writer, and
+    // loads on db for the game thread
+    enum {
+        INSERT, UPDATE, UPDATE_TAGS, CLEAR_LOG, APPEND_LOG,
+        CLEAR_POSITIONS, INDEX_POSITION, CLEAR_SEARCH, INDEX_SEARCH, REMEMBER,
+        REVIEW,
+        LOAD, LATEST, LOAD_LOG, RECALL, NEXT_REVIEW,
+        NUM_STMTS
+    };
+
+    sqlite3      *db;
+    sqlite3      *write_db;
+    sqlite3_stmt *stmts[NUM_STMTS]{};
+    sqlite3      *list_db{nullptr};  // Opened on first listing
+    sqlite3_stmt *list_stmts[16]{};  // By filters given, on list_db
+    sqlite3_stmt *explore_stmts[3]{};  // Also on list_db
+    sqlite3_stmt *search_stmt{nullptr};  // Ditto
+    sqlite3_stmt *review_stmt{nullptr};  // Ditto
+    std::mutex    list_mutex;         // Of list_db and list_stmts
+
+    // Saves, written behind.  New games are numbered from last_rowid, and
+    // moved has those written elsewhere, having found their rowid taken
+    std::atomic<sqlite3_int64> last_rowid{0};
+    std::map<sqlite3_int64, GameLog> logs;  // Game thread only
+    std::map<sqlite3_int64, sqlite3_int64> moved;  // Writer only
+    std::mutex                 write_mutex;  // Of everything down to writer
+    std::condition_variable    write_cond;
+    std::condition_variable    written_cond;
+    std::vector<GameRecord>    queued;  // Each game as last saved
+    std::vector<Evaluation>    remembered;  // And evaluations since
+    std::vector<ReviewRow>     reviewed;    // And review rows, in order
+    bool                       writing{false};
+    bool                       write_now{false};  // Flushing, don't wait for more
+    bool                       write_stop{false};
+    bool                       retrying{false};  // What failed waits for more to be saved
+    unsigned                   failures{0};
+    std::thread                writer;
 
 public:
     ~Database();
     Database();
 
+    // Queue the game, as it is now, to be written by a thread of our own,
+    // so the caller never waits on storage.  While the writer waits on a
+    // burst of saves to finish, later saves of a game add to earlier ones.
+    // A new game is given its rowid here, ahead of being written.  What's
+    // saved is the game's log, appended to its move log, so a move costs
+    // the same however long the game, and now and then its whole PGN,
+    // and with it the positions of its main line that changed (see explore).
+    // Takes the game's log
     int save_game(Game&);
+
+    // Wait for every save so far to be written, or fail to be
+    void flush();
+
+    // With whatever's in their move logs played over their PGN
     std::unique_ptr<Game> load_game(sqlite3_int64 rowid);
     std::unique_ptr<Game> load_latest();
 
+    // Up to limit games saved before rowid (0 for the newest), newest
+    // first.  The last one's rowid is where the next page starts.  On a
+    // connection of its own, so safe to call from any thread.  Throws
+    // std::runtime_error if the query fails
+    std::vector<GameSummary>
+    list_games(sqlite3_int64 before, int limit, const GameFilter& filter = {});
+
+    // Games whose tags have every word of the query, best matches first,
+    // limit of them from offset.  Words match as prefixes, and a word
+    // written column:word, e.g., white:carlsen, only in that tag (event,
+    // site, date, round, white, black, result, or tags for any other).  On
+    // the listing connection, so safe to call from any thread.  Throws
+    // std::runtime_error if the query fails
+    std::vector<GameSummary> search_games(const char *query, int limit, int offset = 0);
+
+    // The games reaching a position, by the key of the position (see
+    // Position::key()), and what was played from it, with up to limit of
+    // the most recent of them.  Indexed by key, so it reads only the games
+    // reaching the position, however many are saved.  On the listing
+    // connection, so safe to call from any thread.  Throws
+    // std::runtime_error if the query fails
+    Explorer explore(std::uint64_t key, int limit = 10);
+
+    // Add every game read to the games table.  Games are parsed on all cores
+    // (or the given number of threads) and inserted in large transactions on
+    // a connection of their own, so this is safe to call from any thread
+    ImportStats import_games(PgnReader& reader, unsigned threads = 0);
+
+    // Evaluations of positions (see Engine), looked up on the game thread's
+    // connection, and written behind with the games, a deeper search's
+    // replacing a shallower's
+    bool recall(std::uint64_t key, int strength, Evaluation& evaluation) override;
+    void remember(const Evaluation& evaluation) override;
+
+    // Games to review, found and loaded on the game thread's connection,
+    // and what's found of them written behind with the games (see
+    // ReviewStore)
+    bool next_review(std::int64_t before, ReviewGame& game) override;
+    std::unique_ptr<Game> review_game(std::int64_t rowid) override;
+    void review(const ReviewRow& row) override;
+
+    // What review's found of a game, ply by ply, as far as it's got.  On
+    // the listing connection, so safe to call from any thread.  Throws
+    // std::runtime_error if the query fails
+    std::vector<ReviewRow> load_review(sqlite3_int64 rowid);
+
 private:
-    int insert_game(Game&);
-    int update_game(Game&);
+    sqlite3_int64 row_of(sqlite3_int64 rowid) const;
+    bool insert_game(const GameRecord&);
+    bool update_game(const GameRecord&);
+    bool update_tags(const GameRecord&);
+    bool clear_log(sqlite3_int64 rowid);
+    bool append_log(sqlite3_int64 rowid, const MoveLogRow&);
+    bool index_positions(const GameRecord&);
+    bool index_tags(const GameRecord&);
+    bool write_game(const GameRecord&);
+    bool write_evaluation(const Evaluation&);
+    bool write_review(const ReviewRow&);
+    bool write_games(
+        const std::vector<GameRecord>&,
+        const std::vector<Evaluation>&,
+        const std::vector<ReviewRow>&);
+    void replay_log(Game&);
+    std::unique_ptr<Game> load_row(sqlite3_stmt*);
+    void index_saved_games();
+    void enqueue(GameRecord&&);
+    void write_behind();
+
+    // Nothing's waiting to be written.  Caller holds write_mutex
+    bool idle() const { return queued.empty() && remembered.empty() && reviewed.empty(); }
 };
 
 extern Database db;
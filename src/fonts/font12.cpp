@@ -37,7 +37,7 @@
 
 #include "fonts.h"
 
-const unsigned char Font12_Table[] =
+constexpr unsigned char Font12_Table[] =
 {
     // @0 ' ' (7 pixels wide)
     0x00, //
@@ -1370,10 +1370,14 @@ const unsigned char Font12_Table[] =
     0x00, //
 };
 
+static constexpr FontAtlas<7, 12> Font12_Atlas{Font12_Table};
+
 const struct sFONT Font12 = {
     .table  = Font12_Table,
     .Width  = 7,
     .Height = 12,
+    .rows   = Font12_Atlas.rows,
+    .glyphs = Font12_Atlas.glyphs,
 };
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
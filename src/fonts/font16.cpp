@@ -38,7 +38,7 @@
 #include "fonts.h"
 
 // Courier New 12pt
-const unsigned char Font16_Table[] =
+constexpr unsigned char Font16_Table[] =
 {
     // @0 ' ' (11 pixels wide)
     0x00, 0x00, //
@@ -1751,10 +1751,14 @@ const unsigned char Font16_Table[] =
     0x00, 0x00, //
 };
 
+static constexpr FontAtlas<11, 16> Font16_Atlas{Font16_Table};
+
 const struct sFONT Font16 = {
     .table  = Font16_Table,
     .Width  = 11,
     .Height = 16,
+    .rows   = Font16_Atlas.rows,
+    .glyphs = Font16_Atlas.glyphs,
 };
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -38,7 +38,7 @@
 #include "fonts.h"
 
 // Courier New 15pt
-const unsigned char Font20_Table[] =
+constexpr unsigned char Font20_Table[] =
 {
     // @0 ' ' (14 pixels wide)
     0x00, 0x00, //
@@ -2131,10 +2131,14 @@ const unsigned char Font20_Table[] =
     0x00, 0x00, //
 };
 
+static constexpr FontAtlas<14, 20> Font20_Atlas{Font20_Table};
+
 const struct sFONT Font20 = {
     .table  = Font20_Table,
     .Width  = 14,
     .Height = 20,
+    .rows   = Font20_Atlas.rows,
+    .glyphs = Font20_Atlas.glyphs,
 };
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -37,7 +37,7 @@
 
 #include "fonts.h"
 
-const unsigned char Font24_Table [] =
+constexpr unsigned char Font24_Table[] =
 {
     // @0 ' ' (17 pixels wide)
     0x00, 0x00, 0x00, //
@@ -2510,10 +2510,14 @@ const unsigned char Font24_Table [] =
     0x00, 0x00, 0x00, //
 };
 
+static constexpr FontAtlas<17, 24> Font24_Atlas{Font24_Table};
+
 const struct sFONT Font24 = {
     .table  = Font24_Table,
     .Width  = 17,
     .Height = 24,
+    .rows   = Font24_Atlas.rows,
+    .glyphs = Font24_Atlas.glyphs,
 };
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -39,10 +39,65 @@
 #ifndef FONTS_H
 #define FONTS_H
 
+#include <cstdint>
+
+// Tables hold the printable characters, ' ' to '~'
+constexpr int FONT_FIRST  = ' ';
+constexpr int FONT_GLYPHS = '~' - ' ' + 1;
+
+struct sGLYPH {
+    unsigned char left;     // First column with ink
+    unsigned char width;    // Columns from there through the last with ink
+    unsigned char advance;  // From this glyph to the next
+};
+
 struct sFONT {
     const unsigned char* table;
     int Width;
     int Height;
+
+    // Glyph g's row r is rows[g * Height + r], leftmost pixel in the top bit
+    const std::uint32_t* rows;
+    const sGLYPH*        glyphs;
+};
+
+// A table repacked, at compile time, one 32-bit word per glyph row, so text
+// is drawn a row at a time rather than a pixel at a time
+template <int Width, int Height>
+struct FontAtlas {
+    static_assert(Width <= 32, "Glyph rows must fit in a word");
+
+    std::uint32_t rows[FONT_GLYPHS * Height];
+    sGLYPH        glyphs[FONT_GLYPHS];
+
+    constexpr explicit FontAtlas(const unsigned char* table) : rows{}, glyphs{} {
+        const auto row_bytes = (Width + 7) / 8;
+        for (auto g = 0; g < FONT_GLYPHS; ++g) {
+            auto ink = std::uint32_t{0};
+            for (auto r = 0; r < Height; ++r) {
+                auto bits = std::uint32_t{0};
+                for (auto b = 0; b < row_bytes; ++b) {
+                    bits |= std::uint32_t{table[(g * Height + r) * row_bytes + b]} << (24 - 8 * b);
+                }
+                rows[g * Height + r] = bits;
+                ink |= bits;
+            }
+
+            auto left  = 0;
+            auto right = -1;
+            for (auto c = 0; c < Width; ++c) {
+                if (ink & (0x80000000u >> c)) {
+                    left  = right < 0 ? c : left;
+                    right = c;
+                }
+            }
+            glyphs[g] = sGLYPH{
+                static_cast<unsigned char>(left),
+                static_cast<unsigned char>(right - left + 1),
+                static_cast<unsigned char>(Width),
+            };
+        }
+    }
 };
 
 extern const sFONT Font12;
@@ -3,11 +3,16 @@
 
 #include "graphics.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
+#include <alloca.h>
+
+using namespace std;
+
 Context::Context()
     : image{nullptr},
       foreground{PIXEL_BLACK},
@@ -62,6 +67,147 @@ void Context::setpixel(int x, int y, PixelColor color) {
     }
 }
 
+// Bits of color, eight at a time
+static uint8_t color_bits(PixelColor color) {
+    return color == PIXEL_BLACK ? 0x00 : 0xff;
+}
+
+// Byte with the pixels of mask taken from bits
+static void merge(uint8_t& byte, uint8_t bits, uint8_t mask) {
+    byte = (byte & ~mask) | (bits & mask);
+}
+
+// Pixels x0 to x1 of a byte, MSB first
+static uint8_t span_mask(int x0, int x1) {
+    return (0xff >> x0) & (0xff << (7 - x1));
+}
+
+// Eight bits of row starting at bit pos, MSB first.  Bits outside the row
+// read as zero
+static uint8_t fetch8(const uint8_t* row, int row_bytes, int pos) {
+    const auto byte  = pos >= 0 ? pos / 8 : (pos - 7) / 8;
+    const auto shift = pos - 8 * byte;
+    const unsigned hi = 0 <= byte && byte < row_bytes ? row[byte] : 0;
+    if (shift == 0) {
+        return hi;
+    }
+    const unsigned lo = 0 <= byte + 1 && byte + 1 < row_bytes ? row[byte + 1] : 0;
+    return (hi << shift | lo >> (8 - shift)) & 0xff;
+}
+
+static uint8_t reverse8(uint8_t bits) {
+    bits = (bits & 0xf0) >> 4 | (bits & 0x0f) << 4;
+    bits = (bits & 0xcc) >> 2 | (bits & 0x33) << 2;
+    bits = (bits & 0xaa) >> 1 | (bits & 0x55) << 1;
+    return bits;
+}
+
+// Pixels x0 to x1 of image row y, already transformed and clipped
+void Context::fill_span(int y, int x0, int x1, PixelColor color) {
+    const auto row   = &image->data_[y * image->width_bytes];
+    const auto bits  = color_bits(color);
+    const auto first = x0 / 8;
+    const auto last  = x1 / 8;
+    if (first == last) {
+        merge(row[first], bits, span_mask(x0 % 8, x1 % 8));
+        return;
+    }
+    merge(row[first], bits, span_mask(x0 % 8, 7));
+    memset(&row[first + 1], bits, last - first - 1);
+    merge(row[last], bits, span_mask(0, x1 % 8));
+}
+
+// Every pixel from (x0, y0) to (x1, y1), inclusive.  Any rotation turns a
+// rectangle into another one, so this is always a run of spans
+void Context::fill(int x0, int y0, int x1, int y1, PixelColor color) {
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+    transform_point(x0, y0);
+    transform_point(x1, y1);
+
+    const auto left   = max(min(x0, x1), 0);
+    const auto right  = min(max(x0, x1), image->width - 1);
+    const auto top    = max(min(y0, y1), 0);
+    const auto bottom = min(max(y0, y1), image->height - 1);
+    if (left > right) {
+        return;
+    }
+    for (auto y = top; y <= bottom; ++y) {
+        fill_span(y, left, right, color);
+    }
+}
+
+// w pixels from (x, y) rightward, colored by bits of row starting at bit:
+// set bits in set, clear bits in unset.  Unrotated, or upside down, that's
+// a span of the image, done a byte at a time.  Otherwise it's a column of
+// the image, a pixel at a time
+void Context::blit_row(
+    int            x,
+    int            y,
+    const uint8_t* row,
+    int            row_bytes,
+    int            bit,
+    int            w,
+    PixelColor     set,
+    PixelColor     unset)
+{
+    if (w <= 0) {
+        return;
+    }
+    const auto set_bits   = color_bits(set);
+    const auto unset_bits = color_bits(unset);
+
+    if (rotate == ROTATE_0 || rotate == ROTATE_180) {
+        auto x0 = x;
+        auto y0 = y;
+        auto x1 = x + w - 1;
+        auto y1 = y;
+        transform_point(x0, y0);
+        transform_point(x1, y1);
+        if (y0 < 0 || image->height <= y0) {
+            return;
+        }
+
+        const auto flipped = rotate == ROTATE_180;
+        const auto left    = max(min(x0, x1), 0);
+        const auto right   = min(max(x0, x1), image->width - 1);
+        const auto dst     = &image->data_[y0 * image->width_bytes];
+        for (auto byte = left / 8; byte <= right / 8; ++byte) {
+            const auto first = max(8 * byte, left);
+            const auto last  = min(8 * byte + 7, right);
+
+            // Source bit for the first pixel of this byte, and on
+            uint8_t bits;
+            if (flipped) {
+                bits = reverse8(fetch8(row, row_bytes, bit + x0 - (8 * byte + 7)));
+            } else {
+                bits = fetch8(row, row_bytes, bit + 8 * byte - x0);
+            }
+            const uint8_t colored = (bits & set_bits) | (~bits & unset_bits);
+            merge(dst[byte], colored, span_mask(first - 8 * byte, last - 8 * byte));
+        }
+        return;
+    }
+
+    // A column, walked up or down from the transformed start
+    auto xd = x;
+    auto yd = y;
+    transform_point(xd, yd);
+    if (xd < 0 || image->width <= xd) {
+        return;
+    }
+    const auto step   = rotate == ROTATE_90 ? -1 : 1;
+    const uint8_t pixel = 0x80 >> xd % 8;
+    for (auto i = 0; i < w; ++i, yd += step) {
+        if (yd < 0 || image->height <= yd) {
+            continue;
+        }
+        const auto on = row[(bit + i) / 8] & (0x80 >> (bit + i) % 8);
+        merge(image->data_[yd * image->width_bytes + xd / 8], on ? set_bits : unset_bits, pixel);
+    }
+}
+
 void Context::drawpoint(int x, int y, PixelColor color)
 {
     switch (dot_style) {
@@ -164,42 +310,62 @@ void Context::drawrect(int x0, int y0, int x1, int y1) {
 }
 
 void Context::fillrect(int x0, int y0, int x1, int y1) {
-    for (auto y = y0; y <= y1; ++y) {
-        drawline(x0, y, x1, y);
+    if (line_style != LINE_STYLE_SOLID) {
+        for (auto y = y0; y <= y1; ++y) {
+            drawline(x0, y, x1, y);
+        }
+        return;
+    }
+
+    // Where solid lines of dots would land, see drawpoint()
+    if (y0 <= y1 && line_width > 0) {
+        fill(min(x0, x1) - line_width, y0 - line_width,
+             max(x0, x1) + line_width - 2, y1 + line_width - 2,
+             foreground);
     }
 }
 
 void Context::eraserect(int x0, int y0, int x1, int y1) {
-    for (auto y = y0; y <= y1; ++y) {
-        for (auto x = x0; x <= x1; ++x) {
-            setpixel(x, y, background);
-        }
+    fill(x0, y0, x1, y1, background);
+}
+
+// Glyph for c, or for '?' if it's not in the font
+static int glyph_index(char c) {
+    const auto g = static_cast<unsigned char>(c) - FONT_FIRST;
+    return 0 <= g && g < FONT_GLYPHS ? g : '?' - FONT_FIRST;
+}
+
+// Or bits, leftmost in the top bit, into row at pixel pos
+static void pack_bits(uint8_t* row, int pos, uint32_t bits) {
+    const auto shifted = uint64_t{bits} << 32 >> (pos % 8);
+    for (auto k = 0; k < 5; ++k) {
+        row[pos / 8 + k] |= static_cast<uint8_t>(shifted >> (56 - 8 * k));
     }
 }
 
 void Context::drawchar(int x, int y, char c) {
-    auto index = (c - ' ') * font->Height * (font->Width / 8 + (font->Width % 8 ? 1 : 0));
-    auto ptr = &font->table[index];
-
-    for (auto r = 0; r < font->Height; ++r) {
-        for (auto c = 0; c < font->Width; ++c) {
-            if (*ptr & (0x80 >> (c % 8))) {
-                setpixel(x + c, y + r, foreground);
-            }
-            else {
-                setpixel(x + c, y + r, background);
-            }
+    drawstring_line(x, y, &c, 1);
+}
 
-            // Move to next byte of font data
-            if (c % 8 == 7) {
-                ptr++;
-            }
-        }
+// Glyphs side by side, each row of all of them packed and blitted at once
+void Context::drawstring_line(int x, int y, const char* s, int n) {
+    auto width = 0;
+    for (auto i = 0; i < n; ++i) {
+        width += font->glyphs[glyph_index(s[i])].advance;
+    }
+    const auto row_bytes = (width + 7) / 8;
 
-        // Move to next row of font data
-        if (font->Width % 8 != 0) {
-            ptr++;
+    // Room for the last word to spill over
+    const auto row = static_cast<uint8_t*>(alloca(row_bytes + 5));
+    for (auto r = 0; r < font->Height; ++r) {
+        memset(row, 0, row_bytes + 5);
+        auto pos = 0;
+        for (auto i = 0; i < n; ++i) {
+            const auto g = glyph_index(s[i]);
+            pack_bits(row, pos, font->rows[g * font->Height + r]);
+            pos += font->glyphs[g].advance;
         }
+        blit_row(x, y + r, row, row_bytes, 0, width, foreground, background);
     }
 }
 
@@ -218,8 +384,28 @@ void Context::drawstring(int left, int top, const char* s) {
             y = top;
         }
 
-        drawchar(x, y, *s++);
-        x += font->Width;
+        // As many as fit before the next wrap.  If even the first line
+        // doesn't fit, every glyph goes back to the start
+        const auto stuck = y + font->Height > image->height;
+        auto n = 0;
+        auto w = 0;
+        while (s[n] && !(stuck && n == 1)) {
+            const auto advance = font->glyphs[glyph_index(s[n])].advance;
+            if (x + w + font->Width > image->width) {
+                break;
+            }
+            w += advance;
+            ++n;
+        }
+        if (n == 0) {
+            // Doesn't fit even at the left, so clipped
+            w = font->glyphs[glyph_index(*s)].advance;
+            n = 1;
+        }
+
+        drawstring_line(x, y, s, n);
+        s += n;
+        x += w;
     }
 }
 
@@ -232,23 +418,120 @@ void Context::drawimage(
     int w,
     int h)
 {
-    for (auto y = 0; y < h; ++y) {
-        for (auto x = 0; x < w; ++x) {
-            const auto x_src = x_from + x;
-            const auto y_src = y_from + y;
-            const auto x_dst = x_to + x;
-            const auto y_dst = y_to + y;
-            if (x_src < 0 || source.width <= x_src || y_src < 0 || source.height <= y_src) {
-                continue;
-            }
-            const auto byte = source.data_[y_src * source.width_bytes + x_src / 8];
-            const auto bit  = 0x80 >> (x_src % 8);
-            const auto color = byte & bit ? background : foreground;
-            setpixel(x_dst, y_dst, color);
+    // Only what's inside the source
+    const auto skip = max(0, -x_from);
+    const auto span = min(x_from + w, source.width) - (x_from + skip);
+    for (auto y = max(0, -y_from); y < h && y_from + y < source.height; ++y) {
+        const auto row = &source.data_[(y_from + y) * source.width_bytes];
+        blit_row(x_to + skip, y_to + y, row, source.width_bytes, x_from + skip, span, background, foreground);
+    }
+}
+
+void Context::drawtile(int x, int y, const TileAtlas& atlas, int tile) {
+    assert(0 <= tile && tile < atlas.size());
+    const auto size = TileAtlas::TILE_SIZE;
+
+    auto x0 = x;
+    auto y0 = y;
+    auto x1 = x + size - 1;
+    auto y1 = y + size - 1;
+    transform_point(x0, y0);
+    transform_point(x1, y1);
+    const auto left = min(x0, x1);
+    const auto top  = min(y0, y1);
+
+    if (atlas.rotate == rotate && left % 8 == 0 &&
+        0 <= left && left + size <= image->width &&
+        0 <= top  && top  + size <= image->height)
+    {
+        const auto& bits = atlas.tiles[tile];
+        auto dst = &image->data_[top * image->width_bytes + left / 8];
+        for (auto r = 0; r < size; ++r, dst += image->width_bytes) {
+            dst[0] = bits[2 * r];
+            dst[1] = bits[2 * r + 1];
+        }
+        return;
+    }
+
+    const auto save_foreground = foreground;
+    const auto save_background = background;
+    foreground = atlas.foreground;
+    background = atlas.background;
+    drawimage(x, y, atlas.sheet, tile % atlas.columns * size, tile / atlas.columns * size, size, size);
+    foreground = save_foreground;
+    background = save_background;
+}
+
+Rect Context::to_image(const Rect& rect) const {
+    if (rect.empty()) {
+        return {};
+    }
+
+    auto x0 = rect.left;
+    auto y0 = rect.top;
+    auto x1 = rect.right - 1;
+    auto y1 = rect.bottom - 1;
+    transform_point(x0, y0);
+    transform_point(x1, y1);
+
+    Rect pixels{
+        max(min(x0, x1), 0),
+        max(min(y0, y1), 0),
+        min(max(x0, x1) + 1, image->width),
+        min(max(y0, y1) + 1, image->height),
+    };
+    return pixels.empty() ? Rect{} : pixels;
+}
+
+bool Rect::intersects(const Rect& other) const {
+    return !empty() && !other.empty() &&
+        left < other.right && other.left < right &&
+        top < other.bottom && other.top < bottom;
+}
+
+void Rect::unite(const Rect& other) {
+    if (other.empty()) {
+        return;
+    }
+    if (empty()) {
+        *this = other;
+        return;
+    }
+    left   = min(left,   other.left);
+    top    = min(top,    other.top);
+    right  = max(right,  other.right);
+    bottom = max(bottom, other.bottom);
+}
+
+TileAtlas::TileAtlas(const Image& sheet, Rotate rotate, PixelColor foreground, PixelColor background)
+    : rotate{rotate},
+      foreground{foreground},
+      background{background},
+      sheet{sheet},
+      columns{sheet.width / TILE_SIZE}
+{
+    // Each tile drawn by itself, the way a context would draw it anywhere
+    Image tile{TILE_SIZE, TILE_SIZE};
+    Context context;
+    context.image      = &tile;
+    context.rotate     = rotate;
+    context.foreground = foreground;
+    context.background = background;
+
+    const auto rows = sheet.height / TILE_SIZE;
+    for (auto r = 0; r < rows; ++r) {
+        for (auto c = 0; c < columns; ++c) {
+            context.drawimage(0, 0, sheet, c * TILE_SIZE, r * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+            tiles.emplace_back();
+            copy(tile.data_.begin(), tile.data_.end(), tiles.back().begin());
         }
     }
 }
 
+bool TileAtlas::matches(Rotate rotate, PixelColor foreground, PixelColor background) const {
+    return this->rotate == rotate && this->foreground == foreground && this->background == background;
+}
+
 // This file is part of the Raccoon's Centaur Mods (RCM).
 //
 // RCM is free software: you can redistribute it and/or modify
@@ -7,6 +7,10 @@
 #include "fonts/fonts.h"
 #include "image.h"
 
+#include <array>
+#include <cstdint>
+#include <vector>
+
 enum DotStyle {
     DOT_FILL_AROUND,
     DOT_FILL_RIGHTUP,
@@ -27,6 +31,46 @@ enum Rotate {
 
 struct sFONT;
 
+// Square tiles cut from a sheet, numbered across it and then down.  Each is
+// stored already rotated, and colored, as Context draws it, as 16 rows of 2
+// bytes.  Drawing one with its left edge on a byte boundary of the image is
+// then just 16 two-byte stores
+class TileAtlas {
+public:
+    static constexpr int TILE_SIZE = 16;
+
+    TileAtlas(const Image& sheet, Rotate rotate, PixelColor foreground, PixelColor background);
+
+    int size() const { return static_cast<int>(tiles.size()); }
+
+    // Whether tiles are as a context with these settings would draw them
+    bool matches(Rotate rotate, PixelColor foreground, PixelColor background) const;
+
+private:
+    friend class Context;
+
+    Rotate     rotate;
+    PixelColor foreground;
+    PixelColor background;
+    Image      sheet;  // For tiles that don't land on a byte boundary
+    int        columns;
+    std::vector<std::array<std::uint8_t, 2 * TILE_SIZE>> tiles;
+};
+
+// Right and bottom are exclusive
+struct Rect {
+    int left;
+    int top;
+    int right;
+    int bottom;
+
+    bool empty() const { return right <= left || bottom <= top; }
+    bool intersects(const Rect& other) const;
+
+    // Smallest rect holding both
+    void unite(const Rect& other);
+};
+
 class Context {
 public:
     Image*       image;
@@ -57,27 +101,54 @@ public:
         int w,
         int h);
 
+    // Tile from atlas with its top left at (x, y), in the atlas' colors
+    void drawtile(int x, int y, const TileAtlas& atlas, int tile);
+
+    // Pixels of the image under rect, clipped to it
+    Rect to_image(const Rect& rect) const;
+
 private:
     void transform_point(int& x, int& y) const;
     void setpixel(int x, int y, PixelColor color);
+
+    // Fast paths, a byte at a time where rotation keeps rows as rows
+    void fill(int x0, int y0, int x1, int y1, PixelColor color);
+    void fill_span(int y, int x0, int x1, PixelColor color);
+    void blit_row(
+        int                 x,
+        int                 y,
+        const std::uint8_t* row,
+        int                 row_bytes,
+        int                 bit,
+        int                 w,
+        PixelColor          set,
+        PixelColor          unset);
     void drawline_low(int x0, int y0, int x1, int y1);
     void drawline_high(int x0, int y0, int x1, int y1);
     void drawchar(int x, int y, char c);
+    void drawstring_line(int x, int y, const char* s, int n);
 };
 
-struct Rect {
-    int left;
-    int top;
-    int right;
-    int bottom;
-};
-
+// Retained: a view keeps what it drew, and redraws only what's been
+// invalidated, by itself or by its owner, since
 class View {
 public:
     Rect bounds;
 
     virtual ~View() = default;
-    virtual void render(Context& context) = 0;
+
+    // Draw at least the invalid area, and return what was drawn, empty if
+    // nothing.  Then all of it's valid again
+    virtual Rect render(Context& context) = 0;
+
+    // Needs drawing again, all of it or just part
+    void invalidate() { dirty = bounds; }
+    void invalidate(const Rect& rect) { dirty.unite(rect); }
+
+    virtual bool invalid() const { return !dirty.empty(); }
+
+protected:
+    Rect dirty{};
 };
 
 #endif
@@ -5,14 +5,39 @@
 #include "centaur.h"
 #include "cfg.h"
 #include "chess/chess.h"
+#include "db.h"
 #include "screen.h"
+#include "utility/broadcast.h"
+#include "utility/latency.h"
+#include "utility/trace.h"
+#include "utility/websocket.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
 #include <cstring>
 #include <cstdio>
-
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <jansson.h>
 #include <pcre2.h>
+#include <poll.h>
 #include <pthread.h>
+#include <strings.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 //
 // Types
@@ -27,6 +52,11 @@ struct HttpdRequest {
     size_t                 body_allocated;
     size_t                 body_used;
     void                  *userdata;
+    void                 (*userdata_free)(void*);
+    HttpdBodyConsumer      consumer;
+    bool                   body_refused;  // By consumer, or for being too big
+    char                  *params[HTTPD_MAX_PARAMS];
+    int                    num_params;
 };
 
 struct HttpdResponse {
@@ -40,9 +70,15 @@ struct HttpdResponse {
 
 void httpd_request_free(struct HttpdRequest *request) {
     assert(request);
+    if (request->userdata && request->userdata_free) {
+        request->userdata_free(request->userdata);
+    }
     if (request->body) {
         free(request->body);
     }
+    for (int i = 0; i != request->num_params; ++i) {
+        free(request->params[i]);
+    }
     free(request);
 }
 
@@ -62,9 +98,20 @@ httpd_request_new(
     request->body_allocated = 0;
     request->body_used      = 0;
     request->userdata       = NULL;
+    request->userdata_free  = NULL;
+    request->consumer       = NULL;
+    request->body_refused   = false;
+    request->num_params     = 0;
     return request;
 }
 
+const char *httpd_request_param(const struct HttpdRequest *request, int n) {
+    if (n < 1 || n > request->num_params) {
+        return NULL;
+    }
+    return request->params[n - 1];
+}
+
 void *httpd_request_userdata(const struct HttpdRequest *request) {
     return request->userdata;
 }
@@ -73,6 +120,15 @@ void httpd_request_set_userdata(struct HttpdRequest *request, void *userdata) {
     request->userdata = userdata;
 }
 
+void
+httpd_request_set_userdata_free(struct HttpdRequest *request, void (*userdata_free)(void*)) {
+    request->userdata_free = userdata_free;
+}
+
+bool httpd_request_body_refused(const struct HttpdRequest *request) {
+    return request->body_refused;
+}
+
 const uint8_t *httpd_request_body(const struct HttpdRequest *request) {
     return request->body;
 }
@@ -169,6 +225,35 @@ httpd_request_query_string(const struct HttpdRequest *request, char **query) {
         query);
 }
 
+bool
+httpd_request_none_match(const struct HttpdRequest *request, const char *etag) {
+    const char *header = httpd_request_header(request, MHD_HTTP_HEADER_IF_NONE_MATCH);
+    if (!header) {
+        return true;
+    }
+
+    // Compared weakly, as If-None-Match allows
+    const size_t len = strlen(etag);
+    for (const char *p = header; *p; ) {
+        p += strspn(p, " \t,");
+        if (*p == '*') {
+            return false;
+        }
+        if (strncmp(p, "W/", 2) == 0) {
+            p += 2;
+        }
+        const char *end = *p == '"' ? strchr(p + 1, '"') : NULL;
+        if (!end) {
+            break;
+        }
+        if (size_t(end + 1 - p) == len && strncmp(p, etag, len) == 0) {
+            return false;
+        }
+        p = end + 1;
+    }
+    return true;
+}
+
 static bool
 is_urlencoded(const struct HttpdRequest *request)
 {
@@ -216,87 +301,439 @@ httpd_response_new(struct MHD_Response *mhd_response, int status_code) {
     return response;
 }
 
+// One a client may keep, as cache_control says
+static struct HttpdResponse*
+httpd_response_cached(
+    struct MHD_Response *mhd_response,
+    int                  status_code,
+    const char          *cache_control,
+    const char          *etag)
+{
+    struct HttpdResponse *response = httpd_response_new(mhd_response, status_code);
+    if (mhd_response) {
+        MHD_del_response_header(mhd_response, "Cache-Control", "no-store");
+        MHD_add_response_header(mhd_response, "Cache-Control", cache_control);
+        if (etag) {
+            MHD_add_response_header(mhd_response, MHD_HTTP_HEADER_ETAG, etag);
+        }
+    }
+    return response;
+}
+
+// One a client may keep, so long as it asks each time whether it's still
+// current
+static struct HttpdResponse*
+httpd_response_tagged(struct MHD_Response *mhd_response, int status_code, const char *etag) {
+    return httpd_response_cached(mhd_response, status_code, "no-cache", etag);
+}
+
+static struct HttpdResponse*
+httpd_response_not_modified(const char *etag) {
+    return httpd_response_tagged(
+        MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT),
+        MHD_HTTP_NOT_MODIFIED,
+        etag);
+}
+
+// Strong entity tag for a generation of something, which can't be mistaken
+// for one from an earlier run
+static std::string
+httpd_etag(const char *kind, std::uint64_t generation) {
+    static const long run = (long)time(NULL);
+
+    char etag[64];
+    snprintf(etag, sizeof etag, "\"%s-%lx-%llx\"", kind, run, (unsigned long long)generation);
+    return etag;
+}
+
 //
 // Handlers
 //
 
-class EventStream : public Observer<Game>, public Observer<Screen> {
+// Server-sent events.  Every change is serialized once, into a numbered
+// ring of events shared by all streams, each of which keeps its place in
+// the ring.  A stream that's caught up suspends its connection, so it costs
+// no thread while it waits, and is resumed when there's a new event or a
+// keepalive is due
+class EventStream {
 public:
-    std::condition_variable cond;
+    struct MHD_Connection  *connection;
     std::mutex              mutex;
-    std::queue<std::string> events;
+    std::uint64_t           cursor;  // Last event sent
+    bool                    reset{false};
+    bool                    keepalive_due{false};
+    bool                    suspended{false};
+    bool                    closing{false};
 
     ~EventStream();
-    EventStream();
+    EventStream(struct MHD_Connection *connection, std::uint64_t cursor);
 
-    void on_changed(Game&) override;
-    void on_changed(Screen&) override;
+    // With mutex held
+    void resume();
 };
 
-void EventStream::on_changed(Game&) {
-    std::lock_guard<std::mutex> lock(mutex);
-    events.push("game_changed");
-    cond.notify_one();
-}
+// Every open stream, for new events, keepalives and shutdown
+static std::mutex               streams_mutex;
+static std::set<EventStream*>   streams;
+static std::condition_variable  keepalive_cond;
+static std::thread              keepalive_thread;
+static bool                     keepalive_stop = false;
 
-void EventStream::on_changed(Screen&) {
-    std::lock_guard<std::mutex> lock(mutex);
-    events.push("screen_changed");
-    cond.notify_one();
+static constexpr auto KEEPALIVE_INTERVAL = std::chrono::seconds(25);
+
+// Complete SSE messages, ready to send
+static constexpr std::size_t EVENT_RING_SIZE = 256;
+static BroadcastRing<std::string> event_ring{EVENT_RING_SIZE};
+
+void EventStream::resume() {
+    if (suspended) {
+        suspended = false;
+        MHD_resume_connection(connection);
+    }
 }
 
 EventStream::~EventStream() {
-    std::lock_guard<std::mutex> lock(mutex);
-    centaur.game->unobserve(this);
-    centaur.screen.unobserve(this);
+    std::lock_guard<std::mutex> lock(streams_mutex);
+    streams.erase(this);
+}
+
+EventStream::EventStream(struct MHD_Connection *connection, std::uint64_t cursor)
+    : connection{connection}, cursor{cursor}
+{
+    std::lock_guard<std::mutex> lock(streams_mutex);
+    streams.insert(this);
+}
+
+// The game as handlers see it, as the broadcaster last followed it (see
+// below), written out once for everyone that asks
+struct GameState {
+    std::uint64_t generation;
+    std::string   fen;
+    std::string   pgn;
+};
+
+static std::mutex game_state_mutex;
+static std::shared_ptr<const GameState> game_state;
+
+static std::shared_ptr<const GameState> current_game_state() {
+    std::lock_guard<std::mutex> lock(game_state_mutex);
+    return game_state;
+}
+
+static std::shared_ptr<const GameState> update_game_state(std::uint64_t generation, const Game& game) {
+    if (auto state = current_game_state(); state && state->generation == generation) {
+        return state;
+    }
+
+    auto state = std::make_shared<const GameState>(GameState{generation, game.fen(), game.pgn()});
+    std::lock_guard<std::mutex> lock(game_state_mutex);
+    game_state = state;
+    return state;
+}
+
+// To every WebSocket client, see below
+static void ws_publish(websocket::Opcode opcode, const std::string& payload);
+
+// Turns Centaur's events into events for every stream and WebSocket, on a
+// thread of its own, so none of it holds up the game.  Screen deltas and
+// analyses coalesce, a burst of them coming to the latest
+class EventBroadcaster {
+public:
+    void start();
+    void stop();
+
+private:
+    std::unique_ptr<Executor> executor;
+    std::uint64_t game{0}, screen{0}, board{0}, analysis{0};  // Subscriptions
+    GameFollower  follower;  // Of the game, on executor
+
+    std::mutex mutex;  // Of publishers, so events are numbered as they're pushed
+
+    void on_game(const GameEvent&);
+    void on_screen(const ScreenEvent&);
+    void on_board(const BoardEvent&);
+    void on_analysis(const AnalysisEvent&);
+
+    void publish(const char *event, const char *data);
+};
+
+static EventBroadcaster event_broadcaster;
+
+void EventBroadcaster::start() {
+    executor = std::make_unique<Executor>("events");
+
+    auto& events = centaur.events;
+    game     = events.game.subscribe(*executor, [this](const GameEvent& e) { on_game(e); });
+    screen   = events.screen.subscribe(
+        *executor, [this](const ScreenEvent& e) { on_screen(e); }, EventBus<ScreenEvent>::LATEST);
+    board    = events.board.subscribe(*executor, [this](const BoardEvent& e) { on_board(e); });
+    analysis = events.analysis.subscribe(
+        *executor, [this](const AnalysisEvent& e) { on_analysis(e); }, EventBus<AnalysisEvent>::LATEST);
+}
+
+// Whatever's queued is dropped, streams being about to close
+void EventBroadcaster::stop() {
+    if (!executor) {
+        return;
+    }
+    auto& events = centaur.events;
+    events.game.unsubscribe(game);
+    events.screen.unsubscribe(screen);
+    events.board.unsubscribe(board);
+    events.analysis.unsubscribe(analysis);
+    executor.reset();
 }
 
-EventStream::EventStream() {
-    std::lock_guard<std::mutex> lock(mutex);
-    centaur.game->observe(this);
-    centaur.screen.observe(this);
+void EventBroadcaster::publish(const char *event, const char *data) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        char *message = NULL;
+        if (asprintf(&message, "id: %llu\nevent: %s\ndata: %s\n\n",
+                     (unsigned long long)(event_ring.last() + 1), event, data) < 0)
+        {
+            return;
+        }
+        event_ring.push(message);
+        free(message);
+
+        char *json = NULL;
+        if (asprintf(&json, "{\"event\": \"%s\", \"data\": %s}", event, data) >= 0) {
+            ws_publish(websocket::TEXT, json);
+            free(json);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(streams_mutex);
+    for (auto stream : streams) {
+        std::lock_guard<std::mutex> stream_lock(stream->mutex);
+        stream->resume();
+    }
+}
+
+// The move just played, if that's what changed, and where it leaves the game
+void EventBroadcaster::on_game(const GameEvent& event) {
+    if (!follower.follow(event)) {
+        return;
+    }
+    const auto state = update_game_state(event.generation, follower.game());
+    if (event.quiet) {
+        return;
+    }
+
+    char *data = NULL;
+    const int rc = !event.uci.empty()
+        ? asprintf(
+            &data,
+            "{\"timestamp\": %ld, \"ply\": %zu, \"uci\": \"%s\", \"san\": \"%s\", \"fen\": \"%s\"}",
+            (long)event.timestamp,
+            event.ply,
+            event.uci.c_str(),
+            event.san.c_str(),
+            state->fen.c_str())
+        : asprintf(
+            &data,
+            "{\"timestamp\": %ld, \"ply\": %zu, \"uci\": null, \"san\": null, \"fen\": \"%s\"}",
+            (long)event.timestamp,
+            event.ply,
+            state->fen.c_str());
+    if (rc >= 0) {
+        publish("game_changed", data);
+        free(data);
+    }
 }
 
+// Screen deltas as u32 little-endian generation, and the generation they
+// apply to, then the delta.  Binary, since it's for WebSockets only
+static std::string screen_payload(const ScreenDelta& delta) {
+    static constexpr std::uint8_t SCREEN = 0x02;
+
+    std::string payload;
+    payload += char(SCREEN);
+    for (int i = 0; i != 4; ++i) {
+        payload += char(delta.generation >> 8 * i);
+    }
+    for (int i = 0; i != 4; ++i) {
+        payload += char(delta.base >> 8 * i);
+    }
+    payload += delta.data;
+    return payload;
+}
+
+// The latest frame, however many were drawn since the last event
+void EventBroadcaster::on_screen(const ScreenEvent& event) {
+    char data[64];
+    snprintf(data, sizeof data, "{\"timestamp\": %ld, \"generation\": %u}",
+             (long)event.timestamp, event.generation);
+    publish("screen_changed", data);
+
+    // Mirrors follow along from whatever frame they have, which is the one
+    // before unless they're new or have missed some, when they ask for a
+    // keyframe
+    if (auto delta = centaur.screen.delta()) {
+        ws_publish(websocket::BINARY, screen_payload(*delta));
+    }
+}
+
+// Boardstate as u64 little-endian, then the count of new actions and each
+// as lift and place squares, 0xFF for none.  Binary, since it's for
+// WebSockets only
+void EventBroadcaster::on_board(const BoardEvent& mirror) {
+    static constexpr std::uint8_t BOARD = 0x01;
+
+    auto square = [](thc::Square square) {
+        return char(square == thc::SQUARE_INVALID ? 0xFF : square);
+    };
+
+    const auto count = std::min<std::size_t>(mirror.actions.size(), 255);
+    std::string payload;
+    payload += char(BOARD);
+    for (int i = 0; i != 8; ++i) {
+        payload += char(mirror.boardstate >> 8 * i);
+    }
+    payload += char(count);
+    for (std::size_t i = mirror.actions.size() - count; i != mirror.actions.size(); ++i) {
+        payload += square(mirror.actions[i].lift);
+        payload += square(mirror.actions[i].place);
+    }
+    ws_publish(websocket::BINARY, payload);
+}
+
+// The engine's best lines so far, each with its score from the side to
+// move, as centipawns or moves to mate, and its moves in UCI notation
+void EventBroadcaster::on_analysis(const AnalysisEvent& event) {
+    const auto& latest = event.analysis;
+
+    // Built up whole, as a search's numbers run to any length
+    char key[17];
+    snprintf(key, sizeof key, "%016llx", (unsigned long long)latest.key);
+    std::string data = "{\"timestamp\": " + std::to_string((long)event.timestamp);
+    data += ", \"key\": \"";
+    data += key;
+    data += latest.done ? "\", \"done\": true, \"lines\": [" : "\", \"done\": false, \"lines\": [";
+    for (std::size_t i = 0; i != latest.lines; ++i) {
+        const auto& line = latest.line[i];
+        data += i ? ", {\"multipv\": " : "{\"multipv\": ";
+        data += std::to_string(line.multipv);
+        data += ", \"depth\": " + std::to_string(line.depth);
+        data += ", \"seldepth\": " + std::to_string(line.seldepth);
+        data += line.mate ? ", \"score\": {\"mate\": " : ", \"score\": {\"cp\": ";
+        data += std::to_string(line.score);
+        data += "}, \"nodes\": " + std::to_string(line.nodes);
+        data += ", \"nps\": " + std::to_string(line.nps);
+        data += ", \"time\": " + std::to_string(line.time);
+        data += ", \"pv\": [";
+        for (std::size_t j = 0; j != line.pv_length; ++j) {
+            char move[6];
+            uci_text(line.pv[j], move);
+            data += j ? ", \"" : "\"";
+            data += move;
+            data += '"';
+        }
+        data += "]}";
+    }
+    data += "]}";
+    publish("analysis", data.c_str());
+}
+
+// Every event since the stream's last that fits, or a reset if it missed
+// some, or a keepalive if that's due, or else suspend until there's one or
+// the other
 static ssize_t
 stream_events(EventStream *stream, uint64_t pos, char *buf, size_t max)
 {
     (void)pos;
 
-    // Keepalive
-    int rc = snprintf(buf, max, ":\n\n");
-
-    auto to = std::chrono::system_clock::now() + std::chrono::seconds(25);
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (stream->closing) {
+        return MHD_CONTENT_READER_END_OF_STREAM;
+    }
 
-    std::unique_lock<std::mutex> lock(stream->mutex);
-    stream->cond.wait_until(lock, to);
-    struct timespec ts;
-    clock_gettime(CLOCK_REALTIME, &ts);
-    if (stream->events.empty()) {
-        rc = snprintf(buf, max, "event: keepalive\ndata: {\"timestamp\": %ld}\n\n", ts.tv_sec);
+    size_t len = 0;
+    const bool caught_up = event_ring.read(
+        stream->cursor,
+        [&](uint64_t, const std::string& message) {
+            if (message.size() > max - len) {
+                // The rest next time
+                return false;
+            }
+            memcpy(buf + len, message.data(), message.size());
+            len += message.size();
+            return true;
+        });
+
+    // Too far behind to catch up, so start again from now.  The client has
+    // to fetch what it's missed
+    if (!caught_up || stream->reset) {
+        stream->cursor = event_ring.last();
+        stream->reset  = false;
+        len = snprintf(buf, max, "id: %llu\nevent: reset\ndata: {\"timestamp\": %ld}\n\n",
+                       (unsigned long long)stream->cursor, (long)time(NULL));
     }
-    else {
-        std::string event = stream->events.front();
-        stream->events.pop();
-        rc = snprintf(
-            buf, max, "event: %s\ndata: {\"timestamp\": %ld}\n\n", event.data(), ts.tv_sec);
+
+    if (len == 0 && stream->keepalive_due) {
+        len = snprintf(buf, max, "event: keepalive\ndata: {\"timestamp\": %ld}\n\n", (long)time(NULL));
     }
+    stream->keepalive_due = false;
 
-    return rc;
+    if (len == 0) {
+        MHD_suspend_connection(stream->connection);
+        stream->suspended = true;
+    }
+    return len;
 }
 
 static void stream_free(struct EventStream *stream) {
     delete stream;
 }
 
+// Wake every stream now and then, so it sends something and a dead client
+// is noticed
+static void send_keepalives() {
+    std::unique_lock<std::mutex> lock(streams_mutex);
+    while (!keepalive_cond.wait_for(lock, KEEPALIVE_INTERVAL, [] { return keepalive_stop; })) {
+        for (auto stream : streams) {
+            std::lock_guard<std::mutex> stream_lock(stream->mutex);
+            stream->keepalive_due = true;
+            stream->resume();
+        }
+    }
+}
+
+// Streams end, rather than hold up the daemon's shutdown
+static void close_streams() {
+    std::lock_guard<std::mutex> lock(streams_mutex);
+    for (auto stream : streams) {
+        std::lock_guard<std::mutex> stream_lock(stream->mutex);
+        stream->closing = true;
+        stream->resume();
+    }
+}
+
+// Picks up after Last-Event-ID when the client is reconnecting, else from
+// the next event
 static struct HttpdResponse*
 get_events(struct HttpdRequest *request) {
-    (void)request;
+    std::uint64_t cursor = event_ring.last();
+    bool          reset  = false;
+
+    const char *last_event_id = httpd_request_header(request, "Last-Event-ID");
+    if (last_event_id) {
+        char *end = NULL;
+        const unsigned long long id = strtoull(last_event_id, &end, 10);
+        if (end != last_event_id && *end == '\0') {
+            cursor = id;
+        }
+        else {
+            reset = true;
+        }
+    }
 
-    auto stream = new EventStream();
+    auto stream = new EventStream(request->mhd_connection, cursor);
+    stream->reset = reset;
 
     struct MHD_Response *mhd_response = MHD_create_response_from_callback(
         MHD_SIZE_UNKNOWN,
-        1024,
+        4096,
         (MHD_ContentReaderCallback)stream_events,
         stream,
         (MHD_ContentReaderFreeCallback)stream_free);
@@ -305,49 +742,982 @@ get_events(struct HttpdRequest *request) {
     return httpd_response_new(mhd_response, 200);
 }
 
+// WebSockets
+//
+// Every client is pushed the board as it's read and the screen as it's
+// drawn, in binary frames, and the same events as SSE streams, as JSON
+// text frames.  Clients send commands for the game back as text, and
+// "keyframe" for a whole screen to apply the deltas that follow to.
+// Upgraded sockets are left to one thread of our own, polling them all, so
+// none ties up the daemon's
+
+struct WebSocketClient {
+    MHD_socket                        socket;
+    struct MHD_UpgradeResponseHandle *urh;
+    std::uint64_t   cursor;       // Last message queued
+    std::string     pending;      // Messages, partly sent
+    std::string     replies;      // Pongs and closing, ahead of any message
+    WebSocketReader reader;
+    bool            closing{false};
+};
+
+// Whole frames, ready to send
+static BroadcastRing<std::string> ws_ring{EVENT_RING_SIZE};
+
+static std::mutex                    ws_mutex;  // Of ws_joining and ws_stop
+static std::vector<WebSocketClient*> ws_joining;
+static bool                          ws_stop = false;
+static int                           ws_wakeup = -1;  // eventfd
+static std::thread                   ws_thread;
+
+// Most to queue for a client at once
+static constexpr std::size_t WS_PENDING = 64 * 1024;
+
+static void ws_wake() {
+    const std::uint64_t one = 1;
+    if (ws_wakeup >= 0 && write(ws_wakeup, &one, sizeof one) != sizeof one) {
+        perror("write");
+    }
+}
+
+static void ws_publish(websocket::Opcode opcode, const std::string& payload) {
+    ws_ring.push(websocket::frame(opcode, payload));
+    ws_wake();
+}
+
+static void ws_command(WebSocketClient& client, const std::string& command) {
+    bool queued = false;
+    if (command == "takeback") {
+        queued = centaur.command(REMOTE_TAKEBACK);
+    }
+    else if (command == "new_game") {
+        queued = centaur.command(REMOTE_NEW_GAME);
+    }
+    else if (command == "keyframe") {
+        // After whatever's queued, so deltas that follow apply to it
+        client.pending += websocket::frame(
+            websocket::BINARY, screen_payload(centaur.screen.keyframe()));
+        return;
+    }
+    else {
+        client.replies += websocket::frame(
+            websocket::TEXT, "{\"event\": \"error\", \"data\": {\"error\": \"unknown command\"}}");
+        return;
+    }
+    if (!queued) {
+        client.replies += websocket::frame(
+            websocket::TEXT, "{\"event\": \"error\", \"data\": {\"error\": \"busy\"}}");
+    }
+}
+
+static void ws_close(WebSocketClient& client, std::uint16_t code) {
+    const char status[2] = {char(code >> 8), char(code)};
+    client.replies += websocket::frame(websocket::CLOSE, std::string(status, 2));
+    client.pending.clear();
+    client.closing = true;
+}
+
+// Everything the client's sent, false once it's gone
+static bool ws_read(WebSocketClient& client) {
+    char buf[4096];
+    for (;;) {
+        const ssize_t n = recv(client.socket, buf, sizeof buf, 0);
+        if (n == 0) {
+            return false;
+        }
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+            break;
+        }
+        client.reader.feed(buf, n);
+    }
+
+    websocket::Opcode opcode;
+    std::string       payload;
+    while (!client.closing && client.reader.next(opcode, payload)) {
+        switch (opcode) {
+        case websocket::TEXT:
+            ws_command(client, payload);
+            break;
+        case websocket::PING:
+            client.replies += websocket::frame(websocket::PONG, payload);
+            break;
+        case websocket::CLOSE:
+            ws_close(client, 1000);
+            break;
+        default:
+            break;
+        }
+    }
+    if (client.reader.failed() && !client.closing) {
+        ws_close(client, 1002);
+    }
+    return true;
+}
+
+// Whatever the client can take, replies first.  False once it's gone, or
+// has been sent all it's getting
+static bool ws_write(WebSocketClient& client) {
+    for (;;) {
+        auto& out = client.replies.empty() ? client.pending : client.replies;
+        if (out.empty()) {
+            return !client.closing;
+        }
+        const ssize_t n = send(client.socket, out.data(), out.size(), MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        out.erase(0, n);
+    }
+}
+
+// New messages for the client, and a reset if it's missed some
+static void ws_queue(WebSocketClient& client) {
+    if (client.closing || client.pending.size() >= WS_PENDING) {
+        return;
+    }
+    const bool caught_up = ws_ring.read(
+        client.cursor,
+        [&](std::uint64_t, const std::string& frame) {
+            client.pending += frame;
+            return client.pending.size() < WS_PENDING;
+        });
+    if (!caught_up) {
+        client.cursor = ws_ring.last();
+        client.pending += websocket::frame(websocket::TEXT, "{\"event\": \"reset\", \"data\": {}}");
+    }
+}
+
+static void ws_release(WebSocketClient *client) {
+    MHD_upgrade_action(client->urh, MHD_UPGRADE_ACTION_CLOSE);
+    delete client;
+}
+
+static void serve_websockets() {
+    TRACE_THREAD("websocket");
+
+    std::vector<WebSocketClient*> clients;
+    std::vector<struct pollfd>    fds;
+
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(ws_mutex);
+            if (ws_stop) {
+                break;
+            }
+            clients.insert(clients.end(), ws_joining.begin(), ws_joining.end());
+            ws_joining.clear();
+        }
+
+        fds.assign(1, {ws_wakeup, POLLIN, 0});
+        for (auto client : clients) {
+            ws_queue(*client);
+            const bool writing = !client->replies.empty() || !client->pending.empty();
+            fds.push_back({client->socket, short(POLLIN | (writing ? POLLOUT : 0)), 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0 && errno != EINTR) {
+            perror("poll");
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            std::uint64_t count;
+            (void)read(ws_wakeup, &count, sizeof count);
+        }
+
+        // Whoever's gone, or done with
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i != clients.size(); ++i) {
+            auto client = clients[i];
+            const auto revents = fds[i + 1].revents;
+            bool open = true;
+            if (revents & (POLLIN | POLLHUP | POLLERR)) {
+                open = ws_read(*client);
+            }
+            if (open) {
+                ws_queue(*client);
+                open = ws_write(*client);
+            }
+            if (open) {
+                clients[kept++] = client;
+            } else {
+                ws_release(client);
+            }
+        }
+        clients.resize(kept);
+    }
+
+    for (auto client : clients) {
+        ws_release(client);
+    }
+}
+
+// Handshake done, the socket's ours
+static void
+ws_upgraded(
+    void                             *cls,
+    struct MHD_Connection            *connection,
+    void                             *req_cls,
+    const char                       *extra_in,
+    size_t                            extra_in_size,
+    MHD_socket                        socket,
+    struct MHD_UpgradeResponseHandle *urh)
+{
+    (void)cls;
+    (void)connection;
+    (void)req_cls;
+
+    fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK);
+
+    auto client = new WebSocketClient{socket, urh, ws_ring.last(), {}, {}, {}, false};
+    if (extra_in_size) {
+        client->reader.feed(extra_in, extra_in_size);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(ws_mutex);
+        if (!ws_stop) {
+            ws_joining.push_back(client);
+            client = NULL;
+        }
+    }
+    if (client) {
+        ws_release(client);
+    }
+    ws_wake();
+}
+
+static bool header_has_token(const char *header, const char *token) {
+    const size_t len = strlen(token);
+    for (const char *p = header; p && *p; ) {
+        p += strspn(p, " \t,");
+        const size_t n = strcspn(p, " \t,");
+        if (n == len && strncasecmp(p, token, len) == 0) {
+            return true;
+        }
+        p += n;
+    }
+    return false;
+}
+
+static struct HttpdResponse*
+get_ws(struct HttpdRequest *request) {
+    const char *upgrade = httpd_request_header(request, MHD_HTTP_HEADER_UPGRADE);
+    const char *version = httpd_request_header(request, "Sec-WebSocket-Version");
+    const char *key     = httpd_request_header(request, "Sec-WebSocket-Key");
+    if (!header_has_token(upgrade, "websocket") || !version || strcmp(version, "13") != 0 || !key) {
+        struct MHD_Response *mhd_response =
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT);
+        MHD_add_response_header(mhd_response, "Sec-WebSocket-Version", "13");
+        return httpd_response_new(mhd_response, MHD_HTTP_BAD_REQUEST);
+    }
+
+    struct MHD_Response *mhd_response = MHD_create_response_for_upgrade(ws_upgraded, NULL);
+    if (!mhd_response) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 500);
+    }
+    MHD_add_response_header(mhd_response, MHD_HTTP_HEADER_UPGRADE, "websocket");
+    MHD_add_response_header(mhd_response, "Sec-WebSocket-Accept", websocket::accept(key).c_str());
+
+    return httpd_response_new(mhd_response, MHD_HTTP_SWITCHING_PROTOCOLS);
+}
+
+// Text for a generation of the game, unless the client has it already
+static struct HttpdResponse*
+get_game_text(struct HttpdRequest *request, const char *kind, std::string GameState::*text) {
+    const auto state = current_game_state();
+    if (!state) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 503);
+    }
+
+    const auto etag = httpd_etag(kind, state->generation);
+    if (!httpd_request_none_match(request, etag.c_str())) {
+        return httpd_response_not_modified(etag.c_str());
+    }
+
+    const std::string& body = (*state).*text;
+    struct MHD_Response *mhd_response =
+        MHD_create_response_from_buffer(body.size(), (void*)body.data(), MHD_RESPMEM_MUST_COPY);
+    MHD_add_response_header(mhd_response, "Content-Type", "text/plain");
+
+    return httpd_response_tagged(mhd_response, 200, etag.c_str());
+}
+
 static struct HttpdResponse*
 get_fen(struct HttpdRequest *request) {
+    return get_game_text(request, "fen", &GameState::fen);
+}
+
+// Latency histograms for the board pipeline
+static struct HttpdResponse*
+get_latency(struct HttpdRequest *request) {
     (void)request;
 
-    const char *fen = ""; // position_fen(game_current(centaur.game));
-    size_t      len = strlen(fen);
+    const auto latency = LatencyHistogram::json();
+    char *json = strdup(latency.c_str());
 
     struct MHD_Response *mhd_response =
-        MHD_create_response_from_buffer(len, (void*)fen, MHD_RESPMEM_PERSISTENT);
-    MHD_add_response_header(mhd_response, "Content-Type", "text/plain");
+        MHD_create_response_from_buffer(strlen(json), json, MHD_RESPMEM_MUST_FREE);
+    MHD_add_response_header(mhd_response, "Content-Type", "application/json");
 
     return httpd_response_new(mhd_response, 200);
 }
 
+// Chrome trace JSON of the latest spans on every thread, see
+// utility/trace.h.  Empty unless built with tracing
 static struct HttpdResponse*
-get_pgn(struct HttpdRequest *request) {
+get_trace(struct HttpdRequest *request) {
     (void)request;
 
-    const char *pgn = ""; // game_pgn(centaur.game);
-    size_t      len = strlen(pgn);
+    const auto trace = trace_json();
+    char *json = strdup(trace.c_str());
 
     struct MHD_Response *mhd_response =
-        MHD_create_response_from_buffer(len, (void*)pgn, MHD_RESPMEM_PERSISTENT);
-    MHD_add_response_header(mhd_response, "Content-Type", "text/plain");
+        MHD_create_response_from_buffer(strlen(json), json, MHD_RESPMEM_MUST_FREE);
+    MHD_add_response_header(mhd_response, "Content-Type", "application/json");
+    MHD_add_response_header(mhd_response, "Cache-Control", "no-store");
 
     return httpd_response_new(mhd_response, 200);
 }
 
+static struct HttpdResponse*
+get_pgn(struct HttpdRequest *request) {
+    return get_game_text(request, "pgn", &GameState::pgn);
+}
+
+// Response body holding its reference to the frame's PNG
+static ssize_t
+read_png(std::shared_ptr<const ScreenPng> *png, uint64_t pos, char *buf, size_t max)
+{
+    const auto n = std::min<uint64_t>(max, (*png)->size - pos);
+    memcpy(buf, (*png)->data + pos, n);
+    return n;
+}
+
+static void
+free_png(std::shared_ptr<const ScreenPng> *png) {
+    delete png;
+}
+
 static struct HttpdResponse*
 get_screen(struct HttpdRequest *request) {
-    (void)request;
+    // Without encoding anything, if the client has the newest frame
+    const auto newest = httpd_etag("screen", centaur.screen.frame());
+    if (!httpd_request_none_match(request, newest.c_str())) {
+        return httpd_response_not_modified(newest.c_str());
+    }
+
+    auto png = centaur.screen.png();
+    if (!png) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 500);
+    }
 
-    uint8_t *png  = NULL;
-    size_t   size = 0;
-    centaur.screen.png(&png, &size);
+    // Which may not quite be the newest
+    const auto etag = httpd_etag("screen", png->generation);
 
-    struct MHD_Response *mhd_response =
-        MHD_create_response_from_buffer(size, png, MHD_RESPMEM_MUST_FREE);
+    const auto size = png->size;
+    struct MHD_Response *mhd_response = MHD_create_response_from_callback(
+        size,
+        4096,
+        (MHD_ContentReaderCallback)read_png,
+        new std::shared_ptr<const ScreenPng>(std::move(png)),
+        (MHD_ContentReaderFreeCallback)free_png);
     MHD_add_response_header(mhd_response, "Content-Type", "image/png");
 
+    return httpd_response_tagged(mhd_response, 200, etag.c_str());
+}
+
+// Web app
+//
+// Files as built into app/dist, with any precompressed sibling the client
+// accepts sent instead, straight from the file by sendfile
+
+static const struct {
+    const char *extension;
+    const char *content_type;
+} content_types[] = {
+    {".css",   "text/css"},
+    {".html",  "text/html; charset=utf-8"},
+    {".ico",   "image/x-icon"},
+    {".jpg",   "image/jpeg"},
+    {".js",    "text/javascript"},
+    {".json",  "application/json"},
+    {".map",   "application/json"},
+    {".mjs",   "text/javascript"},
+    {".mp3",   "audio/mpeg"},
+    {".png",   "image/png"},
+    {".svg",   "image/svg+xml"},
+    {".txt",   "text/plain; charset=utf-8"},
+    {".wasm",  "application/wasm"},
+    {".webp",  "image/webp"},
+    {".woff2", "font/woff2"},
+};
+
+static const char *content_type(const std::string& path) {
+    const auto dot = path.rfind('.');
+    if (dot != std::string::npos && path.find('/', dot) == std::string::npos) {
+        for (const auto& type : content_types) {
+            if (path.compare(dot, std::string::npos, type.extension) == 0) {
+                return type.content_type;
+            }
+        }
+    }
+    return "application/octet-stream";
+}
+
+// File under the app for url, if there can be one.  Nothing climbs out
+static bool app_path(const char *url, std::string& path) {
+    if (url[0] != '/') {
+        return false;
+    }
+
+    for (const char *segment = url + 1; ; ) {
+        const size_t len = strcspn(segment, "/");
+        if ((len == 1 && segment[0] == '.') || (len == 2 && strncmp(segment, "..", 2) == 0)) {
+            return false;
+        }
+        if (!segment[len]) {
+            break;
+        }
+        segment += len + 1;
+    }
+
+    path = url;
+    if (path.back() == '/') {
+        path += "index.html";
+    }
+    return true;
+}
+
+// Whether Accept-Encoding lists coding, and not with q=0
+static bool accepts_encoding(const char *header, const char *coding) {
+    const size_t len = strlen(coding);
+    for (const char *p = header; p && *p; ) {
+        p += strspn(p, " \t,");
+        const size_t token = strcspn(p, " \t,;");
+        const char  *end   = p + strcspn(p, ",");
+        if (token == len && strncasecmp(p, coding, len) == 0) {
+            const char *q = strstr(p, "q=");
+            return !(q && q < end && atof(q + 2) == 0.0);
+        }
+        p = end;
+    }
+    return false;
+}
+
+static const struct {
+    const char *coding;
+    const char *suffix;
+} precompressed[] = {
+    {"br",   ".br"},
+    {"gzip", ".gz"},
+};
+
+static struct HttpdResponse*
+get_app(struct HttpdRequest *request) {
+    std::string path;
+    if (!app_path(httpd_request_url(request), path)) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), MHD_HTTP_NOT_FOUND);
+    }
+    const std::string file = cfg_app_dir() + path;
+
+    // The smallest the client can take
+    const char *accept   = httpd_request_header(request, MHD_HTTP_HEADER_ACCEPT_ENCODING);
+    const char *encoding = NULL;
+    struct stat st;
+    int fd = -1;
+    for (const auto& variant : precompressed) {
+        if (accepts_encoding(accept, variant.coding)) {
+            fd = open((file + variant.suffix).c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd >= 0 && fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+                encoding = variant.coding;
+                break;
+            }
+            if (fd >= 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+    }
+    if (fd < 0) {
+        fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd >= 0 && (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    if (fd < 0) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), MHD_HTTP_NOT_FOUND);
+    }
+
+    char etag[64];
+    snprintf(etag, sizeof etag, "\"app-%lx-%llx%s%s\"",
+             (long)st.st_mtime, (unsigned long long)st.st_size, encoding ? "-" : "", encoding ? encoding : "");
+    if (!httpd_request_none_match(request, etag)) {
+        close(fd);
+        return httpd_response_not_modified(etag);
+    }
+
+    // Takes the fd
+    struct MHD_Response *mhd_response = MHD_create_response_from_fd(st.st_size, fd);
+    if (!mhd_response) {
+        close(fd);
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 500);
+    }
+    MHD_add_response_header(mhd_response, "Content-Type", content_type(path));
+    MHD_add_response_header(mhd_response, MHD_HTTP_HEADER_VARY, MHD_HTTP_HEADER_ACCEPT_ENCODING);
+    if (encoding) {
+        MHD_add_response_header(mhd_response, MHD_HTTP_HEADER_CONTENT_ENCODING, encoding);
+    }
+
+    // Vite names everything it puts in assets/ by a hash of its content
+    const bool immutable = path.compare(0, 8, "/assets/") == 0;
+    return httpd_response_cached(
+        mhd_response,
+        200,
+        immutable ? "public, max-age=31536000, immutable" : "no-cache",
+        etag);
+}
+
+// A page of saved games, newest first, by their Seven Tag Roster:
+// ?before=<id>&limit=<n>, and any of date, white, black and result to
+// filter on.  "next" is the before of the following page, null at the end
+static struct HttpdResponse*
+get_games(struct HttpdRequest *request) {
+    static constexpr int DEFAULT_LIMIT = 50;
+    static constexpr int MAX_LIMIT     = 500;
+    static const char *const keys[7] = {
+        "event", "site", "date", "round", "white", "black", "result"
+    };
+
+    const char *s_before = httpd_request_query_var(request, "before");
+    const char *s_limit  = httpd_request_query_var(request, "limit");
+    const sqlite3_int64 before = s_before ? atoll(s_before) : 0;
+    const int limit = std::clamp(s_limit ? atoi(s_limit) : DEFAULT_LIMIT, 1, MAX_LIMIT);
+
+    GameFilter filter;
+    filter.date   = httpd_request_query_var(request, "date");
+    filter.white  = httpd_request_query_var(request, "white");
+    filter.black  = httpd_request_query_var(request, "black");
+    filter.result = httpd_request_query_var(request, "result");
+
+    std::vector<GameSummary> games;
+    try {
+        games = db.list_games(before, limit, filter);
+    }
+    catch (const std::runtime_error&) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 500);
+    }
+
+    json_t *list = json_array();
+    for (const auto& game : games) {
+        json_t *item = json_object();
+        json_object_set_new(item, "id", json_integer(game.rowid));
+        for (int i = 0; i != 7; ++i) {
+            json_object_set_new(item, keys[i], json_string(game.str[i].c_str()));
+        }
+        json_array_append_new(list, item);
+    }
+    json_t *page = json_object();
+    json_object_set_new(page, "games", list);
+    json_object_set_new(page, "next",
+        (int)games.size() == limit ? json_integer(games.back().rowid) : json_null());
+
+    char *json = json_dumps(page, JSON_COMPACT);
+    json_decref(page);
+    if (!json) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 500);
+    }
+
+    struct MHD_Response *mhd_response =
+        MHD_create_response_from_buffer(strlen(json), json, MHD_RESPMEM_MUST_FREE);
+    MHD_add_response_header(mhd_response, "Content-Type", "application/json");
+
+    return httpd_response_new(mhd_response, 200);
+}
+
+// Saved games whose tags match ?q=<words>, best first, ?limit=<n> of them
+// from ?offset=<n>.  "next" is the offset of the following page, null at
+// the end
+static struct HttpdResponse*
+get_search(struct HttpdRequest *request) {
+    static constexpr int DEFAULT_LIMIT = 50;
+    static constexpr int MAX_LIMIT     = 500;
+    static const char *const keys[7] = {
+        "event", "site", "date", "round", "white", "black", "result"
+    };
+
+    const char *query    = httpd_request_query_var(request, "q");
+    const char *s_limit  = httpd_request_query_var(request, "limit");
+    const char *s_offset = httpd_request_query_var(request, "offset");
+    const int limit  = std::clamp(s_limit ? atoi(s_limit) : DEFAULT_LIMIT, 1, MAX_LIMIT);
+    const int offset = std::max(s_offset ? atoi(s_offset) : 0, 0);
+
+    std::vector<GameSummary> games;
+    try {
+        games = db.search_games(query, limit, offset);
+    }
+    catch (const std::runtime_error&) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 500);
+    }
+
+    json_t *list = json_array();
+    for (const auto& game : games) {
+        json_t *item = json_object();
+        json_object_set_new(item, "id", json_integer(game.rowid));
+        for (int i = 0; i != 7; ++i) {
+            json_object_set_new(item, keys[i], json_string(game.str[i].c_str()));
+        }
+        json_array_append_new(list, item);
+    }
+    json_t *page = json_object();
+    json_object_set_new(page, "games", list);
+    json_object_set_new(page, "next",
+        (int)games.size() == limit ? json_integer(offset + limit) : json_null());
+
+    char *json = json_dumps(page, JSON_COMPACT);
+    json_decref(page);
+    if (!json) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 500);
+    }
+
+    struct MHD_Response *mhd_response =
+        MHD_create_response_from_buffer(strlen(json), json, MHD_RESPMEM_MUST_FREE);
+    MHD_add_response_header(mhd_response, "Content-Type", "application/json");
+
     return httpd_response_new(mhd_response, 200);
 }
 
+// What's been played, over the saved games, from ?fen=<fen> or else the
+// current position, most played first, and the most recent games reaching
+// it.  A move of null is the games that ended there
+static struct HttpdResponse*
+get_explorer(struct HttpdRequest *request) {
+    static constexpr int DEFAULT_LIMIT = 10;
+    static constexpr int MAX_LIMIT     = 100;
+    static const char *const keys[7] = {
+        "event", "site", "date", "round", "white", "black", "result"
+    };
+
+    const char *s_limit = httpd_request_query_var(request, "limit");
+    const int limit = std::clamp(s_limit ? atoi(s_limit) : DEFAULT_LIMIT, 1, MAX_LIMIT);
+
+    std::string fen;
+    if (const char *s_fen = httpd_request_query_var(request, "fen")) {
+        fen = s_fen;
+    } else if (const auto state = current_game_state()) {
+        fen = state->fen;
+    }
+
+    Position position;
+    if (!fen.empty() && !position.Forsyth(fen.c_str())) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 400);
+    }
+
+    Explorer explorer;
+    try {
+        explorer = db.explore(position.key(), limit);
+    }
+    catch (const std::runtime_error&) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 500);
+    }
+
+    json_t *moves = json_array();
+    for (const auto& played : explorer.moves) {
+        json_t *item = json_object();
+        thc::Move move{thc::a8, thc::a8};
+        if (played.move && archive::decode(position, played.move, move)) {
+            json_object_set_new(item, "uci", json_string(move.uci().c_str()));
+            json_object_set_new(item, "san", json_string(position.move_san(move).c_str()));
+        } else {
+            json_object_set_new(item, "uci", json_null());
+            json_object_set_new(item, "san", json_null());
+        }
+        json_object_set_new(item, "games", json_integer(played.games));
+        json_object_set_new(item, "white", json_integer(played.white));
+        json_object_set_new(item, "draws", json_integer(played.draws));
+        json_object_set_new(item, "black", json_integer(played.black));
+        json_array_append_new(moves, item);
+    }
+    json_t *recent = json_array();
+    for (const auto& game : explorer.recent) {
+        json_t *item = json_object();
+        json_object_set_new(item, "id", json_integer(game.rowid));
+        for (int i = 0; i != 7; ++i) {
+            json_object_set_new(item, keys[i], json_string(game.str[i].c_str()));
+        }
+        json_array_append_new(recent, item);
+    }
+    json_t *page = json_object();
+    json_object_set_new(page, "fen",    json_string(position.fen().c_str()));
+    json_object_set_new(page, "games",  json_integer(explorer.games));
+    json_object_set_new(page, "moves",  moves);
+    json_object_set_new(page, "recent", recent);
+
+    char *json = json_dumps(page, JSON_COMPACT);
+    json_decref(page);
+    if (!json) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 500);
+    }
+
+    struct MHD_Response *mhd_response =
+        MHD_create_response_from_buffer(strlen(json), json, MHD_RESPMEM_MUST_FREE);
+    MHD_add_response_header(mhd_response, "Content-Type", "application/json");
+
+    return httpd_response_new(mhd_response, 200);
+}
+
+// What review's found of saved game ?game=<id>, ply by ply: how each
+// position stood for the side to move, the move played from it and the
+// engine's best, and what the move cost.  Complete once the review's got
+// to the end, when the last ply has no move
+static struct HttpdResponse*
+get_review(struct HttpdRequest *request) {
+    static const char *const flags[3] = {NULL, "opportunity", "error"};
+
+    const char *s_game = httpd_request_query_var(request, "game");
+    const sqlite3_int64 rowid = s_game ? atoll(s_game) : 0;
+    if (rowid <= 0) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 400);
+    }
+
+    std::vector<ReviewRow> rows;
+    try {
+        rows = db.load_review(rowid);
+    }
+    catch (const std::runtime_error&) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 500);
+    }
+
+    const auto uci = [](uint16_t token) {
+        char text[6];
+        uci_text(token, text);
+        return token ? json_string(text) : json_null();
+    };
+
+    json_t *plies = json_array();
+    for (const auto& row : rows) {
+        json_t *item = json_object();
+        json_object_set_new(item, "ply",   json_integer(row.ply));
+        json_object_set_new(item, "move",  uci(row.move));
+        json_object_set_new(item, "best",  uci(row.best));
+        json_object_set_new(item, "score", json_integer(row.score));
+        json_object_set_new(item, "mate",  json_boolean(row.mate));
+        json_object_set_new(item, "depth", json_integer(row.depth));
+        json_object_set_new(item, "loss",  json_integer(row.loss));
+        const char *flag = row.flag < 3 ? flags[row.flag] : NULL;
+        json_object_set_new(item, "flag",  flag ? json_string(flag) : json_null());
+        json_array_append_new(plies, item);
+    }
+    json_t *page = json_object();
+    json_object_set_new(page, "id",       json_integer(rowid));
+    json_object_set_new(page, "complete", json_boolean(!rows.empty() && !rows.back().move));
+    json_object_set_new(page, "plies",    plies);
+
+    char *json = json_dumps(page, JSON_COMPACT);
+    json_decref(page);
+    if (!json) {
+        return httpd_response_new(
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT), 500);
+    }
+
+    struct MHD_Response *mhd_response =
+        MHD_create_response_from_buffer(strlen(json), json, MHD_RESPMEM_MUST_FREE);
+    MHD_add_response_header(mhd_response, "Content-Type", "application/json");
+
+    return httpd_response_new(mhd_response, 200);
+}
+
+// Import the games in a PGN request body, as it arrives.  The body goes
+// down a socket to an import reading it as a stream, on a thread of its
+// own, so the upload never has to fit in memory.  Whenever the import falls
+// behind, the upload's connection is suspended, so it holds up none of the
+// daemon's threads, until there's room in the socket again
+struct GamesImport {
+    int         fd{-1};  // Ours, non-blocking, the import reads the other end
+    std::thread thread;
+    ImportStats stats;
+    bool        failed{false};
+
+    // Resuming the upload once the import's caught up
+    std::mutex              mutex;  // Of what follows
+    std::condition_variable cond;
+    struct MHD_Connection  *connection{NULL};  // Suspended, if any
+    bool                    stop{false};
+    std::thread             waker;
+
+    ~GamesImport() { finish(); }
+
+    // With the connection the upload's on.  Called on the daemon's thread,
+    // from the body's consumer
+    void suspend(struct MHD_Connection *upload) {
+        std::lock_guard<std::mutex> lock(mutex);
+        MHD_suspend_connection(upload);
+        connection = upload;
+        cond.notify_one();
+    }
+
+    void wake() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            cond.wait(lock, [this] { return stop || connection; });
+            if (stop) {
+                break;
+            }
+
+            // Writable, or the import's gone (and sending fails)
+            lock.unlock();
+            pollfd pfd{fd, POLLOUT, 0};
+            const auto ready = poll(&pfd, 1, 100) != 0;
+            lock.lock();
+            if (ready) {
+                MHD_resume_connection(std::exchange(connection, nullptr));
+            }
+        }
+        if (connection) {
+            MHD_resume_connection(std::exchange(connection, nullptr));
+        }
+    }
+
+    // Let the import see the end, and wait for it
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        cond.notify_one();
+        if (waker.joinable()) {
+            waker.join();
+        }
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+};
+
+static void import_free(void *import) {
+    delete (GamesImport*)import;
+}
+
+static GamesImport *import_start() {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+        return NULL;
+    }
+
+    if (fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK) != 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return NULL;
+    }
+
+    auto import = new GamesImport;
+    import->fd     = fds[0];
+    import->waker  = std::thread(&GamesImport::wake, import);
+    import->thread = std::thread([import, fd = fds[1]] {
+        try {
+            PgnReader reader{fd};
+            import->stats = db.import_games(reader);
+        }
+        catch (const std::runtime_error&) {
+            import->failed = true;
+        }
+    });
+    return import;
+}
+
+static bool
+post_games_body(struct HttpdRequest *request, const char *data, size_t *len) {
+    auto import = (GamesImport*)httpd_request_userdata(request);
+    if (!import) {
+        import = import_start();
+        if (!import) {
+            return false;
+        }
+        httpd_request_set_userdata(request, import);
+        httpd_request_set_userdata_free(request, import_free);
+    }
+
+    if (*len == 0) {
+        import->finish();
+        return true;
+    }
+
+    while (*len) {
+        const ssize_t n = send(import->fd, data, *len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // The rest once the import's caught up
+                import->suspend(request->mhd_connection);
+                return true;
+            }
+            // The import's given up
+            return false;
+        }
+        data += n;
+        *len -= n;
+    }
+    return true;
+}
+
+static struct HttpdResponse*
+post_games(struct HttpdRequest *request) {
+    auto import = (GamesImport*)httpd_request_userdata(request);
+    if (import) {
+        import->finish();
+    }
+
+    char *json   = NULL;
+    int   status = 200;
+    if (!import) {
+        json = strdup("{\"imported\": 0, \"rejected\": 0}");
+    }
+    else if (import->failed || httpd_request_body_refused(request)) {
+        json   = strdup("{\"error\": \"import failed\"}");
+        status = 500;
+    }
+    else {
+        asprintf(&json, "{\"imported\": %zu, \"rejected\": %zu}",
+                 import->stats.imported, import->stats.rejected);
+    }
+
+    struct MHD_Response *mhd_response =
+        MHD_create_response_from_buffer(strlen(json), json, MHD_RESPMEM_MUST_FREE);
+    MHD_add_response_header(mhd_response, "Content-Type", "application/json");
+
+    return httpd_response_new(mhd_response, status);
+}
+
 //
 // Daemon
 //
@@ -368,100 +1738,143 @@ enum Method {
     METHOD_PUT       = 0x40,
 };
 
+// Bodies are buffered for the handler, up to cfg_http_body_limit(), unless
+// the endpoint has a consumer to take them as they arrive
 struct Endpoint {
     const char *pattern;
     enum Match  match;
     enum Method method;
     HttpdRequestHandler handler;
+    HttpdBodyConsumer   consumer;
 };
 
-#define NUM_ENDPOINTS 4
+#define NUM_ENDPOINTS 13
 
 static const struct Endpoint
 endpoints[NUM_ENDPOINTS] = {
-    {"/api/events", MATCH_PREFIX, METHOD_GET, get_events},
-    {"/api/fen",    MATCH_PREFIX, METHOD_GET, get_fen},
-    {"/api/pgn",    MATCH_PREFIX, METHOD_GET, get_pgn},
-    {"/api/screen", MATCH_PREFIX, METHOD_GET, get_screen},
+    {"/api/events",   MATCH_PREFIX, METHOD_GET,  get_events,   NULL},
+    {"/api/explorer", MATCH_PREFIX, METHOD_GET,  get_explorer, NULL},
+    {"/api/fen",      MATCH_PREFIX, METHOD_GET,  get_fen,      NULL},
+    {"/api/games",    MATCH_PREFIX, METHOD_GET,  get_games,    NULL},
+    {"/api/games",    MATCH_PREFIX, METHOD_POST, post_games,   post_games_body},
+    {"/api/latency",  MATCH_PREFIX, METHOD_GET,  get_latency,  NULL},
+    {"/api/pgn",      MATCH_PREFIX, METHOD_GET,  get_pgn,      NULL},
+    {"/api/review",   MATCH_PREFIX, METHOD_GET,  get_review,   NULL},
+    {"/api/screen",   MATCH_PREFIX, METHOD_GET,  get_screen,   NULL},
+    {"/api/search",   MATCH_PREFIX, METHOD_GET,  get_search,   NULL},
+    {"/api/trace",    MATCH_PREFIX, METHOD_GET,  get_trace,    NULL},
+    {"/api/ws",       MATCH_PREFIX, METHOD_GET,  get_ws,       NULL},
+    {"/",             MATCH_PREFIX, METHOD_GET,  get_app,      NULL},  // Anything else
 };
 
+// The method as the table has it, without trying every name
 static enum Method
 encode_method(const char *method)
 {
-    static const struct {
-        const char *name;
-        enum Method value;
-    } methods[7] = {
-        {MHD_HTTP_METHOD_DELETE,  METHOD_DELETE},
-        {MHD_HTTP_METHOD_GET,     METHOD_GET},
-        {MHD_HTTP_METHOD_HEAD,    METHOD_HEAD},
-        {MHD_HTTP_METHOD_OPTIONS, METHOD_OPTIONS},
-        {MHD_HTTP_METHOD_PATCH,   METHOD_PATCH},
-        {MHD_HTTP_METHOD_POST,    METHOD_POST},
-        {MHD_HTTP_METHOD_PUT,     METHOD_PUT},
-    };
-
-    for (int i = 0; i != 7; ++i) {
-        if (strcmp(method, methods[i].name) == 0) {
-            return methods[i].value;
+    enum Method value = METHOD_UNDEFINED;
+    const char *name  = NULL;
+
+    switch (method[0]) {
+    case 'D': value = METHOD_DELETE;  name = MHD_HTTP_METHOD_DELETE;  break;
+    case 'G': value = METHOD_GET;     name = MHD_HTTP_METHOD_GET;     break;
+    case 'H': value = METHOD_HEAD;    name = MHD_HTTP_METHOD_HEAD;    break;
+    case 'O': value = METHOD_OPTIONS; name = MHD_HTTP_METHOD_OPTIONS; break;
+    case 'P':
+        switch (method[1]) {
+        case 'A': value = METHOD_PATCH; name = MHD_HTTP_METHOD_PATCH; break;
+        case 'O': value = METHOD_POST;  name = MHD_HTTP_METHOD_POST;  break;
+        case 'U': value = METHOD_PUT;   name = MHD_HTTP_METHOD_PUT;   break;
         }
+        break;
     }
 
-    return METHOD_UNDEFINED;
-}
-
-static bool
-match_prefix(const char *pattern, const char *url)
-{
-    return strncmp(pattern, url, strlen(pattern)) == 0;
+    return name && strcmp(method, name) == 0 ? value : METHOD_UNDEFINED;
 }
 
-static bool
-match_regex(const char *pattern, const char *url)
-{
-    int err_code;
-    PCRE2_SIZE err_offset;
+// An endpoint made ready to match, once, when the daemon starts
+struct Route {
+    const struct Endpoint *endpoint;
+    size_t                 length;
+    pcre2_code            *re;
+};
 
-    pcre2_code *re = pcre2_compile(
-        (PCRE2_SPTR)pattern,
-        PCRE2_ZERO_TERMINATED,
-        0,
-        &err_code,
-        &err_offset,
-        NULL);
+static struct Route routes[NUM_ENDPOINTS];
 
-    pcre2_match_data *md = NULL;
-    if (re) {
-        md = pcre2_match_data_create_from_pattern(re, NULL);
+static void routes_free() {
+    for (auto& route : routes) {
+        if (route.re) {
+            pcre2_code_free(route.re);
+        }
+        route = Route{};
     }
+}
 
-    int rc = 0;
-    if (md) {
-        rc = pcre2_match(re, (PCRE2_SPTR)url, PCRE2_ZERO_TERMINATED, 0, 0, md, NULL);
+static int routes_compile() {
+    for (int i = 0; i != NUM_ENDPOINTS; ++i) {
+        routes[i].endpoint = &endpoints[i];
+        routes[i].length   = strlen(endpoints[i].pattern);
+        routes[i].re       = NULL;
+
+        if (endpoints[i].match == MATCH_REGEX) {
+            int err_code;
+            PCRE2_SIZE err_offset;
+            routes[i].re = pcre2_compile(
+                (PCRE2_SPTR)endpoints[i].pattern,
+                PCRE2_ZERO_TERMINATED,
+                0,
+                &err_code,
+                &err_offset,
+                NULL);
+            if (!routes[i].re) {
+                fprintf(stderr, "httpd: bad pattern %s at %zu\n", endpoints[i].pattern, err_offset);
+                routes_free();
+                return 1;
+            }
+            pcre2_jit_compile(routes[i].re, PCRE2_JIT_COMPLETE);
+        }
     }
+    return 0;
+}
 
-    if (md) {
-        pcre2_match_data_free(md);
-    }
+// Match data for this thread, big enough for any route's captures
+static pcre2_match_data *match_data() {
+    struct Deleter {
+        void operator()(pcre2_match_data *md) { pcre2_match_data_free(md); }
+    };
+    thread_local std::unique_ptr<pcre2_match_data, Deleter> md{
+        pcre2_match_data_create(HTTPD_MAX_PARAMS + 1, NULL)};
+    return md.get();
+}
 
-    if (re) {
-        pcre2_code_free(re);
-    }
+// Copy out the groups a regex route captured, n being what it matched
+static void
+capture_params(struct HttpdRequest *request, const char *url, pcre2_match_data *md, int n)
+{
+    const PCRE2_SIZE *ovector = pcre2_get_ovector_pointer(md);
 
-    return rc > 0;
+    for (int i = 1; i < n; ++i) {
+        const PCRE2_SIZE start = ovector[2 * i];
+        const PCRE2_SIZE end   = ovector[2 * i + 1];
+        request->params[i - 1] = start == PCRE2_UNSET ? NULL : strndup(url + start, end - start);
+        request->num_params    = i;
+    }
 }
 
-static bool
-match_endpoint(const struct Endpoint *endpoint, const char *url)
+// Nonzero if the route matches the url: for a regex, the whole match and
+// captured groups
+static int
+match_route(const struct Route *route, const char *url, pcre2_match_data *md)
 {
-    bool result = false;
+    int result = 0;
 
-    switch (endpoint->match) {
+    switch (route->endpoint->match) {
     case MATCH_PREFIX:
-        result = match_prefix(endpoint->pattern, url);
+        result = strncmp(route->endpoint->pattern, url, route->length) == 0;
         break;
     case MATCH_REGEX:
-        result = match_regex(endpoint->pattern, url);
+        if (md) {
+            result = std::max(0, pcre2_match(route->re, (PCRE2_SPTR)url, PCRE2_ZERO_TERMINATED, 0, 0, md, NULL));
+        }
         break;
     default:
         assert(0);
@@ -470,25 +1883,22 @@ match_endpoint(const struct Endpoint *endpoint, const char *url)
     return result;
 }
 
-
-static void
-lookup_endpoint(
-    const struct Endpoint  *lookup_table,
-    int                     lookup_table_size,
-    const char             *url,
-    const char             *method,
-    const struct Endpoint **endpoint)
+// First route for the url and method.  A regex route's captures are left
+// in md, and how many in *matched
+static const struct Route*
+lookup_route(const char *url, const char *method, pcre2_match_data *md, int *matched)
 {
     const enum Method meth = encode_method(method);
 
-    for (int i = 0; i != lookup_table_size; ++i) {
-        if ((lookup_table[i].method & meth) == meth &&
-            match_endpoint(&lookup_table[i], url))
+    for (const auto& route : routes) {
+        if ((route.endpoint->method & meth) == meth &&
+            (*matched = match_route(&route, url, md)))
         {
-            *endpoint = &lookup_table[i];
-            return;
+            return &route;
         }
     }
+
+    return NULL;
 }
 
 static enum MHD_Result
@@ -507,16 +1917,21 @@ handle_headers(
     (void)upload_data;
     (void)upload_data_size;
 
-    const struct Endpoint *endpoint = NULL;
-    lookup_endpoint(endpoints, NUM_ENDPOINTS, url, method, &endpoint);
+    pcre2_match_data *md = match_data();
+    int matched = 0;
+    const struct Route *route = lookup_route(url, method, md, &matched);
 
     struct HttpdRequest *request = NULL;
-    if (endpoint) {
+    if (route) {
         request = httpd_request_new(
             connection,
             method,
             url,
-            endpoint->handler);
+            route->endpoint->handler);
+        request->consumer = route->endpoint->consumer;
+        if (route->re) {
+            capture_params(request, url, md, matched);
+        }
         *con_cls = request;
     }
     if (request) {
@@ -553,16 +1968,47 @@ handle_body(
     struct HttpdRequest *request = (struct HttpdRequest*)*con_cls;
 
     if (*upload_data_size) {
-        // Handle incoming request data.
-        httpd_request_accumulate_body(request, upload_data, *upload_data_size);
+        // Handle incoming request data.  Once refused, the rest is dropped
+        if (request->body_refused) {
+            // Nothing more to do with it
+        }
+        else if (request->consumer) {
+            request->body_refused = !request->consumer(request, upload_data, upload_data_size);
+            if (!request->body_refused) {
+                // Whatever's left is for later
+                return MHD_YES;
+            }
+        }
+        else if (request->body_used + *upload_data_size > (size_t)cfg_http_body_limit()) {
+            request->body_refused = true;
+        }
+        else {
+            httpd_request_accumulate_body(request, upload_data, *upload_data_size);
+        }
         *upload_data_size = 0;
         return MHD_YES;
     }
 
     // Have received entire request.
+    if (request->consumer && !request->body_refused) {
+        size_t end = 0;
+        request->body_refused = !request->consumer(request, NULL, &end);
+    }
+    if (request->body_refused && !request->consumer) {
+        struct MHD_Response *res =
+            MHD_create_response_from_buffer(0, NULL, MHD_RESPMEM_PERSISTENT);
+        enum MHD_Result result = MHD_NO;
+        if (res) {
+            result = MHD_queue_response(connection, MHD_HTTP_CONTENT_TOO_LARGE, res);
+            MHD_destroy_response(res);
+        }
+        return result;
+    }
     struct HttpdResponse *response = NULL;
     HttpdRequestHandler  handler = httpd_request_get_handler(request);
     if (handler) {
+        TRACE_THREAD("http");
+        TRACE_SPAN("http_handler");
         response = handler(request);
     }
 
@@ -643,26 +2089,82 @@ handle_completed(
 static struct MHD_Daemon *httpd_daemon = NULL;
 
 void httpd_stop() {
+    if (keepalive_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(streams_mutex);
+            keepalive_stop = true;
+        }
+        keepalive_cond.notify_all();
+        keepalive_thread.join();
+    }
+
     if (httpd_daemon) {
+        event_broadcaster.stop();
+        close_streams();
+
+        // Upgraded sockets have to be closed before the daemon stops
+        if (ws_thread.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(ws_mutex);
+                ws_stop = true;
+            }
+            ws_wake();
+            ws_thread.join();
+        }
+        if (ws_wakeup >= 0) {
+            close(ws_wakeup);
+            ws_wakeup = -1;
+        }
+
         MHD_stop_daemon(httpd_daemon);
         httpd_daemon = NULL;
     }
+
+    routes_free();
 }
 
+// A few threads polling every connection with epoll, however many clients
+// there are.  Handlers mustn't block for long, they hold up others
 int httpd_start() {
+    if (routes_compile()) {
+        return 1;
+    }
+
     const int port = cfg_port();
     httpd_daemon = MHD_start_daemon(
-        MHD_USE_THREAD_PER_CONNECTION,
+        MHD_USE_EPOLL_INTERNAL_THREAD | MHD_ALLOW_SUSPEND_RESUME | MHD_ALLOW_UPGRADE,
         port,
         NULL,
         NULL,
         handle_connection,
         NULL,
+        MHD_OPTION_THREAD_POOL_SIZE,
+        (unsigned int)cfg_http_threads(),
         MHD_OPTION_NOTIFY_COMPLETED,
         handle_completed,
         NULL,
         MHD_OPTION_END);
-    return httpd_daemon ? 0 : 1;
+    if (!httpd_daemon) {
+        routes_free();
+        return 1;
+    }
+
+    // The broadcaster follows the game from the next render(), whole
+    event_broadcaster.start();
+    centaur.resync();
+
+    keepalive_stop   = false;
+    keepalive_thread = std::thread(send_keepalives);
+
+    ws_wakeup = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (ws_wakeup >= 0) {
+        ws_stop   = false;
+        ws_thread = std::thread(serve_websockets);
+    } else {
+        perror("eventfd");
+        ws_stop = true;  // Refuse upgrades
+    }
+    return 0;
 }
 
 // This file is part of the Raccoon's Centaur Mods (RCM).
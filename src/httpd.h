@@ -17,8 +17,18 @@
 struct HttpdRequest;
 struct HttpdResponse;
 
+// Most groups an endpoint's pattern may capture from the url
+#define HTTPD_MAX_PARAMS 8
+
 typedef struct HttpdResponse *(*HttpdRequestHandler)(struct HttpdRequest*);
 
+// Takes a request body as it arrives, a chunk at a time, and then *len 0 at
+// the end.  False refuses the rest, which is dropped, and the handler still
+// answers the request.  A consumer that can't take it all yet leaves in *len
+// what it hasn't, which comes again, once it's resumed the connection it
+// suspended meanwhile
+typedef bool (*HttpdBodyConsumer)(struct HttpdRequest*, const char *data, size_t *len);
+
 //
 // Request
 //
@@ -32,9 +42,19 @@ httpd_request_new(
     const char            *url,
     HttpdRequestHandler    handler);
 
+// Group n of the url, as captured by its endpoint's pattern, or NULL
+const char *httpd_request_param(const struct HttpdRequest*, int n);
+
 void *httpd_request_userdata(const struct HttpdRequest *request);
 void httpd_request_set_userdata(struct HttpdRequest *request, void *userdata);
 
+// For userdata, when the request is done with
+void
+httpd_request_set_userdata_free(struct HttpdRequest *request, void (*userdata_free)(void*));
+
+// Whether the body's consumer refused it
+bool httpd_request_body_refused(const struct HttpdRequest*);
+
 const uint8_t *httpd_request_body(const struct HttpdRequest*);
 size_t httpd_request_body_length(const struct HttpdRequest*);
 
@@ -64,6 +84,9 @@ httpd_request_query_string(const struct HttpdRequest*, char**);
 const char*
 httpd_request_post_var(const struct HttpdRequest*, const char *name);
 
+// False if the client says it already has etag, per If-None-Match
+bool httpd_request_none_match(const struct HttpdRequest*, const char *etag);
+
 //
 // Response
 //
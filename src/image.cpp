@@ -77,30 +77,48 @@ unique_ptr<Image> Image::readbmp(const char* path) {
         return NULL;
     }
 
+    // All at once, then decoded in memory
+    vector<uint8_t> bytes;
+    uint8_t buf[4096];
+    for (size_t n; (n = fread(buf, 1, sizeof buf, fp)) > 0; ) {
+        bytes.insert(bytes.end(), buf, buf + n);
+    }
+    fclose(fp);
+
+    return readbmp(bytes.data(), bytes.size());
+}
+
+unique_ptr<Image> Image::readbmp(const uint8_t* data, size_t size) {
     struct BMPFILEHEADER header;
-    fread(&header, sizeof header, 1, fp);
+    struct BMPINFOHEADER info;
+    if (size < sizeof header + sizeof info) {
+        return NULL;
+    }
+    memcpy(&header, data, sizeof header);
+    memcpy(&info, data + sizeof header, sizeof info);
+
     if (strncmp((const char*)&header.bType, "BM", 2) != 0) {
         // Not a Windows bitmap file
-        fclose(fp);
         return NULL;
     }
 
-    struct BMPINFOHEADER info;
-    fread(&info, sizeof info, 1, fp);
     if (info.biInfoSize != 40) {
         // Not a Windows bitmap file
-        fclose(fp);
         return NULL;
     }
 
-    if (info.biBitCount != 1 && info.biBitCount != 8) {
+    if (info.biBitCount != 1 && info.biBitCount != 4 && info.biBitCount != 8) {
         // Not a supported size
-        fclose(fp);
         return NULL;
     }
 
-    struct BMPRGBQUAD rgb[2];
-    fread(&rgb, sizeof rgb, 1, fp);
+    const auto palette = data + sizeof header + sizeof info;
+    const auto entries = info.biBitCount == 4 ? 16 : 2;
+    if (size < sizeof header + sizeof info + entries * sizeof(BMPRGBQUAD)) {
+        return NULL;
+    }
+    struct BMPRGBQUAD rgb[16];
+    memcpy(&rgb, palette, entries * sizeof(BMPRGBQUAD));
 
     PixelColor colors[2] = { PIXEL_BLACK, PIXEL_WHITE };
     if (rgb[0].rgbBlue == 255 && rgb[0].rgbGreen == 255 && rgb[0].rgbRed == 255) {
@@ -108,40 +126,51 @@ unique_ptr<Image> Image::readbmp(const char* path) {
         colors[1] = PIXEL_BLACK;
     }
 
-    auto image = make_unique<Image>(int(info.biWidth), int(info.biHeight));
-    fseek(fp, header.bOffset, SEEK_SET);
+    // 4-bit palettes are grays, light or dark
+    PixelColor grays[16];
+    for (auto i = 0; i < 16; ++i) {
+        const auto light = rgb[i].rgbRed + rgb[i].rgbGreen + rgb[i].rgbBlue >= 3 * 128;
+        grays[i] = light ? PIXEL_WHITE : PIXEL_BLACK;
+    }
 
     // Bitmap pads each row out to 4 bytes
     const auto row_bytes = ((info.biWidth * info.biBitCount + 31) / 32) * 4;
+    if (int(info.biWidth) <= 0 || int(info.biHeight) <= 0 ||
+        header.bOffset > size ||
+        (size - header.bOffset) / row_bytes < info.biHeight)
+    {
+        return NULL;
+    }
+
+    auto image = make_unique<Image>(int(info.biWidth), int(info.biHeight));
+    const auto set = [&image](int x, int y, PixelColor color) {
+        if (color == PIXEL_WHITE) {
+            image->data_[y * image->width_bytes + x / 8] |=   0x80 >> (x % 8);
+        } else {
+            image->data_[y * image->width_bytes + x / 8] &= ~(0x80 >> (x % 8));
+        }
+    };
 
     // Bitmap starts with lower-left corner
-    for (auto y = image->height - 1 ; y >= 0; --y) {
-        for (auto x = 0; x < row_bytes; ++x) {
-            uint8_t Rdata;
-            if (fread((char*)&Rdata, 1, 1, fp) != 1) {
-                fclose(fp);
-                return NULL;
+    auto row = data + header.bOffset;
+    for (auto y = image->height - 1 ; y >= 0; --y, row += row_bytes) {
+        switch (info.biBitCount) {
+        case 1:
+            memcpy(&image->data_[y * image->width_bytes], row, image->width_bytes);
+            break;
+        case 4:
+            for (auto x = 0; x < image->width; ++x) {
+                set(x, y, grays[row[x / 2] >> (x % 2 ? 0 : 4) & 0xf]);
             }
-
-            if (info.biBitCount == 1) {
-                if (x < image->width_bytes) {
-                    image->data_[y * image->width_bytes + x] = Rdata;
-                }
-            } else if (info.biBitCount == 8) {
-                const PixelColor color = Rdata ? colors[1] : colors[0];
-                if (x < image->width) {
-                    if (color == PIXEL_WHITE) {
-                        image->data_[y * image->width_bytes + x / 8] |=   0x80 >> (x % 8);
-                    } else {
-                        image->data_[y * image->width_bytes + x / 8] &= ~(0x80 >> (x % 8));
-                    }
-                }
+            break;
+        case 8:
+            for (auto x = 0; x < image->width; ++x) {
+                set(x, y, row[x] ? colors[1] : colors[0]);
             }
+            break;
         }
     }
 
-    fclose(fp);
-
     assert(image->is_valid());
     return image;
 }
@@ -187,6 +216,12 @@ int Image::png(uint8_t** png, size_t* size) const {
         PNG_INTERLACE_NONE,
         PNG_COMPRESSION_TYPE_DEFAULT,
         PNG_FILTER_TYPE_DEFAULT);
+
+    // Filters don't help 1-bit rows, and the image is small enough that the
+    // best compression is cheap
+    png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+    png_set_compression_level(png_ptr, 9);
+    png_set_compression_mem_level(png_ptr, 9);
     png_write_info(png_ptr, info_ptr);
 
     png_bytep* row_pointers = (png_bytep*)alloca(height * sizeof(png_bytep));
@@ -26,7 +26,10 @@ public:
     Image(int width, int height);
     bool is_valid() const;
 
+    // Windows bitmap, from a file or already in memory.  Null if it can't
+    // be read, or isn't a bitmap
     static std::unique_ptr<Image> readbmp(const char* path);
+    static std::unique_ptr<Image> readbmp(const std::uint8_t* data, std::size_t size);
 
     const std::uint8_t* data() const { return data_.data(); }
     std::uint8_t* data() { return data_.data(); }
@@ -0,0 +1,75 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "leds.h"
+
+using namespace std;
+using namespace thc;
+
+void Leds::off() {
+    wanted.squares.clear();
+    wanted.flash = false;
+}
+
+void Leds::light(Square square) {
+    wanted.squares.assign({square});
+    wanted.flash = false;
+}
+
+void Leds::light(Square from, Square to) {
+    wanted.squares.assign({from, to});
+    wanted.flash = false;
+}
+
+void Leds::flash() {
+    wanted.flash = true;
+}
+
+bool Leds::showing(Square square) const {
+    return known && shown.squares.size() == 1 && shown.squares.front() == square;
+}
+
+int Leds::show() {
+    if (known && wanted == shown) {
+        return 0;
+    }
+
+    int rc;
+    if (wanted.flash) {
+        rc = board.led_flash();
+    }
+    else if (wanted.squares.empty()) {
+        rc = board.leds_off();
+    }
+    else if (wanted.squares.size() == 1) {
+        rc = board.led(wanted.squares.front());
+    }
+    else if (wanted.squares.size() == 2) {
+        rc = board.led_from_to(wanted.squares[0], wanted.squares[1]);
+    }
+    else {
+        rc = board.led_array(wanted.squares);
+    }
+
+    // A flash happens once and leaves the squares lit as they were, so
+    // asking again flashes again
+    wanted.flash = false;
+    shown.squares = wanted.squares;
+    known = rc == 0;
+    return rc;
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
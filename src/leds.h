@@ -0,0 +1,64 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef LEDS_H
+#define LEDS_H
+
+#include "board.h"
+
+#include <vector>
+
+// What the field LEDs should show
+struct LedFrame {
+    std::vector<thc::Square> squares;  // Lit together, none for all off
+    bool flash{false};                 // Flash the board once, then as before
+
+    bool operator==(const LedFrame& other) const {
+        return squares == other.squares && flash == other.flash;
+    }
+    bool operator!=(const LedFrame& other) const { return !(*this == other); }
+};
+
+// Holds the frame the LEDs should show, and tells the board only when that
+// changes.  Any number of changes between calls to show() go out as (at
+// most) one packet, of whatever was asked for last
+class Leds {
+public:
+    explicit Leds(Board& board) : board{board} {}
+
+    void off();
+    void light(thc::Square square);
+    void light(thc::Square from, thc::Square to);
+    void flash();
+
+    // Already lit, exactly this
+    bool showing(thc::Square square) const;
+
+    // Send the wanted frame, if it's not already showing.  Returns nonzero
+    // if the board didn't take it
+    int show();
+
+private:
+    Board&   board;
+    LedFrame wanted;
+    LedFrame shown;
+    bool     known{false};  // Whether shown is what the board has
+};
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -1,10 +1,124 @@
 // Copyright (C) 2024 Eric Sessoms
 // See license at end of file
 
+#include "db.h"
+#include "cfg.h"
 #include "httpd.h"
+#include "soak.h"
 #include "standard.h"
+#include "chess/chess.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+// rcm import FILE...
+//   Add the games in each PGN file ("-" for stdin) to the database
+static int import_command(int argc, char* argv[]) {
+    auto rc = EXIT_SUCCESS;
+    for (auto i = 2; i < argc; ++i) {
+        try {
+            auto reader = strcmp(argv[i], "-") == 0
+                ? std::make_unique<PgnReader>(0)
+                : PgnReader::open(argv[i]);
+            const auto stats = db.import_games(*reader);
+            printf("%s: %zu imported, %zu rejected\n", argv[i], stats.imported, stats.rejected);
+        }
+        catch (const std::exception& e) {
+            fprintf(stderr, "%s: %s\n", argv[i], e.what());
+            rc = EXIT_FAILURE;
+        }
+    }
+    return rc;
+}
+
+// rcm archive PGN ARCHIVE
+//   Convert a PGN file to a binary archive
+static int archive_command(int argc, char* argv[]) {
+    if (argc != 4) {
+        fprintf(stderr, "usage: %s archive PGN ARCHIVE\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    try {
+        auto reader = PgnReader::open(argv[2]);
+        ArchiveWriter writer{argv[3]};
+        const auto rejected = pgn_to_archive(*reader, writer);
+        writer.finish();
+        printf("%s: %zu archived, %zu rejected\n", argv[2], writer.size(), rejected);
+    }
+    catch (const std::exception& e) {
+        fprintf(stderr, "%s: %s\n", argv[2], e.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// rcm unarchive ARCHIVE
+//   Write the games in a binary archive to stdout as PGN
+static int unarchive_command(int argc, char* argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s unarchive ARCHIVE\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    try {
+        Archive archive{argv[2]};
+        archive_to_pgn(archive, std::cout);
+    }
+    catch (const std::exception& e) {
+        fprintf(stderr, "%s: %s\n", argv[2], e.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// The engine against itself, on whatever board it's built for, but meant
+// for the simulated one (BOARD=sim), with web clients and reports, until
+// Enter.  Fails if the game ever stalled.  Games are saved as any others,
+// so best with a scratch XDG_DATA_HOME
+static int soak_command(int argc, char* argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s soak\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Player computer{};
+    computer.type            = COMPUTER;
+    computer.computer.engine = "stockfish";
+    computer.computer.elo    = cfg_soak_elo();
+
+    if (httpd_start() != 0) {
+        fprintf(stderr, "%s: can't start the web server, its clients will fail\n", argv[0]);
+    }
+
+    Soak soak;
+    soak.start();
+    {
+        StandardGame standard{computer, computer};
+        standard.main();
+    }
+    soak.stop();
+
+    httpd_stop();
+    db.flush();
+    return soak.stalled() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "import") == 0) {
+        return import_command(argc, argv);
+    }
+    if (argc > 1 && strcmp(argv[1], "archive") == 0) {
+        return archive_command(argc, argv);
+    }
+    if (argc > 1 && strcmp(argv[1], "unarchive") == 0) {
+        return unarchive_command(argc, argv);
+    }
+    if (argc > 1 && strcmp(argv[1], "soak") == 0) {
+        return soak_command(argc, argv);
+    }
 
-int main() {
     // Optional, can ignore failure
     httpd_start();
 
@@ -12,6 +126,9 @@ int main() {
     standard.main();
 
     httpd_stop();
+
+    // Whatever's still to be saved
+    db.flush();
 }
 
 // This file is part of the Raccoon's Centaur Mods (RCM).
@@ -0,0 +1,230 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+// Stands in for the DGT Centaur board by replaying serial traffic recorded
+// from a real one, see cfg_serial_record().  Board replies come back at the
+// pace they were recorded, or faster by cfg_replay_speed(), and at speed 0 as
+// fast as field events are asked for.  LEDs and sounds go nowhere.
+
+#include "boardserial.h"
+#include "../cfg.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+// Reply to boardstate is {id, 1, 7, addr, addr, ?}, two bytes per field,
+// checksum
+static const int BOARDSTATE_LEN = 6 + 2 * 64 + 1;
+
+// Replies, by what they look like, as the centaur backend matches them
+static bool is_fields(const Packet& packet) {
+    const auto& data = packet.data;
+    return packet.direction == packetlog::FROM_BOARD &&
+        data.size() >= 6 && (data[0] == 131 || data[0] == 133);
+}
+
+static bool has_events(const Packet& packet) {
+    return is_fields(packet) && packet.data.size() > 6;
+}
+
+static bool is_boardstate(const Packet& packet) {
+    return packet.direction == packetlog::FROM_BOARD && packet.data.size() == BOARDSTATE_LEN;
+}
+
+static bool is_charging(const Packet& packet) {
+    return packet.direction == packetlog::FROM_BOARD &&
+        packet.data.size() == 7 && packet.data[0] == 181;
+}
+
+static bool is_buttons(const Packet& packet) {
+    return packet.direction == packetlog::FROM_BOARD &&
+        packet.data.size() >= 11 && packet.data[0] == 177 && packet.data[2] >= 16;
+}
+
+static Bitmap decode_boardstate(const uint8_t* resp) {
+    Bitmap boardstate = 0;
+    Bitmap mask = 1;
+    for (auto i = 0; i != 64; ++i) {
+        const auto value = 256 * resp[2*i] + resp[2*i + 1];
+        if (300 <= value && value <= 32000) {
+            boardstate |= mask;
+        }
+        mask <<= 1;
+    }
+    return boardstate;
+}
+
+static const char* replay_path() {
+    const auto path = cfg_serial_replay();
+    if (!path) {
+        throw runtime_error("Nothing to replay, set RCM_SERIAL_REPLAY");
+    }
+    return path;
+}
+
+BoardSerial::~BoardSerial() {
+}
+
+BoardSerial::BoardSerial() : BoardSerial(replay_path(), cfg_replay_speed()) {
+}
+
+BoardSerial::BoardSerial(const char* path, double speed)
+    : log{read_packets(path)}, speed{speed}, started{Clock::now()}
+{
+    // Until the log says otherwise, the board is as it was first scanned
+    for (const auto& packet : log) {
+        if (is_boardstate(packet)) {
+            state = decode_boardstate(&packet.data[6]);
+            break;
+        }
+    }
+}
+
+chrono::microseconds BoardSerial::now() const {
+    const auto elapsed = chrono::duration<double, micro>(Clock::now() - started) * speed;
+    return chrono::duration_cast<chrono::microseconds>(elapsed);
+}
+
+// Everything the board said before end
+void BoardSerial::replay_until(size_t end) {
+    for (; next < end; ++next) {
+        const auto& packet = log[next];
+        const auto  data   = packet.data.data();
+        if (is_fields(packet)) {
+            events.insert(events.end(), data + 5, data + packet.data.size() - 1);
+        }
+        else if (is_boardstate(packet)) {
+            state = decode_boardstate(data + 6);
+        }
+        else if (is_charging(packet)) {
+            charging = data[5];
+        }
+        else if (is_buttons(packet)) {
+            pressed  |= data[ 9];
+            released |= data[10];
+        }
+    }
+
+    if (next == log.size() && !finished) {
+        finished = true;
+        printf("Replay finished\n");
+    }
+}
+
+void BoardSerial::catch_up() {
+    if (speed > 0) {
+        const auto until = now();
+        auto end = next;
+        while (end < log.size() && log[end].at <= until) {
+            ++end;
+        }
+        replay_until(end);
+        return;
+    }
+
+    // Flat out, every read of field events gets the next ones recorded, and
+    // then everything up to the read after, since that's where the boardstate
+    // read with them is
+    if (!events.empty()) {
+        return;
+    }
+    auto end = next;
+    while (end < log.size() && !has_events(log[end])) {
+        ++end;
+    }
+    if (end < log.size()) {
+        ++end;
+    }
+    while (end < log.size() && !is_fields(log[end])) {
+        ++end;
+    }
+    replay_until(end);
+}
+
+int BoardSerial::chargingstate() {
+    if (speed > 0) {
+        catch_up();
+    }
+    return charging;
+}
+
+Bitmap BoardSerial::boardstate() {
+    if (speed > 0) {
+        catch_up();
+    }
+    return state;
+}
+
+int BoardSerial::readdata(uint8_t* buf, int len) {
+    assert(buf && len >= 256);
+    catch_up();
+
+    // As one packet, {id, length >> 7, length & 127, addr, addr, events...,
+    // checksum}.  Events are pairs, don't split one
+    const auto n = static_cast<int>(min<size_t>(events.size(), 248));
+    const auto packet_len = 6 + n;
+    const uint8_t header[5] = {133, uint8_t(packet_len >> 7), uint8_t(packet_len & 127), 0, 0};
+    memcpy(buf, header, sizeof header);
+    memcpy(buf + 5, events.data(), n);
+    events.erase(events.begin(), events.begin() + n);
+
+    unsigned sum = 0;
+    for (auto i = 0; i != packet_len - 1; ++i) {
+        sum += buf[i];
+    }
+    buf[packet_len - 1] = sum % 128;
+    return packet_len;
+}
+
+void BoardSerial::buttons(Buttons& press, Buttons& release) {
+    if (speed > 0) {
+        catch_up();
+    }
+    press    = Buttons(pressed);
+    release  = Buttons(released);
+    pressed  = 0;
+    released = 0;
+}
+
+int BoardSerial::leds_off() {
+    return 0;
+}
+
+int BoardSerial::led_flash() {
+    return 0;
+}
+
+int BoardSerial::led(int) {
+    return 0;
+}
+
+int BoardSerial::led_array(const int*, int) {
+    return 0;
+}
+
+int BoardSerial::led_from_to(int, int) {
+    return 0;
+}
+
+int BoardSerial::play_sound(Sound) {
+    return 0;
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
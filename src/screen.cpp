@@ -2,18 +2,74 @@
 // See license at end of file
 
 #include "screen.h"
+#include "cfg.h"
+#include "utility/latency.h"
+#include "utility/trace.h"
+#include "utility/xordelta.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <stdexcept>
+#include <vector>
 
 #include <alloca.h>
 
 using namespace std;
 
+static LatencyHistogram render_latency{"render"};
+static LatencyHistogram epd_latency{"epd_update"};
+static LatencyHistogram epd_full_latency{"epd_display"};
+
+// From field events to their move on screen (or whatever else changed it)
+static LatencyHistogram screen_latency{"event_to_screen"};
+
+// Smallest window of rows and bytes within rows that holds every difference
+// between the images in rows from first_row to last_row, false if there
+// are none
+static bool changed_window(
+    const uint8_t* old_image,
+    const uint8_t* new_image,
+    int&           first_row,
+    int&           last_row,
+    int&           first_byte,
+    int&           last_byte)
+{
+    const auto width_bytes = (SCREEN_WIDTH + 7) / 8;
+    const auto from_row    = first_row;
+    const auto to_row      = last_row;
+
+    first_row  = SCREEN_HEIGHT;
+    last_row   = -1;
+    first_byte = width_bytes;
+    last_byte  = -1;
+    for (auto row = from_row; row <= to_row; ++row) {
+        const auto offset = row * width_bytes;
+        if (memcmp(old_image + offset, new_image + offset, width_bytes) == 0) {
+            continue;
+        }
+
+        first_row = min(first_row, row);
+        last_row  = row;
+        for (auto byte = 0; byte < width_bytes; ++byte) {
+            if (old_image[offset + byte] != new_image[offset + byte]) {
+                first_byte = min(first_byte, byte);
+                last_byte  = max(last_byte, byte);
+            }
+        }
+    }
+    return last_row >= 0;
+}
+
 // E-Paper updates can be slow, and we don't want to block, so we offload
-// them to a separate thread.
+// them to a separate thread.  It also decides how each frame goes to the
+// panel: a partial update of just the window that changed, or now and then
+// a full refresh to clear the ghosting partials leave behind.  And it puts
+// the panel to sleep when nothing's changed for a while.
+//
+// Whatever is drawn while the panel is busy waits in damage, so however
+// many frames arrive during an update, they go out as one frame after it
 void Screen::update_epd2in9d() {
     // Debug out-of-control threads
     static bool once_only = false;
@@ -22,83 +78,244 @@ void Screen::update_epd2in9d() {
     }
     once_only = true;
 
+    TRACE_THREAD("epd");
+
+    const auto full_refresh_partials = cfg_full_refresh_partials();
+    const auto full_refresh_area     = cfg_full_refresh_area() * SCREEN_WIDTH * SCREEN_HEIGHT;
+    const auto idle = chrono::duration_cast<chrono::steady_clock::duration>(
+        chrono::duration<double>(cfg_screen_idle()));
+
     epd2in9d.wake();
 
     const auto width_bytes = (SCREEN_WIDTH + 7) / 8;
     const auto size_bytes  = width_bytes * SCREEN_HEIGHT;
 
-    const auto new_image = (uint8_t*)alloca(size_bytes);
+    // As the panel shows it
     const auto old_image = (uint8_t*)alloca(size_bytes);
-    memset(old_image, -1, size_bytes);
-    memset(new_image, -1, size_bytes);
-
-    {
-        lock_guard<std::mutex> lock(mutex);
-        memcpy(new_image, image[0]->data(), size_bytes);
-    }
-    memcpy(old_image, new_image, size_bytes);
+    epd_frames.take();
+    memcpy(old_image, epd_frames.front().image.data(), size_bytes);
     epd2in9d.display(old_image);
 
-    struct timespec last_render;
-    clock_gettime(CLOCK_REALTIME, &last_render);
+    // Panel state, and changes since its last full refresh
+    auto   awake    = true;
+    auto   full     = false;  // Next frame is a full refresh
+    auto   partials = 0;
+    double area     = 0;
+    auto   last_update = chrono::steady_clock::now();
 
-    while (!shutdown) {
-        auto timeout = chrono::system_clock::now() + chrono::seconds(100);
+    // Field events shown on screen so far
+    auto shown = latency_origin();
+
+    for (;;) {
+        auto prewarm = false;
         {
             unique_lock<std::mutex> lock(mutex);
-            cond.wait_until(lock, timeout);
+            const auto pending = [this] { return shutdown || prewarm_wanted || epd_frames.fresh(); };
+            if (awake) {
+                cond.wait_until(lock, last_update + idle, pending);
+            } else {
+                cond.wait(lock, pending);
+            }
             if (shutdown) {
                 break;
             }
-            memcpy(new_image, image[0]->data(), size_bytes);
+
+            prewarm = prewarm_wanted;
+            prewarm_wanted = false;
         }
 
-        const bool dirty = memcmp(new_image, old_image, size_bytes) != 0;
-        if (!dirty) {
+        // The newest frame, now the e-paper thread's alone.  Only rows drawn
+        // since the last one can have changed
+        const auto  drawn     = epd_frames.take();
+        const auto& frame     = epd_frames.front();
+        const auto  new_image = frame.image.data();
+        int first_row  = frame.damage.top;
+        int last_row   = frame.damage.bottom - 1;
+        int first_byte, last_byte;
+
+        if (!drawn && !prewarm) {
+            // Idle
+            epd2in9d.sleep();
+            awake = false;
             continue;
         }
 
-        memcpy(old_image, new_image, size_bytes);
-        epd2in9d.update(old_image);
+        if (!awake) {
+            // Its memory of the old image doesn't survive sleep
+            epd2in9d.wake();
+            awake = true;
+            full  = true;
+        }
+        last_update = chrono::steady_clock::now();
+
+        if (!drawn || frame.damage.empty()) {
+            // Prewarmed, and any full refresh waits for something to show
+            continue;
+        }
+
+        // And only what's changed goes to the display
+        if (!changed_window(old_image, new_image, first_row, last_row, first_byte, last_byte)) {
+            if (!full) {
+                continue;
+            }
+            first_row  = 0;
+            last_row   = SCREEN_HEIGHT - 1;
+            first_byte = 0;
+            last_byte  = width_bytes - 1;
+        }
+
+        for (auto row = first_row; row <= last_row; ++row) {
+            memcpy(old_image + row * width_bytes, new_image + row * width_bytes, width_bytes);
+        }
+
+        area += 8.0 * (last_byte - first_byte + 1) * (last_row - first_row + 1);
+        full = full || partials >= full_refresh_partials || area >= full_refresh_area;
 
-        // Eventually we'll want to sleep if nothing is happening.
-        clock_gettime(CLOCK_REALTIME, &last_render);
+        const auto origin = latency_origin();
+        if (full) {
+            LatencyTimer timer{epd_full_latency};
+            TRACE_SPAN("epd_display");
+            epd2in9d.display(old_image);
+            full     = false;
+            partials = 0;
+            area     = 0;
+        } else {
+            LatencyTimer timer{epd_latency};
+            TRACE_SPAN("epd_update");
+            epd2in9d.update(old_image, first_row, last_row, first_byte, last_byte);
+            ++partials;
+        }
+        if (origin != shown) {
+            screen_latency.record_since(origin);
+            shown = origin;
+        }
+        last_update = chrono::steady_clock::now();
     }
 }
 
 Screen::~Screen() {
-    shutdown = true;
+    {
+        lock_guard<std::mutex> lock(mutex);
+        shutdown = true;
+    }
     cond.notify_one();
     thread.join();
 }
 
 Screen::Screen()
 {
-    image[0] = make_unique<Image>(SCREEN_WIDTH, SCREEN_HEIGHT);
-    image[1] = make_unique<Image>(SCREEN_WIDTH, SCREEN_HEIGHT);
+    image = make_unique<Image>(SCREEN_WIDTH, SCREEN_HEIGHT);
+    context.image  = image.get();
     context.rotate = ROTATE_180;
+    context.clear();
+    publish({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT});
     thread = std::thread(&Screen::update_epd2in9d, this);
 }
 
+// Renderer only
+void Screen::publish(const Rect& rendered) {
+    ++generation;
+    unseen.unite(rendered);
+
+    auto& frame = epd_frames.back();
+    frame.generation = generation;
+    frame.damage     = unseen;
+    frame.image.data_ = image->data_;
+    if (epd_frames.publish()) {
+        // Everything before is taken, all but what's in this frame
+        unseen = rendered;
+    }
+
+    auto& png = png_frames.back();
+    png.generation  = generation;
+    png.image.data_ = image->data_;
+    png_frames.publish();
+}
+
 void Screen::render(View& view) {
+    {
+        lock_guard<std::mutex> lock(render_mutex);
+        if (!view.invalid()) {
+            return;
+        }
+
+        LatencyTimer timer{render_latency};
+        TRACE_SPAN("render");
+        const auto rendered = context.to_image(view.render(context));
+        if (rendered.empty()) {
+            return;
+        }
+        publish(rendered);
+    }
+
+    // Empty, but the e-paper thread is either waiting or will see the frame
     {
         lock_guard<std::mutex> lock(mutex);
+    }
+    cond.notify_all();
+}
+
+void Screen::prewarm() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        prewarm_wanted = true;
+    }
+    cond.notify_all();
+}
+
+shared_ptr<const ScreenPng> Screen::png() {
+    lock_guard<std::mutex> lock(png_mutex);
+
+    png_frames.take();
+    const auto& frame = png_frames.front();
+    if (png_cache && png_generation == frame.generation) {
+        return png_cache;
+    }
+
+    auto png = make_shared<ScreenPng>();
+    if (frame.image.png(&png->data, &png->size) != 0) {
+        return nullptr;
+    }
+    png->generation = frame.generation;
+    png_cache      = png;
+    png_generation = frame.generation;
+    return png;
+}
 
-        swap(image[0], image[1]);
-        context.image = image[0].get();
-        context.clear();
-        view.render(context);
+shared_ptr<const ScreenDelta> Screen::delta() {
+    lock_guard<std::mutex> lock(png_mutex);
+
+    png_frames.take();
+    const auto& frame = png_frames.front();
+    if (delta_cache && delta_cache->generation == frame.generation) {
+        return delta_cache;
     }
 
-    if (*image[0] != *image[1]) {
-        cond.notify_all();
-        changed();
+    if (!delta_cache) {
+        fill(delta_image.data_.begin(), delta_image.data_.end(), uint8_t(0xFF));
     }
+
+    auto delta = make_shared<ScreenDelta>();
+    delta->base       = delta_cache ? delta_cache->generation : 0;
+    delta->generation = frame.generation;
+    delta->data       = xordelta::encode(
+        delta_image.data(), frame.image.data(), frame.image.data_.size());
+    delta_image.data_ = frame.image.data_;
+    delta_cache = delta;
+    return delta;
 }
 
-int Screen::png(uint8_t** png, size_t* size) const {
-    lock_guard<std::mutex> lock(mutex);
-    return image[0]->png(png, size);
+ScreenDelta Screen::keyframe() {
+    lock_guard<std::mutex> lock(png_mutex);
+
+    png_frames.take();
+    const auto& frame = png_frames.front();
+    const vector<uint8_t> blank(frame.image.data_.size(), 0xFF);
+
+    ScreenDelta keyframe;
+    keyframe.generation = frame.generation;
+    keyframe.data       = xordelta::encode(blank.data(), frame.image.data(), blank.size());
+    return keyframe;
 }
 
 // This file is part of the Raccoon's Centaur Mods (RCM).
@@ -6,23 +6,59 @@
 
 #include "epd2in9d.h"
 #include "graphics.h"
-#include "utility/model.h"
+#include "utility/triplebuffer.h"
 
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 
-class Screen : public Model<Screen> {
+// A frame encoded as PNG, shared by everyone who asks for that frame
+struct ScreenPng {
+    std::uint8_t* data{nullptr};
+    std::size_t   size{0};
+    unsigned      generation{0};  // Of the frame
+
+    ScreenPng() = default;
+    ScreenPng(const ScreenPng&) = delete;
+    ScreenPng& operator=(const ScreenPng&) = delete;
+    ~ScreenPng() { std::free(data); }
+};
+
+// The difference from one frame to another, see utility/xordelta.h.  A
+// keyframe is from generation 0, which is blank, all white
+struct ScreenDelta {
+    unsigned    base{0};        // Generation it applies to
+    unsigned    generation{0};  // And the frame it makes
+    std::string data;
+};
+
+// A complete frame, as the renderer hands it to whoever shows it
+struct ScreenFrame {
+    unsigned generation{0};  // Counting frames drawn
+    Rect     damage{};       // Drawn since the last frame its reader took
+    Image    image{SCREEN_WIDTH, SCREEN_HEIGHT};
+};
+
+// The renderer draws into image, which only it touches, and hands each
+// frame to the e-paper thread and to PNG readers through triple buffers, so
+// none of them waits on another for a frame.  The mutex is only for waking
+// the e-paper thread
+class Screen {
 public:
     Epd2in9d    epd2in9d;
     Context     context;
-    std::unique_ptr<Image>  image[2];
+    std::unique_ptr<Image>  image;  // Retained, as views last drew it
     std::condition_variable cond;
     mutable std::mutex  mutex;
     std::thread thread;
     bool        shutdown{false};
+    bool        prewarm_wanted{false};
 
     // Shutdown display
     ~Screen();
@@ -30,13 +66,41 @@ public:
     // Initialize display
     Screen();
 
-    // Render UI to display
+    // Redraw whatever's invalid in view, and display it
     void render(View& view);
 
-    // Get PNG image of display
-    int png(std::uint8_t** png, std::size_t* size) const;
+    // Wake the display, if it's asleep, ahead of an update that's likely
+    // coming, as when a piece is lifted
+    void prewarm();
+
+    // Generation of the newest frame drawn
+    unsigned frame() const { return generation.load(std::memory_order_relaxed); }
+
+    // PNG image of display, encoded once per frame, null if it can't be
+    std::shared_ptr<const ScreenPng> png();
+
+    // From the frame last asked for to the newest, once per frame, for
+    // mirrors following along
+    std::shared_ptr<const ScreenDelta> delta();
+
+    // The newest frame, whole, for mirrors starting out or lost
+    ScreenDelta keyframe();
 
 private:
+    std::mutex render_mutex;  // Of renderers, and image
+    Rect       unseen{};      // Drawn since the e-paper thread's last frame
+    std::atomic<unsigned> generation{0};  // Written by renderers, read by anyone
+
+    TripleBuffer<ScreenFrame> epd_frames;
+    TripleBuffer<ScreenFrame> png_frames;
+
+    std::mutex png_mutex;  // Of PNG and delta readers, the one consumer of png_frames
+    std::shared_ptr<const ScreenPng> png_cache;
+    unsigned   png_generation{0};
+    std::shared_ptr<const ScreenDelta> delta_cache;
+    Image      delta_image{SCREEN_WIDTH, SCREEN_HEIGHT};  // As of delta_cache
+
+    void publish(const Rect& rendered);
     void update_epd2in9d();
 };
 
@@ -0,0 +1,339 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+// Stands in for the DGT Centaur board, with someone playing on it, for soak
+// testing (see `rcm soak`).  They play games from cfg_soak_pgn() for both
+// sides, as someone playing for the computer would, and in between the
+// engine's games, making whatever move the LEDs show.  Pieces are handled as
+// people handle them: captures either way round, castling rook first,
+// pieces picked up and put back, and now and then a move taken back.  Once
+// a game's over, or has gone on for cfg_soak_plies(), the pieces go back to
+// the start for another.  Everything happens cfg_soak_speed() times as fast
+// as a person would do it, or at speed 0, every read of field events gets
+// whatever's next.  Squares are the board's, never reversed, as they aren't
+// with the computer on both sides.
+
+#include "boardserial.h"
+#include "../cfg.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+using namespace std;
+using namespace thc;
+
+static const Bitmap STARTING_POSITION = 0xFFFF00000000FFFF;
+
+// A person's pace, in seconds: thinking of a move of their own, reaching
+// for one the LEDs show, between the lifts and places of a move, and
+// between pieces as they set up
+static constexpr double THINK  = 3.0;
+static constexpr double REACH  = 1.0;
+static constexpr double HANDLE = 0.4;
+static constexpr double SET_UP = 0.2;
+
+// How often pieces are picked up and put back before a move, taken off
+// first when they're captured, or moved rook first when castling, and how
+// often a move's taken straight back
+static constexpr double NUDGE          = 0.1;
+static constexpr double CAPTURED_FIRST = 0.5;
+static constexpr double ROOK_FIRST     = 0.3;
+static constexpr double TAKEBACK       = 0.04;
+
+// Real seconds without the computer's move lit before an engine game's
+// given up on, as the engine's own time doesn't speed up
+static constexpr auto STALL = chrono::seconds{30};
+
+BoardSerial::~BoardSerial() noexcept {
+}
+
+BoardSerial::BoardSerial()
+    : BoardSerial(cfg_soak_pgn(), cfg_soak_speed(), cfg_soak_seed(), max(1, cfg_soak_plies()))
+{
+}
+
+BoardSerial::BoardSerial(const char* corpus, double speed, unsigned seed, size_t plies)
+    : corpus_path{corpus}, speed{speed}, plies{plies}, random{seed}, state{STARTING_POSITION}
+{
+}
+
+BoardSerial::Clock::duration BoardSerial::pause(double seconds) const {
+    if (speed <= 0) {
+        return {};
+    }
+    return chrono::duration_cast<Clock::duration>(chrono::duration<double>(seconds / speed));
+}
+
+bool BoardSerial::chance(double probability) {
+    return uniform_real_distribution<double>{}(random) < probability;
+}
+
+void BoardSerial::schedule(const ActionList& actions, Clock::duration delay) {
+    auto at = Clock::now() + delay;
+    const auto between = pause(mode == RESET ? SET_UP : HANDLE);
+    for (const auto& action : actions) {
+        script.push_back({at, action});
+        at += between;
+    }
+}
+
+void BoardSerial::happen(const Action& action) {
+    reader->read({action});
+    state = reader->boardstate;
+
+    if (action.lift != SQUARE_INVALID) {
+        events.push_back(64);
+        events.push_back(action.lift);
+    }
+    else {
+        events.push_back(65);
+        events.push_back(action.place);
+    }
+    idle_since = Clock::now();
+}
+
+// Whatever's due happens, and once it's all happened, what's next is planned
+void BoardSerial::step() {
+    const auto now = Clock::now();
+    while (!script.empty() && script.front().at <= now) {
+        happen(script.front().action);
+        script.pop_front();
+    }
+    if (script.empty()) {
+        plan();
+    }
+}
+
+void BoardSerial::plan() {
+    if (mode == RESET) {
+        next_game();
+        return;
+    }
+
+    const auto& game = reader->game;
+    auto over = game.legal_moves().empty() || game.history.size() > plies;
+    if (mode == CORPUS) {
+        over = over || ply >= line.size();
+    }
+    else {
+        over = over || Clock::now() - idle_since > STALL;
+    }
+    if (over) {
+        reset();
+        return;
+    }
+
+    // Second thoughts
+    if (moved && chance(TAKEBACK)) {
+        const auto before = game.previous();
+        const auto last   = before ? before->find_move_played(game.current()) : nullopt;
+        ActionList actions;
+        if (last && hands::takeback(*last, actions)) {
+            moved = false;
+            if (mode == CORPUS && ply) {
+                --ply;
+            }
+            schedule(actions, pause(REACH));
+            return;
+        }
+    }
+    moved = false;
+
+    const auto legal = game.legal_moves();
+    if (mode == CORPUS) {
+        // Off the game's line, if what was read differs from what was
+        // meant, then anything to get on with it
+        auto move = legal[uniform_int_distribution<size_t>{0, legal.size() - 1}(random)];
+        for (auto candidate : legal) {
+            if (candidate == line[ply]) {
+                move = candidate;
+                break;
+            }
+        }
+        ++ply;
+        play(move, pause(THINK));
+        return;
+    }
+
+    if (!shown) {
+        return;
+    }
+    shown = false;
+
+    // Lit as squares, a promotion's read as a queen, the first generated
+    for (auto move : legal) {
+        if (move.src == shown_from && move.dst == shown_to) {
+            play(move, pause(REACH));
+            return;
+        }
+    }
+}
+
+void BoardSerial::play(Move move, Clock::duration delay) {
+    unsigned handling = hands::TIDY;
+    if (chance(NUDGE)) {
+        handling |= hands::NUDGE;
+    }
+    if (chance(CAPTURED_FIRST)) {
+        handling |= hands::CAPTURED_FIRST;
+    }
+    if (chance(ROOK_FIRST)) {
+        handling |= hands::ROOK_FIRST;
+    }
+    schedule(hands::move(move, handling), delay);
+    moved = true;
+}
+
+// Everything off squares it doesn't start on, then onto those it does
+void BoardSerial::reset() {
+    mode  = RESET;
+    moved = false;
+
+    ActionList actions;
+    for (auto i = 0; i != 64; ++i) {
+        const auto bit = 1ULL << i;
+        if (state & bit & ~STARTING_POSITION) {
+            actions.push_back({static_cast<Square>(i), SQUARE_INVALID});
+        }
+    }
+    for (auto i = 0; i != 64; ++i) {
+        const auto bit = 1ULL << i;
+        if (~state & bit & STARTING_POSITION) {
+            actions.push_back({SQUARE_INVALID, static_cast<Square>(i)});
+        }
+    }
+    schedule(actions, pause(THINK));
+}
+
+// From the top, a game from the corpus every other time, if there's one to
+// be had, otherwise the engine's
+void BoardSerial::next_game() {
+    reader     = make_unique<hands::Reader>();
+    state      = reader->boardstate;
+    idle_since = Clock::now();
+    shown      = false;
+    ply        = 0;
+
+    mode        = from_corpus && next_line() ? CORPUS : ENGINE;
+    from_corpus = !from_corpus;
+    assert(state == STARTING_POSITION);
+}
+
+// Main line of the corpus' next game, starting over at the end.  False if
+// there's no corpus, or nothing in it
+bool BoardSerial::next_line() {
+    for (auto pass = 0; corpus_path && pass != 2; ++pass) {
+        try {
+            if (!corpus) {
+                corpus = PgnReader::open(corpus_path);
+            }
+
+            PgnGame pgn;
+            while (corpus->next(pgn)) {
+                Game game;
+                try {
+                    game.pgn(pgn);
+                }
+                catch (const exception&) {
+                    continue;
+                }
+
+                line.clear();
+                for (size_t i = 1; i < game.history.size(); ++i) {
+                    line.push_back(*game.history[i - 1]->find_move_played(game.history[i]));
+                }
+                if (!line.empty()) {
+                    return true;
+                }
+            }
+            corpus.reset();
+        }
+        catch (const exception& e) {
+            fprintf(stderr, "%s: %s\n", corpus_path, e.what());
+            corpus_path = nullptr;
+        }
+    }
+    return false;
+}
+
+// On charge, and full
+int BoardSerial::chargingstate() {
+    return 1 << 5 | 20;
+}
+
+Bitmap BoardSerial::boardstate() {
+    return state;
+}
+
+int BoardSerial::readdata(uint8_t* buf, int len) {
+    assert(buf && len >= 256);
+    step();
+
+    // As one packet, {id, length >> 7, length & 127, addr, addr, events...,
+    // checksum}.  Events are pairs, don't split one
+    const auto n = static_cast<int>(min<size_t>(events.size(), 248));
+    const auto packet_len = 6 + n;
+    const uint8_t header[5] = {133, uint8_t(packet_len >> 7), uint8_t(packet_len & 127), 0, 0};
+    memcpy(buf, header, sizeof header);
+    memcpy(buf + 5, events.data(), n);
+    events.erase(events.begin(), events.begin() + n);
+
+    unsigned sum = 0;
+    for (auto i = 0; i != packet_len - 1; ++i) {
+        sum += buf[i];
+    }
+    buf[packet_len - 1] = sum % 128;
+    return packet_len;
+}
+
+void BoardSerial::buttons(Buttons& press, Buttons& release) {
+    press   = Buttons();
+    release = Buttons();
+}
+
+int BoardSerial::leds_off() {
+    return 0;
+}
+
+int BoardSerial::led_flash() {
+    return 0;
+}
+
+int BoardSerial::led(int) {
+    return 0;
+}
+
+int BoardSerial::led_array(const int* squares, int num_squares) {
+    if (num_squares == 2) {
+        return led_from_to(squares[0], squares[1]);
+    }
+    return 0;
+}
+
+int BoardSerial::led_from_to(int from, int to) {
+    shown      = true;
+    shown_from = static_cast<Square>(from);
+    shown_to   = static_cast<Square>(to);
+    return 0;
+}
+
+int BoardSerial::play_sound(Sound) {
+    return 0;
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
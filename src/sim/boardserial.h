@@ -0,0 +1,160 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+// A simulated DGT Centaur board, with someone playing on it
+
+#ifndef BOARDSERIAL_H
+#define BOARDSERIAL_H
+
+#include "../chess/chess_hands.h"
+#include "../chess/chess_pgn.h"
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+enum class Button {
+    BACK = 0,
+    DOWN = 1,
+    PLAY = 2,
+    UP   = 3,
+    TICK = 4,
+    HELP = 6,  // no, I don't know where 5 went
+};
+
+class Buttons {
+    std::bitset<7> buttons;
+public:
+    Buttons(unsigned long value = 0) noexcept : buttons(value) {}
+};
+
+enum Sound {
+    SOUND_GENERAL    = 0,
+    SOUND_FACTORY    = 1,
+    SOUND_POWER_OFF  = 2,
+    SOUND_POWER_ON   = 3,
+    SOUND_WRONG      = 4,
+    SOUND_WRONG_MOVE = 5,
+    SOUND_NONE       = 6,
+};
+
+class BoardSerial {
+    using Clock = std::chrono::steady_clock;
+
+    // An action, and when it's due
+    struct Scheduled {
+        Clock::time_point at;
+        Action            action;
+    };
+
+    // Playing a game from the corpus, or the engine's, or setting up
+    enum Mode { CORPUS, ENGINE, RESET };
+
+    const char*  corpus_path;
+    double       speed;
+    std::size_t  plies;
+    std::mt19937 random;
+
+    std::unique_ptr<PgnReader> corpus;
+    bool                       from_corpus{true};  // Whose the next game is
+    std::vector<thc::Move>     line;               // Of the corpus game
+    std::size_t                ply{0};
+
+    // The board, and what the game loop makes of it, but for moves it misses
+    std::unique_ptr<hands::Reader> reader;
+    Bitmap                         state;
+
+    Mode                  mode{RESET};
+    std::deque<Scheduled> script;
+    Clock::time_point     idle_since;
+    bool                  moved{false};  // Last thing done was a move
+
+    // The computer's move, lit
+    bool        shown{false};
+    thc::Square shown_from{thc::SQUARE_INVALID};
+    thc::Square shown_to{thc::SQUARE_INVALID};
+
+    std::vector<std::uint8_t> events;  // Not yet read
+
+    Clock::duration pause(double seconds) const;
+    bool chance(double probability);
+    void schedule(const ActionList& actions, Clock::duration delay);
+    void happen(const Action& action);
+    void step();
+    void plan();
+    void play(thc::Move move, Clock::duration delay);
+    void reset();
+    void next_game();
+    bool next_line();
+
+public:
+    // Replies are ready at once, there's nothing to wait for
+    class Reply {};
+
+    // Shutdown serial connection to board
+    ~BoardSerial() noexcept;
+
+    // Play games from cfg_soak_pgn(), if any, and the engine's, at
+    // cfg_soak_speed()
+    BoardSerial();
+
+    // Ditto, from games in corpus (NULL for none)
+    BoardSerial(const char* corpus, double speed, unsigned seed, std::size_t plies);
+
+    // Return battery and charging status
+    int chargingstate();
+
+    // Read current state of board fields.  Returns bitmap where set bit
+    // indicates presence of piece.
+    // MSB: H1=63 G1 F1 ... A1, H2 G2 ... A2, ..., H8 G8 ... A8=0
+    Bitmap boardstate();
+
+    // Read field events from board
+    int readdata(std::uint8_t* buf, int len);
+
+    // Read button events from board
+    void buttons(Buttons& press, Buttons& release);
+
+    // Pipelined queries, see centaur/boardserial.h
+    Reply send_chargingstate() { return {}; }
+    Reply send_boardstate() { return {}; }
+    Reply send_readdata() { return {}; }
+    Reply send_buttons() { return {}; }
+
+    int    chargingstate(Reply&) { return chargingstate(); }
+    Bitmap boardstate(Reply&) { return boardstate(); }
+    int    readdata(Reply&, std::uint8_t* buf, int len) { return readdata(buf, len); }
+    void   buttons(Reply&, Buttons& press, Buttons& release) { buttons(press, release); }
+
+    int leds_off();
+    int led_flash();
+    int led(int square);
+    int led_array(const int* squares, int num_squares);
+    int led_from_to(int from, int to);
+
+    int play_sound(Sound sound);
+};
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,241 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "soak.h"
+#include "centaur.h"
+#include "cfg.h"
+#include "utility/latency.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace std;
+
+// What a client asks for, in turn, as the web app does.  The event stream
+// is held open a while, then it reconnects, as a browser tab would
+static const char* const REQUESTS[] = {
+    "/api/fen",
+    "/api/pgn",
+    "/api/screen",
+    "/api/latency",
+    "/api/games",
+    "/api/events",
+};
+
+// Longest any request is waited on, and how long the event stream is held
+static constexpr int TIMEOUT_MS = 5000;
+static constexpr int EVENTS_MS  = 1000;
+
+// Longer than any move takes, engine's or simulated player's
+static constexpr double STALL_S = 60;
+
+Soak::Soak() {
+}
+
+Soak::~Soak() {
+    stop();
+}
+
+void Soak::start() {
+    began    = clock::now();
+    changed  = began.time_since_epoch().count();
+    stopping = false;
+
+    executor     = make_unique<Executor>("soak");
+    // A ply further on is a move played, any further back a takeback, or
+    // back to none, a new game.  Whatever the game was at first, resumed,
+    // isn't counted
+    auto counted = [this, ply = optional<size_t>{}](const GameEvent& event) mutable {
+        if (ply && event.ply > *ply) {
+            moves += event.ply - *ply;
+        }
+        else if (ply && event.ply == 0 && *ply != 0) {
+            ++games;
+        }
+        if (!ply || event.ply != *ply) {
+            changed = clock::now().time_since_epoch().count();
+        }
+        ply = event.ply;
+    };
+    subscription = centaur.events.game.subscribe(*executor, counted);
+
+    const auto clients = static_cast<unsigned>(max(0, cfg_soak_clients()));
+    for (unsigned i = 0; i != clients; ++i) {
+        threads.emplace_back(&Soak::client, this, i);
+    }
+    threads.emplace_back(&Soak::reporter, this);
+}
+
+void Soak::stop() {
+    if (!executor) {
+        return;
+    }
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cond.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+
+    centaur.events.game.unsubscribe(subscription);
+    executor.reset();
+
+    report(cout);
+}
+
+// One GET, to the end of the response or for as long as it's held, which
+// counts as having failed unless it got as far as a 200
+static bool get(const char* path, int hold_ms, uint64_t& received) {
+    const auto fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    sockaddr_in address{};
+    address.sin_family      = AF_INET;
+    address.sin_port        = htons(static_cast<uint16_t>(cfg_port()));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof address) != 0) {
+        close(fd);
+        return false;
+    }
+
+    const auto request = string("GET ") + path + " HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+    if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(request.size())) {
+        close(fd);
+        return false;
+    }
+
+    // Read to the end, or the deadline
+    const auto deadline = chrono::steady_clock::now() + chrono::milliseconds{hold_ms};
+    string     status;
+    char       buf[4096];
+    for (;;) {
+        const auto left = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now());
+        if (left.count() <= 0) {
+            break;
+        }
+        pollfd pfd{fd, POLLIN, 0};
+        if (poll(&pfd, 1, static_cast<int>(left.count())) <= 0) {
+            break;
+        }
+        const auto n = recv(fd, buf, sizeof buf, 0);
+        if (n <= 0) {
+            break;
+        }
+        received += n;
+        if (status.size() < 12) {
+            status.append(buf, min<size_t>(n, 12 - status.size()));
+        }
+    }
+    close(fd);
+
+    return status.compare(0, 9, "HTTP/1.1 ") == 0 && status.compare(9, 3, "200") == 0;
+}
+
+void Soak::client(unsigned index) {
+    // Not all in step
+    auto next = index % size(REQUESTS);
+    for (;;) {
+        {
+            unique_lock<std::mutex> lock(mutex);
+            if (cond.wait_for(lock, chrono::milliseconds{100}, [this] { return stopping; })) {
+                return;
+            }
+        }
+
+        const auto path   = REQUESTS[next];
+        const auto stream = strcmp(path, "/api/events") == 0;
+        next = (next + 1) % size(REQUESTS);
+
+        uint64_t bytes = 0;
+        const auto ok  = get(path, stream ? EVENTS_MS : TIMEOUT_MS, bytes);
+        ++requests;
+        received += bytes;
+        if (!ok) {
+            ++failures;
+        }
+    }
+}
+
+void Soak::reporter() {
+    const auto every = chrono::duration_cast<clock::duration>(
+        chrono::duration<double>(max(1.0, cfg_soak_report())));
+
+    unique_lock<std::mutex> lock(mutex);
+    while (!cond.wait_for(lock, every, [this] { return stopping; })) {
+        lock.unlock();
+        report(cout);
+        lock.lock();
+    }
+}
+
+// Resident set, in kB
+static unsigned long resident() {
+    unsigned long size = 0;
+    unsigned long pages = 0;
+    if (auto statm = fopen("/proc/self/statm", "r")) {
+        if (fscanf(statm, "%lu %lu", &size, &pages) != 2) {
+            pages = 0;
+        }
+        fclose(statm);
+    }
+    return pages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+void Soak::report(ostream& out) {
+    const auto elapsed = chrono::duration<double>(clock::now() - began).count();
+    const auto played  = moves.load();
+
+    char line[256];
+    snprintf(line, sizeof line,
+             "soak: %.0f s, %llu games, %llu moves, %.2f moves/s, "
+             "%llu requests, %llu failed, %llu kB received, %lu kB resident\n",
+             elapsed,
+             (unsigned long long)games.load(),
+             (unsigned long long)played,
+             elapsed > 0 ? played / elapsed : 0.0,
+             (unsigned long long)requests.load(),
+             (unsigned long long)failures.load(),
+             (unsigned long long)(received.load() / 1024),
+             resident());
+    out << line;
+
+    const auto still = chrono::duration<double>(clock::now() - clock::time_point{clock::duration{changed.load()}}).count();
+    if (still > STALL_S) {
+        ++stalls;
+        snprintf(line, sizeof line, "soak: stalled, nothing played for %.0f s\n", still);
+        out << line;
+    }
+    LatencyHistogram::report(out);
+    out.flush();
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,81 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef SOAK_H
+#define SOAK_H
+
+#include "utility/eventbus.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Load on the game loop for `rcm soak`, besides what the simulated board
+// plays: web clients asking for everything the web app does, over and
+// over, and a report every so often of how it's holding up.  Moves a
+// second, what the clients got, the process' resident size and where the
+// time went (see LatencyHistogram), so a leak or a slowdown shows as a
+// trend over hours
+class Soak {
+public:
+    Soak();
+    ~Soak();
+
+    // Clients and reports from now, until stopped
+    void start();
+
+    // A last report, once the clients are done
+    void stop();
+
+    // Reports that found the game stuck, nothing played and no new game for
+    // a minute, as when the computer's never asked for its move
+    std::uint64_t stalled() const { return stalls; }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    std::unique_ptr<Executor> executor;
+    std::uint64_t             subscription{0};
+    clock::time_point         began;
+
+    std::atomic<std::uint64_t> moves{0};
+    std::atomic<std::uint64_t> games{0};
+    std::atomic<std::uint64_t> requests{0};
+    std::atomic<std::uint64_t> failures{0};
+    std::atomic<std::uint64_t> received{0};  // Bytes
+    std::atomic<std::uint64_t> stalls{0};
+    std::atomic<clock::rep>    changed{0};  // When the ply last did, since the clock's epoch
+
+    std::mutex               mutex;  // Of stopping
+    std::condition_variable  cond;
+    bool                     stopping{false};
+    std::vector<std::thread> threads;
+
+    void client(unsigned index);
+    void reporter();
+    void report(std::ostream& out);
+};
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -4,13 +4,25 @@
 #include "standard.h"
 #include "board.h"
 #include "centaur.h"
+#include "cfg.h"
 #include "chess/chess.h"
 #include "db.h"
+#include "utility/latency.h"
+#include "utility/reactor.h"
+#include "utility/trace.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <thread>
 
-#include <sys/select.h>
+#include <unistd.h>
 
 #include <jansson.h>
 
@@ -34,6 +46,11 @@ StandardGame::StandardGame() {
     };
 }
 
+StandardGame::StandardGame(const Player& white, const Player& black)
+    : white{white}, black{black}, fixed{true}
+{
+}
+
 static json_t* player_to_json(const Player& player) {
     json_t *data = json_object();
     json_object_set_new(data, "player",
@@ -139,18 +156,21 @@ void StandardGame::on_changed(Game& game) {
     }
 
     if (white.type == COMPUTER) {
-        game.tag("White") = white.computer.engine;
+        game.tag("White", white.computer.engine);
     } else {
-        game.tag("White") = "Human";
+        game.tag("White", "Human");
     }
 
     if (black.type == COMPUTER) {
-        game.tag("Black") = black.computer.engine;
+        game.tag("Black", black.computer.engine);
     } else {
-        game.tag("Black") = "Human";
+        game.tag("Black", "Human");
     }
 
-    game.settings = settings_to_json();
+    char *settings = settings_to_json();
+    game.settings = settings ? settings : "";
+    free(settings);
+
     db.save_game(game);
 }
 
@@ -168,20 +188,12 @@ void StandardGame::set_game(unique_ptr<Game> game) {
     centaur.game->observe(this);
 }
 
-// When running in the console, we can hit "Enter" to exit cleanly.  Otherwise
-// this is just a sleep.
-static int poll_for_keypress(int timeout_ms) {
-    const struct timespec timeout = {
-        .tv_sec  =  timeout_ms / 1000,
-        .tv_nsec = (timeout_ms % 1000) * 1000000,
-    };
-
-    fd_set readfds;
-    FD_ZERO(&readfds);
-    FD_SET(0, &readfds);
-
-    // Yields 1 if there's input, 0 otherwise
-    return pselect(1, &readfds, NULL, NULL, &timeout, NULL);
+// When running in the console, we can hit "Enter" to exit cleanly.  Waits
+// on the board's events, when it's being read, wake us too, as does
+// anything else watched
+static void watch_console(Reactor& reactor, bool& quit) {
+    reactor.watch(STDIN_FILENO, [&quit] { quit = true; });
+    reactor.watch(centaur.wakeup_fd(), [] {});
 }
 
 // We can only read moves from known positions.  Here we wait for the pieces to
@@ -190,7 +202,7 @@ static int poll_for_keypress(int timeout_ms) {
 void StandardGame::start() {
     // Load latest game and settings from database
     auto game = db.load_latest();
-    if (static_cast<bool>(game) && !game->settings.empty()) {
+    if (static_cast<bool>(game) && !game->settings.empty() && !fixed) {
         settings_from_json(game->settings.data());
     }
     if (!game) {
@@ -204,7 +216,13 @@ void StandardGame::start() {
     set_game(std::move(game));
     centaur.render();
 
-    while (!poll_for_keypress(500)) {
+    // Looking again whenever a piece is moved
+    Reactor reactor;
+    auto quit = false;
+    watch_console(reactor, quit);
+    centaur.start_reading();
+
+    for (; !quit; reactor.wait()) {
         // Discard any actions generated during setup
         centaur.purge_actions();
 
@@ -223,32 +241,197 @@ void StandardGame::start() {
     }
 }
 
+// Playing a move read from the board, with saving and its LED, drawn after
+static LatencyHistogram play_move_latency{"play_move"};
+
+// From field events to their move being played
+static LatencyHistogram move_latency{"event_to_move"};
+
+// Best lines analysed for a human being coached
+static constexpr unsigned COACHING_LINES = 3;
+
+// What there is to spend on the engine's next search
+static Resources resources() {
+    Resources resources;
+    resources.cores    = max(1u, thread::hardware_concurrency());
+    resources.charging = centaur.charging();
+    resources.battery  = centaur.batterylevel();
+
+    if (auto meminfo = fopen("/proc/meminfo", "r")) {
+        char line[128];
+        unsigned long kb;
+        while (fgets(line, sizeof line, meminfo)) {
+            if (sscanf(line, "MemAvailable: %lu kB", &kb) == 1) {
+                resources.memory = static_cast<unsigned>(kb / 1024);
+                break;
+            }
+        }
+        fclose(meminfo);
+    }
+    return resources;
+}
+
 // Gameplay loop: Read and interpret user actions to update game state
 void StandardGame::run() {
-    vector<Move>   candidates;
+    MoveList       candidates;
     optional<Move> takeback;
 
-    Engine engine{"stockfish"};
+    TRACE_THREAD("game");
+
+    Engine engine{cfg_engine_path(), {
+        .processes = static_cast<unsigned>(max(1, cfg_engine_processes())),
+        .threads   = static_cast<unsigned>(max(1, cfg_engine_threads())),
+        .hash      = static_cast<unsigned>(max(1, cfg_engine_hash())),
+        .cache     = static_cast<unsigned>(max(1, cfg_engine_cache())),
+    }, &db};
+    engine.reuse_depth = static_cast<unsigned>(max(0, cfg_engine_reuse_depth()));
+    if (const auto book = cfg_book()) {
+        try {
+            engine.book = make_unique<Book>(book);
+        }
+        catch (const exception& e) {
+            // Out of book from the start, then
+            fprintf(stderr, "%s: %s\n", book, e.what());
+        }
+    }
+
+    // Saved games are reviewed with whatever the engine isn't doing for
+    // this one, once nothing's happened on the board for a while
+    Review review{db, static_cast<unsigned>(max(100, cfg_review_movetime()))};
+    const auto review_idle = chrono::duration<double>(cfg_review_idle());
+    auto active    = chrono::steady_clock::now();
+    auto reviewing = false;
 
     auto player = centaur.game->WhiteToPlay() ? &white : &black;
 
+    // Whoever's turn it is, the computer is asked for its move, or for a
+    // human being coached, the position's analysed while they think (once,
+    // not again each time they touch a piece)
+    uint64_t analysed = 0;  // Generation of the game
+    auto coach = [&] {
+        if ((player->human.error || player->human.opportunity) &&
+            centaur.game->generation() != analysed)
+        {
+            analysed = centaur.game->generation();
+            engine.analyse(*centaur.game, COACHING_LINES);
+        }
+    };
+    auto next_turn = [&] {
+        player = centaur.game->WhiteToPlay() ? &white : &black;
+        active = chrono::steady_clock::now();
+        engine.govern(resources());
+        if (player->type == COMPUTER) {
+            // In case human played for computer and something is left in the queue
+            (void)engine.move();
+
+            // Ask for new move
+            engine.play(*centaur.game, player->computer.elo);
+        }
+        else {
+            coach();
+        }
+    };
+
     // If camputer has first move, see what it wants to do
     //
     // N.B., this check is necessary b/c in the main loop (below) we read the
     // computer's move at the top but request it at the bottom.  When computer
     // moves first, we need this extra request to kick things off.
     //
-    if (player->type == COMPUTER) {
-        // In case human played for computer and something is left in the queue
-        (void)engine.move();
+    next_turn();
+
+    // Wake as soon as the board or the engine has something for us, and
+    // otherwise only when something's due: working out a missed move,
+    // review starting once the board's been idle, or review's own
+    // deadlines.  Nothing's polled, so nothing happening costs nothing
+    Reactor reactor;
+    auto quit = false;
+    watch_console(reactor, quit);
+    reactor.watch(engine.wakeup_fd(), [] {});
+    centaur.start_reading();
+
+    auto review_allowed = false;
+    auto due = [&]() -> optional<chrono::steady_clock::time_point> {
+        const auto now = chrono::steady_clock::now();
+        if (centaur.reconstructing()) {
+            return now;
+        }
+        optional<chrono::steady_clock::time_point> until;
+        if (review_allowed) {
+            until = review.due();
+        }
+        const auto idle_at = active + chrono::duration_cast<chrono::steady_clock::duration>(review_idle);
+        if (now < idle_at && (!until || idle_at < *until)) {
+            until = idle_at;
+        }
+        return until;
+    };
 
-        // Ask for new move
-        engine.play(*centaur.game, player->computer.elo);
-    }
+    while (reactor.wait(due()), !quit) {
+        // Whatever this pass changes is drawn at the end, once, after the
+        // engine's been asked for anything and the LEDs are out
+        struct Render {
+            ~Render() { centaur.render(); }
+        } render;
+
+        // Whatever this pass does to the LEDs goes out at the end, together
+        struct ShowLeds {
+            ~ShowLeds() { centaur.show_leds(); }
+        } show_leds;
+
+        // Whatever the web app has asked for, as if it had happened on the
+        // board
+        RemoteCommand command;
+        bool          commanded = false;
+        while (centaur.commands.pop(command)) {
+            commanded = true;
+            switch (command) {
+            case REMOTE_TAKEBACK:
+                if (auto before = centaur.game->previous()) {
+                    const auto takeback = before->find_move_played(centaur.game->current());
+                    centaur.game->play_takeback();
+                    if (takeback) {
+                        // Show where the pieces go back to
+                        centaur.led_from_to(takeback->dst, takeback->src);
+                    }
+                }
+                break;
+            case REMOTE_NEW_GAME:
+                set_game(make_unique<Game>());
+                break;
+            }
+        }
+        if (commanded) {
+            // Actions so far were read against the position before
+            centaur.purge_actions();
+            next_turn();
+            continue;
+        }
+
+        // Whatever the engine's found of the position on the board, for the
+        // web app and coaching
+        if (auto analysis = engine.analysis()) {
+            if (analysis->key == centaur.game->current()->key()) {
+                centaur.events.analysis.publish({*analysis, time(NULL)});
+            }
+            review.found(*analysis);
+        }
 
-    while (!poll_for_keypress(200)) {
         player = centaur.game->WhiteToPlay() ? &white : &black;
 
+        // On charge, review goes on through the game, unless someone's being
+        // coached, who has the engine back as soon as they're at the board
+        const auto coached = player->type == HUMAN && (player->human.error || player->human.opportunity);
+        const auto idle    = chrono::steady_clock::now() - active > review_idle;
+        const auto allowed = idle || (centaur.charging() > 0 && !coached);
+        if (reviewing && !allowed && player->type == HUMAN) {
+            // Whatever coaching review pre-empted, again
+            analysed = 0;
+            coach();
+        }
+        reviewing      = review.step(engine, allowed);
+        review_allowed = allowed;
+
         // Check if computer has move to play
         optional<Move> move;
         if (player->type == COMPUTER) {
@@ -260,18 +443,24 @@ void StandardGame::run() {
         }
 
         // Check if there are user actions to process
-        if (centaur.update_actions() == 0) {
+        if (centaur.update_actions() == 0 && !centaur.reconstructing()) {
             // No actions, nothing's changed, there's nothing to do
             continue;
         }
+        active = chrono::steady_clock::now();
+
+        // From here, what the board's actions come to
+        TRACE_SPAN("actions");
 
         // Detect start of new game
         const auto boardstate = centaur.getstate();
         if (boardstate == Board::STARTING_POSITION) {
             centaur.purge_actions();
             if (centaur.game->started) {
-                // Replace in-progress game with new game
+                // Replace in-progress game with new game, and if the
+                // computer's white, it's its move
                 set_game(make_unique<Game>());
+                next_turn();
             }
             continue;
         }
@@ -289,29 +478,32 @@ void StandardGame::run() {
             move = candidates.front();
         }
 
-        if (takeback && move) {
-            centaur.game->revise_move(*takeback, *move);
-            centaur.led(move->dst);
-        }
-        else if (takeback) {
-            centaur.game->play_takeback(*takeback);
-            centaur.led(takeback->src);
-        }
-        else if (move) {
-            centaur.game->play_move(*move);
-            centaur.led(move->dst);
+        if (takeback || move) {
+            LatencyTimer timer{play_move_latency};
+            TRACE_SPAN("play_move");
+            if (takeback && move) {
+                centaur.game->revise_move(*takeback, *move);
+                centaur.led(move->dst);
+            }
+            else if (takeback) {
+                centaur.game->play_takeback(*takeback);
+                centaur.led(takeback->src);
+            }
+            else {
+                centaur.game->play_move(*move);
+                centaur.led(move->dst);
+            }
+            move_latency.record_since(latency_origin());
         }
 
         // If is now computer's turn, ask for its move
-        player = centaur.game->WhiteToPlay() ? &white : &black;
-        if (player->type == COMPUTER) {
-            // In case human played for computer and something is left in the queue
-            (void)engine.move();
-
-            // Ask for new move
-            engine.play(*centaur.game, player->computer.elo);
-        }
+        next_turn();
     }
+
+    centaur.stop_reading();
+
+    // Where the time went
+    LatencyHistogram::report(cout);
 }
 
 void StandardGame::main() {
@@ -39,11 +39,15 @@ struct Player {
 class StandardGame : public Observer<Game> {
     Player white;
     Player black;
+    bool   fixed{false};  // Players as given, not the last game's
 
 public:
     virtual ~StandardGame();
     StandardGame();
 
+    // Between these players, whatever the last game was between
+    StandardGame(const Player& white, const Player& black);
+
     void main();
 
     void on_changed(Game&) override;
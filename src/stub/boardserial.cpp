@@ -30,8 +30,8 @@ Bitmap BoardSerial::boardstate() {
     return ::boardstate;
 }
 
-int BoardSerial::readdata(uint8_t* buf, int len) {
-    printf("boardserial_readdata(%p, %d) => 6\n", (void*)buf, len);
+// Not logged, the board is read continuously
+int BoardSerial::readdata(uint8_t*, int) {
     return 6;  // Idle
 }
 
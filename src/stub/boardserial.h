@@ -40,6 +40,9 @@ enum Sound {
 
 class BoardSerial {
 public:
+    // Replies are ready at once, there's nothing to wait for
+    class Reply {};
+
     // Shutdown serial connection to board
     ~BoardSerial() noexcept;
 
@@ -60,6 +63,17 @@ public:
     // Read button events from board
     void buttons(Buttons& press, Buttons& release);
 
+    // Pipelined queries, see centaur/boardserial.h
+    Reply send_chargingstate() { return {}; }
+    Reply send_boardstate() { return {}; }
+    Reply send_readdata() { return {}; }
+    Reply send_buttons() { return {}; }
+
+    int    chargingstate(Reply&) { return chargingstate(); }
+    Bitmap boardstate(Reply&) { return boardstate(); }
+    int    readdata(Reply&, std::uint8_t* buf, int len) { return readdata(buf, len); }
+    void   buttons(Reply&, Buttons& press, Buttons& release) { buttons(press, release); }
+
     int leds_off();
     int led_flash();
     int led(int square);
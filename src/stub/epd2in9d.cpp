@@ -37,6 +37,12 @@ void Epd2in9d::update(const uint8_t* data) {
     sleep_ms(100);
 }
 
+void Epd2in9d::update(const uint8_t* data, int first_row, int last_row, int first_byte, int last_byte) {
+    printf("epd2in9d_update(%p, %d, %d, %d, %d)\n",
+        (void*)data, first_row, last_row, first_byte, last_byte);
+    sleep_ms(100);
+}
+
 // This file is part of the Raccoon's Centaur Mods (RCM).
 //
 // RCM is free software: you can redistribute it and/or modify
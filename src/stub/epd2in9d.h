@@ -34,6 +34,11 @@ public:
     // Partially update display.  That is, instruct the e-Paper to make the
     // minimal changes necessary to display the new image.
     void update(const std::uint8_t* data);
+
+    // Partially update just the window of rows first_row to last_row, and of
+    // bytes (8 pixels each) first_byte to last_byte in each row.  data is the
+    // whole image, as for update(data)
+    void update(const std::uint8_t* data, int first_row, int last_row, int first_byte, int last_byte);
 };
 
 #endif
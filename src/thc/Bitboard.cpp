@@ -0,0 +1,309 @@
+/****************************************************************************
+ * Bitboard.cpp Chess classes - Bitboard representation of the position
+ *  License: MIT license. Full text of license is in associated file LICENSE
+ ****************************************************************************/
+
+#include "Bitboard.h"
+
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+using namespace thc;
+
+namespace {
+
+// Same order as enum Direction
+constexpr int file_step[NBR_DIRECTIONS] = { -1, +1,  0,  0, -1, -1, +1, +1 };
+constexpr int rank_step[NBR_DIRECTIONS] = {  0,  0, -1, +1, -1, +1, +1, -1 };
+
+// Knight and king steps as (file, rank), in lookup table order
+constexpr int knight_steps[8][2] = {
+    {-2, -1}, {-2, +1}, {-1, -2}, {-1, +2}, {+2, -1}, {+2, +1}, {+1, -2}, {+1, +2}
+};
+constexpr int king_steps[8][2] = {
+    {-1, -1}, {-1, +1}, {+1, -1}, {+1, +1}, {-1,  0}, {+1,  0}, { 0, -1}, { 0, +1}
+};
+
+constexpr bool on_board(int file, int rank) {
+    return 0 <= file && file < 8 && 0 <= rank && rank < 8;
+}
+
+constexpr Square square_at(int file, int rank) {
+    return static_cast<Square>((7 - rank) * 8 + file);
+}
+
+using Table = BitboardTable;
+
+constexpr array<Table, NBR_DIRECTIONS> make_rays() {
+    array<Table, NBR_DIRECTIONS> rays{};
+    for (int dir = 0; dir < NBR_DIRECTIONS; ++dir) {
+        for (int sq = 0; sq < 64; ++sq) {
+            auto file = sq % 8 + file_step[dir];
+            auto rank = 7 - sq / 8 + rank_step[dir];
+            while (on_board(file, rank)) {
+                rays[dir][sq] |= BB(square_at(file, rank));
+                file += file_step[dir];
+                rank += rank_step[dir];
+            }
+        }
+    }
+    return rays;
+}
+
+// Squares between if not whole, else the line through
+constexpr array<Table, 64> make_lines(const array<Table, NBR_DIRECTIONS>& rays, bool whole) {
+    array<Table, 64> lines{};
+    for (int from = 0; from < 64; ++from) {
+        for (int dir = 0; dir < NBR_DIRECTIONS; ++dir) {
+            const auto opposite = dir < DIR_SW ? dir ^ 1 : (dir + 2 - DIR_SW) % 4 + DIR_SW;
+            for (int to = 0; to < 64; ++to) {
+                if (!(rays[dir][from] & BB(Square(to)))) {
+                    continue;
+                }
+                lines[from][to] = whole ?
+                    rays[dir][from] | rays[opposite][from] | BB(Square(from)) :
+                    rays[dir][from] & ~rays[dir][to] & ~BB(Square(to));
+            }
+        }
+    }
+    return lines;
+}
+
+constexpr array<Targets, 64> make_targets(const int (&steps)[8][2]) {
+    array<Targets, 64> targets{};
+    for (int sq = 0; sq < 64; ++sq) {
+        for (const auto& step : steps) {
+            const auto file = sq % 8 + step[0];
+            const auto rank = 7 - sq / 8 + step[1];
+            if (on_board(file, rank)) {
+                auto& t = targets[sq];
+                t.dst[t.nbr++] = square_at(file, rank);
+            }
+        }
+    }
+    return targets;
+}
+
+constexpr Table make_masks(const array<Targets, 64>& targets) {
+    Table masks{};
+    for (int sq = 0; sq < 64; ++sq) {
+        for (int i = 0; i < targets[sq].nbr; ++i) {
+            masks[sq] |= BB(targets[sq].dst[i]);
+        }
+    }
+    return masks;
+}
+
+constexpr Table make_pawn_attacks(bool white) {
+    Table attacks{};
+    const auto step = white ? +1 : -1;
+    for (int sq = 0; sq < 64; ++sq) {
+        const auto file = sq % 8;
+        const auto rank = 7 - sq / 8;
+        if (on_board(file - 1, rank + step)) {
+            attacks[sq] |= BB(square_at(file - 1, rank + step));
+        }
+        if (on_board(file + 1, rank + step)) {
+            attacks[sq] |= BB(square_at(file + 1, rank + step));
+        }
+    }
+    return attacks;
+}
+
+}
+
+// Defined constexpr, so there's no static initialisation order to worry
+//  about when positions are constructed at startup
+namespace thc {
+
+constexpr array<Table, NBR_DIRECTIONS> rays = make_rays();
+constexpr array<Table, 64> between = make_lines(rays, false);
+constexpr array<Table, 64> line    = make_lines(rays, true);
+
+constexpr array<Targets, 64> knight_targets = make_targets(knight_steps);
+constexpr array<Targets, 64> king_targets   = make_targets(king_steps);
+constexpr Table knight_attacks = make_masks(knight_targets);
+constexpr Table king_attacks   = make_masks(king_targets);
+
+constexpr array<Table, 2> pawn_attacks = {
+    make_pawn_attacks(false),
+    make_pawn_attacks(true),
+};
+
+}
+
+namespace {
+
+// Found by trying sparse random numbers until one maps every blocker set
+//  without a harmful collision.  make_slider_attacks() checks them again
+constexpr Bitboard rook_magic_numbers[64] = {
+    0x1080004008801020, 0x0840092002c03000, 0x1900200010400900, 0x0880100008000480,
+    0x4200100420080200, 0x8100020100080400, 0x0200040110886200, 0x0200008040220411,
+    0x0404800084400220, 0x0000401000402000, 0x0086001081220440, 0x0408800800100280,
+    0x000a001201040820, 0x8848800200840080, 0x4001000100040200, 0x0442000102105084,
+    0x9080010020804100, 0x0040404000201009, 0x0000808010002009, 0x2200090021d00100,
+    0x0008008008040080, 0x0004004002010040, 0x0011040008015042, 0x00000a0001768104,
+    0x0000800080204009, 0x2010004140002001, 0x9800200280100080, 0x1000100080080080,
+    0x0442000a00049020, 0x2100040080020080, 0x0800120400900148, 0x0010040a00128541,
+    0x2800804000800030, 0x1010002000400041, 0x4000200011004100, 0x0610008410800800,
+    0x0400802402800800, 0xc100020080800400, 0x0002000802000401, 0x0182085882000401,
+    0x0220204000808000, 0x2860100040024022, 0x0001002004110040, 0x99101042000a0020,
+    0x0004080004008080, 0x0010040002008080, 0x2012004881020004, 0x8300842444820011,
+    0x0088403882010200, 0x0820400080210100, 0x0110910040a00300, 0x0801100280080480,
+    0x0242009008200600, 0x1002000489500200, 0x0040800200010080, 0x0091800041000080,
+    0x0000209300488001, 0x04c1002414824001, 0x020020000b001041, 0x7000100004200901,
+    0x8002002004100802, 0x30010002084c0007, 0x0888221800813004, 0x4000002840840112
+};
+
+constexpr Bitboard bishop_magic_numbers[64] = {
+    0xa010041108003100, 0x006082020a002900, 0x6810010619200000, 0x08281a0520000408,
+    0x0001104001000400, 0x0018901008048400, 0x00040a0210245280, 0x000200210808a402,
+    0x9140048410821200, 0x0800091010820041, 0x20504804832202c0, 0x0100091401081000,
+    0x8021011140000012, 0x0810020804450400, 0x208b0542109008a2, 0x0080084a08040204,
+    0x0040e2a80811244c, 0x2505022008008108, 0x0430220100420040, 0x010a040420220040,
+    0x1105000290400000, 0x0093001200822120, 0x4000a62048043004, 0x280120048a015004,
+    0x006090002a020814, 0x44042000240800d0, 0x01102800040a4400, 0x1004080080220040,
+    0x0001001011004024, 0x0010044000805040, 0x0914041200820100, 0x0004821012821480,
+    0x0024040500c05021, 0x0088611002080200, 0x0116080a00040020, 0x4000020080080080,
+    0x2450450140840040, 0x0000880201484100, 0x0222020404020092, 0x8081110600002e00,
+    0x2842101105000801, 0x1100809008001025, 0x00020202221c0400, 0x0422014022009020,
+    0x0210046102100c00, 0xc004008082029102, 0x00aa461801101200, 0x0404080080201108,
+    0x020542108c205002, 0x0410544804100100, 0x0040910841100000, 0x0400200042021100,
+    0x00004204850400c0, 0x0200100410a42102, 0x1040020801210102, 0x0805040410420000,
+    0x2884804130100200, 0x800c262201242000, 0x1058000194108800, 0x0014221054420204,
+    0x0104000012a02200, 0x0200881003300100, 0x0140400202840100, 0x0402020801010201
+};
+
+constexpr Bitboard slow_slider_attacks(int sq, Bitboard occupied, int first, int last) {
+    Bitboard attacks = 0;
+    for (int dir = first; dir <= last; ++dir) {
+        auto ray = rays[dir][sq];
+        if (const auto blockers = ray & occupied) {
+            ray ^= rays[dir][ascending(dir) ? lsb(blockers) : msb(blockers)];
+        }
+        attacks |= ray;
+    }
+    return attacks;
+}
+
+// Squares whose occupancy matters to a slider, edges only block what's
+//  beyond them, and there's nothing beyond them
+constexpr Bitboard blocker_mask(int sq, int first, int last) {
+    const auto file  = sq % 8;
+    const auto rank  = 7 - sq / 8;
+    const auto edges = ((rank_bb(0) | rank_bb(7)) & ~rank_bb(rank)) |
+                       ((file_bb(0) | file_bb(7)) & ~file_bb(file));
+    return slow_slider_attacks(sq, 0, first, last) & ~edges;
+}
+
+template <size_t N>
+constexpr array<Bitboard, N> make_slider_attacks(int sq, Bitboard mask, Bitboard magic,
+                                                 unsigned shift, int first, int last)
+{
+    array<Bitboard, N> attacks{};
+    auto blockers = Bitboard{0};
+    do {
+        // Every attack set has at least one square, so zero is unused
+        const auto attacked = slow_slider_attacks(sq, blockers, first, last);
+        auto& entry = attacks[(blockers * magic) >> shift];
+        if (entry != 0 && entry != attacked) {
+            throw logic_error("Bad magic number");
+        }
+        entry = attacked;
+        blockers = (blockers - mask) & mask;  // next subset of mask
+    } while (blockers);
+    return attacks;
+}
+
+// One table per square, each just big enough for its blocker mask
+template <bool bishop, int sq>
+struct SliderTable {
+    static constexpr int      first = bishop ? DIR_SW : DIR_W;
+    static constexpr int      last  = bishop ? DIR_SE : DIR_N;
+    static constexpr Bitboard mask  = blocker_mask(sq, first, last);
+    static constexpr unsigned bits  = popcount(mask);
+    static constexpr Bitboard magic = bishop ? bishop_magic_numbers[sq] : rook_magic_numbers[sq];
+    static constexpr array<Bitboard, size_t{1} << bits> attacks =
+        make_slider_attacks<size_t{1} << bits>(sq, mask, magic, 64 - bits, first, last);
+};
+
+template <bool bishop, size_t... sq>
+constexpr array<Magic, 64> make_magics(index_sequence<sq...>) {
+    return {{
+        Magic{
+            SliderTable<bishop, sq>::mask,
+            SliderTable<bishop, sq>::magic,
+            SliderTable<bishop, sq>::attacks.data(),
+            64 - SliderTable<bishop, sq>::bits
+        }...
+    }};
+}
+
+}
+
+namespace thc {
+
+constexpr array<Magic, 64> rook_magics   = make_magics<false>(make_index_sequence<64>{});
+constexpr array<Magic, 64> bishop_magics = make_magics<true>(make_index_sequence<64>{});
+
+}
+
+void Bitboards::toggle(Square sq, char piece) {
+    const auto bit = BB(sq);
+    switch (piece) {
+    case 'P': white ^= bit; pawns   ^= bit; break;
+    case 'N': white ^= bit; knights ^= bit; break;
+    case 'B': white ^= bit; bishops ^= bit; break;
+    case 'R': white ^= bit; rooks   ^= bit; break;
+    case 'Q': white ^= bit; queens  ^= bit; break;
+    case 'K': white ^= bit; kings   ^= bit; break;
+    case 'p': black ^= bit; pawns   ^= bit; break;
+    case 'n': black ^= bit; knights ^= bit; break;
+    case 'b': black ^= bit; bishops ^= bit; break;
+    case 'r': black ^= bit; rooks   ^= bit; break;
+    case 'q': black ^= bit; queens  ^= bit; break;
+    case 'k': black ^= bit; kings   ^= bit; break;
+    default:
+        break;
+    }
+}
+
+Bitboard Bitboards::pieces(char piece) const {
+    switch (piece) {
+    case 'P': return white & pawns;
+    case 'N': return white & knights;
+    case 'B': return white & bishops;
+    case 'R': return white & rooks;
+    case 'Q': return white & queens;
+    case 'K': return white & kings;
+    case 'p': return black & pawns;
+    case 'n': return black & knights;
+    case 'b': return black & bishops;
+    case 'r': return black & rooks;
+    case 'q': return black & queens;
+    case 'k': return black & kings;
+    default:
+        return 0;
+    }
+}
+
+Bitboard Bitboards::attackers(Square sq, Bitboard occupied) const {
+    return (pawn_attacks[0][sq] & pawns & white) |
+           (pawn_attacks[1][sq] & pawns & black) |
+           (knight_attacks[sq] & knights) |
+           (king_attacks[sq] & kings) |
+           (bishop_attacks(sq, occupied) & (bishops | queens)) |
+           (rook_attacks(sq, occupied) & (rooks | queens));
+}
+
+bool Bitboards::attacked(Square sq, bool by_white, Bitboard occupied) const {
+    const auto enemy = by_white ? white : black;
+    return
+        (pawn_attacks[!by_white][sq] & pawns & enemy) ||
+        (knight_attacks[sq] & knights & enemy) ||
+        (king_attacks[sq] & kings & enemy) ||
+        (bishop_attacks(sq, occupied) & (bishops | queens) & enemy) ||
+        (rook_attacks(sq, occupied) & (rooks | queens) & enemy);
+}
@@ -0,0 +1,151 @@
+/****************************************************************************
+ * Bitboard.h Chess classes - Bitboard representation of the position
+ *  License: MIT license. Full text of license is in associated file LICENSE
+ ****************************************************************************/
+#pragma once
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "ChessDefs.h"
+
+#include <array>
+#include <cstdint>
+
+namespace thc {
+
+// Set of squares, bit N set for Square N.  So a8 is the least significant
+//  bit and h1 the most significant, same as the board's own field bitmaps
+using Bitboard = std::uint64_t;
+
+constexpr Bitboard BB(Square sq) { return Bitboard{1} << sq; }
+
+// All squares on a file (0 is the a-file) or rank (0 is the first rank)
+constexpr Bitboard file_bb(int ifile) { return Bitboard{0x0101010101010101} << ifile; }
+constexpr Bitboard rank_bb(int irank) { return Bitboard{0xff} << 8 * (7 - irank); }
+
+constexpr int    popcount(Bitboard b) { return __builtin_popcountll(b); }
+constexpr Square lsb(Bitboard b)      { return static_cast<Square>(__builtin_ctzll(b)); }
+constexpr Square msb(Bitboard b)      { return static_cast<Square>(63 - __builtin_clzll(b)); }
+
+constexpr Square pop_lsb(Bitboard& b) {
+    const auto sq = lsb(b);
+    b &= b - 1;
+    return sq;
+}
+
+// Ray directions, in the order the lookup tables generate slider moves
+//  (rooks use the first four, bishops the last four, queens all eight)
+enum Direction {
+    DIR_W, DIR_E, DIR_S, DIR_N, DIR_SW, DIR_NW, DIR_NE, DIR_SE,
+    NBR_DIRECTIONS
+};
+
+// True for directions in which Square increases, so the nearest square on
+//  a ray is its least significant bit (otherwise its most significant bit)
+constexpr bool ascending(int dir) {
+    return dir == DIR_E || dir == DIR_S || dir == DIR_SW || dir == DIR_SE;
+}
+
+// Destination squares of a knight or king, in the order the lookup tables
+//  generate them
+struct Targets {
+    unsigned char nbr;
+    Square        dst[8];
+};
+
+using BitboardTable = std::array<Bitboard, 64>;
+
+// Squares along each ray from each square, not including the square itself
+extern const std::array<BitboardTable, NBR_DIRECTIONS> rays;
+
+// Squares strictly between two squares sharing a rank, file or diagonal
+extern const std::array<BitboardTable, 64> between;
+
+// The entire rank, file or diagonal through two squares
+extern const std::array<BitboardTable, 64> line;
+
+extern const std::array<Targets, 64> knight_targets;
+extern const std::array<Targets, 64> king_targets;
+extern const BitboardTable knight_attacks;
+extern const BitboardTable king_attacks;
+
+// Squares attacked by a black ([0]) or white ([1]) pawn on each square
+extern const std::array<BitboardTable, 2> pawn_attacks;
+
+// Squares attacked along one ray, up to and including the first blocker
+inline Bitboard ray_attacks(int dir, Square sq, Bitboard occupied) {
+    auto attacks = rays[dir][sq];
+    if (const auto blockers = attacks & occupied) {
+        attacks ^= rays[dir][ascending(dir) ? lsb(blockers) : msb(blockers)];
+    }
+    return attacks;
+}
+
+// Slider attacks by magic multiplication: the occupied squares that could
+//  block (mask), times magic, shifted, index a table of attack sets.  The
+//  tables are built and checked at compile time
+struct Magic {
+    Bitboard        mask;
+    Bitboard        magic;
+    const Bitboard* attacks;
+    unsigned        shift;
+
+    Bitboard operator()(Bitboard occupied) const {
+        return attacks[((occupied & mask) * magic) >> shift];
+    }
+};
+
+extern const std::array<Magic, 64> rook_magics;
+extern const std::array<Magic, 64> bishop_magics;
+
+inline Bitboard rook_attacks(Square sq, Bitboard occupied) {
+    return rook_magics[sq](occupied);
+}
+
+inline Bitboard bishop_attacks(Square sq, Bitboard occupied) {
+    return bishop_magics[sq](occupied);
+}
+
+inline Bitboard queen_attacks(Square sq, Bitboard occupied) {
+    return rook_attacks(sq, occupied) | bishop_attacks(sq, occupied);
+}
+
+// The position as one bitboard per colour and one per type of piece
+class Bitboards {
+public:
+    Bitboard white{0};
+    Bitboard black{0};
+    Bitboard pawns{0};
+    Bitboard knights{0};
+    Bitboard bishops{0};
+    Bitboard rooks{0};
+    Bitboard queens{0};
+    Bitboard kings{0};
+
+    Bitboard occupied() const { return white | black; }
+
+    // Squares holding a given piece, eg 'N' for white knights
+    Bitboard pieces(char piece) const;
+
+    // Squares whose contents differ, a different piece counts as a difference
+    Bitboard difference(const Bitboards& other) const {
+        return (white   ^ other.white)   | (black   ^ other.black) |
+               (pawns   ^ other.pawns)   | (knights ^ other.knights) |
+               (bishops ^ other.bishops) | (rooks   ^ other.rooks) |
+               (queens  ^ other.queens)  | (kings   ^ other.kings);
+    }
+
+    // Add a piece to, or remove it from, a square (' ' is a no-op)
+    void toggle(Square sq, char piece);
+
+    // Set of pieces of either colour attacking a square
+    Bitboard attackers(Square sq, Bitboard occupied) const;
+
+    // Is square attacked by the given side?
+    bool attacked(Square sq, bool by_white, Bitboard occupied) const;
+};
+
+}
+
+#endif
@@ -57,7 +57,7 @@
 
 #include "ChessPosition.h"
 #include "Move.h"
-#include "PrivateChessDefs.h"
+#include "SquareMask.h"
 
 #include <cctype>
 #include <cstdio>
@@ -78,6 +78,34 @@ ChessPosition::ChessPosition()
         "        "
         "PPPPPPPP"
         "RNBQKBNR", sizeof squares);
+    rebuild_bitboards();
+}
+
+void ChessPosition::rebuild_bitboards() {
+    bitboards = Bitboards{};
+    piece_key = 0;
+    for (auto occupied = occupancy_mask(squares); occupied;) {
+        const auto sq = pop_lsb(occupied);
+        bitboards.toggle(sq, squares[sq]);
+        piece_key ^= zobrist::piece(sq, squares[sq]);
+    }
+}
+
+zobrist::Key ChessPosition::key() const {
+    auto key = piece_key;
+    if (!white) {
+        key ^= zobrist::black;
+    }
+    if (wking_allowed())  key ^= zobrist::castling[0];
+    if (wqueen_allowed()) key ^= zobrist::castling[1];
+    if (bking_allowed())  key ^= zobrist::castling[2];
+    if (bqueen_allowed()) key ^= zobrist::castling[3];
+
+    const auto ep = groomed_enpassant_target();
+    if (ep != SQUARE_INVALID) {
+        key ^= zobrist::enpassant[IFILE(ep)];
+    }
+    return key;
 }
 
 Square ChessPosition::groomed_enpassant_target() const {
@@ -376,6 +404,7 @@ bool ChessPosition::Forsyth(const char* txt) {
                 full_move_count = temp;
         }
     }
+    rebuild_bitboards();
     return( okay );
 }
 
@@ -9,7 +9,9 @@
 #ifndef CHESSPOSITION_H
 #define CHESSPOSITION_H
 
+#include "Bitboard.h"
 #include "ChessDefs.h"
+#include "Zobrist.h"
 
 #include <bitset>
 #include <string>
@@ -115,6 +117,12 @@ public:
 
     DETAIL d;
 
+    // The same pieces as squares[], kept in step by set_square()
+    Bitboards bitboards;
+
+    // Zobrist key of the pieces alone, also kept in step by set_square()
+    zobrist::Key piece_key{0};
+
     ChessPosition();
 
     // Groomed enpassant target is enpassant target qualified by the possibility to
@@ -125,6 +133,23 @@ public:
 
     char at(Square sq) const { return squares[sq]; }
 
+    // Change the contents of a square, all changes to squares[] after set up
+    //  should go through here to keep the bitboards up to date
+    void set_square(Square sq, char piece) {
+        bitboards.toggle(sq, squares[sq]);
+        bitboards.toggle(sq, piece);
+        piece_key ^= zobrist::piece(sq, squares[sq]) ^ zobrist::piece(sq, piece);
+        squares[sq] = piece;
+    }
+
+    // Recalculate bitboards and piece_key from squares[]
+    void rebuild_bitboards();
+
+    // Zobrist key of the whole position, covering the pieces, who's to move
+    //  and the castling and en passant possibilities.  Positions that count
+    //  as repetitions have the same key
+    zobrist::Key key() const;
+
     // Castling allowed ?
     bool wking_allowed()  const { return d.wking()  && at(e1)=='K' && at(h1)=='R'; }
     bool wqueen_allowed() const { return d.wqueen() && at(e1)=='K' && at(a1)=='R'; }
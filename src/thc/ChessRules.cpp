@@ -6,7 +6,7 @@
  ****************************************************************************/
 
 #include "ChessRules.h"
-#include "PrivateChessDefs.h"
+#include "Bitboard.h"
 
 #include <algorithm>
 #include <cassert>
@@ -21,8 +21,8 @@ using namespace thc;
 
 // Play a move
 void ChessRules::PlayMove(Move move) {
-    // Legal move - save it in history
-    history.push_back(move);
+    // Legal move - save the position it's played from in history
+    key_history.push_back(key());
 
     // Update full move count
     if (!white) {
@@ -40,8 +40,15 @@ void ChessRules::PlayMove(Move move) {
         ++half_move_clock;    // neither pawn move nor capture
     }
 
-    // Actually play the move
+    // No earlier position can be repeated after a pawn move or capture, so
+    //  there's no need to remember them.  Keeps copies of the position small
+    if (half_move_clock == 0) {
+        key_history.clear();
+    }
+
+    // Actually play the move, it can't be undone so drop the saved details
     PushMove(move);
+    detail_stack.pop_back();
 }
 
 void ChessRules::play_san_move(string_view san_move) {
@@ -80,12 +87,196 @@ MoveList ChessRules::GenMoveList() {
 }
 
 MoveList ChessRules::GenLegalMoveList() {
-    return select_legal(GenMoveList());
+    MoveList moves;
+    GenLegalMoveList(moves);
+    return moves;
+}
+
+// Add a pawn move, or all four promotions
+static void add_pawn_move(
+    MoveList& moves, Square src, Square dst, SPECIAL special, char capture, bool promotion)
+{
+    if (!promotion) {
+        moves.push_back({src, dst, special, capture});
+    }
+    else {
+        // Generate (under)promotions in the order (Q),N,B,R
+        moves.push_back({src, dst, SPECIAL_PROMOTION_QUEEN,  capture});
+        moves.push_back({src, dst, SPECIAL_PROMOTION_KNIGHT, capture});
+        moves.push_back({src, dst, SPECIAL_PROMOTION_BISHOP, capture});
+        moves.push_back({src, dst, SPECIAL_PROMOTION_ROOK,   capture});
+    }
 }
 
-// Create a list of all legal moves in this position
-void ChessRules::GenLegalMoveList(vector<Move>& moves) {
-    moves = GenLegalMoveList();
+// Create a list of all legal moves in this position.  Legality is decided on
+//  the bitboards (checks, pins, attacked squares) instead of by playing each
+//  candidate, but the result is exactly the moves, in exactly the order, of
+//  select_legal(GenMoveList())
+void ChessRules::GenLegalMoveList(MoveList& moves) {
+    GenLegalMoveList(moves, ~Bitboard{0}, ~Bitboard{0});
+}
+
+// Create the legal moves from squares in src_mask to squares in dst_mask,
+//  in the same order as the full list
+void ChessRules::GenLegalMoveList(MoveList& moves, Bitboard src_mask, Bitboard dst_mask) {
+    moves.clear();
+
+    const auto& bb      = bitboards;
+    const auto own      = white ? bb.white : bb.black;
+    const auto enemy    = white ? bb.black : bb.white;
+    const auto occupied = own | enemy;
+
+    // Without exactly one king we can't reason about checks and pins
+    if (popcount(own & bb.kings) != 1) {
+        for (auto move : select_legal(GenMoveList())) {
+            if ((src_mask & BB(move.src)) && (dst_mask & BB(move.dst))) {
+                moves.push_back(move);
+            }
+        }
+        return;
+    }
+    const auto king = lsb(own & bb.kings);
+
+    // When in check, pieces other than the king must capture a single
+    //  checker, or block it
+    const auto checkers = bb.attackers(king, occupied) & enemy;
+    auto evasions = ~Bitboard{0};
+    if (checkers) {
+        evasions = popcount(checkers) > 1 ? 0 : checkers | between[king][lsb(checkers)];
+    }
+
+    // Pinned pieces may only move along the line of the pin
+    auto pinned  = Bitboard{0};
+    auto snipers = enemy & (
+        (rook_attacks(king, 0)   & (bb.rooks   | bb.queens)) |
+        (bishop_attacks(king, 0) & (bb.bishops | bb.queens)));
+    while (snipers) {
+        const auto blockers = between[king][pop_lsb(snipers)] & occupied;
+        if (popcount(blockers) == 1) {
+            pinned |= blockers & own;
+        }
+    }
+
+    for (auto pieces = own & src_mask; pieces; ) {
+        const auto src = pop_lsb(pieces);
+        auto allowed = evasions & ~own & dst_mask;
+        if (pinned & BB(src)) {
+            allowed &= line[king][src];
+        }
+
+        auto first = 0, last = -1;  // ray directions, for sliders
+        switch (squares[src]) {
+        case 'P': case 'p': {
+            if (RANK(src) == (white ? '8' : '1')) {
+                break;  // only in illegal set ups
+            }
+            const auto step      = white ? -8 : +8;
+            const auto promotion = RANK(src) == (white ? '7' : '2');
+
+            // Captures, a-side first
+            for (auto df : {-1, +1}) {
+                if (IFILE(src) + df < 0 || IFILE(src) + df > 7) {
+                    continue;
+                }
+                const auto dst = static_cast<Square>(src + step + df);
+                if (dst == d.enpassant_target) {
+                    // Rare enough, and subtle enough, to just try it
+                    const Move move{src, dst, white ? SPECIAL_WEN_PASSANT : SPECIAL_BEN_PASSANT,
+                                    white ? 'p' : 'P'};
+                    if ((dst_mask & BB(dst)) && is_legal(move)) {
+                        moves.push_back(move);
+                    }
+                }
+                else if (enemy & allowed & BB(dst)) {
+                    add_pawn_move(moves, src, dst, NOT_SPECIAL, squares[dst], promotion);
+                }
+            }
+
+            // Advances
+            const auto dst = static_cast<Square>(src + step);
+            if (occupied & BB(dst)) {
+                break;
+            }
+            if (allowed & BB(dst)) {
+                add_pawn_move(moves, src, dst, NOT_SPECIAL, ' ', promotion);
+            }
+            const auto dst2 = static_cast<Square>(dst + step);
+            if (RANK(src) == (white ? '2' : '7') && !(occupied & BB(dst2)) && (allowed & BB(dst2))) {
+                moves.push_back({src, dst2, white ? SPECIAL_WPAWN_2SQUARES : SPECIAL_BPAWN_2SQUARES, ' '});
+            }
+            break;
+        }
+
+        case 'N': case 'n': {
+            if (!(knight_attacks[src] & allowed)) {
+                break;
+            }
+            const auto& targets = knight_targets[src];
+            for (auto i = 0; i < targets.nbr; ++i) {
+                const auto dst = targets.dst[i];
+                if (allowed & BB(dst)) {
+                    moves.push_back({src, dst, NOT_SPECIAL, squares[dst]});
+                }
+            }
+            break;
+        }
+
+        case 'B': case 'b': first = DIR_SW; last = DIR_SE;   break;
+        case 'R': case 'r': first = DIR_W;  last = DIR_N;    break;
+        case 'Q': case 'q': first = DIR_W;  last = DIR_SE;   break;
+
+        case 'K': case 'k': {
+            // Exclude the king from the occupancy, else it would shield
+            //  squares behind itself from sliders
+            const auto others  = occupied ^ BB(src);
+            const auto& targets = king_targets[src];
+            for (auto i = 0; i < targets.nbr; ++i) {
+                const auto dst = targets.dst[i];
+                if ((~own & dst_mask & BB(dst)) && !bb.attacked(dst, !white, others)) {
+                    moves.push_back({src, dst, SPECIAL_KING_MOVE, squares[dst]});
+                }
+            }
+
+            // Castling, under the same conditions as KingMoves()
+            auto castle = [&](Square rook, Square via, Square to, Bitboard empty, char piece,
+                              bool flag, bool by_white, SPECIAL special)
+            {
+                if (!flag || !(dst_mask & BB(to)) || squares[rook] != piece || (occupied & empty) ||
+                    bb.attacked(src, by_white, occupied) ||
+                    bb.attacked(via, by_white, occupied) ||
+                    bb.attacked(to,  by_white, occupied))
+                {
+                    return;
+                }
+
+                // As select_legal() would, make sure we don't end up in check
+                const auto after = (occupied ^ BB(src) ^ BB(rook)) | BB(via) | BB(to);
+                if (!bb.attacked(to, !white, after)) {
+                    moves.push_back({src, to, special, ' '});
+                }
+            };
+            if (src == e1) {
+                castle(h1, f1, g1, BB(f1) | BB(g1), 'R', d.wking(), false, SPECIAL_WK_CASTLING);
+                castle(a1, d1, c1, BB(b1) | BB(c1) | BB(d1), 'R', d.wqueen(), false, SPECIAL_WQ_CASTLING);
+            }
+            if (src == e8) {
+                castle(h8, f8, g8, BB(f8) | BB(g8), 'r', d.bking(), true, SPECIAL_BK_CASTLING);
+                castle(a8, d8, c8, BB(b8) | BB(c8) | BB(d8), 'r', d.bqueen(), true, SPECIAL_BQ_CASTLING);
+            }
+            break;
+        }
+        }
+
+        // Sliders, nearest square first along each ray
+        for (auto dir = first; dir <= last; ++dir) {
+            auto targets = ray_attacks(dir, src, occupied) & allowed;
+            while (targets) {
+                const auto dst = ascending(dir) ? lsb(targets) : msb(targets);
+                targets ^= BB(dst);
+                moves.push_back({src, dst, NOT_SPECIAL, squares[dst]});
+            }
+        }
+    }
 }
 
 // Create a list of all legal moves in this position, with extra info
@@ -100,7 +291,7 @@ void ChessRules::GenLegalMoveList(vector<Move>& moves,
     stalemate.clear();
 
     // Generate all moves, including illegal (e.g. put king in check) moves
-    vector<Move> list2;
+    MoveList list2;
     GenMoveList(list2);
 
     // Loop copying the proven good ones
@@ -156,131 +347,30 @@ bool ChessRules::IsDraw(bool white_asks, DRAWTYPE& result) {
 
 // Get number of times position has been repeated
 int ChessRules::GetRepetitionCount() {
+    // Keys already distinguish real castling and en passant possibilities,
+    //  and there's no going back past the last pawn move or capture
+    const auto target = key();
+    const auto nbr_half_moves = std::min<size_t>(half_move_clock, key_history.size());
     auto matches = 0;
-
-    //  Save those aspects of current position that are changed by multiple
-    //  PopMove() calls as we search backwards (i.e. squares, white,
-    //  detail, detail_idx)
-    char save_squares[sizeof(squares)];
-    memcpy(save_squares, squares, sizeof save_squares);
-    const auto save_detail_stack = detail_stack;
-    bool          save_white     = white;
-    DETAIL tmp{d};
-
-    // Search backwards ....
-    size_t nbr_half_moves = (full_move_count - 1) * 2 + (!white ? 1 : 0);
-    nbr_half_moves = std::min(nbr_half_moves, history.size());
-    nbr_half_moves = std::min(nbr_half_moves, detail_stack.size());
-    auto idx = history.size();
-    for (auto i = 0; i < nbr_half_moves; i++) {
-        Move m = history[--idx];
-        PopMove(m);
-
-        // ... looking for matching positions
-        if (white          == save_white       &&  // quick ones first!
-            d.wking_square == tmp.wking_square &&
-            d.bking_square == tmp.bking_square &&
-            memcmp(squares, save_squares, sizeof squares) == 0)
-        {
+    for (auto p = key_history.rbegin(); p != key_history.rbegin() + nbr_half_moves; ++p) {
+        if (*p == target) {
             matches++;
-            if (d == tmp) {  // Castling flags and/or enpassant target different?
-                continue;
-            }
-
-            // It might not be a match (but it could be - we have to unpack what the differences
-            //  really mean)
-            auto revoke_match = false;
-
-            // Revoke match if different value of en-passant target square means different
-            //  en passant possibilities
-            if (d.enpassant_target != tmp.enpassant_target) {
-                int ep_saved = tmp.enpassant_target;
-                int ep_now   = d.enpassant_target;
-
-                // Work out whether each en_passant is a real one, i.e. is there an opposition
-                //  pawn in place to capture (if not it's just a double pawn advance with no
-                //  actual enpassant consequences)
-                auto real=false;
-                auto ep = ep_saved;
-                char const *squ = save_squares;
-                for (auto j = 0; j < 2; j++) {
-                    if (ep == a6) {
-                            real = (squ[SE(ep)] == 'P');
-                    }
-                    else if (b6 <= ep && ep <= g6) {
-                            real = (squ[SW(ep)] == 'P' || squ[SE(ep)] == 'P');
-                    }
-                    else if (ep == h6) {
-                            real = (squ[SW(ep)] == 'P');
-                    }
-                    else if (ep == a3) {
-                            real = (squ[NE(ep)] == 'p');
-                    }
-                    else if (b3 <= ep && ep <= g3) {
-                            real = (squ[NE(ep)] == 'p' || squ[NW(ep)] == 'p');
-                    }
-                    else if (ep == h3) {
-                            real = (squ[NW(ep)] == 'p' );
-                    }
-                    if (j > 0) {
-                        ep_now = real ? ep : SQUARE_INVALID;    // evaluate second time through
-                    }
-                    else {
-                        ep_saved = real ? ep : SQUARE_INVALID;  // evaluate first time through
-                        ep = ep_now;                            // setup second time through
-                        squ = squares;
-                        real = false;
-                    }
-                }
-
-                // If for example one en_passant is real and the other not, it's not a real match
-                if (ep_saved != ep_now) {
-                    revoke_match = true;
-                }
-            }
-
-            // Revoke match if different value of castling flags means different
-            //  castling possibilities
-            if (!revoke_match && !eq_castling(d, tmp)) {
-                bool wking_saved  = save_squares[e1]=='K' && save_squares[h1]=='R' && tmp.wking();
-                bool wking_now    = squares[e1]=='K' && squares[h1]=='R' && d.wking();
-                bool bking_saved  = save_squares[e8]=='k' && save_squares[h8]=='r' && tmp.bking();
-                bool bking_now    = squares[e8]=='k' && squares[h8]=='r' && d.bking();
-                bool wqueen_saved = save_squares[e1]=='K' && save_squares[a1]=='R' && tmp.wqueen();
-                bool wqueen_now   = squares[e1]=='K' && squares[a1]=='R' && d.wqueen();
-                bool bqueen_saved = save_squares[e8]=='k' && save_squares[a8]=='r' && tmp.bqueen();
-                bool bqueen_now   = squares[e8]=='k' && squares[a8]=='r' && d.bqueen();
-                revoke_match = (
-                    wking_saved  != wking_now  ||
-                    bking_saved  != bking_now  ||
-                    wqueen_saved != wqueen_now ||
-                    bqueen_saved != bqueen_now
-                );
-            }
-
-            // If the real castling or enpassant possibilities differ, it's not a match
-            //  At one stage we just did a naive binary match of the details - not good enough. For example
-            //  a rook moving away from h1 doesn't affect the WKING flag, but does disallow white king side
-            //  castling
-            if (revoke_match) {
-                matches--;
-            }
         }
-
-        // For performance reasons, abandon search early if pawn move
-        //  or capture
-        if( squares[m.src]=='P' || squares[m.src]=='p' || !IsEmptySquare(m.capture) )
-            break;
     }
-
-    // Restore current position
-    memcpy(squares, save_squares, sizeof squares);
-    white      = save_white;
-    detail_stack = save_detail_stack;
-    d = tmp;
     return matches+1;  // +1 counts original position
 }
 
+bool ChessRules::same_history(const ChessRules& other) const {
+    if (key_history.size() != other.key_history.size()) {
+        return false;
+    }
+    auto lhs = key_history;
+    auto rhs = other.key_history;
+    sort(lhs.begin(), lhs.end());
+    sort(rhs.begin(), rhs.end());
+    return lhs == rhs;
+}
+
 // Check insufficient material draw rule
 bool ChessRules::IsInsufficientDraw(bool white_asks, DRAWTYPE& result) {
     char   piece;
@@ -337,35 +427,32 @@ bool ChessRules::IsInsufficientDraw(bool white_asks, DRAWTYPE& result) {
 }
 
 // Generate a list of all possible moves in a position
-void ChessRules::GenMoveList(vector<Move>& moves) {
+void ChessRules::GenMoveList(MoveList& moves) {
     moves.clear();
 
-    for (Square square = a8; square <= h1; ++square) {
-        // If square occupied by a piece of the right colour
-        const auto piece = squares[square];
-        if ((white && IsBlack(piece)) || (!white && IsWhite(piece))) {
-            continue;
-        }
+    // Squares occupied by a piece of the right colour, a8 to h1
+    for (auto pieces = white ? bitboards.white : bitboards.black; pieces; ) {
+        const auto square = pop_lsb(pieces);
 
         // Generate moves according to the occupying piece
-        switch (piece) {
+        switch (squares[square]) {
         case 'P':
-            WhitePawnMoves(moves, square );
+            WhitePawnMoves(moves, square);
             break;
         case 'p':
-            BlackPawnMoves(moves, square );
+            BlackPawnMoves(moves, square);
             break;
         case 'N': case 'n':
-            ShortMoves(moves, square, knight_lookup[square], NOT_SPECIAL);
+            ShortMoves(moves, square, knight_targets[square], NOT_SPECIAL);
             break;
         case 'B': case 'b':
-            LongMoves(moves, square, bishop_lookup[square]);
+            LongMoves(moves, square, DIR_SW, DIR_SE);
             break;
         case 'R': case 'r':
-            LongMoves(moves, square, rook_lookup[square]);
+            LongMoves(moves, square, DIR_W, DIR_N);
             break;
         case 'Q': case 'q':
-            LongMoves(moves, square, queen_lookup[square]);
+            LongMoves(moves, square, DIR_W, DIR_SE);
             break;
         case 'K': case 'k':
             KingMoves(moves, square);
@@ -375,53 +462,37 @@ void ChessRules::GenMoveList(vector<Move>& moves) {
 }
 
 // Generate moves for pieces that move along multi-move rays (B,R,Q)
-void ChessRules::LongMoves(vector<Move>& moves, Square square, const lte* ptr) {
-    for (lte nbr_rays = *ptr++; nbr_rays != 0; --nbr_rays) {
-        for (lte ray_len = *ptr++; ray_len != 0; --ray_len) {
-            const Square dst = static_cast<Square>(*ptr++);
-            const char piece = squares[dst];
-
-            // If square not occupied (empty), add move to list
-            if (IsEmptySquare(piece)) {
-                moves.push_back({square, dst, NOT_SPECIAL, ' '});
-            }
-            // Else must move to end of ray
-            else {
-                ptr += ray_len - 1;
-
-                // If not occupied by our man add a capture
-                if ((white && IsBlack(piece)) || (!white && IsWhite(piece))) {
-                    moves.push_back({square, dst, NOT_SPECIAL, piece});
-                }
-                break;
-            }
+void ChessRules::LongMoves(MoveList& moves, Square square, int first, int last) {
+    const auto own = white ? bitboards.white : bitboards.black;
+    for (auto dir = first; dir <= last; ++dir) {
+        // Nearest square first, up to and including any enemy man
+        auto targets = ray_attacks(dir, square, bitboards.occupied()) & ~own;
+        while (targets) {
+            const auto dst = ascending(dir) ? lsb(targets) : msb(targets);
+            targets ^= BB(dst);
+            moves.push_back({square, dst, NOT_SPECIAL, squares[dst]});
         }
     }
 }
 
 // Generate moves for pieces that move along single move rays (N,K)
 void ChessRules::ShortMoves(
-    vector<Move>& moves, Square square, const lte* ptr, SPECIAL special)
+    MoveList& moves, Square square, const Targets& targets, SPECIAL special)
 {
-    for (lte nbr_moves = *ptr++; nbr_moves != 0; --nbr_moves) {
-        const Square dst = static_cast<Square>(*ptr++);
-        const char piece = squares[dst];
+    const auto own = white ? bitboards.white : bitboards.black;
+    for (auto i = 0; i < targets.nbr; ++i) {
+        const auto dst = targets.dst[i];
 
-        // If square not occupied (empty), add move to list
-        if (IsEmptySquare(piece)) {
-            moves.push_back({square, dst, special, ' '});
-        }
-        // Else if occupied by enemy man, add move to list as a capture
-        else if ((white && IsBlack(piece)) || (!white && IsWhite(piece))) {
-            moves.push_back({square, dst, special, piece});
+        // Empty, or occupied by enemy man (a capture)
+        if (!(own & BB(dst))) {
+            moves.push_back({square, dst, special, squares[dst]});
         }
     }
 }
 
 // Generate list of king moves
-void ChessRules::KingMoves(vector<Move>& moves, Square square) {
-    const lte* ptr = king_lookup[square];
-    ShortMoves(moves, square, ptr, SPECIAL_KING_MOVE);
+void ChessRules::KingMoves(MoveList& moves, Square square) {
+    ShortMoves(moves, square, king_targets[square], SPECIAL_KING_MOVE);
 
     // White castling
     if (square == e1)   // king on e1 ?
@@ -483,106 +554,62 @@ void ChessRules::KingMoves(vector<Move>& moves, Square square) {
 }
 
 // Generate list of white pawn moves
-void ChessRules::WhitePawnMoves(vector<Move>& moves, Square square) {
-    const lte* ptr = pawn_white_lookup[square];
-    bool promotion = RANK(square) == '7';
+void ChessRules::WhitePawnMoves(MoveList& moves, Square square) {
+    // Nowhere to go from the last rank (only in illegal set ups)
+    if (RANK(square) == '8') {
+        return;
+    }
+    const bool promotion = RANK(square) == '7';
 
-    // Capture ray
-    for (lte nbr_moves = *ptr++; nbr_moves != 0; --nbr_moves) {
-        const Square dst = static_cast<Square>(*ptr++);
+    // Captures, a-side first
+    for (auto targets = pawn_attacks[1][square]; targets; ) {
+        const auto dst = pop_lsb(targets);
         if (dst == d.enpassant_target) {
             moves.push_back({square, dst, SPECIAL_WEN_PASSANT, 'p'});
         }
-        else if (IsBlack(squares[dst])) {
-            const auto capture = squares[dst];
-            if (!promotion) {
-                moves.push_back({square, dst, NOT_SPECIAL, capture});
-            }
-            else {
-                // Generate (under)promotions in the order (Q),N,B,R
-                //  but we no longer rely on this elsewhere as it
-                //  stops us reordering moves
-                moves.push_back({square, dst, SPECIAL_PROMOTION_QUEEN,  capture});
-                moves.push_back({square, dst, SPECIAL_PROMOTION_KNIGHT, capture});
-                moves.push_back({square, dst, SPECIAL_PROMOTION_BISHOP, capture});
-                moves.push_back({square, dst, SPECIAL_PROMOTION_ROOK,   capture});
-            }
+        else if (bitboards.black & BB(dst)) {
+            add_pawn_move(moves, square, dst, NOT_SPECIAL, squares[dst], promotion);
         }
     }
 
-    // Advance ray
-    lte nbr_moves = *ptr++;
-    for (int i = 0; i < nbr_moves; ++i) {
-        const Square dst = static_cast<Square>(*ptr++);
-
-        // If square occupied, end now
-        if (!IsEmptySquare(squares[dst])) {
-            break;
-        }
-        if (!promotion) {
-            moves.push_back({square, dst, i == 0 ? NOT_SPECIAL : SPECIAL_WPAWN_2SQUARES, ' '});
-        }
-        else {
-            // Generate (under)promotions in the order (Q),N,B,R
-            //  but we no longer rely on this elsewhere as it
-            //  stops us reordering moves
-            moves.push_back({square, dst, SPECIAL_PROMOTION_QUEEN,  ' '});
-            moves.push_back({square, dst, SPECIAL_PROMOTION_KNIGHT, ' '});
-            moves.push_back({square, dst, SPECIAL_PROMOTION_BISHOP, ' '});
-            moves.push_back({square, dst, SPECIAL_PROMOTION_ROOK,   ' '});
-        }
+    // Advances, two squares from the second rank
+    const auto dst = NORTH(square);
+    if (bitboards.occupied() & BB(dst)) {
+        return;
+    }
+    add_pawn_move(moves, square, dst, NOT_SPECIAL, ' ', promotion);
+    if (RANK(square) == '2' && !(bitboards.occupied() & BB(NORTH(dst)))) {
+        moves.push_back({square, NORTH(dst), SPECIAL_WPAWN_2SQUARES, ' '});
     }
 }
 
 // Generate list of black pawn moves
-void ChessRules::BlackPawnMoves(vector<Move>& moves, Square square) {
-    const lte* ptr = pawn_black_lookup[square];
-    bool promotion = RANK(square) == '2';
+void ChessRules::BlackPawnMoves(MoveList& moves, Square square) {
+    // Nowhere to go from the last rank (only in illegal set ups)
+    if (RANK(square) == '1') {
+        return;
+    }
+    const bool promotion = RANK(square) == '2';
 
-    // Capture ray
-    for (lte nbr_moves = *ptr++; nbr_moves != 0; --nbr_moves) {
-        const Square dst = static_cast<Square>(*ptr++);
+    // Captures, a-side first
+    for (auto targets = pawn_attacks[0][square]; targets; ) {
+        const auto dst = pop_lsb(targets);
         if (dst == d.enpassant_target) {
             moves.push_back({square, dst, SPECIAL_BEN_PASSANT, 'P'});
         }
-        else if (IsWhite(squares[dst])) {
-            const auto capture = squares[dst];
-            if (!promotion) {
-                moves.push_back({square, dst, NOT_SPECIAL, capture});
-            }
-            else {
-                // Generate (under)promotions in the order (Q),N,B,R
-                //  but we no longer rely on this elsewhere as it
-                //  stops us reordering moves
-                moves.push_back({square, dst, SPECIAL_PROMOTION_QUEEN,  capture});
-                moves.push_back({square, dst, SPECIAL_PROMOTION_KNIGHT, capture});
-                moves.push_back({square, dst, SPECIAL_PROMOTION_BISHOP, capture});
-                moves.push_back({square, dst, SPECIAL_PROMOTION_ROOK,   capture});
-            }
+        else if (bitboards.white & BB(dst)) {
+            add_pawn_move(moves, square, dst, NOT_SPECIAL, squares[dst], promotion);
         }
     }
 
-    // Advance ray
-    lte nbr_moves = *ptr++;
-    for (int i = 0; i < nbr_moves; ++i) {
-        const Square dst = static_cast<Square>(*ptr++);
-
-        // If square occupied, end now
-        if (!IsEmptySquare(squares[dst])) {
-            break;
-        }
-        if (!promotion) {
-            moves.push_back({square, dst, i == 0 ? NOT_SPECIAL : SPECIAL_BPAWN_2SQUARES, ' '});
-        }
-        else {
-            // Generate (under)promotions in the order (Q),N,B,R
-            //  but we no longer rely on this elsewhere as it
-            //  stops us reordering moves
-            moves.push_back({square, dst, SPECIAL_PROMOTION_QUEEN,  ' '});
-            moves.push_back({square, dst, SPECIAL_PROMOTION_KNIGHT, ' '});
-            moves.push_back({square, dst, SPECIAL_PROMOTION_BISHOP, ' '});
-            moves.push_back({square, dst, SPECIAL_PROMOTION_ROOK,   ' '});
-        }
+    // Advances, two squares from the seventh rank
+    const auto dst = SOUTH(square);
+    if (bitboards.occupied() & BB(dst)) {
+        return;
+    }
+    add_pawn_move(moves, square, dst, NOT_SPECIAL, ' ', promotion);
+    if (RANK(square) == '7' && !(bitboards.occupied() & BB(SOUTH(dst)))) {
+        moves.push_back({square, SOUTH(dst), SPECIAL_BPAWN_2SQUARES, ' '});
     }
 }
 
@@ -613,14 +640,14 @@ void ChessRules::PushMove(Move m) {
     // Special handling might be required
     switch (m.special) {
     default:
-        squares[m.dst] = squares[m.src];
-        squares[m.src] = ' ';
+        set_square(m.dst, squares[m.src]);
+        set_square(m.src, ' ');
         break;
 
     // King move updates king position in details field
     case SPECIAL_KING_MOVE:
-        squares[m.dst] = squares[m.src];
-        squares[m.src] = ' ';
+        set_square(m.dst, squares[m.src]);
+        set_square(m.src, ' ');
         if (white) {
             d.wking_square = m.dst;
         }
@@ -631,83 +658,83 @@ void ChessRules::PushMove(Move m) {
 
     // In promotion case, dst piece doesn't equal src piece
     case SPECIAL_PROMOTION_QUEEN:
-        squares[m.src] = ' ';
-        squares[m.dst] = (white?'Q':'q');
+        set_square(m.src, ' ');
+        set_square(m.dst, (white?'Q':'q'));
         break;
 
     // In promotion case, dst piece doesn't equal src piece
     case SPECIAL_PROMOTION_ROOK:
-        squares[m.src] = ' ';
-        squares[m.dst] = (white?'R':'r');
+        set_square(m.src, ' ');
+        set_square(m.dst, (white?'R':'r'));
         break;
 
     // In promotion case, dst piece doesn't equal src piece
     case SPECIAL_PROMOTION_BISHOP:
-        squares[m.src] = ' ';
-        squares[m.dst] = (white?'B':'b');
+        set_square(m.src, ' ');
+        set_square(m.dst, (white?'B':'b'));
         break;
 
     // In promotion case, dst piece doesn't equal src piece
     case SPECIAL_PROMOTION_KNIGHT:
-        squares[m.src] = ' ';
-        squares[m.dst] = (white?'N':'n');
+        set_square(m.src, ' ');
+        set_square(m.dst, (white?'N':'n'));
         break;
 
     // White enpassant removes pawn south of destination
     case SPECIAL_WEN_PASSANT:
-        squares[m.src] = ' ';
-        squares[m.dst] = 'P';
-        squares[ SOUTH(m.dst) ] = ' ';
+        set_square(m.src, ' ');
+        set_square(m.dst, 'P');
+        set_square(SOUTH(m.dst), ' ');
         break;
 
     // Black enpassant removes pawn north of destination
     case SPECIAL_BEN_PASSANT:
-        squares[m.src] = ' ';
-        squares[m.dst] = 'p';
-        squares[ NORTH(m.dst) ] = ' ';
+        set_square(m.src, ' ');
+        set_square(m.dst, 'p');
+        set_square(NORTH(m.dst), ' ');
         break;
 
     // White pawn advances 2 squares sets an enpassant target
     case SPECIAL_WPAWN_2SQUARES:
-        squares[m.src] = ' ';
-        squares[m.dst] = 'P';
+        set_square(m.src, ' ');
+        set_square(m.dst, 'P');
         d.enpassant_target = SOUTH(m.dst);
         break;
 
     // Black pawn advances 2 squares sets an enpassant target
     case SPECIAL_BPAWN_2SQUARES:
-        squares[m.src] = ' ';
-        squares[m.dst] = 'p';
+        set_square(m.src, ' ');
+        set_square(m.dst, 'p');
         d.enpassant_target = NORTH(m.dst);
         break;
 
     // Castling moves update 4 squares each
     case SPECIAL_WK_CASTLING:
-        squares[e1] = ' ';
-        squares[f1] = 'R';
-        squares[g1] = 'K';
-        squares[h1] = ' ';
+        set_square(e1, ' ');
+        set_square(f1, 'R');
+        set_square(g1, 'K');
+        set_square(h1, ' ');
         d.wking_square = g1;
         break;
     case SPECIAL_WQ_CASTLING:
-        squares[e1] = ' ';
-        squares[d1] = 'R';
-        squares[c1] = 'K';
-        squares[a1] = ' ';
+        set_square(e1, ' ');
+        set_square(d1, 'R');
+        set_square(c1, 'K');
+        set_square(a1, ' ');
         d.wking_square = c1;
         break;
     case SPECIAL_BK_CASTLING:
-        squares[e8] = ' ';
-        squares[f8] = 'r';
-        squares[g8] = 'k';
-        squares[h8] = ' ';
+        set_square(e8, ' ');
+        set_square(f8, 'r');
+        set_square(g8, 'k');
+        set_square(h8, ' ');
         d.bking_square = g8;
         break;
     case SPECIAL_BQ_CASTLING:
-        squares[e8] = ' ';
-        squares[d8] = 'r';
-        squares[c8] = 'k';
-        squares[a8] = ' ';
+        set_square(e8, ' ');
+        set_square(d8, 'r');
+        set_square(c8, 'k');
+        set_square(a8, ' ');
         d.bking_square = c8;
         break;
     }
@@ -728,8 +755,8 @@ void ChessRules::PopMove(Move m) {
     // Special handling might be required
     switch (m.special) {
     default:
-        squares[m.src] = squares[m.dst];
-        squares[m.dst] = m.capture;
+        set_square(m.src, squares[m.dst]);
+        set_square(m.dst, m.capture);
         break;
 
     // For promotion, src piece was a pawn
@@ -738,52 +765,52 @@ void ChessRules::PopMove(Move m) {
     case SPECIAL_PROMOTION_BISHOP:
     case SPECIAL_PROMOTION_KNIGHT:
         if (white) {
-            squares[m.src] = 'P';
+            set_square(m.src, 'P');
         }
         else {
-            squares[m.src] = 'p';
+            set_square(m.src, 'p');
         }
-        squares[m.dst] = m.capture;
+        set_square(m.dst, m.capture);
         break;
 
     // White enpassant re-insert black pawn south of destination
     case SPECIAL_WEN_PASSANT:
-        squares[m.src] = 'P';
-        squares[m.dst] = ' ';
-        squares[SOUTH(m.dst)] = 'p';
+        set_square(m.src, 'P');
+        set_square(m.dst, ' ');
+        set_square(SOUTH(m.dst), 'p');
         break;
 
     // Black enpassant re-insert white pawn north of destination
     case SPECIAL_BEN_PASSANT:
-        squares[m.src] = 'p';
-        squares[m.dst] = ' ';
-        squares[NORTH(m.dst)] = 'P';
+        set_square(m.src, 'p');
+        set_square(m.dst, ' ');
+        set_square(NORTH(m.dst), 'P');
         break;
 
     // Castling moves update 4 squares each
     case SPECIAL_WK_CASTLING:
-        squares[e1] = 'K';
-        squares[f1] = ' ';
-        squares[g1] = ' ';
-        squares[h1] = 'R';
+        set_square(e1, 'K');
+        set_square(f1, ' ');
+        set_square(g1, ' ');
+        set_square(h1, 'R');
         break;
     case SPECIAL_WQ_CASTLING:
-        squares[e1] = 'K';
-        squares[d1] = ' ';
-        squares[c1] = ' ';
-        squares[a1] = 'R';
+        set_square(e1, 'K');
+        set_square(d1, ' ');
+        set_square(c1, ' ');
+        set_square(a1, 'R');
         break;
     case SPECIAL_BK_CASTLING:
-        squares[e8] = 'k';
-        squares[f8] = ' ';
-        squares[g8] = ' ';
-        squares[h8] = 'r';
+        set_square(e8, 'k');
+        set_square(f8, ' ');
+        set_square(g8, ' ');
+        set_square(h8, 'r');
         break;
     case SPECIAL_BQ_CASTLING:
-        squares[e8] = 'k';
-        squares[d8] = ' ';
-        squares[c8] = ' ';
-        squares[a8] = 'r';
+        set_square(e8, 'k');
+        set_square(d8, ' ');
+        set_square(c8, ' ');
+        set_square(a8, 'r');
         break;
     }
 }
@@ -796,53 +823,7 @@ bool ChessRules::AttackedPiece(Square square) {
 
 // Is a square is attacked by enemy ?
 bool ChessRules::AttackedSquare(Square square, bool enemy_is_white) {
-    Square dst;
-    const lte *ptr = (enemy_is_white ? attacks_black_lookup[square] : attacks_white_lookup[square] );
-    lte nbr_rays = *ptr++;
-    while( nbr_rays-- ) {
-        lte ray_len = *ptr++;
-        while( ray_len-- ) {
-            dst = (Square)*ptr++;
-            char piece=squares[dst];
-
-            // If square not occupied (empty), continue
-            if( IsEmptySquare(piece) )
-                ptr++;  // skip mask
-
-            // Else if occupied
-            else {
-                lte mask = *ptr++;
-
-                // White attacker ?
-                if( IsWhite(piece) && enemy_is_white ) {
-                    if( to_mask[piece] & mask )
-                        return true;
-                }
-
-                // Black attacker ?
-                else if( IsBlack(piece) && !enemy_is_white ) {
-                    if( to_mask[piece] & mask )
-                        return true;
-                }
-
-                // Goto end of ray
-                ptr += (2*ray_len);
-                ray_len = 0;
-            }
-        }
-    }
-
-    ptr = knight_lookup[square];
-    lte nbr_squares = *ptr++;
-    while( nbr_squares-- ) {
-        dst = (Square)*ptr++;
-        char piece=squares[dst];
-
-        // If occupied by an enemy knight, we have found an attacker
-        if( (enemy_is_white&&piece=='N') || (!enemy_is_white&&piece=='n') )
-            return true;
-    }
-    return false;
+    return bitboards.attacked(square, enemy_is_white, bitboards.occupied());
 }
 
 // Evaluate a position, returns bool okay (not okay means illegal position)
@@ -856,9 +837,9 @@ bool ChessRules::Evaluate(TERMINAL &score_terminal) {
     return Evaluate(nullptr, score_terminal);
 }
 
-bool ChessRules::Evaluate(vector<Move> *p, TERMINAL& score_terminal) {
-    vector<Move> local_list;
-    vector<Move>& list = p ? *p : local_list;
+bool ChessRules::Evaluate(MoveList *p, TERMINAL& score_terminal) {
+    MoveList local_list;
+    MoveList& list = p ? *p : local_list;
     int i, any;
     Square my_king, enemy_king;
     bool okay;
@@ -985,7 +966,7 @@ bool ChessRules::IsLegal(ILLEGAL_REASON& reason) {
 }
 
 Move ChessRules::uci_move(string_view uci_move) {
-    vector<Move> legal_moves;
+    MoveList legal_moves;
     GenLegalMoveList(legal_moves);
 
     const auto expected = Move(uci_move);
@@ -1010,7 +991,7 @@ string ChessRules::move_uci(Move move) {
 // Read natural string move eg "Nf3"
 //  return bool okay
 Move ChessRules::san_move(string_view natural_in) {
-    vector<Move> list;
+    MoveList list;
     int  i, len=0;
     char src_file='\0', src_rank='\0', dst_file='\0', dst_rank='\0';
     char promotion='\0';
@@ -1032,7 +1013,7 @@ Move ChessRules::san_move(string_view natural_in) {
     okay = false;
     for( i=0; i<sizeof(move); i++ )
     {
-        move[i] = natural_in[i];
+        move[i] = i<natural_in.size() ? natural_in[i] : '\0';
         if( move[i]=='\0' || move[i]==' ' || move[i]=='\t' ||
             move[i]=='\r' || move[i]=='\n' )
         {
@@ -1232,11 +1213,28 @@ Move ChessRules::san_move(string_view natural_in) {
     // Check against all possible moves
     if( okay )
     {
-        GenLegalMoveList(list);
-
-        // Have source and destination, eg "d2d3"
         if( enpassant )
             src_rank = dst_rank = '\0';
+
+        // Only generate moves the tests below could accept, so from the
+        //  named piece (and file or rank) to the destination square (or file).
+        //  Matches keep their order, so the first match is the same move it
+        //  would be in the full list
+        const bool any_piece = default_piece && src_file && src_rank && dst_file && dst_rank;
+        Bitboard src_mask = any_piece ? ~Bitboard{0} : bitboards.pieces(piece);
+        if( src_file )
+            src_mask &= file_bb(src_file-'a');
+        if( src_rank )
+            src_mask &= rank_bb(src_rank-'1');
+        const Bitboard dst_mask = dst_rank ? BB(dst_) : file_bb(dst_file-'a');
+
+        // Knights and sliders only go where they attack (pawns advance and
+        //  kings castle onto squares they don't attack)
+        if( dst_rank && !any_piece && strchr("NBRQnbrq",piece) )
+            src_mask &= bitboards.attackers(dst_, bitboards.occupied());
+        GenLegalMoveList(list, src_mask, dst_mask);
+
+        // Have source and destination, eg "d2d3"
         if( src_file && src_rank && dst_file && dst_rank )
         {
             for (auto& m : list) {
@@ -1397,10 +1395,7 @@ string ChessRules::move_san(Move move) {
     nmove[0] = '-';
     nmove[1] = '-';
     nmove[2] = '\0';
-    vector<Move> list;
-    vector<bool> check;
-    vector<bool> mate;
-    vector<bool> stalemate;
+    MoveList list;
     enum
     {
         ALG_PAWN_MOVE,
@@ -1413,19 +1408,25 @@ string ChessRules::move_san(Move move) {
     bool done=false;
     bool found = false;
     char append='\0';
-    GenLegalMoveList(list, check, mate, stalemate);
-    for (int i = 0; i != list.size(); ++i) {
-        Move mfound = list[i];
+    GenLegalMoveList(list);
+    for (auto mfound : list) {
         if( mfound == move )
         {
             found = true;
-            if( mate[i] )
-                append = '#';
-            else if( check[i] )
-                append = '+';
+            break;
         }
     }
 
+    // Only the move itself needs checking for check and mate
+    if( found )
+    {
+        PushMove(move);
+        const Square king_to_move = static_cast<Square>(white ? d.wking_square : d.bking_square);
+        if( AttackedPiece(king_to_move) )
+            append = GenLegalMoveList().empty() ? '#' : '+';
+        PopMove(move);
+    }
+
     // Loop through algorithms
     for( int alg=ALG_PAWN_MOVE; found && !done && alg<=ALG_NB1D2; alg++ )
     {
@@ -11,18 +11,19 @@
 
 #include "ChessPosition.h"
 #include "Move.h"
+#include "MoveList.h"
 
 #include <vector>
 
 namespace thc {
 
-using MoveList = std::vector<Move>;
-
 // Encapsulates state of game and operations available
 class ChessRules: public ChessPosition {
 private:
-    MoveList            history;
-    std::vector<DETAIL> detail_stack;
+    std::vector<zobrist::Key> key_history;  // key() before each PlayMove(),
+                                            //  since the last irreversible one
+    std::vector<DETAIL>       detail_stack; // for PopMove(), so only non-empty
+                                            //  between PushMove() and PopMove()
 
 public:
     //  Test for legal position, sets reason to a mask of possibly multiple reasons
@@ -33,7 +34,7 @@ public:
     std::string move_uci(Move move);
     std::string move_san(Move move);
 
-    // Play a move
+    // Play a move (for good, use PushMove() to be able to undo it)
     void PlayMove(Move imove);
     void play_san_move(std::string_view san_move);
     void play_uci_move(std::string_view uci_move);
@@ -44,6 +45,10 @@ public:
     // Get number of times position has been repeated
     int GetRepetitionCount();
 
+    // True if the same earlier positions could still be repeated, in any
+    //  order, so the two count repetitions alike from here on
+    bool same_history(const ChessRules& other) const;
+
     // Check insufficient material draw rule
     bool IsInsufficientDraw(bool white_asks, DRAWTYPE& result);
 
@@ -64,8 +69,11 @@ public:
     void GenLegalMoveList(MoveList& moves);
     MoveList GenLegalMoveList();
 
+    // Create a list of the legal moves from src_mask to dst_mask
+    void GenLegalMoveList(MoveList& moves, Bitboard src_mask, Bitboard dst_mask);
+
     //  Create a list of all legal moves in this position, with extra info
-    void GenLegalMoveList(MoveList&          moves,
+    void GenLegalMoveList(std::vector<Move>& moves,
                           std::vector<bool>& check,
                           std::vector<bool>& mate,
                           std::vector<bool>& stalemate);
@@ -84,11 +92,12 @@ protected:
     void GenMoveList(MoveList& moves);
     MoveList GenMoveList();
 
-    // Generate moves for pieces that move along multi-move rays (B,R,Q)
-    void LongMoves(MoveList& moves, Square square, const lte* ptr);
+    // Generate moves for pieces that move along multi-move rays (B,R,Q),
+    //  in ray directions first to last
+    void LongMoves(MoveList& moves, Square square, int first, int last);
 
     // Generate moves for pieces that move along single-move rays (K,N,P)
-    void ShortMoves(MoveList& moves, Square square, const lte* ptr, SPECIAL special);
+    void ShortMoves(MoveList& moves, Square square, const Targets& targets, SPECIAL special);
 
     // Generate list of king moves
     void KingMoves(MoveList& moves, Square square);
@@ -0,0 +1,117 @@
+/****************************************************************************
+ * MoveList.h Chess classes - Fixed capacity list of moves
+ *  License: MIT license. Full text of license is in associated file LICENSE
+ ****************************************************************************/
+#pragma once
+
+#ifndef MOVELIST_H
+#define MOVELIST_H
+
+#include "Move.h"
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+
+namespace thc {
+
+// A vector-like list of moves that lives entirely on the stack (or wherever
+//  it's declared), so generating moves never touches the heap.  Capacity is
+//  comfortably more than the most moves possible in any legal position (218)
+class MoveList {
+public:
+    using value_type      = Move;
+    using size_type       = std::size_t;
+    using reference       = Move&;
+    using const_reference = const Move&;
+    using iterator        = Move*;
+    using const_iterator  = const Move*;
+
+    static constexpr size_type max_moves = 256;
+
+    MoveList() {}
+
+    MoveList(std::initializer_list<Move> moves) {
+        for (auto move : moves) {
+            push_back(move);
+        }
+    }
+
+    template <typename InputIt>
+    MoveList(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    // Move is trivially copyable, so only copy the moves in use
+    MoveList(const MoveList& other) : nbr{other.nbr} {
+        std::memcpy(storage, other.storage, nbr * sizeof(Move));
+    }
+
+    MoveList& operator=(const MoveList& other) {
+        nbr = other.nbr;
+        std::memmove(storage, other.storage, nbr * sizeof(Move));
+        return *this;
+    }
+
+    size_type size() const { return nbr; }
+    bool empty() const { return nbr == 0; }
+    static constexpr size_type capacity() { return max_moves; }
+
+    void clear() { nbr = 0; }
+
+    void push_back(Move move) {
+        if (nbr == max_moves) {
+            throw std::length_error("MoveList full");
+        }
+        new (storage + nbr++ * sizeof(Move)) Move{move};
+    }
+
+    void pop_back() { --nbr; }
+
+    Move*       data()       { return std::launder(reinterpret_cast<Move*>(storage)); }
+    const Move* data() const { return std::launder(reinterpret_cast<const Move*>(storage)); }
+
+    Move&       operator[](size_type i)       { return data()[i]; }
+    const Move& operator[](size_type i) const { return data()[i]; }
+
+    Move& at(size_type i) {
+        if (i >= nbr) {
+            throw std::out_of_range("MoveList index out of range");
+        }
+        return data()[i];
+    }
+    const Move& at(size_type i) const { return const_cast<MoveList*>(this)->at(i); }
+
+    Move&       front()       { return data()[0]; }
+    const Move& front() const { return data()[0]; }
+    Move&       back()        { return data()[nbr-1]; }
+    const Move& back()  const { return data()[nbr-1]; }
+
+    iterator       begin()        { return data(); }
+    iterator       end()          { return data() + nbr; }
+    const_iterator begin()  const { return data(); }
+    const_iterator end()    const { return data() + nbr; }
+    const_iterator cbegin() const { return data(); }
+    const_iterator cend()   const { return data() + nbr; }
+
+private:
+    size_type nbr{0};
+    alignas(Move) unsigned char storage[max_moves * sizeof(Move)];
+};
+
+inline bool operator==(const MoveList& lhs, const MoveList& rhs) {
+    return lhs.size() == rhs.size() &&
+        std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(Move)) == 0;
+}
+
+inline bool operator!=(const MoveList& lhs, const MoveList& rhs) {
+    return !(lhs == rhs);
+}
+
+}
+
+#endif
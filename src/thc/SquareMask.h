@@ -0,0 +1,141 @@
+/****************************************************************************
+ * SquareMask.h Chess classes - Bitmaps from the 64 byte squares[] array
+ *  License: MIT license. Full text of license is in associated file LICENSE
+ ****************************************************************************/
+#pragma once
+
+#ifndef SQUAREMASK_H
+#define SQUAREMASK_H
+
+#include <cstdint>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define THC_SQUAREMASK_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define THC_SQUAREMASK_SSE2 1
+#endif
+
+namespace thc {
+
+// Both kernels return bit N set for squares[N], like a Bitboard, so a8 is
+//  the least significant bit.  squares need not be aligned
+
+namespace scalar {
+
+// Squares that aren't empty (' ')
+inline std::uint64_t occupancy_mask(const char* squares) {
+    std::uint64_t mask = 0;
+    for (auto i = 0; i < 64; ++i) {
+        mask |= std::uint64_t{squares[i] != ' '} << i;
+    }
+    return mask;
+}
+
+// Squares whose contents differ
+inline std::uint64_t difference_mask(const char* lhs, const char* rhs) {
+    std::uint64_t mask = 0;
+    for (auto i = 0; i < 64; ++i) {
+        mask |= std::uint64_t{lhs[i] != rhs[i]} << i;
+    }
+    return mask;
+}
+
+}
+
+#if defined(THC_SQUAREMASK_NEON)
+
+namespace neon {
+
+// NEON has no movemask, so weight each lane of the comparison by its bit
+//  and add them up pairwise.  Sticks to ARMv7 intrinsics, the 32 bit Pi
+//  userland doesn't have vaddv
+inline std::uint64_t movemask(uint8x16_t cmp) {
+    static const std::uint8_t weights[16] = {
+        1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128
+    };
+    const auto bits = vandq_u8(cmp, vld1q_u8(weights));
+    const auto sums = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(bits)));
+    return vgetq_lane_u64(sums, 0) | (vgetq_lane_u64(sums, 1) << 8);
+}
+
+inline std::uint64_t equal_mask(const char* lhs, const char* rhs) {
+    std::uint64_t mask = 0;
+    for (auto i = 0; i < 64; i += 16) {
+        const auto a = vld1q_u8(reinterpret_cast<const std::uint8_t*>(lhs + i));
+        const auto b = vld1q_u8(reinterpret_cast<const std::uint8_t*>(rhs + i));
+        mask |= movemask(vceqq_u8(a, b)) << i;
+    }
+    return mask;
+}
+
+inline std::uint64_t empty_mask(const char* squares) {
+    const auto space = vdupq_n_u8(' ');
+    std::uint64_t mask = 0;
+    for (auto i = 0; i < 64; i += 16) {
+        const auto a = vld1q_u8(reinterpret_cast<const std::uint8_t*>(squares + i));
+        mask |= movemask(vceqq_u8(a, space)) << i;
+    }
+    return mask;
+}
+
+}
+
+inline std::uint64_t occupancy_mask(const char* squares) {
+    return ~neon::empty_mask(squares);
+}
+
+inline std::uint64_t difference_mask(const char* lhs, const char* rhs) {
+    return ~neon::equal_mask(lhs, rhs);
+}
+
+#elif defined(THC_SQUAREMASK_SSE2)
+
+namespace sse2 {
+
+inline std::uint64_t equal_mask(const char* lhs, const char* rhs) {
+    std::uint64_t mask = 0;
+    for (auto i = 0; i < 64; i += 16) {
+        const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+        const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+        mask |= std::uint64_t(unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)))) << i;
+    }
+    return mask;
+}
+
+inline std::uint64_t empty_mask(const char* squares) {
+    const auto space = _mm_set1_epi8(' ');
+    std::uint64_t mask = 0;
+    for (auto i = 0; i < 64; i += 16) {
+        const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(squares + i));
+        mask |= std::uint64_t(unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(a, space)))) << i;
+    }
+    return mask;
+}
+
+}
+
+inline std::uint64_t occupancy_mask(const char* squares) {
+    return ~sse2::empty_mask(squares);
+}
+
+inline std::uint64_t difference_mask(const char* lhs, const char* rhs) {
+    return ~sse2::equal_mask(lhs, rhs);
+}
+
+#else
+
+inline std::uint64_t occupancy_mask(const char* squares) {
+    return scalar::occupancy_mask(squares);
+}
+
+inline std::uint64_t difference_mask(const char* lhs, const char* rhs) {
+    return scalar::difference_mask(lhs, rhs);
+}
+
+#endif
+
+}
+
+#endif
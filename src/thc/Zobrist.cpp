@@ -0,0 +1,68 @@
+/****************************************************************************
+ * Zobrist.cpp Chess classes - Zobrist keys for hashing positions
+ *  License: MIT license. Full text of license is in associated file LICENSE
+ ****************************************************************************/
+
+#include "Zobrist.h"
+
+using namespace std;
+using namespace thc;
+using namespace thc::zobrist;
+
+namespace {
+
+// SplitMix64, generating a fixed sequence of keys at compile time
+class Random {
+    Key state;
+
+public:
+    constexpr explicit Random(Key seed) : state{seed} {}
+
+    constexpr Key next() {
+        auto z = (state += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+};
+
+template <size_t N>
+constexpr array<Key, N> make_keys(Key seed) {
+    Random random{seed};
+    array<Key, N> keys{};
+    for (auto& key : keys) {
+        key = random.next();
+    }
+    return keys;
+}
+
+constexpr array<array<Key, 64>, 13> make_pieces() {
+    array<array<Key, 64>, 13> keys{};
+    for (size_t row = 1; row < keys.size(); ++row) {
+        keys[row] = make_keys<64>(row);
+    }
+    return keys;
+}
+
+constexpr array<unsigned char, 128> make_piece_row() {
+    array<unsigned char, 128> rows{};
+    const char* pieces = "PNBRQKpnbrqk";
+    for (auto i = 0; pieces[i]; ++i) {
+        rows[static_cast<unsigned char>(pieces[i])] = i + 1;
+    }
+    return rows;
+}
+
+}
+
+namespace thc {
+namespace zobrist {
+
+constexpr array<array<Key, 64>, 13> pieces = make_pieces();
+constexpr array<unsigned char, 128> piece_row = make_piece_row();
+constexpr Key black = make_keys<1>(13)[0];
+constexpr array<Key, 4> castling  = make_keys<4>(14);
+constexpr array<Key, 8> enpassant = make_keys<8>(15);
+
+}
+}
@@ -0,0 +1,44 @@
+/****************************************************************************
+ * Zobrist.h Chess classes - Zobrist keys for hashing positions
+ *  License: MIT license. Full text of license is in associated file LICENSE
+ ****************************************************************************/
+#pragma once
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "ChessDefs.h"
+
+#include <array>
+#include <cstdint>
+
+namespace thc {
+namespace zobrist {
+
+using Key = std::uint64_t;
+
+// One key per piece per square, row 0 (an empty square) is all zeroes so
+//  it can be xor'd in and out unconditionally
+extern const std::array<std::array<Key, 64>, 13> pieces;
+
+// Row of pieces[] for each piece character
+extern const std::array<unsigned char, 128> piece_row;
+
+// Side to move is black
+extern const Key black;
+
+// Possible (not merely permitted) castling, indexed in the order
+//  wking, wqueen, bking, bqueen
+extern const std::array<Key, 4> castling;
+
+// Possible en passant, indexed by file of the target
+extern const std::array<Key, 8> enpassant;
+
+inline Key piece(Square sq, char p) {
+    return pieces[piece_row[static_cast<unsigned char>(p) & 0x7f]][sq];
+}
+
+}
+}
+
+#endif
@@ -12,5 +12,6 @@
 #include "ChessPosition.h"
 #include "ChessRules.h"
 #include "Move.h"
+#include "SquareMask.h"
 
 #endif
@@ -0,0 +1,78 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef BROADCAST_H
+#define BROADCAST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// The latest events, numbered in order from 1, for any number of readers.
+// Each reader keeps its own cursor, the number of the last event it read,
+// so an event is stored once however many are reading it.  A reader that
+// falls behind by more than the capacity has missed some, and is told so
+template <typename T>
+class BroadcastRing {
+public:
+    explicit BroadcastRing(std::size_t capacity) : slots(capacity) {}
+
+    BroadcastRing(const BroadcastRing&) = delete;
+    BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+    // Add the newest event, overwriting the oldest, and return its number
+    std::uint64_t push(T value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++newest;
+        slots[newest % slots.size()] = std::move(value);
+        return newest;
+    }
+
+    // Number of the newest event, 0 if there's been none
+    std::uint64_t last() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return newest;
+    }
+
+    // Hand each event after cursor to f(number, event), oldest first, until
+    // f returns false, advancing cursor past those it accepted.  False, with
+    // cursor unchanged, if events after cursor have been overwritten or
+    // cursor is from the future
+    template <typename F>
+    bool read(std::uint64_t& cursor, F&& f) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cursor > newest || newest - cursor > slots.size()) {
+            return false;
+        }
+        while (cursor != newest && f(cursor + 1, slots[(cursor + 1) % slots.size()])) {
+            ++cursor;
+        }
+        return true;
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::vector<T>     slots;
+    std::uint64_t      newest{0};
+};
+
+#endif
+
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -3,6 +3,7 @@
 
 #include "buffer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <cstdlib>
@@ -16,20 +17,16 @@ using namespace std;
 
 bool Buffer::invariant() const {
     return (
-        begin  <= read  &&
-        read   <= write &&
-        write  <= end   &&
-        *write == '\0'  &&
-        fd     >= -1
+        !ring.empty()                    &&
+        read    <= scanned               &&
+        scanned <= write                 &&
+        write - read <= ring.size()      &&
+        fd      >= -1
     );
 }
 
 Buffer::Buffer(size_t size, int fd) : fd{fd} {
-    data.resize(size + 1);
-    begin = data.data();
-    read  = begin;
-    write = begin;
-    end   = begin + size;
+    ring.resize(max<size_t>(1, size));
     assert(invariant());
 }
 
@@ -46,18 +43,54 @@ Buffer::~Buffer() {
     close();
 }
 
-char* Buffer::try_getline() {
+// Search on from where the last search left off, stopping at a newline,
+// false if there's none yet.  The unsearched part runs at most once round
+// the end of the ring, so it's at most two calls to memchr()
+bool Buffer::find_newline() {
+    while (scanned < write) {
+        const auto at   = scanned % ring.size();
+        const auto n    = min(write - scanned, ring.size() - at);
+        const auto from = ring.data() + at;
+        if (auto eol = static_cast<const char*>(memchr(from, '\n', n))) {
+            scanned += eol - from;
+            return true;
+        }
+        scanned += n;
+    }
+    return false;
+}
+
+// What's between from and to, as one piece
+string_view Buffer::view(size_t from, size_t to) {
+    const auto at = from % ring.size();
+    const auto n  = to - from;
+    if (at + n <= ring.size()) {
+        return {ring.data() + at, n};
+    }
+    const auto first = ring.size() - at;
+    wrapped.assign(ring, at, first);
+    wrapped.append(ring, 0, n - first);
+    return wrapped;
+}
+
+optional<string_view> Buffer::try_getline() {
     assert(invariant());
 
-    char* line = NULL;
-    if (char *const eol = strchr(read, '\n')) {
-        line = read;
-        *eol = 0;
-        read = eol + 1;
+    while (find_newline()) {
+        const auto from = read;
+        const auto to   = scanned;
+        read = scanned = to + 1;
+        if (dropping) {
+            // The end of a line that didn't fit
+            dropping = false;
+            continue;
+        }
+        assert(invariant());
+        return view(from, to);
     }
 
     assert(invariant());
-    return line;
+    return nullopt;
 }
 
 bool Buffer::can_fill(long timeout_ms) {
@@ -87,38 +120,49 @@ bool Buffer::can_fill(long timeout_ms) {
     return rc == 1;
 }
 
-void Buffer::try_fill(long timeout_ms) {
-    if (!can_fill(timeout_ms)) {
-        return;
+bool Buffer::fill() {
+    assert(invariant());
+    if (fd < 0) {
+        return false;
     }
 
-    char *const midpoint = begin + (end - begin) / 2;
-    if (write >= midpoint) {
-        memmove(begin, read, write - read);
-        write -= read - begin;
-        read   = begin;
-        *write = '\0';
+    if (write - read == ring.size() && !find_newline()) {
+        // A line longer than the buffer, there's nothing sensible to do but
+        // drop it, up to its newline whenever that comes
+        read = scanned = write;
+        dropping = true;
     }
 
-    ssize_t n_read = ::read(fd, write, end - write);
-    if (n_read < 0) {
-        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
-            n_read = 0;
-        }
+    // Into the free space up to the end of the ring, and round to the start
+    // with the next read
+    const auto at = write % ring.size();
+    const auto n  = min(ring.size() - (write - read), ring.size() - at);
+    if (n == 0) {
+        // Full of whole lines, waiting to be taken
+        return true;
     }
 
-    if (n_read >= 0) {
+    const ssize_t n_read = ::read(fd, ring.data() + at, n);
+    if (n_read > 0) {
         write += n_read;
-        *write = '\0';
-    } else {
+    }
+    else if (n_read == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        // Readable but nothing to read is end of file
         close();
     }
 
     assert(invariant());
+    return fd >= 0;
+}
+
+void Buffer::try_fill(long timeout_ms) {
+    if (can_fill(timeout_ms)) {
+        fill();
+    }
 }
 
-char* Buffer::getline(long timeout_ms) {
-    if (char* line = try_getline()) {
+optional<string_view> Buffer::getline(long timeout_ms) {
+    if (auto line = try_getline()) {
         return line;
     }
 
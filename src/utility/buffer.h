@@ -6,28 +6,54 @@
 #define BUFFER_H
 
 #include <cstddef>
+#include <optional>
 #include <string>
+#include <string_view>
 
+// Lines read from a file descriptor into a ring of fixed size.  Positions
+// in the ring only ever count up, taken modulo its size, so nothing read is
+// ever moved to make room, and each byte is searched for a newline once,
+// however many reads a line takes to come in.  Lines are handed out as views
+// of the ring itself, which hold until the next line's asked for; only one
+// that wraps round the end of the ring is copied, to put it back together
 class Buffer {
 private:
-    std::string data;
-    char *begin;
-    char *read;
-    char *write;
-    char *end;
-    int   fd;
+    std::string ring;
+    std::string wrapped;  // The last line, if it went round the end
+    std::size_t read{0};     // Start of the next line
+    std::size_t scanned{0};  // Searched for a newline up to here
+    std::size_t write{0};    // End of what's been read
+    bool        dropping{false};  // Skipping the rest of a line too long
+    int         fd;
 
     bool  invariant() const;
-    char* try_getline();
     bool  can_fill(long timeout_ms);
     void  try_fill(long timeout_ms);
+    bool  find_newline();
+    std::string_view view(std::size_t from, std::size_t to);
 
 public:
     Buffer(std::size_t size, int fd);
     ~Buffer();
 
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
     void close();
-    char* getline(long timeout_ms);
+
+    // A whole line, without its newline, waiting no longer than timeout_ms
+    // for one.  None if none came in time, or the descriptor's closed
+    std::optional<std::string_view> getline(long timeout_ms);
+
+    // For callers who poll() for themselves: what to wait on, -1 once closed
+    int descriptor() const { return fd; }
+
+    // A whole line if one's already read, without waiting
+    std::optional<std::string_view> try_getline();
+
+    // Read what's ready, once poll() says the descriptor is, false if it's
+    // closed now.  A line longer than the ring is dropped
+    bool fill();
 };
 
 #endif
@@ -0,0 +1,74 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "eventbus.h"
+#include "trace.h"
+
+#include <cassert>
+
+using namespace std;
+
+Executor::Executor(const char* name) : name{name}, thread{&Executor::run, this} {
+}
+
+Executor::~Executor() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cond.notify_all();
+    thread.join();
+}
+
+void Executor::post(function<void()> work) {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(work));
+        ++posted;
+    }
+    cond.notify_all();
+}
+
+void Executor::drain() {
+    assert(this_thread::get_id() != thread.get_id());
+    unique_lock<std::mutex> lock(mutex);
+    const auto target = posted;
+    cond.wait(lock, [&] { return done >= target; });
+}
+
+void Executor::run() {
+    TRACE_THREAD(name);
+
+    unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        cond.wait(lock, [this] { return stop || !queue.empty(); });
+        if (queue.empty()) {
+            return;
+        }
+        auto work = std::move(queue.front());
+        queue.pop_front();
+
+        lock.unlock();
+        work();
+        work = nullptr;
+        lock.lock();
+
+        ++done;
+        cond.notify_all();
+    }
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,181 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef EVENTBUS_H
+#define EVENTBUS_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// A thread of its own, working through what it's handed in order, so
+// whoever hands it work is never kept waiting on it
+class Executor {
+public:
+    explicit Executor(const char* name);
+    ~Executor();  // Once what's queued is done
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    void post(std::function<void()> work);
+
+    // Wait for everything posted so far to be done.  Not from the
+    // executor's own thread
+    void drain();
+
+private:
+    const char* name;
+
+    std::mutex              mutex;  // Of what follows
+    std::condition_variable cond;
+    std::deque<std::function<void()>> queue;
+    std::uint64_t posted{0};
+    std::uint64_t done{0};
+    bool          stop{false};
+
+    std::thread thread;  // Started once all the above is ready
+
+    void run();
+};
+
+// Events of type E, from whatever thread raises them, delivered to each
+// subscriber on its executor, never on the raiser's, so a slow subscriber
+// holds up nobody but itself and whoever shares its executor.  Each event
+// is copied once, however many subscribers share it.  A subscriber that
+// only wants the latest has bursts coalesce: an event waiting to be
+// delivered is replaced by the next.  Everyone else gets every event, in
+// order
+template <typename E>
+class EventBus {
+public:
+    enum Delivery { EVERY, LATEST };
+
+    using Handler = std::function<void(const E&)>;
+
+    EventBus() = default;
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    // Have handler called on executor with events from now on, until
+    // unsubscribed by the id returned
+    std::uint64_t subscribe(Executor& executor, Handler handler, Delivery delivery = EVERY) {
+        auto subscriber = std::make_shared<Subscriber>(executor, std::move(handler), delivery);
+        std::lock_guard<std::mutex> lock(mutex);
+        subscriber->id = ++last_id;
+        subscribers.push_back(subscriber);
+        return subscriber->id;
+    }
+
+    // Once this returns, the handler isn't called again, even with events
+    // already queued.  Not from the handler itself
+    void unsubscribe(std::uint64_t id) {
+        std::shared_ptr<Subscriber> subscriber;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto i = subscribers.begin(); i != subscribers.end(); ++i) {
+                if ((*i)->id == id) {
+                    subscriber = std::move(*i);
+                    subscribers.erase(i);
+                    break;
+                }
+            }
+        }
+        if (subscriber) {
+            std::lock_guard<std::mutex> lock(subscriber->handling);
+            subscriber->active = false;
+        }
+    }
+
+    // Whether there's anyone to tell, so raisers can skip making events
+    // nobody wants
+    bool subscribed() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !subscribers.empty();
+    }
+
+    void publish(E event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (subscribers.empty()) {
+            return;
+        }
+        const auto shared = std::make_shared<const E>(std::move(event));
+        for (const auto& subscriber : subscribers) {
+            if (subscriber->delivery == EVERY) {
+                subscriber->executor.post([subscriber, shared] { subscriber->handle(*shared); });
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> latest_lock(subscriber->latest_mutex);
+                const auto waiting = subscriber->latest != nullptr;
+                subscriber->latest = shared;
+                if (waiting) {
+                    // Delivered instead of the one before, by what's queued
+                    continue;
+                }
+            }
+            subscriber->executor.post([subscriber] {
+                std::shared_ptr<const E> latest;
+                {
+                    std::lock_guard<std::mutex> latest_lock(subscriber->latest_mutex);
+                    latest = std::move(subscriber->latest);
+                }
+                subscriber->handle(*latest);
+            });
+        }
+    }
+
+private:
+    struct Subscriber {
+        Subscriber(Executor& executor, Handler handler, Delivery delivery)
+            : executor{executor}, handler{std::move(handler)}, delivery{delivery} {}
+
+        std::uint64_t  id{0};
+        Executor&      executor;
+        const Handler  handler;
+        const Delivery delivery;
+
+        std::mutex handling;  // Held while handling, and of active
+        bool       active{true};
+
+        std::mutex               latest_mutex;  // Of latest, never held handling
+        std::shared_ptr<const E> latest;        // Waiting to be delivered
+
+        void handle(const E& event) {
+            std::lock_guard<std::mutex> lock(handling);
+            if (active) {
+                handler(event);
+            }
+        }
+    };
+
+    mutable std::mutex mutex;  // Of what follows
+    std::vector<std::shared_ptr<Subscriber>> subscribers;
+    std::uint64_t last_id{0};
+};
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
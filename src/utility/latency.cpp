@@ -0,0 +1,171 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "latency.h"
+
+#include <cstdio>
+
+using namespace std;
+
+// Histograms are static, and this is constant initialized ahead of them
+static LatencyHistogram* first = nullptr;
+
+static atomic<LatencyHistogram::Clock::rep> origin{0};
+
+LatencyHistogram::LatencyHistogram(const char* name) : label{name}, next{first} {
+    first = this;
+}
+
+static size_t bucket_of(uint64_t us) {
+    size_t bucket = 0;
+    while (us > 0 && bucket < LatencyHistogram::BUCKETS - 1) {
+        us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+// Exclusive upper bound of bucket in us
+static uint64_t bucket_limit(size_t bucket) {
+    return uint64_t{1} << bucket;
+}
+
+void LatencyHistogram::record(Clock::duration elapsed) {
+    const auto ns = static_cast<uint64_t>(
+        max<int64_t>(0, chrono::duration_cast<chrono::nanoseconds>(elapsed).count()));
+
+    buckets[bucket_of(ns / 1000)].fetch_add(1, memory_order_relaxed);
+    total_ns.fetch_add(ns, memory_order_relaxed);
+
+    auto longest = longest_ns.load(memory_order_relaxed);
+    while (ns > longest && !longest_ns.compare_exchange_weak(longest, ns, memory_order_relaxed)) {
+    }
+}
+
+uint64_t LatencyHistogram::count() const {
+    uint64_t n = 0;
+    for (const auto& bucket : buckets) {
+        n += bucket.load(memory_order_relaxed);
+    }
+    return n;
+}
+
+uint64_t LatencyHistogram::percentile(double fraction) const {
+    const auto n = count();
+    if (n == 0) {
+        return 0;
+    }
+
+    const auto rank = static_cast<uint64_t>(fraction * n);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS - 1; ++i) {
+        seen += buckets[i].load(memory_order_relaxed);
+        if (seen > rank) {
+            return min(bucket_limit(i), max_us());
+        }
+    }
+    return max_us();
+}
+
+uint64_t LatencyHistogram::max_us() const {
+    return longest_ns.load(memory_order_relaxed) / 1000;
+}
+
+uint64_t LatencyHistogram::mean_us() const {
+    const auto n = count();
+    return n == 0 ? 0 : total_ns.load(memory_order_relaxed) / n / 1000;
+}
+
+void LatencyHistogram::clear() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, memory_order_relaxed);
+    }
+    total_ns.store(0, memory_order_relaxed);
+    longest_ns.store(0, memory_order_relaxed);
+}
+
+void LatencyHistogram::report(ostream& out) {
+    char line[128];
+    snprintf(line, sizeof line, "%-16s %8s %10s %10s %10s %10s %10s\n",
+        "latency (us)", "count", "mean", "p50", "p90", "p99", "max");
+    out << line;
+
+    for (auto h = first; h; h = h->next) {
+        const auto n = h->count();
+        if (n == 0) {
+            continue;
+        }
+        snprintf(line, sizeof line, "%-16s %8llu %10llu %10llu %10llu %10llu %10llu\n",
+            h->name(),
+            (unsigned long long)n,
+            (unsigned long long)h->mean_us(),
+            (unsigned long long)h->percentile(0.50),
+            (unsigned long long)h->percentile(0.90),
+            (unsigned long long)h->percentile(0.99),
+            (unsigned long long)h->max_us());
+        out << line;
+    }
+}
+
+string LatencyHistogram::json() {
+    string json = "{";
+    char buf[160];
+    for (auto h = first; h; h = h->next) {
+        const auto n = h->count();
+        if (n == 0) {
+            continue;
+        }
+        if (json.size() > 1) {
+            json += ", ";
+        }
+        snprintf(buf, sizeof buf,
+            "\"%s\": {\"count\": %llu, \"mean_us\": %llu, \"p50_us\": %llu, "
+            "\"p90_us\": %llu, \"p99_us\": %llu, \"max_us\": %llu, \"buckets\": [",
+            h->name(),
+            (unsigned long long)n,
+            (unsigned long long)h->mean_us(),
+            (unsigned long long)h->percentile(0.50),
+            (unsigned long long)h->percentile(0.90),
+            (unsigned long long)h->percentile(0.99),
+            (unsigned long long)h->max_us());
+        json += buf;
+
+        // Trailing empty buckets left off
+        auto last = BUCKETS;
+        while (last > 0 && h->buckets[last - 1].load(memory_order_relaxed) == 0) {
+            --last;
+        }
+        for (size_t i = 0; i < last; ++i) {
+            snprintf(buf, sizeof buf, i ? ", %llu" : "%llu",
+                (unsigned long long)h->buckets[i].load(memory_order_relaxed));
+            json += buf;
+        }
+        json += "]}";
+    }
+    json += "}";
+    return json;
+}
+
+void latency_origin(LatencyHistogram::Clock::time_point when) {
+    origin.store(when.time_since_epoch().count(), memory_order_relaxed);
+}
+
+LatencyHistogram::Clock::time_point latency_origin() {
+    return LatencyHistogram::Clock::time_point{
+        LatencyHistogram::Clock::duration{origin.load(memory_order_relaxed)}};
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,92 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Distribution of how long something takes, in buckets doubling from 1 us.
+// Cheap enough for hot paths and safe to record from any thread.  Every
+// histogram lives for the whole program and is listed in the reports; define
+// them static at file scope, so they're all listed before any thread starts.
+class LatencyHistogram {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Bucket 0 is under 1 us, bucket i from 2^(i-1) us, the last open ended
+    static constexpr std::size_t BUCKETS = 28;
+
+    explicit LatencyHistogram(const char* name);
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    const char* name() const { return label; }
+
+    void record(Clock::duration elapsed);
+    void record_since(Clock::time_point start) { record(Clock::now() - start); }
+
+    std::uint64_t count() const;
+
+    // Upper bound of the bucket holding this fraction of samples, in us
+    std::uint64_t percentile(double fraction) const;
+
+    std::uint64_t max_us() const;
+    std::uint64_t mean_us() const;
+
+    void clear();
+
+    // Every histogram with samples, one per line, or as a JSON object
+    static void report(std::ostream& out);
+    static std::string json();
+
+private:
+    const char*                                   label;
+    std::array<std::atomic<std::uint64_t>, BUCKETS> buckets{};
+    std::atomic<std::uint64_t>                    total_ns{0};
+    std::atomic<std::uint64_t>                    longest_ns{0};
+    LatencyHistogram*                             next;
+};
+
+// Records the time from construction to destruction
+class LatencyTimer {
+public:
+    explicit LatencyTimer(LatencyHistogram& histogram)
+        : histogram{histogram}, start{LatencyHistogram::Clock::now()} {}
+    LatencyTimer(const LatencyTimer&) = delete;
+    LatencyTimer& operator=(const LatencyTimer&) = delete;
+    ~LatencyTimer() { histogram.record_since(start); }
+
+private:
+    LatencyHistogram&                   histogram;
+    LatencyHistogram::Clock::time_point start;
+};
+
+// When the board last reported field events, the start of the pipeline that
+// turns them into a move on screen.  Zero until it has
+void latency_origin(LatencyHistogram::Clock::time_point when);
+LatencyHistogram::Clock::time_point latency_origin();
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,86 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef LRU_H
+#define LRU_H
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+// Cache of up to capacity values by key, forgetting whichever was least
+// recently found or put once it's full.  Entries are reused as they're
+// forgotten, so a full cache allocates only for its index
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRU {
+    using Entry = std::pair<Key, Value>;
+
+    std::size_t      limit;
+    std::list<Entry> entries;  // Most recent first
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index;
+
+public:
+    explicit LRU(std::size_t capacity) : limit{capacity} {
+        assert(capacity > 0);
+        index.reserve(capacity);
+    }
+
+    std::size_t capacity() const { return limit; }
+    std::size_t size() const { return entries.size(); }
+
+    // The value of key, now the most recent, null if there's none
+    Value* find(const Key& key) {
+        const auto found = index.find(key);
+        if (found == index.end()) {
+            return nullptr;
+        }
+        entries.splice(entries.begin(), entries, found->second);
+        return &found->second->second;
+    }
+
+    // Value of key, replacing any it had, the most recent
+    Value& put(const Key& key, Value value) {
+        if (auto existing = find(key)) {
+            *existing = std::move(value);
+            return *existing;
+        }
+
+        if (entries.size() < limit) {
+            entries.emplace_front(key, std::move(value));
+        } else {
+            // The least recent, to the front as the new
+            entries.splice(entries.begin(), entries, std::prev(entries.end()));
+            index.erase(entries.front().first);
+            entries.front() = Entry{key, std::move(value)};
+        }
+        index.emplace(key, entries.begin());
+        return entries.front().second;
+    }
+
+    void clear() {
+        index.clear();
+        entries.clear();
+    }
+};
+
+#endif
+
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
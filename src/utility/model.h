@@ -6,8 +6,14 @@
 #define MODEL_H
 
 #include <algorithm>
+#include <mutex>
+#include <utility>
 #include <vector>
 
+// Observers are told of changes synchronously, on the thread making them,
+// so they're for what's cheap and has to see the model as it is, like a
+// game's own bookkeeping.  Anything slow, or on another thread, wants an
+// event on an EventBus instead
 template<typename T> class Observer {
 public:
     virtual ~Observer() = default;
@@ -15,26 +21,48 @@ public:
 };
 
 template<typename T> class Model {
+    mutable std::mutex        mutex;  // Of observers, who may come and go from any thread
     std::vector<Observer<T>*> observers;
 
 public:
+    Model() = default;
     virtual ~Model() = default;
 
+    // Copies are observed by the same observers
+    Model(const Model& model) : observers{model.snapshot()} {}
+    Model& operator=(const Model& model) {
+        if (this != &model) {
+            auto copied = model.snapshot();
+            std::lock_guard<std::mutex> lock(mutex);
+            observers = std::move(copied);
+        }
+        return *this;
+    }
+
     void observe(Observer<T>* observer) {
+        std::lock_guard<std::mutex> lock(mutex);
         observers.push_back(observer);
     }
 
     void unobserve(Observer<T>* observer) {
+        std::lock_guard<std::mutex> lock(mutex);
         observers.erase(
             std::remove(observers.begin(), observers.end(), observer),
             observers.end());
     }
 
+    // Told without the lock, so they may observe or unobserve
     void changed() {
-        for (auto observer : observers) {
+        for (auto observer : snapshot()) {
             observer->on_changed(*dynamic_cast<T*>(this));
         }
     }
+
+private:
+    std::vector<Observer<T>*> snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return observers;
+    }
 };
 
 #endif
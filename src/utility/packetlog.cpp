@@ -0,0 +1,113 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "packetlog.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+static constexpr char MAGIC[4] = {'R', 'C', 'M', 'S'};
+
+static void put_le(uint8_t* p, uint64_t value, int bytes) {
+    for (auto i = 0; i < bytes; ++i) {
+        p[i] = static_cast<uint8_t>(value >> 8 * i);
+    }
+}
+
+static uint64_t get_le(const uint8_t* p, int bytes) {
+    uint64_t value = 0;
+    for (auto i = 0; i < bytes; ++i) {
+        value |= uint64_t{p[i]} << 8 * i;
+    }
+    return value;
+}
+
+PacketRecorder::PacketRecorder(const char* path) : file{fopen(path, "wb")}, last{Clock::now()} {
+    if (!file) {
+        throw runtime_error(string("Failed to create ") + path);
+    }
+
+    uint8_t header[8];
+    copy(MAGIC, MAGIC + sizeof MAGIC, header);
+    put_le(header + 4, packetlog::VERSION, 4);
+    if (fwrite(header, 1, sizeof header, file) != sizeof header || fflush(file) != 0) {
+        fclose(file);
+        throw runtime_error(string("Failed to write ") + path);
+    }
+}
+
+PacketRecorder::~PacketRecorder() {
+    fclose(file);
+}
+
+void PacketRecorder::record(packetlog::Direction direction, const uint8_t* data, size_t length) {
+    const auto now = Clock::now();
+    const auto elapsed = chrono::duration_cast<chrono::microseconds>(now - last).count();
+    last = now;
+
+    // Gaps over an hour or so are only idle time, they needn't be exact
+    length = min<size_t>(length, 0xffff);
+    uint8_t header[7];
+    header[0] = direction;
+    put_le(header + 1, min<uint64_t>(elapsed, 0xffffffff), 4);
+    put_le(header + 5, length, 2);
+
+    // Nowhere to report failure, the board is more important than the log
+    fwrite(header, 1, sizeof header, file);
+    fwrite(data, 1, length, file);
+    fflush(file);
+}
+
+vector<Packet> read_packets(const char* path) {
+    const auto file = fopen(path, "rb");
+    if (!file) {
+        throw runtime_error(string("Failed to open ") + path);
+    }
+
+    uint8_t header[8];
+    if (fread(header, 1, sizeof header, file) != sizeof header ||
+        !equal(MAGIC, MAGIC + sizeof MAGIC, header) ||
+        get_le(header + 4, 4) != packetlog::VERSION)
+    {
+        fclose(file);
+        throw domain_error("Invalid packet log");
+    }
+
+    vector<Packet> packets;
+    chrono::microseconds at{0};
+    uint8_t record[7];
+    while (fread(record, 1, sizeof record, file) == sizeof record) {
+        if (record[0] != packetlog::TO_BOARD && record[0] != packetlog::FROM_BOARD) {
+            fclose(file);
+            throw domain_error("Invalid packet log");
+        }
+
+        at += chrono::microseconds(get_le(record + 1, 4));
+        vector<uint8_t> data(get_le(record + 5, 2));
+        if (fread(data.data(), 1, data.size(), file) != data.size()) {
+            break;
+        }
+        packets.push_back(Packet{static_cast<packetlog::Direction>(record[0]), at, std::move(data)});
+    }
+
+    fclose(file);
+    return packets;
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,73 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef PACKETLOG_H
+#define PACKETLOG_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Serial traffic with the field board, recorded for replay.  A log is
+// "RCMS", u32 version, then for every packet u8 direction, u32 microseconds
+// since the packet before, u16 length and the packet itself.  All numbers
+// are little-endian
+namespace packetlog {
+
+constexpr std::uint32_t VERSION = 1;
+
+enum Direction : std::uint8_t {
+    TO_BOARD   = 0,
+    FROM_BOARD = 1,
+};
+
+}
+
+struct Packet {
+    packetlog::Direction      direction;
+    std::chrono::microseconds at;  // Since the log started
+    std::vector<std::uint8_t> data;
+};
+
+class PacketRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Throws std::runtime_error if the file can't be created
+    explicit PacketRecorder(const char* path);
+    PacketRecorder(const PacketRecorder&) = delete;
+    PacketRecorder& operator=(const PacketRecorder&) = delete;
+    ~PacketRecorder();
+
+    // Written through, so a log survives a crash up to its last packet
+    void record(packetlog::Direction direction, const std::uint8_t* data, std::size_t length);
+
+private:
+    std::FILE*        file;
+    Clock::time_point last;
+};
+
+// Whole log, read up front.  Throws std::runtime_error if the file can't be
+// read, std::domain_error if it isn't a log.  A log cut short, as by a
+// crash, is good up to its last whole packet
+std::vector<Packet> read_packets(const char* path);
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
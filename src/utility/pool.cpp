@@ -0,0 +1,74 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "pool.h"
+
+#include <cassert>
+
+using namespace std;
+
+Pool::~Pool() {
+    for (auto chunk : chunks) {
+        ::operator delete(chunk);
+    }
+}
+
+void* Pool::allocate(size_t size) {
+    if (size == 0 || size > MAX_SIZE) {
+        return ::operator new(size);
+    }
+
+    const auto bin  = (size - 1) / GRANULE;
+    const auto need = (bin + 1) * GRANULE;
+
+    lock_guard<mutex> lock(guard);
+    if (auto block = free_lists[bin]) {
+        free_lists[bin] = block->next;
+        return block;
+    }
+
+    if (static_cast<size_t>(end - next) < need) {
+        // Whatever's left of the old chunk is lost, at most MAX_SIZE bytes
+        next = static_cast<char*>(::operator new(CHUNK_SIZE));
+        end  = next + CHUNK_SIZE;
+        chunks.push_back(next);
+    }
+
+    auto p = next;
+    next += need;
+    return p;
+}
+
+void Pool::deallocate(void* p, size_t size) {
+    if (size == 0 || size > MAX_SIZE) {
+        ::operator delete(p);
+        return;
+    }
+
+    const auto bin = (size - 1) / GRANULE;
+
+    lock_guard<mutex> lock(guard);
+    auto block = static_cast<Block*>(p);
+    block->next = free_lists[bin];
+    free_lists[bin] = block;
+}
+
+size_t Pool::reserved() const {
+    lock_guard<mutex> lock(guard);
+    return chunks.size() * CHUNK_SIZE;
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
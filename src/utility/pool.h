@@ -0,0 +1,110 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Memory for lots of small objects, carved out of large chunks and recycled
+// through one free list per size.  Nothing goes back to the system until
+// the pool itself goes, then all of it goes at once.
+class Pool {
+public:
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+    static constexpr std::size_t GRANULE    = 16;   // Size and alignment step
+    static constexpr std::size_t MAX_SIZE   = 512;  // Bigger uses operator new
+
+    Pool() = default;
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+    ~Pool();
+
+    void* allocate(std::size_t size);
+    void  deallocate(void* p, std::size_t size);
+
+    // Bytes taken from the system
+    std::size_t reserved() const;
+
+private:
+    struct Block {
+        Block* next;
+    };
+
+    mutable std::mutex guard;
+    std::array<Block*, MAX_SIZE / GRANULE> free_lists{};
+    std::vector<char*> chunks;
+    char* next{nullptr};
+    char* end{nullptr};
+};
+
+// Standard allocator drawing from a pool, which it keeps alive.  Without a
+// pool (default constructed) it's just operator new
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    // Containers assigned or swapped take their pool with them
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    std::shared_ptr<Pool> pool;
+
+    PoolAllocator() = default;
+    explicit PoolAllocator(std::shared_ptr<Pool> pool) : pool{std::move(pool)} {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) : pool{other.pool} {}
+
+    T* allocate(std::size_t n) {
+        static_assert(alignof(T) <= Pool::GRANULE, "Pool is not aligned for T");
+        if (!pool) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(pool->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        if (!pool) {
+            ::operator delete(p);
+            return;
+        }
+        pool->deallocate(p, n * sizeof(T));
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) {
+    return lhs.pool == rhs.pool;
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) {
+    return !(lhs == rhs);
+}
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,95 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "reactor.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <system_error>
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+using namespace std;
+
+// How many descriptors one wait can report
+static constexpr int MAX_EVENTS = 16;
+
+Reactor::Reactor() : epoll_fd{epoll_create1(EPOLL_CLOEXEC)} {
+    if (epoll_fd < 0) {
+        throw system_error(errno, generic_category(), "epoll_create1");
+    }
+}
+
+Reactor::~Reactor() {
+    close(epoll_fd);
+}
+
+bool Reactor::watch(int fd, Handler handler) {
+    if (fd < 0) {
+        return false;
+    }
+
+    struct epoll_event event {};
+    event.events  = EPOLLIN;
+    event.data.fd = fd;
+    const auto op = handlers.count(fd) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (epoll_ctl(epoll_fd, op, fd, &event) != 0) {
+        return false;
+    }
+    handlers[fd] = std::move(handler);
+    return true;
+}
+
+void Reactor::unwatch(int fd) {
+    if (handlers.erase(fd)) {
+        (void)epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+}
+
+size_t Reactor::wait(optional<Clock::time_point> until) {
+    // Rounded up, so a deadline isn't woken for a moment early, over and
+    // over
+    auto timeout = -1;
+    if (until) {
+        const auto remaining = chrono::ceil<chrono::milliseconds>(*until - Clock::now()).count();
+        timeout = static_cast<int>(clamp<decltype(remaining)>(remaining, 0, INT_MAX));
+    }
+
+    struct epoll_event events[MAX_EVENTS];
+    const auto n = epoll_wait(epoll_fd, events, MAX_EVENTS, timeout);
+    if (n < 0) {
+        if (errno == EINTR) {
+            return 0;
+        }
+        throw system_error(errno, generic_category(), "epoll_wait");
+    }
+
+    size_t called = 0;
+    for (auto i = 0; i < n; ++i) {
+        // Unless an earlier handler unwatched it
+        const auto found = handlers.find(events[i].data.fd);
+        if (found != handlers.end()) {
+            const auto handler = found->second;
+            handler();
+            ++called;
+        }
+    }
+    return called;
+}
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,61 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef REACTOR_H
+#define REACTOR_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+
+// One thread waiting on any number of descriptors and a deadline at once,
+// with epoll, so it wakes as soon as any is ready, and otherwise sleeps,
+// costing nothing.  Descriptors are level-triggered: whatever a handler
+// leaves unread wakes the next wait() straight away
+class Reactor {
+public:
+    using Clock   = std::chrono::steady_clock;
+    using Handler = std::function<void()>;
+
+    // Throws std::system_error if there's no epoll to be had
+    Reactor();
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    // Have handler called from wait() whenever fd's readable, or hung up.
+    // False if it can't be waited on, like a regular file or /dev/null,
+    // which are always readable anyway
+    bool watch(int fd, Handler handler);
+    void unwatch(int fd);
+
+    // Wait for whatever's watched, no later than until if there's a
+    // deadline, then call the handlers of everything that's ready.  How
+    // many were called, 0 if it was the deadline
+    std::size_t wait(std::optional<Clock::time_point> until = std::nullopt);
+
+private:
+    int epoll_fd;
+    std::map<int, Handler> handlers;
+};
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
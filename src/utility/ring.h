@@ -0,0 +1,70 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef RING_H
+#define RING_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Fixed size queue between exactly one producer thread and one consumer
+// thread, without locks.  Each side owns one index and only reads the
+// other's, so push() and pop() never wait.
+template <typename T, std::size_t N>
+class Ring {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "Ring size must be a power of two");
+
+public:
+    static constexpr std::size_t capacity() { return N; }
+
+    // Producer only.  False if the ring is full
+    bool push(const T& value) {
+        const auto tail = write.load(std::memory_order_relaxed);
+        if (tail - read.load(std::memory_order_acquire) == N) {
+            return false;
+        }
+        items[tail % N] = value;
+        write.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only.  False if the ring is empty
+    bool pop(T& value) {
+        const auto head = read.load(std::memory_order_relaxed);
+        if (head == write.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = items[head % N];
+        read.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return read.load(std::memory_order_acquire) == write.load(std::memory_order_acquire);
+    }
+
+private:
+    // Kept on separate cache lines so the two sides don't contend
+    alignas(64) std::atomic<std::size_t> read{0};
+    alignas(64) std::atomic<std::size_t> write{0};
+    std::array<T, N> items{};
+};
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
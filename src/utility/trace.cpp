@@ -0,0 +1,162 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "trace.h"
+
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+
+// Spans on one thread.  Only it writes, and publishes each span by moving
+// head past it, so readers can take what's there without stopping it, and
+// throw out whatever it may have been overwriting meanwhile.  Rings last
+// for the whole program, and go to new threads as old ones exit
+struct TraceRing {
+    struct Span {
+        atomic<const char*> name{nullptr};
+        atomic<int64_t>     start_ns{0};
+        atomic<int64_t>     end_ns{0};
+    };
+
+    array<Span, TRACE_SPANS> spans;
+    atomic<uint64_t>    head{0};  // Spans ever recorded
+    atomic<const char*> thread_name{nullptr};
+    atomic<bool>        in_use{true};
+    int                 tid;
+    TraceRing*          next;
+};
+
+static atomic<TraceRing*> rings{nullptr};
+static atomic<int>        num_rings{0};
+
+// Timestamps are from when the program started
+static const TraceClock::time_point epoch = TraceClock::now();
+
+static int64_t since_epoch(TraceClock::time_point when) {
+    return chrono::duration_cast<chrono::nanoseconds>(when - epoch).count();
+}
+
+// The calling thread's ring, one left by a thread that's gone if there is
+// one
+static TraceRing* acquire_ring() {
+    for (auto ring = rings.load(memory_order_acquire); ring; ring = ring->next) {
+        auto free = false;
+        if (ring->in_use.compare_exchange_strong(free, true, memory_order_acquire)) {
+            ring->thread_name.store(nullptr, memory_order_relaxed);
+            return ring;
+        }
+    }
+
+    auto ring = new TraceRing;
+    ring->tid  = ++num_rings;
+    ring->next = rings.load(memory_order_relaxed);
+    while (!rings.compare_exchange_weak(ring->next, ring, memory_order_release)) {
+    }
+    return ring;
+}
+
+static TraceRing* this_ring() {
+    struct Owner {
+        TraceRing* ring = acquire_ring();
+        ~Owner() { ring->in_use.store(false, memory_order_release); }
+    };
+    static thread_local Owner owner;
+    return owner.ring;
+}
+
+void trace_thread(const char* name) {
+    this_ring()->thread_name.store(name, memory_order_relaxed);
+}
+
+void trace_record(const char* name, TraceClock::time_point start, TraceClock::time_point end) {
+    auto ring = this_ring();
+    const auto i = ring->head.load(memory_order_relaxed);
+    auto& span = ring->spans[i % TRACE_SPANS];
+    span.name.store(name, memory_order_relaxed);
+    span.start_ns.store(since_epoch(start), memory_order_relaxed);
+    span.end_ns.store(since_epoch(end), memory_order_relaxed);
+    ring->head.store(i + 1, memory_order_release);
+}
+
+string trace_json() {
+    struct Copy {
+        const char* name;
+        int64_t     start_ns;
+        int64_t     end_ns;
+    };
+
+    string json = "{\"traceEvents\": [";
+    auto first = true;
+    char buf[256];
+    auto append = [&](int n) {
+        if (n > 0) {
+            json += first ? "\n" : ",\n";
+            json.append(buf, min<size_t>(n, sizeof buf - 1));
+            first = false;
+        }
+    };
+
+    vector<Copy> copies;
+    for (auto ring = rings.load(memory_order_acquire); ring; ring = ring->next) {
+        const auto thread_name = ring->thread_name.load(memory_order_relaxed);
+        if (thread_name) {
+            append(snprintf(
+                buf, sizeof buf,
+                "{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": 1, \"tid\": %d,"
+                " \"args\": {\"name\": \"%s\"}}",
+                ring->tid, thread_name));
+        }
+
+        const auto head = ring->head.load(memory_order_acquire);
+        const auto from = head > TRACE_SPANS ? head - TRACE_SPANS : 0;
+        copies.clear();
+        for (auto i = from; i != head; ++i) {
+            const auto& span = ring->spans[i % TRACE_SPANS];
+            copies.push_back({
+                span.name.load(memory_order_relaxed),
+                span.start_ns.load(memory_order_relaxed),
+                span.end_ns.load(memory_order_relaxed),
+            });
+        }
+
+        // Whatever the thread's got to since may have overwritten the
+        // oldest, and the one it's writing the oldest of those
+        atomic_thread_fence(memory_order_acquire);
+        const auto now  = ring->head.load(memory_order_relaxed);
+        const auto keep = now + 1 > TRACE_SPANS ? now + 1 - TRACE_SPANS : 0;
+        for (auto i = max(from, keep); i < head; ++i) {
+            const auto& copy = copies[i - from];
+            append(snprintf(
+                buf, sizeof buf,
+                "{\"ph\": \"X\", \"name\": \"%s\", \"pid\": 1, \"tid\": %d,"
+                " \"ts\": %" PRId64 ".%03d, \"dur\": %" PRId64 ".%03d}",
+                copy.name, ring->tid,
+                copy.start_ns / 1000, int(copy.start_ns % 1000),
+                (copy.end_ns - copy.start_ns) / 1000, int((copy.end_ns - copy.start_ns) % 1000)));
+        }
+    }
+
+    json += "\n], \"displayTimeUnit\": \"ms\"}\n";
+    return json;
+}
+
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
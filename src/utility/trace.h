@@ -0,0 +1,71 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <string>
+
+// Spans of time on each thread, for a timeline of where it goes, as Chrome
+// trace JSON for chrome://tracing or ui.perfetto.dev.  Spans are only
+// recorded when built with RCM_TRACE, otherwise the macros are nothing at
+// all.  Each thread records into a ring of its own, without locking, and
+// keeps the latest TRACE_SPANS.  Names have to be string literals
+#ifdef RCM_TRACE
+#define TRACE_JOIN_(a, b) a##b
+#define TRACE_JOIN(a, b)  TRACE_JOIN_(a, b)
+#define TRACE_SPAN(name)   TraceSpan TRACE_JOIN(trace_span_, __LINE__){name}
+#define TRACE_THREAD(name) trace_thread(name)
+#define TRACE_RECORD(name, start, end) trace_record(name, start, end)
+#else
+#define TRACE_SPAN(name)   ((void)0)
+#define TRACE_THREAD(name) ((void)0)
+#define TRACE_RECORD(name, start, end) ((void)0)
+#endif
+
+using TraceClock = std::chrono::steady_clock;
+
+// Kept per thread
+constexpr std::size_t TRACE_SPANS = 4096;
+
+// Names the calling thread on the timeline
+void trace_thread(const char* name);
+
+// A span on the calling thread, already over
+void trace_record(const char* name, TraceClock::time_point start, TraceClock::time_point end);
+
+// Every span still kept, from every thread, as Chrome trace JSON
+std::string trace_json();
+
+// Records the time from construction to destruction
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name) : name{name}, start{TraceClock::now()} {}
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+    ~TraceSpan() { trace_record(name, start, TraceClock::now()); }
+
+private:
+    const char*            name;
+    TraceClock::time_point start;
+};
+
+#endif
+
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,81 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+
+// Latest value from exactly one producer thread to one consumer thread,
+// without locks.  The producer fills its back slot and swaps it for the
+// middle one, the consumer swaps its front slot for the middle one when
+// there's something new there, so each always has a slot to itself and
+// neither ever waits.  Values the consumer doesn't take in time are
+// overwritten by newer ones
+template <typename T>
+class TripleBuffer {
+public:
+    explicit TripleBuffer(const T& initial = T{}) : slots{{initial, initial, initial}} {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producer only.  Slot to fill in before publish()
+    T& back() { return slots[back_index]; }
+
+    // Producer only.  Make back the newest value.  False if the consumer
+    // hadn't taken the one before it
+    bool publish() {
+        const auto old = state.exchange(back_index | FRESH, std::memory_order_acq_rel);
+        back_index = old & INDEX;
+        return (old & FRESH) == 0;
+    }
+
+    // Consumer only.  Move the newest value to front, false if there's been
+    // none since last time
+    bool take() {
+        if ((state.load(std::memory_order_relaxed) & FRESH) == 0) {
+            return false;
+        }
+        const auto old = state.exchange(front_index, std::memory_order_acq_rel);
+        front_index = old & INDEX;
+        return true;
+    }
+
+    // Consumer only
+    const T& front() const { return slots[front_index]; }
+
+    // Whether there's a value the consumer hasn't taken
+    bool fresh() const { return (state.load(std::memory_order_acquire) & FRESH) != 0; }
+
+private:
+    static constexpr unsigned INDEX = 3;
+    static constexpr unsigned FRESH = 4;
+
+    std::array<T, 3> slots;
+
+    // Index of the middle slot, and whether it's newer than front
+    alignas(64) std::atomic<unsigned> state{1};
+
+    alignas(64) unsigned back_index{0};
+    alignas(64) unsigned front_index{2};
+};
+
+#endif
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
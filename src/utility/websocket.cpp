@@ -0,0 +1,215 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "websocket.h"
+
+#include <array>
+#include <cstring>
+
+using namespace std;
+using namespace websocket;
+
+// Only for the handshake, which is all SHA-1 is good for now
+static array<uint8_t, 20> sha1(string_view data) {
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+    auto rotl = [](uint32_t x, int n) { return (x << n) | (x >> (32 - n)); };
+
+    // Message, a one bit, zeros to 56 mod 64, and the length in bits
+    string padded{data};
+    padded += '\x80';
+    while (padded.size() % 64 != 56) {
+        padded += '\0';
+    }
+    const uint64_t bits = uint64_t{data.size()} * 8;
+    for (int i = 7; i >= 0; --i) {
+        padded += static_cast<char>(bits >> 8 * i);
+    }
+
+    for (size_t block = 0; block < padded.size(); block += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            const auto p = reinterpret_cast<const uint8_t*>(&padded[block + 4 * i]);
+            w[i] = uint32_t{p[0]} << 24 | uint32_t{p[1]} << 16 | uint32_t{p[2]} << 8 | p[3];
+        }
+        for (int i = 16; i < 80; ++i) {
+            w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i) {
+            uint32_t f, k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            const uint32_t t = rotl(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotl(b, 30);
+            b = a;
+            a = t;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    array<uint8_t, 20> digest;
+    for (int i = 0; i < 20; ++i) {
+        digest[i] = static_cast<uint8_t>(h[i / 4] >> (24 - 8 * (i % 4)));
+    }
+    return digest;
+}
+
+static string base64(const uint8_t* data, size_t size) {
+    static const char digits[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    string out;
+    for (size_t i = 0; i < size; i += 3) {
+        const uint32_t n = uint32_t{data[i]} << 16 |
+            (i + 1 < size ? uint32_t{data[i + 1]} << 8 : 0) |
+            (i + 2 < size ? uint32_t{data[i + 2]} : 0);
+        out += digits[n >> 18 & 63];
+        out += digits[n >> 12 & 63];
+        out += i + 1 < size ? digits[n >> 6 & 63] : '=';
+        out += i + 2 < size ? digits[n & 63] : '=';
+    }
+    return out;
+}
+
+string websocket::accept(string_view key) {
+    static constexpr string_view GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+    string concatenated{key};
+    concatenated += GUID;
+    const auto digest = sha1(concatenated);
+    return base64(digest.data(), digest.size());
+}
+
+string websocket::frame(Opcode opcode, string_view payload) {
+    string out;
+    out += static_cast<char>(0x80 | opcode);  // FIN
+    if (payload.size() < 126) {
+        out += static_cast<char>(payload.size());
+    } else if (payload.size() <= 0xFFFF) {
+        out += static_cast<char>(126);
+        out += static_cast<char>(payload.size() >> 8);
+        out += static_cast<char>(payload.size());
+    } else {
+        out += static_cast<char>(127);
+        for (int i = 7; i >= 0; --i) {
+            out += static_cast<char>(uint64_t{payload.size()} >> 8 * i);
+        }
+    }
+    out += payload;
+    return out;
+}
+
+void WebSocketReader::feed(const char* data, size_t size) {
+    buffer.append(data, size);
+}
+
+bool WebSocketReader::next(Opcode& opcode, string& payload) {
+    while (!error) {
+        const auto p = reinterpret_cast<const uint8_t*>(buffer.data());
+        if (buffer.size() < 2) {
+            return false;
+        }
+
+        const bool fin    = p[0] & 0x80;
+        const auto code   = static_cast<Opcode>(p[0] & 0x0F);
+        const bool masked = p[1] & 0x80;
+        const bool control = code & 0x8;
+
+        // Clients mask everything, and we've agreed no extensions
+        size_t header = 2;
+        uint64_t length = p[1] & 0x7F;
+        if ((p[0] & 0x70) || !masked || (control && (!fin || length > 125))) {
+            error = true;
+            break;
+        }
+        if (length == 126) {
+            if (buffer.size() < 4) {
+                return false;
+            }
+            length = uint64_t{p[2]} << 8 | p[3];
+            header = 4;
+        } else if (length == 127) {
+            if (buffer.size() < 10) {
+                return false;
+            }
+            length = 0;
+            for (int i = 0; i < 8; ++i) {
+                length = length << 8 | p[2 + i];
+            }
+            header = 10;
+        }
+        if (length > MAX_MESSAGE || message.size() + length > MAX_MESSAGE) {
+            error = true;
+            break;
+        }
+        if (buffer.size() < header + 4 + length) {
+            return false;
+        }
+
+        const uint8_t* mask = p + header;
+        string data(length, '\0');
+        for (size_t i = 0; i < length; ++i) {
+            data[i] = static_cast<char>(p[header + 4 + i] ^ mask[i % 4]);
+        }
+        buffer.erase(0, header + 4 + length);
+
+        if (control) {
+            opcode  = code;
+            payload = std::move(data);
+            return true;
+        }
+
+        // A data frame starts a message, continuations add to it
+        if ((code == CONTINUATION) == (message_opcode == CONTINUATION)) {
+            error = true;
+            break;
+        }
+        if (code != CONTINUATION) {
+            message_opcode = code;
+        }
+        message += data;
+        if (fin) {
+            opcode  = message_opcode;
+            payload = std::move(message);
+            message.clear();
+            message_opcode = CONTINUATION;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
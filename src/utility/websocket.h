@@ -0,0 +1,74 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef WEBSOCKET_H
+#define WEBSOCKET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// The framing of RFC 6455, from the server's side: frames it sends are
+// unmasked, frames from clients have to be masked
+namespace websocket {
+
+enum Opcode : std::uint8_t {
+    CONTINUATION = 0x0,
+    TEXT         = 0x1,
+    BINARY       = 0x2,
+    CLOSE        = 0x8,
+    PING         = 0x9,
+    PONG         = 0xA,
+};
+
+// Largest message a client may send, reassembled
+constexpr std::size_t MAX_MESSAGE = 64 * 1024;
+
+// Sec-WebSocket-Accept answering a client's Sec-WebSocket-Key
+std::string accept(std::string_view key);
+
+// A whole frame, with payload
+std::string frame(Opcode opcode, std::string_view payload);
+
+}
+
+// Messages from a client, as its bytes arrive.  Control frames come out as
+// they're read, fragmented messages once they're whole
+class WebSocketReader {
+public:
+    // Add bytes as they arrive
+    void feed(const char* data, std::size_t size);
+
+    // Next whole message, false if there isn't one yet or the client has
+    // broken the protocol
+    bool next(websocket::Opcode& opcode, std::string& payload);
+
+    // Client broke the protocol, and should be closed
+    bool failed() const { return error; }
+
+private:
+    std::string buffer;   // Not yet parsed
+    std::string message;  // Fragments so far
+    websocket::Opcode message_opcode{websocket::CONTINUATION};
+    bool error{false};
+};
+
+#endif
+
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
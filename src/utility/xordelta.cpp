@@ -0,0 +1,99 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+
+#include "xordelta.h"
+
+using namespace std;
+
+static void put_varint(string& out, size_t value) {
+    while (value >= 0x80) {
+        out += char(0x80 | (value & 0x7F));
+        value >>= 7;
+    }
+    out += char(value);
+}
+
+static bool get_varint(string_view& in, size_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (in.empty()) {
+            return false;
+        }
+        const auto byte = uint8_t(in.front());
+        in.remove_prefix(1);
+        value |= size_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace xordelta {
+
+string encode(const uint8_t* from, const uint8_t* to, size_t size) {
+    string out;
+    size_t i = 0;
+    for (;;) {
+        const auto start = i;
+        while (i != size && from[i] == to[i]) {
+            ++i;
+        }
+        if (i == size) {
+            return out;
+        }
+        const auto zeros = i - start;
+
+        // A lone matching byte costs less inside the literals than as a
+        // run of its own
+        const auto literal = i;
+        while (i != size && (from[i] != to[i] ||
+                             (i + 1 != size && from[i + 1] != to[i + 1])))
+        {
+            ++i;
+        }
+
+        put_varint(out, zeros);
+        put_varint(out, i - literal);
+        for (auto j = literal; j != i; ++j) {
+            out += char(from[j] ^ to[j]);
+        }
+    }
+}
+
+bool apply(uint8_t* image, size_t size, string_view delta) {
+    size_t i = 0;
+    while (!delta.empty()) {
+        size_t zeros, count;
+        if (!get_varint(delta, zeros) || !get_varint(delta, count)) {
+            return false;
+        }
+        if (zeros > size - i || count > size - i - zeros || count > delta.size()) {
+            return false;
+        }
+        i += zeros;
+        for (size_t j = 0; j != count; ++j) {
+            image[i++] ^= uint8_t(delta[j]);
+        }
+        delta.remove_prefix(count);
+    }
+    return true;
+}
+
+}
+
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
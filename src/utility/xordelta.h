@@ -0,0 +1,47 @@
+// Copyright (C) 2024 Eric Sessoms
+// See license at end of file
+#pragma once
+
+#ifndef XORDELTA_H
+#define XORDELTA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// The difference between two images of the same size, as the XOR of their
+// bytes, run-length encoded.  Mostly it's zeros, so it's a sequence of
+//
+//     varint zeros, varint count, count bytes of XOR
+//
+// with varints as LEB128, and whatever follows the last run is zero.
+// Identical images encode as nothing at all
+namespace xordelta {
+
+// Delta taking from to to
+std::string encode(const std::uint8_t* from, const std::uint8_t* to, std::size_t size);
+
+// Apply the delta to image, in place, false if it's malformed or overruns
+// the image, which is then only partly changed
+bool apply(std::uint8_t* image, std::size_t size, std::string_view delta);
+
+}
+
+#endif
+
+
+// This file is part of the Raccoon's Centaur Mods (RCM).
+//
+// RCM is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// RCM is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,397 @@
+// Time what the game loop does most, or most urgently, to see what a change
+// costs, before and after.
+//
+//     bench [repetitions [name]]
+//
+// Each benchmark is warmed up, then run repetitions times (default 1000),
+// and its median and 99th percentile printed as JSON, in nanoseconds per
+// run.  With a name, only benchmarks whose names start with it are run.
+#include "../src/boardview.h"
+#include "../src/chess/chess.h"
+#include "../src/graphics.h"
+#include "../src/image.h"
+#include "../src/utility/buffer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace std;
+using namespace thc;
+
+//
+// Harness
+//
+
+struct Result {
+    string   name;
+    size_t   repetitions;
+    uint64_t median;
+    uint64_t p99;
+    uint64_t min;
+    uint64_t max;
+};
+
+static size_t         repetitions = 1000;
+static const char*    only        = "";
+static vector<Result> results;
+
+// What each run returns, so the compiler can't do away with the work
+static volatile size_t sink;
+
+// Run setup, untimed, then work, timed, a tenth as many times as there are
+// repetitions to warm up, then the repetitions
+template <typename Setup, typename Work>
+static void bench(const string& name, Setup setup, Work work) {
+    if (name.compare(0, strlen(only), only) != 0) {
+        return;
+    }
+
+    using clock = chrono::steady_clock;
+    for (size_t i = 0; i != max<size_t>(1, repetitions / 10); ++i) {
+        setup();
+        sink = work();
+    }
+
+    vector<uint64_t> times;
+    times.reserve(repetitions);
+    for (size_t i = 0; i != repetitions; ++i) {
+        setup();
+        const auto t0 = clock::now();
+        sink = work();
+        const auto t1 = clock::now();
+        times.push_back(chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count());
+    }
+
+    sort(times.begin(), times.end());
+    const auto n = times.size();
+    results.push_back({name, n, times[n / 2], times[min(n - 1, n * 99 / 100)], times.front(), times.back()});
+}
+
+template <typename Work>
+static void bench(const string& name, Work work) {
+    bench(name, [] {}, work);
+}
+
+static void print_results() {
+    printf("{\n  \"repetitions\": %zu,\n  \"benchmarks\": [", repetitions);
+    for (size_t i = 0; i != results.size(); ++i) {
+        const auto& r = results[i];
+        printf("%s\n    {\"name\": \"%s\", \"repetitions\": %zu, "
+               "\"median_ns\": %llu, \"p99_ns\": %llu, \"min_ns\": %llu, \"max_ns\": %llu}",
+               i ? "," : "",
+               r.name.c_str(),
+               r.repetitions,
+               (unsigned long long)r.median,
+               (unsigned long long)r.p99,
+               (unsigned long long)r.min,
+               (unsigned long long)r.max);
+    }
+    printf("\n  ]\n}\n");
+}
+
+//
+// Reading the board
+//
+
+static const Bitmap START = 0xFFFF00000000FFFF;
+
+static Bitmap after(Bitmap boardstate, const ActionList& actions) {
+    for (const auto& action : actions) {
+        if (action.lift != SQUARE_INVALID) {
+            boardstate &= ~(1ULL << action.lift);
+        }
+        else {
+            boardstate |= 1ULL << action.place;
+        }
+    }
+    return boardstate;
+}
+
+static Action lift(Square square) {
+    return Action{square, SQUARE_INVALID};
+}
+
+static Action place(Square square) {
+    return Action{SQUARE_INVALID, square};
+}
+
+static void bench_read_move(const char* name, const char* fen, const ActionList& actions, size_t expected) {
+    const Position position{fen};
+    const auto     boardstate = after(position.bitmap(), actions);
+
+    MoveList candidates;
+    position.read_move(boardstate, actions, candidates);
+    if (candidates.size() != expected) {
+        throw logic_error(string(name) + ": read the wrong moves");
+    }
+
+    bench(name, [&] {
+        MoveList candidates;
+        position.read_move(boardstate, actions, candidates);
+        return candidates.size();
+    });
+}
+
+// Pieces picked up and put back, or nudged, from all over the board, before
+// the two moves between them that were missed, 1. e4 e5
+static ActionList noisy_actions(size_t length) {
+    static const Square touched[] = {g1, b8, d1, f8, a2, h7, c1, e8};
+    const ActionList missed{lift(e2), place(e4), lift(e7), place(e5)};
+
+    ActionList actions;
+    for (size_t i = 0; actions.size() + missed.size() < length; ++i) {
+        const auto square = touched[i % size(touched)];
+        actions.push_back(lift(square));
+        actions.push_back(place(square));
+    }
+    actions.insert(actions.end(), missed.begin(), missed.end());
+    return actions;
+}
+
+// The search Centaur::read_move falls back on for a missed move, all of it,
+// not just what fits in a budget for one call
+static void bench_reconstruction(size_t size) {
+    const Game game;
+    const auto actions    = noisy_actions(size);
+    const auto boardstate = after(START, actions);
+    const auto budget     = chrono::microseconds{chrono::seconds{10}};
+
+    unique_ptr<Reconstruction> reconstruction;
+    Reconstructed              reconstructed;
+    const auto                 find_tail = [&] {
+        return reconstruction->find_tail(game, actions, boardstate, reconstructed, budget);
+    };
+
+    reconstruction = make_unique<Reconstruction>();
+    if (!find_tail() || !reconstructed.move || reconstructed.move->uci() != "e2e4") {
+        throw logic_error("reconstruction: missed 1. e4");
+    }
+
+    bench(
+        "Reconstruction::find_tail/" + to_string(size) + " noisy actions",
+        [&] { reconstruction = make_unique<Reconstruction>(); },
+        find_tail);
+}
+
+//
+// PGN
+//
+
+// A game of 200 plies, picked at random but the same each time, with a
+// variation every eighth ply
+static unique_ptr<Game> long_game() {
+    auto    game = make_unique<Game>();
+    mt19937 random{20240101};
+    for (auto ply = 0; ply != 200; ++ply) {
+        const auto moves = game->legal_moves();
+        if (moves.empty()) {
+            break;
+        }
+        const auto i    = random() % moves.size();
+        const auto move = moves[i];
+        game->play_move(move);
+        if (ply % 8 == 0 && moves.size() > 1) {
+            game->play_takeback();
+            game->play_move(moves[(i + 1) % moves.size()]);
+            game->play_takeback();
+            game->play_move(move);
+        }
+    }
+    return game;
+}
+
+// PGN of game, with a comment after every third move and a NAG after every
+// fifth
+static string annotate(const string& pgn) {
+    const auto movetext = pgn.find("\n\n") + 2;
+
+    string annotated = pgn.substr(0, movetext);
+    size_t moves     = 0;
+    for (size_t begin = movetext; begin < pgn.size();) {
+        const auto end   = min(pgn.find_first_of(" \n", begin), pgn.size());
+        const auto token = pgn.substr(begin, end - begin);
+        annotated += token;
+        const auto is_move = !token.empty() && token != "*" && token.back() != '.' &&
+                             !isdigit(static_cast<unsigned char>(token[0]));
+        if (is_move) {
+            ++moves;
+            if (moves % 3 == 0) {
+                annotated += " {A comment, as a reviewer might leave}";
+            }
+            if (moves % 5 == 0) {
+                annotated += " $1";
+            }
+        }
+        if (end < pgn.size()) {
+            annotated += pgn[end];
+        }
+        begin = end + 1;
+    }
+    return annotated;
+}
+
+static void bench_pgn() {
+    auto       game      = long_game();
+    const auto pgn       = game->pgn();
+    const auto annotated = annotate(pgn);
+    if (Game{annotated}.pgn() != pgn) {
+        throw logic_error("pgn: annotations changed the game");
+    }
+
+    bench("Game::pgn()/cached movetext", [&] { return game->pgn().size(); });
+
+    // Revising the last move changes the graph, so all of it's written again
+    const auto last  = game->history.size() - 1;
+    const auto moves = game->history[last - 1]->legal_moves();
+    const auto moved = *game->history[last - 1]->find_move_played(game->history[last]);
+    const auto other = moves[0] == moved ? moves[1] : moves[0];
+    bench(
+        "Game::pgn()/after a revision",
+        [&] {
+            const auto played = *game->previous()->find_move_played(game->current());
+            game->revise_move(played, played == moved ? other : moved);
+        },
+        [&] { return game->pgn().size(); });
+
+    bench("Game::pgn(string_view)/annotated", [&] {
+        game->pgn(annotated);
+        return game->history.size();
+    });
+}
+
+//
+// Screen
+//
+
+static void bench_screen() {
+    auto game     = make_unique<Game>();
+    bool reversed = false;
+
+    // As the screen has it, see epd2in9d.h
+    Image   image{128, 296};
+    Context context;
+    context.image = &image;
+    context.clear();
+
+    BoardView view{game, reversed};
+    view.render(context);
+
+    bench(
+        "BoardView::render/after a move",
+        [&] {
+            if (game->history.size() > 1) {
+                game->play_takeback();
+            }
+            else {
+                game->play_uci_move("e2e4");
+            }
+        },
+        [&] { return static_cast<size_t>(view.render(context).right); });
+
+    bench(
+        "BoardView::render/everything",
+        [&] { view.invalidate(); },
+        [&] { return static_cast<size_t>(view.render(context).right); });
+
+    bench("Image::png", [&] {
+        uint8_t* png  = nullptr;
+        size_t   size = 0;
+        if (image.png(&png, &size) != 0) {
+            throw runtime_error("Image::png failed");
+        }
+        free(png);
+        return size;
+    });
+}
+
+//
+// Engine output
+//
+
+static void bench_buffer() {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        throw runtime_error("pipe() failed");
+    }
+
+    // As a search says them, well short of what a pipe holds
+    const string line = "info depth 18 seldepth 24 multipv 1 score cp 31 nodes 1843216 nps 921608 "
+                        "pv e2e4 e7e5 g1f3 b8c6 f1b5\n";
+    const auto   lines = 256;
+    string       said;
+    for (auto i = 0; i != lines; ++i) {
+        said += line;
+    }
+
+    Buffer buffer{8192, fds[0]};
+    bench(
+        "Buffer::getline/256 lines",
+        [&] {
+            if (write(fds[1], said.data(), said.size()) != static_cast<ssize_t>(said.size())) {
+                throw runtime_error("write() failed");
+            }
+        },
+        [&] {
+            size_t read = 0;
+            while (read != lines) {
+                if (buffer.getline(0)) {
+                    ++read;
+                }
+            }
+            return read;
+        });
+
+    close(fds[1]);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        repetitions = strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2) {
+        only = argv[2];
+    }
+    if (!repetitions) {
+        fprintf(stderr, "usage: %s [repetitions [name]]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        bench_read_move(
+            "Position::read_move/typical",
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+            {lift(e2), place(e4)},
+            1);
+        bench_read_move(
+            "Position::read_move/capture",
+            "rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2",
+            {lift(e4), lift(d5), place(d5)},
+            1);
+        for (auto size : {10, 50, 200}) {
+            bench_reconstruction(size);
+        }
+        bench_pgn();
+        bench_screen();
+        bench_buffer();
+    }
+    catch (const exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    print_results();
+    return EXIT_SUCCESS;
+}
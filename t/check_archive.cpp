@@ -0,0 +1,97 @@
+#include "../src/chess/chess_archive.h"
+#include "doctest.h"
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+using namespace std;
+
+static string temp_path() {
+    char path[] = "/tmp/check_archiveXXXXXX";
+    const auto fd = mkstemp(path);
+    REQUIRE(fd >= 0);
+    close(fd);
+    return path;
+}
+
+TEST_CASE("archive round trip") {
+    Game opening;
+    opening.pgn("[Event \"Opening\"]\n1. e4 e5 2. Nf3 Nc6 (2... d6 3. d4 (3. Bc4)) 3. Bb5 a6");
+
+    Game endgame{{}, "4k3/P7/8/8/8/8/8/4K3 w - - 0 1"};
+    endgame.play_san_move("a8=N");
+    endgame.tags["Event"] = "Endgame";
+
+    const auto path = temp_path();
+    {
+        ArchiveWriter writer{path.c_str()};
+        writer.add(opening);
+        writer.add(endgame);
+        CHECK(writer.size() == 2);
+    }
+
+    Archive archive{path.c_str()};
+    REQUIRE(archive.size() == 2);
+
+    const auto tags = archive.tags(0);
+    REQUIRE(tags.size() == 1);
+    CHECK(tags[0].first == "Event");
+    CHECK(tags[0].second == "Opening");
+
+    Game game;
+    archive.load(0, game);
+    CHECK(game.pgn() == opening.pgn());
+    CHECK(game.fen() == opening.fen());
+
+    archive.load(1, game);
+    CHECK(game.pgn() == endgame.pgn());
+    CHECK(game.start()->fen() == "4k3/P7/8/8/8/8/8/4K3 w - - 0 1");
+
+    // Positions from any line, and the start
+    CHECK(archive.find(opening.start()->key()) == vector<size_t>{0});
+    CHECK(archive.find(game.current()->key()) == vector<size_t>{1});
+    auto d4 = opening.start();
+    for (auto san : {"e4", "e5", "Nf3", "d6", "d4"}) {
+        d4 = d4->play_move(const_cast<Position&>(*d4).san_move(san));
+    }
+    CHECK(archive.find(d4->key()) == vector<size_t>{0});
+    CHECK(archive.find(0).empty());
+
+    CHECK_THROWS_AS(archive.load(2, game), out_of_range);
+    unlink(path.c_str());
+}
+
+TEST_CASE("archive converts to and from PGN") {
+    const string pgn =
+        "[Event \"A\"]\n\n1. d4 d5 2. c4 1-0\n\n"
+        "[Event \"Bad\"]\n\n1. d4 d4 *\n\n"
+        "[Event \"B\"]\n\n1. f3 e6 2. g4 Qh4# 0-1\n";
+
+    const auto path = temp_path();
+    {
+        PgnReader     reader{pgn};
+        ArchiveWriter writer{path.c_str()};
+        CHECK(pgn_to_archive(reader, writer) == 1);
+        CHECK(writer.size() == 2);
+    }
+
+    Archive archive{path.c_str()};
+    ostringstream out;
+    archive_to_pgn(archive, out);
+    CHECK(out.str() ==
+        "[Event \"A\"]\n\n1. d4 d5 2. c4\n\n"
+        "[Event \"B\"]\n\n1. f3 e6 2. g4 Qh4#\n\n");
+    unlink(path.c_str());
+}
+
+TEST_CASE("not an archive") {
+    const auto path = temp_path();
+    auto f = fopen(path.c_str(), "w");
+    fputs("[Event \"Just some PGN, long enough for a header\"]\n", f);
+    fclose(f);
+    CHECK_THROWS_AS(Archive{path.c_str()}, domain_error);
+    unlink(path.c_str());
+    CHECK_THROWS_AS(Archive{path.c_str()}, runtime_error);
+}
@@ -0,0 +1,150 @@
+#include "../src/thc/ChessRules.h"
+#include "doctest.h"
+
+#include <cstdint>
+
+using namespace std;
+using namespace thc;
+
+// Expose thc's original mailbox generator for comparison
+class Mailbox : public ChessRules {
+public:
+    MoveList legal_moves() { return select_legal(GenMoveList()); }
+};
+
+static bool bitboards_match(const ChessPosition& cp) {
+    ChessPosition expected{cp};
+    expected.rebuild_bitboards();
+    const auto& a = cp.bitboards;
+    const auto& b = expected.bitboards;
+    return a.white == b.white && a.black == b.black &&
+        a.pawns == b.pawns && a.knights == b.knights && a.bishops == b.bishops &&
+        a.rooks == b.rooks && a.queens == b.queens && a.kings == b.kings;
+}
+
+// Play a pseudo-random game from fen, checking the generators agree at
+// every ply
+static void random_walk(const char* fen, int plies, uint32_t seed) {
+    Mailbox p;
+    REQUIRE(p.Forsyth(fen));
+    for (auto i = 0; i < plies; ++i) {
+        const auto expected = p.legal_moves();
+        MoveList moves;
+        p.GenLegalMoveList(moves);
+        REQUIRE(moves == expected);
+        if (moves.empty()) {
+            break;
+        }
+
+        // Try taking each move back too
+        for (auto move : moves) {
+            p.PushMove(move);
+            REQUIRE(bitboards_match(p));
+            p.PopMove(move);
+        }
+        REQUIRE(bitboards_match(p));
+
+        seed = seed * 1103515245 + 12345;
+        p.PlayMove(moves[(seed >> 16) % moves.size()]);
+    }
+}
+
+TEST_CASE("bitboards follow squares") {
+    ChessRules p;
+    CHECK(p.bitboards.white == 0xffff000000000000);
+    CHECK(p.bitboards.black == 0x000000000000ffff);
+    CHECK(p.bitboards.kings == (BB(e1) | BB(e8)));
+    CHECK(p.bitboards.pawns == 0x00ff00000000ff00);
+
+    p.play_san_move("e4");
+    CHECK(p.bitboards.pawns == 0x00ef00100000ff00);
+    CHECK(bitboards_match(p));
+
+    CHECK(p.Forsyth("4k3/8/8/8/8/8/8/4K2R w K - 0 1"));
+    CHECK(p.bitboards.occupied() == (BB(e8) | BB(e1) | BB(h1)));
+    p.play_san_move("O-O");
+    CHECK(p.bitboards.rooks == BB(f1));
+    CHECK(p.bitboards.kings == (BB(e8) | BB(g1)));
+}
+
+TEST_CASE("attack tables") {
+    CHECK(knight_attacks[a8] == (BB(b6) | BB(c7)));
+    CHECK(king_attacks[h1] == (BB(g1) | BB(g2) | BB(h2)));
+    CHECK(pawn_attacks[1][e4] == (BB(d5) | BB(f5)));
+    CHECK(pawn_attacks[0][e4] == (BB(d3) | BB(f3)));
+    CHECK(between[a1][d4] == (BB(b2) | BB(c3)));
+    CHECK(between[a1][b3] == 0);
+    CHECK(line[c3][e5] == (BB(a1) | BB(b2) | BB(c3) | BB(d4) | BB(e5) |
+                           BB(f6) | BB(g7) | BB(h8)));
+    CHECK(rook_attacks(a1, BB(a4) | BB(c1)) ==
+          (BB(a2) | BB(a3) | BB(a4) | BB(b1) | BB(c1)));
+}
+
+TEST_CASE("magic slider attacks agree with rays") {
+    auto seed = uint64_t{0x243f6a8885a308d3};
+    for (auto trial = 0; trial < 200; ++trial) {
+        // Sparse and dense boards
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+        auto occupied = seed;
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+        occupied &= trial % 2 ? seed : ~seed;
+
+        for (Square sq = a8; sq <= h1; ++sq) {
+            auto rook = Bitboard{0}, bishop = Bitboard{0};
+            for (auto dir = int(DIR_W); dir <= DIR_N; ++dir) {
+                rook |= ray_attacks(dir, sq, occupied);
+            }
+            for (auto dir = int(DIR_SW); dir <= DIR_SE; ++dir) {
+                bishop |= ray_attacks(dir, sq, occupied);
+            }
+            REQUIRE(rook_attacks(sq, occupied) == rook);
+            REQUIRE(bishop_attacks(sq, occupied) == bishop);
+            REQUIRE(queen_attacks(sq, occupied) == (rook | bishop));
+        }
+    }
+}
+
+TEST_CASE("bitboard generator agrees with mailbox generator") {
+    static const char* fens[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "8/8/8/2k5/3pP3/8/8/4K2Q b - e3 0 1",    // en passant exposes king
+        "8/8/3k4/8/1K1pP2r/8/8/8 b - e3 0 1",    // en passant along the rank
+    };
+    auto seed = uint32_t{1};
+    for (auto fen : fens) {
+        CAPTURE(fen);
+        for (auto walk = 0; walk < 4; ++walk) {
+            random_walk(fen, 60, seed++);
+        }
+    }
+}
+
+TEST_CASE("bitboard generator handles pins, checks and castling") {
+    Mailbox p;
+
+    // Bishop pinned on the file can't move, rook pinned along it can
+    CHECK(p.Forsyth("4r1k1/8/8/8/8/8/4B3/4K3 w - - 0 1"));
+    CHECK(p.legal_moves().size() == 4);
+    CHECK(p.GenLegalMoveList() == p.legal_moves());
+
+    // Double check, only the king moves
+    CHECK(p.Forsyth("4k3/8/8/8/1b6/8/4r3/4K3 w - - 0 1"));
+    for (auto move : p.GenLegalMoveList()) {
+        CHECK(move.special == SPECIAL_KING_MOVE);
+    }
+    CHECK(p.GenLegalMoveList() == p.legal_moves());
+
+    // Can't castle through an attacked square
+    CHECK(p.Forsyth("4k3/8/8/8/8/8/8/R3K2R w KQ - 0 1"));
+    CHECK(p.GenLegalMoveList().size() == 26);
+    CHECK(p.Forsyth("4kr2/8/8/8/8/8/8/R3K2R w KQ - 0 1"));
+    CHECK(p.GenLegalMoveList() == p.legal_moves());
+    for (auto move : p.GenLegalMoveList()) {
+        CHECK(move.special != SPECIAL_WK_CASTLING);
+    }
+}
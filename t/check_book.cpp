@@ -0,0 +1,192 @@
+#include "../src/chess/chess_book.h"
+#include "../src/chess/chess_game.h"
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace thc;
+
+static string temp_path() {
+    char path[] = "/tmp/check_bookXXXXXX";
+    const auto fd = mkstemp(path);
+    REQUIRE(fd >= 0);
+    close(fd);
+    return path;
+}
+
+// Any table will do for a book made with it
+static polyglot::Random made_up() {
+    polyglot::Random random;
+    uint64_t state = 0x0123456789abcdef;
+    for (auto& key : random) {
+        auto z = state += 0x9e3779b97f4a7c15;
+        z = (z ^ z >> 30) * 0xbf58476d1ce4e5b9;
+        z = (z ^ z >> 27) * 0x94d049bb133111eb;
+        key = z ^ z >> 31;
+    }
+    return random;
+}
+
+// As Polyglot has a move, squares named
+static uint16_t book_move(const char* from, const char* to, unsigned promotion = 0) {
+    return (to[0] - 'a') | (to[1] - '1') << 3 | (from[0] - 'a') << 6 | (from[1] - '1') << 9 | promotion << 12;
+}
+
+static void put_be(string& out, uint64_t value, int bytes) {
+    while (bytes--) {
+        out += static_cast<char>(value >> 8 * bytes);
+    }
+}
+
+struct Written {
+    uint64_t key;
+    uint16_t move;
+    uint16_t weight;
+};
+
+static string write_book(vector<Written> entries) {
+    sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.key < b.key; });
+    string bytes;
+    for (const auto& entry : entries) {
+        put_be(bytes, entry.key, 8);
+        put_be(bytes, entry.move, 2);
+        put_be(bytes, entry.weight, 2);
+        put_be(bytes, 0, 4);
+    }
+
+    const auto path = temp_path();
+    const auto file = fopen(path.c_str(), "wb");
+    REQUIRE(file);
+    fwrite(bytes.data(), 1, bytes.size(), file);
+    fclose(file);
+    return path;
+}
+
+static bool is(const optional<Move>& move, Square src, Square dst) {
+    return move && move->src == src && move->dst == dst;
+}
+
+TEST_CASE("polyglot keys are those Polyglot publishes") {
+    const auto key = [](const Game& game) { return polyglot::key(polyglot::RANDOM64, *game.current()); };
+
+    Game game;
+    CHECK(key(game) == 0x463b96181691fc9c);
+
+    const vector<pair<const char*, uint64_t>> moves{
+        {"e2e4", 0x823c9b50fd114196},
+        {"d7d5", 0x0756b94461c50fb0},
+        {"e4e5", 0x662fafb965db29d4},
+        {"f7f5", 0x22a48b5a8e47ff78},  // En passant on
+        {"e1e2", 0x652a607ca3f242c1},
+        {"e8f7", 0x00fdd303c946bdd9},
+    };
+    for (const auto& [move, expected] : moves) {
+        game.play_uci_move(move);
+        CHECK(key(game) == expected);
+    }
+
+    Game other;
+    for (const auto move : {"a2a4", "b7b5", "h2h4", "b5b4", "c2c4"}) {
+        other.play_uci_move(move);
+    }
+    CHECK(key(other) == 0x3c8123ea7b067637);
+    other.play_uci_move("b4c3");
+    other.play_uci_move("a1a3");
+    CHECK(key(other) == 0x5c3f9b829b279560);
+}
+
+TEST_CASE("polyglot keys are of the position, en passant only if it's on") {
+    const auto random = made_up();
+
+    Game game;
+    const auto start = polyglot::key(random, *game.current());
+    CHECK(start != polyglot::key(random, *Game{{}, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR b KQkq - 0 1"}.current()));
+    CHECK(start != polyglot::key(random, *Game{{}, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w Kkq - 0 1"}.current()));
+
+    // Nothing to take e3 with
+    game.play_uci_move("e2e4");
+    CHECK(polyglot::key(random, *game.current()) ==
+          polyglot::key(random, *Game{{}, "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1"}.current()));
+
+    // But f6, there is
+    game.play_uci_move("d7d5");
+    game.play_uci_move("e4e5");
+    game.play_uci_move("f7f5");
+    CHECK(polyglot::key(random, *game.current()) !=
+          polyglot::key(random, *Game{{}, "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq - 0 3"}.current()));
+    CHECK(polyglot::key(random, *game.current()) ==
+          polyglot::key(random, *Game{{}, "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3"}.current()));
+}
+
+TEST_CASE("book moves are looked up by position and weighted") {
+    const auto random = made_up();
+
+    Game start;
+    Game castles{{}, "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1"};
+    Game promotes{{}, "4k3/P7/8/8/8/8/8/4K3 w - - 0 1"};
+    const auto key = [&](const Game& game) { return polyglot::key(random, *game.current()); };
+
+    const auto path = write_book({
+        {key(start),    book_move("e2", "e4"), 3},
+        {key(start),    book_move("d2", "d4"), 1},
+        {key(start),    book_move("e2", "e5"), 100},  // Not legal
+        {key(start),    book_move("a2", "a3"), 0},    // Never to be played
+        {key(castles),  book_move("e1", "a1"), 1},
+        {key(promotes), book_move("a7", "a8", 1), 1},
+        {1,             book_move("g1", "f3"), 1},
+        {~0ull,         book_move("g1", "f3"), 1},
+    });
+
+    Book book{path.c_str(), random};
+    CHECK(book.size() == 8);
+
+    const auto found = book.find(*start.current());
+    REQUIRE(found.size() == 3);
+    CHECK(found[0].weight == 3);
+    CHECK(found[2].weight == 0);
+
+    // In full, e4 three times in four, and a3 never
+    CHECK(is(book.move(*start.current(), 0, 0.0),   e2, e4));
+    CHECK(is(book.move(*start.current(), 0, 0.7),   e2, e4));
+    CHECK(is(book.move(*start.current(), 0, 0.8),   d2, d4));
+    CHECK(is(book.move(*start.current(), 0, 0.999), d2, d4));
+    CHECK(is(book.move(*start.current(), 2800, 0.7), e2, e4));
+
+    // At the weakest, nearer evens
+    CHECK(is(book.move(*start.current(), 1320, 0.5), e2, e4));
+    CHECK(is(book.move(*start.current(), 1320, 0.6), d2, d4));
+
+    // The king takes its rook to castle
+    CHECK(is(book.move(*castles.current(), 0, 0.5), e1, c1));
+
+    // Polyglot's 1 is a knight
+    const auto knight = book.move(*promotes.current(), 0, 0.5);
+    REQUIRE(is(knight, a7, a8));
+    CHECK(knight->special == SPECIAL_PROMOTION_KNIGHT);
+
+    // Out of book
+    start.play_uci_move("e2e4");
+    CHECK(book.find(*start.current()).empty());
+    CHECK_FALSE(book.move(*start.current(), 0));
+
+    unlink(path.c_str());
+}
+
+TEST_CASE("a book is whole entries") {
+    const auto path = temp_path();
+    const auto file = fopen(path.c_str(), "wb");
+    REQUIRE(file);
+    fputs("not a book", file);
+    fclose(file);
+
+    CHECK_THROWS_AS(Book(path.c_str(), made_up()), domain_error);
+    unlink(path.c_str());
+    CHECK_THROWS_AS(Book(path.c_str(), made_up()), runtime_error);
+}
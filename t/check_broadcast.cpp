@@ -0,0 +1,75 @@
+#include "../src/utility/broadcast.h"
+#include "doctest.h"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static vector<string> read_all(const BroadcastRing<string>& ring, uint64_t& cursor, bool& ok) {
+    vector<string> events;
+    ok = ring.read(cursor, [&](uint64_t number, const string& event) {
+        events.push_back(to_string(number) + ":" + event);
+        return true;
+    });
+    return events;
+}
+
+TEST_CASE("broadcast ring numbers events for every reader") {
+    BroadcastRing<string> ring{4};
+    CHECK(ring.last() == 0);
+
+    uint64_t a = 0;
+    uint64_t b = 0;
+    bool ok;
+    CHECK(read_all(ring, a, ok).empty());
+    CHECK(ok);
+
+    CHECK(ring.push("x") == 1);
+    CHECK(ring.push("y") == 2);
+    CHECK(ring.last() == 2);
+
+    CHECK(read_all(ring, a, ok) == vector<string>{"1:x", "2:y"});
+    CHECK(ok);
+    CHECK(a == 2);
+    CHECK(read_all(ring, a, ok).empty());
+
+    // Each reader has its own cursor
+    ring.push("z");
+    CHECK(read_all(ring, b, ok) == vector<string>{"1:x", "2:y", "3:z"});
+    CHECK(read_all(ring, a, ok) == vector<string>{"3:z"});
+}
+
+TEST_CASE("broadcast ring reader stops where it likes") {
+    BroadcastRing<string> ring{4};
+    ring.push("x");
+    ring.push("y");
+
+    uint64_t cursor = 0;
+    CHECK(ring.read(cursor, [](uint64_t, const string&) { return false; }));
+    CHECK(cursor == 0);
+
+    CHECK(ring.read(cursor, [](uint64_t number, const string&) { return number < 2; }));
+    CHECK(cursor == 1);
+}
+
+TEST_CASE("broadcast ring tells a reader it's missed events") {
+    BroadcastRing<string> ring{4};
+    for (int i = 0; i != 6; ++i) {
+        ring.push(to_string(i));
+    }
+
+    bool ok;
+    uint64_t behind = 1;
+    CHECK(read_all(ring, behind, ok).empty());
+    CHECK(!ok);
+    CHECK(behind == 1);
+
+    uint64_t oldest = 2;
+    CHECK(read_all(ring, oldest, ok) == vector<string>{"3:2", "4:3", "5:4", "6:5"});
+    CHECK(ok);
+
+    uint64_t future = 7;
+    CHECK(read_all(ring, future, ok).empty());
+    CHECK(!ok);
+}
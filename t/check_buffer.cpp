@@ -0,0 +1,102 @@
+#include "../src/utility/buffer.h"
+#include "doctest.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+using namespace std;
+
+static int make_pipe(int (&fds)[2]) {
+    REQUIRE(pipe(fds) == 0);
+    return fds[0];
+}
+
+// A buffer reading what's said down a pipe
+struct Pipe {
+    int    fds[2];
+    Buffer buffer;
+
+    explicit Pipe(size_t size) : fds{-1, -1}, buffer{size, make_pipe(fds)} {}
+    ~Pipe() { close(fds[1]); }
+
+    void say(const char* text) {
+        REQUIRE(write(fds[1], text, strlen(text)) == ssize_t(strlen(text)));
+    }
+
+    // Every line to be had of what's been said, however many reads it takes
+    vector<string> lines() {
+        vector<string> found;
+        for (;;) {
+            if (auto line = buffer.getline(0)) {
+                found.emplace_back(*line);
+                continue;
+            }
+            int unread = 0;
+            REQUIRE(ioctl(fds[0], FIONREAD, &unread) == 0);
+            if (!unread) {
+                return found;
+            }
+        }
+    }
+};
+
+TEST_CASE("buffered lines come whole, however they're read") {
+    Pipe pipe{16};
+
+    pipe.say("uci");
+    CHECK(pipe.lines().empty());
+    pipe.say("ok\nready");
+    CHECK(pipe.lines() == vector<string>{"uciok"});
+    pipe.say("ok\n\nbestmove e2e4\n");
+    CHECK(pipe.lines() == vector<string>{"readyok", "", "bestmove e2e4"});
+}
+
+TEST_CASE("buffered lines round the end of the ring are put back together") {
+    Pipe pipe{16};
+
+    // Round and round, at a different place each time
+    for (auto i = 0; i < 20; ++i) {
+        pipe.say("info depth 1\n");
+        const auto lines = pipe.lines();
+        REQUIRE(lines.size() == 1);
+        CHECK(lines[0] == "info depth 1");
+    }
+}
+
+TEST_CASE("buffered lines come out as views of the ring unless they wrap") {
+    Pipe pipe{16};
+
+    pipe.say("abc\ndefghij\n");
+    const auto first = pipe.buffer.getline(0);
+    const auto second = pipe.buffer.getline(0);
+    REQUIRE(first);
+    REQUIRE(second);
+    CHECK(second->data() == first->data() + 4);
+}
+
+TEST_CASE("buffered lines longer than the ring are dropped") {
+    Pipe pipe{8};
+
+    pipe.say("short\n");
+    CHECK(pipe.lines() == vector<string>{"short"});
+
+    pipe.say("a line too long to fit");
+    CHECK(pipe.lines().empty());
+    pipe.say(" in the buffer at all\nnext\n");
+    CHECK(pipe.lines() == vector<string>{"next"});
+}
+
+TEST_CASE("buffers full of lines read no more until they're taken") {
+    Pipe pipe{8};
+
+    pipe.say("abc\ndefg\n");
+    CHECK(pipe.buffer.fill());
+    CHECK(pipe.buffer.fill());
+    CHECK(pipe.buffer.getline(0) == "abc");
+    CHECK(pipe.buffer.getline(0) == "defg");
+    CHECK(!pipe.buffer.getline(0));
+}
@@ -0,0 +1,112 @@
+#include "../src/utility/eventbus.h"
+#include "doctest.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+TEST_CASE("every event is delivered in order, on the subscriber's thread") {
+    Executor executor{"check"};
+    EventBus<int> bus;
+
+    vector<int> seen;
+    thread::id  on;
+    bus.subscribe(executor, [&](const int& event) {
+        seen.push_back(event);
+        on = this_thread::get_id();
+    });
+    CHECK(bus.subscribed());
+
+    for (auto i = 0; i < 100; ++i) {
+        bus.publish(i);
+    }
+    executor.drain();
+
+    REQUIRE(seen.size() == 100);
+    for (auto i = 0; i < 100; ++i) {
+        CHECK(seen[i] == i);
+    }
+    CHECK((on != this_thread::get_id()));
+}
+
+TEST_CASE("bursts come to the latest for subscribers wanting only that") {
+    Executor executor{"check"};
+    EventBus<int> bus;
+
+    // Held up on the first event while the rest come in
+    mutex              gate;
+    unique_lock<mutex> held(gate);
+    atomic<bool>       started{false};
+    vector<int>        seen;
+    bus.subscribe(executor, [&](const int& event) {
+        started = true;
+        lock_guard<mutex> lock(gate);
+        seen.push_back(event);
+    }, EventBus<int>::LATEST);
+
+    bus.publish(0);
+    while (!started) {
+        this_thread::yield();
+    }
+    for (auto i = 1; i <= 50; ++i) {
+        bus.publish(i);
+    }
+    held.unlock();
+    executor.drain();
+
+    CHECK(seen == vector<int>{0, 50});
+}
+
+TEST_CASE("a slow subscriber holds up neither the publisher nor others") {
+    Executor slow{"slow"};
+    Executor fast{"fast"};
+    EventBus<int> bus;
+
+    mutex              gate;
+    unique_lock<mutex> held(gate);
+    atomic<int>        slow_seen{0};
+    atomic<int>        fast_seen{0};
+    bus.subscribe(slow, [&](const int&) {
+        lock_guard<mutex> lock(gate);
+        ++slow_seen;
+    });
+    bus.subscribe(fast, [&](const int&) { ++fast_seen; });
+
+    for (auto i = 0; i < 10; ++i) {
+        bus.publish(i);
+    }
+    fast.drain();
+    CHECK(fast_seen == 10);
+    CHECK(slow_seen == 0);
+
+    held.unlock();
+    slow.drain();
+    CHECK(slow_seen == 10);
+}
+
+TEST_CASE("unsubscribed handlers aren't called again, even with events queued") {
+    Executor executor{"check"};
+    EventBus<int> bus;
+
+    mutex              gate;
+    unique_lock<mutex> held(gate);
+    atomic<int>        blocked{0};
+    atomic<int>        seen{0};
+    executor.post([&] { lock_guard<mutex> lock(gate); ++blocked; });
+
+    const auto id = bus.subscribe(executor, [&](const int&) { ++seen; });
+    bus.publish(1);
+    bus.publish(2);
+    bus.unsubscribe(id);
+    CHECK(!bus.subscribed());
+    bus.publish(3);
+
+    held.unlock();
+    executor.drain();
+    CHECK(blocked == 1);
+    CHECK(seen == 0);
+}
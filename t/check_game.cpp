@@ -107,6 +107,24 @@ TEST_CASE("read takeback") {
     CHECK(p->move_san(*takeback) == "e5");
 }
 
+TEST_CASE("read takeback of a capture, though a move might be on its way") {
+    // After dxe6, d5 filled again might be a move of Black's on its way
+    // there, but with everything else back as it was, it's the capture
+    // taken back
+    const auto fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+    Game g{"", fen};
+    const auto before = g.bitmap();
+    g.play_uci_move("d5e6");
+
+    MoveList candidates;
+    optional<Move> takeback;
+    const ActionList actions{{e6}, {SQUARE_INVALID, d5}, {SQUARE_INVALID, e6}};
+    CHECK(g.read_move(before, actions, candidates, takeback));
+    CHECK(candidates.empty());
+    REQUIRE(takeback.has_value());
+    CHECK(takeback->uci() == "d5e6");
+}
+
 TEST_CASE("read incomplete move") {
     Game g;
     MoveList candidates;
@@ -131,3 +149,290 @@ TEST_CASE("read out-of-turn move") {
     optional<Move> takeback;
     CHECK(!g.read_move(lift(START, e7), ActionList{}, candidates, takeback));
 }
+
+TEST_CASE("move footprint matches playing the move") {
+    const char* fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq a3 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    };
+    for (auto fen : fens) {
+        const Position before{fen};
+        for (auto move : before.legal_moves()) {
+            Position after{before};
+            after.PushMove(move);
+            const auto footprint = before.footprint(move);
+            CHECK(footprint.bitmap  == after.bitmap());
+            CHECK(footprint.changed == before.difference_bitmap(after));
+        }
+    }
+}
+
+TEST_CASE("read castling rook first") {
+    Game g;
+    for (auto san : {"e4", "e5", "Nf3", "Nc6", "Bc4", "Bc5"}) {
+        g.play_san_move(san);
+    }
+    const auto before = g.bitmap();
+
+    MoveList candidates;
+    optional<Move> takeback;
+
+    // Rook first reads as an ordinary rook move
+    CHECK(g.read_move(move(before, h1, f1), ActionList{}, candidates, takeback));
+    REQUIRE(candidates.size() == 1);
+    CHECK(candidates.at(0) == Move{h1, f1});
+    g.play_move(candidates.at(0));
+
+    // King half way there
+    CHECK(g.read_move(lift(move(before, h1, f1), e1), ActionList{}, candidates, takeback));
+    CHECK(candidates.empty());
+
+    // Then the king completes castling, replacing the rook move
+    CHECK(g.read_move(move(move(before, h1, f1), e1, g1), ActionList{}, candidates, takeback));
+    REQUIRE(candidates.size() == 1);
+    CHECK(candidates.at(0).special == SPECIAL_WK_CASTLING);
+    REQUIRE(takeback.has_value());
+    CHECK(*takeback == Move{h1, f1});
+}
+
+TEST_CASE("read en passant from the pawn taken beside it") {
+    struct {
+        const char* fen;
+        Square      from, to, taken;
+        int         special;
+    } const captures[] = {
+        {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", e5, f6, f5, SPECIAL_WEN_PASSANT},
+        {"rnbqkbnr/pppp1ppp/8/8/3Pp3/8/PPP1PPPP/RNBQKBNR b KQkq d3 0 3", e4, d3, d4, SPECIAL_BEN_PASSANT},
+    };
+    for (const auto& capture : captures) {
+        CAPTURE(capture.fen);
+        Game g{"", capture.fen};
+        const auto after = move(lift(g.bitmap(), capture.taken), capture.from, capture.to);
+
+        // Whichever pawn's lifted first
+        const ActionList capturing[] = {
+            {{capture.from}, {capture.taken}, {SQUARE_INVALID, capture.to}},
+            {{capture.taken}, {capture.from}, {SQUARE_INVALID, capture.to}},
+        };
+        for (const auto& actions : capturing) {
+            MoveList candidates;
+            optional<Move> takeback;
+            CHECK(g.read_move(after, actions, candidates, takeback));
+            REQUIRE(candidates.size() == 1);
+            CHECK(candidates.at(0).special == capture.special);
+            CHECK(!takeback.has_value());
+        }
+    }
+}
+
+TEST_CASE("move index") {
+    const Position p{"4k3/1P6/8/8/8/8/8/4K3 w - - 0 1"};
+    const auto promotions = p.moves_to(move(p.bitmap(), b7, b8));
+    REQUIRE(promotions.size() == 4);
+    CHECK(promotions.at(0).special == SPECIAL_PROMOTION_QUEEN);
+    CHECK(promotions.at(1).special == SPECIAL_PROMOTION_KNIGHT);
+
+    CHECK(p.incomplete(lift(p.bitmap(), b7)));
+    CHECK(p.incomplete(lift(p.bitmap(), e1)));
+    CHECK(!p.incomplete(lift(p.bitmap(), e8)));
+    CHECK(p.moves_to(lift(p.bitmap(), e8)).empty());
+    CHECK(p.move_index().size() == p.legal_moves().size());
+}
+
+TEST_CASE("bitmaps follow the position") {
+    Position p;
+    CHECK(p.bitmap() == START);
+
+    // Same occupancy, but a different piece on b8
+    const Position a{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"};
+    const Position b{"rbnqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"};
+    CHECK(a.bitmap() == b.bitmap());
+    CHECK(a.difference_bitmap(b) == ((1ULL << b8) | (1ULL << c8)));
+    CHECK(a.difference_bitmap(a) == 0);
+
+    const Move double_push{e2, e4, SPECIAL_WPAWN_2SQUARES};
+    p.PushMove(double_push);
+    CHECK(p.bitmap() == move(START, e2, e4));
+    p.PopMove(double_push);
+    CHECK(p.bitmap() == START);
+}
+
+TEST_CASE("generation changes with the game") {
+    Game g;
+    Game h;
+    CHECK(g.generation() != h.generation());
+
+    auto before = g.generation();
+    g.play_san_move("e4");
+    CHECK(g.generation() > before);
+
+    before = g.generation();
+    g.play_takeback();
+    CHECK(g.generation() > before);
+
+    before = g.generation();
+    g.tag("White", "Human");
+    CHECK(g.generation() > before);
+
+    // Not by reading it, or setting it as it is, so ETags still match
+    before = g.generation();
+    CHECK(g.tag("White") == "Human");
+    CHECK(g.tag("Annotator").empty());
+    g.tag("White", "Human");
+    CHECK(g.generation() == before);
+
+    before = g.generation();
+    g.fen("");
+    CHECK(g.generation() > before);
+
+    // A copy is the same until either changes
+    Game c{g};
+    CHECK(c.generation() == g.generation());
+    c.play_san_move("d4");
+    CHECK(c.generation() != g.generation());
+}
+
+TEST_CASE("identity lasts as long as the game") {
+    Game g;
+    Game h;
+    CHECK(g.identity() != h.identity());
+
+    const auto identity = g.identity();
+    g.play_san_move("e4");
+    g.play_takeback();
+    g.tag("White", "Human");
+    CHECK(g.identity() == identity);
+    CHECK(Game{g}.identity() == identity);
+
+    g.fen("");
+    CHECK(g.identity() != identity);
+}
+
+// Every change seen, by the generation it left the game at
+struct Changes : Observer<Game> {
+    vector<uint64_t> seen;
+    void on_changed(Game& game) override { seen.push_back(game.generation()); }
+};
+
+TEST_CASE("a replaced game's changes are seen as the old one's were") {
+    Changes changes;
+    unique_ptr<Game> game;
+    replace_game(game, make_unique<Game>(), changes);
+    REQUIRE(changes.seen.size() == 1);
+
+    game->play_san_move("e4");
+    REQUIRE(changes.seen.size() == 2);
+    CHECK(changes.seen.back() == game->generation());
+
+    // As a game's replaced by one loaded to carry on with
+    auto loaded = make_unique<Game>();
+    loaded->play_san_move("d4");
+    replace_game(game, std::move(loaded), changes);
+    REQUIRE(changes.seen.size() == 3);
+    CHECK(changes.seen.back() == game->generation());
+
+    game->play_san_move("d5");
+    REQUIRE(changes.seen.size() == 4);
+    CHECK(changes.seen.back() == game->generation());
+
+    // And none of the one it replaced
+    auto replaced = replace_game(game, make_unique<Game>(), changes);
+    REQUIRE(changes.seen.size() == 5);
+    replaced->play_san_move("Nf3");
+    CHECK(changes.seen.size() == 5);
+    game->play_san_move("e4");
+    CHECK(changes.seen.size() == 6);
+}
+
+TEST_CASE("uci position has the moves from the start") {
+    Game g;
+    CHECK(g.uci_position() == "startpos");
+
+    g.play_san_move("e4");
+    g.play_san_move("e5");
+    g.play_san_move("Nf3");
+    CHECK(g.uci_position() == "startpos moves e2e4 e7e5 g1f3");
+
+    // Only as far as the position on the board
+    g.play_takeback();
+    CHECK(g.uci_position() == "startpos moves e2e4 e7e5");
+
+    Game f{"", "8/P7/8/8/8/8/8/k6K w - - 0 1"};
+    f.play_uci_move("a7a8q");
+    CHECK(f.uci_position() == "fen 8/P7/8/8/8/8/8/k6K w - - 0 1 moves a7a8q");
+}
+
+TEST_CASE("log replays what was done to the game") {
+    Game g;
+    g.play_san_move("e4");
+    CHECK(g.log.empty());  // Not until it's valid
+
+    const auto saved_pgn = g.pgn();
+    const auto saved_fen = g.fen();
+    g.log_valid = true;
+
+    g.play_san_move("e5");
+    g.play_san_move("Nf3");
+    g.play_takeback();
+    g.play_san_move("Bc4");  // Nf3 stays, as a variation
+    // A rook taken for a move, then the king castling after all
+    g.play_san_move("Nf6");
+    g.play_san_move("Nf3");
+    g.play_san_move("Nc6");
+    const auto rook   = g.uci_move("h1g1");
+    const auto castle = g.san_move("O-O");
+    g.play_move(rook);
+    g.revise_move(rook, castle);
+    CHECK(g.log.size() == 11);
+
+    Game h{saved_pgn, saved_fen};
+    CHECK(h.replay(g.log));
+    CHECK(h.pgn() == g.pgn());
+    CHECK(h.fen() == g.fen());
+    CHECK(h.history.size() == g.history.size());
+
+    // Taking back further than the start doesn't apply
+    Game e;
+    CHECK_FALSE(e.replay({{0, 0}}));
+}
+
+TEST_CASE("snapshot restores the graph and where the game is") {
+    Game g;
+    g.tag("White", "Me");
+    for (auto san : {"Nf3", "Nf6", "Nc3"}) {
+        g.play_san_move(san);
+    }
+    // A variation transposing into the main line, then one left the game in
+    for (auto i = 0; i < 3; ++i) {
+        g.play_takeback();
+    }
+    for (auto san : {"Nc3", "Nf6", "Nf3", "e5"}) {
+        g.play_san_move(san);
+    }
+    g.play_takeback();
+    g.play_san_move("d5");
+    g.play_takeback();
+
+    const auto snapshot = g.snapshot();
+    Game h;
+    h.snapshot(snapshot);
+    CHECK(h.pgn() == g.pgn());
+    CHECK(h.fen() == g.fen());
+    CHECK(h.history.size() == g.history.size());
+    CHECK(h.tags == g.tags);
+    CHECK(h.snapshot() == snapshot);
+
+    // And plays on as the game would
+    g.play_san_move("c5");
+    h.play_san_move("c5");
+    CHECK(h.pgn() == g.pgn());
+
+    // Anything else isn't restored
+    Game e;
+    CHECK_THROWS_AS(e.snapshot(snapshot.substr(0, snapshot.size() - 1)), std::domain_error);
+    auto corrupt = snapshot;
+    corrupt[corrupt.size() - 1] ^= 1;
+    CHECK_THROWS_AS(e.snapshot(corrupt), std::domain_error);
+    CHECK_THROWS_AS(e.snapshot("RCMA"), std::domain_error);
+}
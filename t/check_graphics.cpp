@@ -0,0 +1,369 @@
+#include "../src/assets.h"
+#include "../src/graphics.h"
+#include "doctest.h"
+
+#include <cstdint>
+#include <random>
+
+using namespace std;
+
+static const Rotate rotations[] = {ROTATE_0, ROTATE_90, ROTATE_180, ROTATE_270};
+
+// Foreground and background, either way round
+static const PixelColor colors[][2] = {
+    {PIXEL_BLACK, PIXEL_WHITE},
+    {PIXEL_WHITE, PIXEL_BLACK},
+};
+
+// Whatever was there before, so spans are seen to leave their neighbours be
+static void scribble(Image& image, mt19937& random) {
+    for (auto& byte : image.data_) {
+        byte = static_cast<uint8_t>(random());
+    }
+}
+
+static Context context_for(Image& image, Rotate rotate, const PixelColor (&color)[2]) {
+    Context context;
+    context.image      = &image;
+    context.rotate     = rotate;
+    context.foreground = color[0];
+    context.background = color[1];
+    return context;
+}
+
+// A pixel at a time, rotated and clipped as setpixel() does, by a dot of
+// one, which lands up and left of where it's asked for
+static void reference_pixel(Context& context, int x, int y, PixelColor color) {
+    context.dot_style = DOT_FILL_AROUND;
+    context.dot_size  = 1;
+    context.drawpoint(x + 1, y + 1, color);
+}
+
+static void reference_fill(Context& context, int x0, int y0, int x1, int y1, PixelColor color) {
+    for (auto y = y0; y <= y1; ++y) {
+        for (auto x = x0; x <= x1; ++x) {
+            reference_pixel(context, x, y, color);
+        }
+    }
+}
+
+// As drawimage() did before it went a byte at a time
+static void reference_image(
+    Context& context, int x_to, int y_to, const Image& source, int x_from, int y_from, int w, int h)
+{
+    for (auto y = 0; y < h; ++y) {
+        for (auto x = 0; x < w; ++x) {
+            const auto x_src = x_from + x;
+            const auto y_src = y_from + y;
+            if (x_src < 0 || source.width <= x_src || y_src < 0 || source.height <= y_src) {
+                continue;
+            }
+            const auto byte = source.data_[y_src * source.width_bytes + x_src / 8];
+            const auto on   = byte & (0x80 >> x_src % 8);
+            reference_pixel(context, x_to + x, y_to + y, on ? context.background : context.foreground);
+        }
+    }
+}
+
+// Wide enough for several bytes, narrow enough to try every span, and
+// neither a whole number of bytes, so the last of a row is partly padding
+static constexpr int WIDTH  = 29;
+static constexpr int HEIGHT = 21;
+
+TEST_CASE("spans are erased a byte at a time as they were a pixel at a time") {
+    mt19937 random{1};
+    for (auto rotate : rotations) {
+        for (const auto& color : colors) {
+            // In logical coordinates, which the rotation may turn into columns
+            const auto across = rotate == ROTATE_0 || rotate == ROTATE_180 ? WIDTH : HEIGHT;
+            for (auto x0 = -3; x0 < across + 2; ++x0) {
+                for (auto x1 = x0; x1 < across + 3; ++x1) {
+                    CAPTURE(rotate);
+                    CAPTURE(color[0]);
+                    CAPTURE(x0);
+                    CAPTURE(x1);
+
+                    Image image{WIDTH, HEIGHT};
+                    scribble(image, random);
+                    Image expected = image;
+
+                    const auto y0 = static_cast<int>(random() % 5) - 1;
+                    const auto y1 = y0 + static_cast<int>(random() % 4);
+
+                    auto context = context_for(image, rotate, color);
+                    context.eraserect(x0, y0, x1, y1);
+
+                    auto reference = context_for(expected, rotate, color);
+                    reference_fill(reference, x0, y0, x1, y1, color[1]);
+                    REQUIRE(image == expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("solid rectangles are filled where their lines of dots would land") {
+    mt19937 random{2};
+    for (auto rotate : rotations) {
+        for (const auto& color : colors) {
+            for (auto line_width = 1; line_width <= 3; ++line_width) {
+                for (auto i = 0; i < 200; ++i) {
+                    const auto x0 = static_cast<int>(random() % (WIDTH + 4)) - 2;
+                    const auto x1 = x0 + static_cast<int>(random() % 12);
+                    const auto y0 = static_cast<int>(random() % (HEIGHT + 4)) - 2;
+                    const auto y1 = y0 + static_cast<int>(random() % 6);
+                    CAPTURE(rotate);
+                    CAPTURE(color[0]);
+                    CAPTURE(line_width);
+                    CAPTURE(x0);
+                    CAPTURE(x1);
+                    CAPTURE(y0);
+                    CAPTURE(y1);
+
+                    Image image{WIDTH, HEIGHT};
+                    scribble(image, random);
+                    Image expected = image;
+
+                    auto context = context_for(image, rotate, color);
+                    context.line_width = line_width;
+                    context.fillrect(x0, y0, x1, y1);
+
+                    // Horizontal lines, a dot of line_width at every pixel
+                    auto reference = context_for(expected, rotate, color);
+                    reference.dot_style = DOT_FILL_AROUND;
+                    reference.dot_size  = line_width;
+                    for (auto y = y0; y <= y1; ++y) {
+                        for (auto x = x0; x <= x1; ++x) {
+                            reference.drawpoint(x, y, color[0]);
+                        }
+                    }
+                    REQUIRE(image == expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("images are blitted a byte at a time as they were a pixel at a time") {
+    mt19937 random{3};
+
+    Image source{19, 11};
+    scribble(source, random);
+
+    for (auto rotate : rotations) {
+        for (const auto& color : colors) {
+            for (auto i = 0; i < 1000; ++i) {
+                // From anywhere in the source, or hanging off it, to anywhere,
+                // or hanging off the edge: one pixel wide, within a byte,
+                // across several, and up to the right edge of a row
+                const auto x_from = static_cast<int>(random() % (source.width + 4)) - 2;
+                const auto y_from = static_cast<int>(random() % (source.height + 2)) - 1;
+                const auto w      = 1 + static_cast<int>(random() % 16);
+                const auto h      = 1 + static_cast<int>(random() % 4);
+                const auto x_to   = i % 8 == 0
+                    ? WIDTH - w  // Flush with the right edge, before rotation
+                    : static_cast<int>(random() % (WIDTH + 4)) - 3;
+                const auto y_to   = static_cast<int>(random() % (HEIGHT + 2)) - 2;
+                CAPTURE(rotate);
+                CAPTURE(color[0]);
+                CAPTURE(x_from);
+                CAPTURE(y_from);
+                CAPTURE(w);
+                CAPTURE(h);
+                CAPTURE(x_to);
+                CAPTURE(y_to);
+
+                Image image{WIDTH, HEIGHT};
+                scribble(image, random);
+                Image expected = image;
+
+                auto context = context_for(image, rotate, color);
+                context.drawimage(x_to, y_to, source, x_from, y_from, w, h);
+
+                auto reference = context_for(expected, rotate, color);
+                reference_image(reference, x_to, y_to, source, x_from, y_from, w, h);
+                REQUIRE(image == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("tiles are drawn from the atlas as their sprites would be") {
+    const auto pieces = load_bitmap("pieces.bmp");
+    REQUIRE(pieces);
+
+    // Where the screen's squares are, their left edge on a byte once
+    // rotated, and where they aren't, or are partly off the screen
+    static const int at[][2] = {{0, 0}, {16, 32}, {112, 112}, {48, 280}, {3, 5}, {-4, 7}, {120, 290}};
+
+    mt19937 random{4};
+    for (auto rotate : rotations) {
+        for (const auto& color : colors) {
+            const TileAtlas atlas{*pieces, rotate, color[0], color[1]};
+            const auto      columns = pieces->width / TileAtlas::TILE_SIZE;
+            REQUIRE(atlas.size() == columns * (pieces->height / TileAtlas::TILE_SIZE));
+
+            // Every piece, on either color of square
+            for (auto tile = 0; tile < atlas.size(); ++tile) {
+                for (const auto& xy : at) {
+                    CAPTURE(rotate);
+                    CAPTURE(color[0]);
+                    CAPTURE(tile);
+                    CAPTURE(xy[0]);
+                    CAPTURE(xy[1]);
+
+                    // As the screen has it, see epd2in9d.h
+                    Image image{128, 296};
+                    scribble(image, random);
+                    Image expected = image;
+
+                    auto context = context_for(image, rotate, color);
+                    context.drawtile(xy[0], xy[1], atlas, tile);
+
+                    const auto size = TileAtlas::TILE_SIZE;
+                    auto reference  = context_for(expected, rotate, color);
+                    reference.drawimage(xy[0], xy[1], *pieces, tile % columns * size, tile / columns * size, size, size);
+                    REQUIRE(image == expected);
+                }
+            }
+        }
+    }
+}
+
+// Packed at compile time: a font of one row ten columns wide, the first
+// glyph blank, the second with ink only in its last column, in its second
+// byte, and the rest blank too
+static constexpr unsigned char tiny_table[FONT_GLYPHS * 2] = {0x00, 0x00, 0x00, 0x40};
+static constexpr FontAtlas<10, 1> tiny{tiny_table};
+static_assert(tiny.rows[0] == 0, "");
+static_assert(tiny.glyphs[0].width == 0 && tiny.glyphs[0].advance == 10, "");
+static_assert(tiny.rows[1] == 0x00400000, "");
+static_assert(tiny.glyphs[1].left == 9 && tiny.glyphs[1].width == 1, "");
+
+static const sFONT* const fonts[] = {&Font12, &Font16, &Font20, &Font24};
+
+// Pixel c of glyph g's row r, as the table has it
+static bool table_pixel(const sFONT& font, int g, int r, int c) {
+    const auto row_bytes = (font.Width + 7) / 8;
+    return font.table[(g * font.Height + r) * row_bytes + c / 8] & (0x80 >> c % 8);
+}
+
+TEST_CASE("fonts are packed a word per row as their tables have them") {
+    for (const auto font : fonts) {
+        CAPTURE(font->Width);
+        for (auto g = 0; g < FONT_GLYPHS; ++g) {
+            CAPTURE(g);
+            auto left  = font->Width;
+            auto right = -1;
+            for (auto r = 0; r < font->Height; ++r) {
+                const auto bits = font->rows[g * font->Height + r];
+                for (auto c = 0; c < 32; ++c) {
+                    const auto on = (bits & (0x80000000u >> c)) != 0;
+                    REQUIRE(on == (c < font->Width && table_pixel(*font, g, r, c)));
+                    if (on) {
+                        left  = min(left, c);
+                        right = max(right, c);
+                    }
+                }
+            }
+
+            const auto& glyph = font->glyphs[g];
+            REQUIRE(glyph.advance == font->Width);
+            if (right < 0) {
+                // Nothing but advance, as a space
+                REQUIRE(glyph.width == 0);
+            }
+            else {
+                REQUIRE(glyph.left == left);
+                REQUIRE(glyph.width == right - left + 1);
+            }
+        }
+    }
+}
+
+// A glyph as an image, ink clear, as drawimage() draws a clear bit in the
+// foreground
+static Image glyph_image(const sFONT& font, char c) {
+    Image glyph{font.Width, font.Height};
+    for (auto r = 0; r < font.Height; ++r) {
+        for (auto x = 0; x < font.Width; ++x) {
+            if (!table_pixel(font, c - FONT_FIRST, r, x)) {
+                glyph.data_[r * glyph.width_bytes + x / 8] |= 0x80 >> x % 8;
+            }
+        }
+    }
+    return glyph;
+}
+
+// As drawstring() did before it went a row of glyphs at a time: wrapped
+// and clipped alike, but a glyph at a time
+static void reference_string(Context& context, int left, int top, const char* s) {
+    const auto& font = *context.font;
+    auto x = left;
+    auto y = top;
+    while (*s) {
+        if (x + font.Width > context.image->width) {
+            x = left;
+            y += font.Height;
+        }
+        if (y + font.Height > context.image->height) {
+            x = left;
+            y = top;
+        }
+        context.drawimage(x, y, glyph_image(font, *s++), 0, 0, font.Width, font.Height);
+        x += font.Width;
+    }
+}
+
+TEST_CASE("strings are drawn from the font atlas as they were a glyph at a time") {
+    // Not a whole number of bytes either way, nor of glyphs of any font, and
+    // too short for a line of the largest once rotated
+    static constexpr int width  = 61;
+    static constexpr int height = 43;
+
+    mt19937 random{5};
+    for (const auto font : fonts) {
+        for (auto rotate : rotations) {
+            for (const auto& color : colors) {
+                const auto across = rotate == ROTATE_0 || rotate == ROTATE_180 ? width : height;
+                const auto down   = rotate == ROTATE_0 || rotate == ROTATE_180 ? height : width;
+                for (auto i = 0; i < 64; ++i) {
+                    // Every start within a byte, so glyphs straddle them, and
+                    // now and then hanging off an edge, or wholly past it
+                    auto left = i % 8;
+                    auto top  = static_cast<int>(random() % 5);
+                    switch (i / 8 % 4) {
+                    case 1: left -= font->Width / 2; break;
+                    case 2: left += across - font->Width - 8; break;
+                    case 3: top  += down - font->Height - 2; break;
+                    }
+
+                    // One glyph, a few, or more than there's room for
+                    string s(1 + random() % (i % 3 == 0 ? 2 : 24), ' ');
+                    for (auto& c : s) {
+                        c = static_cast<char>(FONT_FIRST + random() % FONT_GLYPHS);
+                    }
+                    CAPTURE(font->Width);
+                    CAPTURE(rotate);
+                    CAPTURE(color[0]);
+                    CAPTURE(left);
+                    CAPTURE(top);
+                    CAPTURE(s);
+
+                    Image image{width, height};
+                    scribble(image, random);
+                    Image expected = image;
+
+                    auto context = context_for(image, rotate, color);
+                    context.font = font;
+                    context.drawstring(left, top, s.c_str());
+
+                    auto reference = context_for(expected, rotate, color);
+                    reference.font = font;
+                    reference_string(reference, left, top, s.c_str());
+                    REQUIRE(image == expected);
+                }
+            }
+        }
+    }
+}
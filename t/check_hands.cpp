@@ -0,0 +1,83 @@
+#include "../src/chess/chess_hands.h"
+#include "doctest.h"
+
+#include <string>
+
+using namespace std;
+using namespace thc;
+
+static const char* const positions[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+    "rnbqkbnr/pppp1ppp/8/8/3Pp3/8/PPP1PPPP/RNBQKBNR b KQkq d3 0 3",
+};
+
+static const unsigned handlings[] = {
+    hands::TIDY,
+    hands::CAPTURED_FIRST,
+    hands::ROOK_FIRST,
+    hands::NUDGE,
+    hands::CAPTURED_FIRST | hands::NUDGE,
+};
+
+TEST_CASE("moves are read as played, however their pieces are handled") {
+    for (auto fen : positions) {
+        for (auto handling : handlings) {
+            for (auto move : Game{"", fen}.legal_moves()) {
+                // A promotion reads as a queen, whatever's put down
+                if (move.is_promotion() && move.special != SPECIAL_PROMOTION_QUEEN) {
+                    continue;
+                }
+                CAPTURE(string(fen));
+                CAPTURE(handling);
+                CAPTURE(move.uci());
+
+                hands::Reader reader{fen};
+                const auto handled = hands::move(move, handling);
+                reader.read(handled);
+
+                Game expected{"", fen};
+                expected.play_move(move);
+                CHECK(reader.game.fen() == expected.fen());
+                CHECK(reader.boardstate == expected.bitmap());
+                CHECK(reader.actions.empty());
+            }
+        }
+    }
+}
+
+TEST_CASE("takebacks are read as such") {
+    auto taken = 0;
+    for (auto fen : positions) {
+        for (auto move : Game{"", fen}.legal_moves()) {
+            CAPTURE(string(fen));
+            CAPTURE(move.uci());
+
+            const auto castling   = SPECIAL_WK_CASTLING <= move.special && move.special <= SPECIAL_BQ_CASTLING;
+            const auto en_passant = move.special == SPECIAL_WEN_PASSANT || move.special == SPECIAL_BEN_PASSANT;
+            ActionList actions;
+            REQUIRE(hands::takeback(move, actions) == !(castling || en_passant || move.is_promotion()));
+            if (actions.empty()) {
+                continue;
+            }
+
+            hands::Reader reader{fen};
+            reader.read(hands::move(move));
+            reader.read(actions);
+            CHECK(reader.game.fen() == Game{"", fen}.fen());
+            CHECK(reader.boardstate == reader.game.bitmap());
+            ++taken;
+        }
+    }
+    CHECK(taken > 100);
+}
+
+TEST_CASE("en passant lifts the pawn beside") {
+    const auto handled = hands::move(Move{e5, f6, SPECIAL_WEN_PASSANT, 'p'});
+    REQUIRE(handled.size() == 3);
+    CHECK(handled[1].lift == f5);
+    CHECK(handled[2].place == f6);
+}
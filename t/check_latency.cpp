@@ -0,0 +1,60 @@
+#include "../src/utility/latency.h"
+#include "doctest.h"
+
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace std::chrono;
+
+TEST_CASE("latency histogram") {
+    static LatencyHistogram histogram{"check"};
+    histogram.clear();
+    CHECK(histogram.count() == 0);
+    CHECK(histogram.percentile(0.5) == 0);
+
+    for (auto i = 0; i < 90; ++i) {
+        histogram.record(microseconds{3});      // 2..4 us
+    }
+    for (auto i = 0; i < 10; ++i) {
+        histogram.record(milliseconds{10});     // 8192..16384 us
+    }
+    histogram.record(nanoseconds{-5});          // Clock went backwards
+
+    CHECK(histogram.count() == 101);
+    CHECK(histogram.percentile(0.5) == 4);
+    CHECK(histogram.percentile(0.95) == 10000);  // Capped at the longest
+    CHECK(histogram.max_us() == 10000);
+    CHECK(histogram.mean_us() == (90 * 3 + 10 * 10000) / 101);
+
+    // Far beyond the last bucket
+    histogram.record(hours{24});
+    CHECK(histogram.percentile(1.0) == histogram.max_us());
+}
+
+TEST_CASE("latency reports") {
+    static LatencyHistogram histogram{"check_report"};
+    static LatencyHistogram unused{"check_unused"};
+    histogram.clear();
+    {
+        LatencyTimer timer{histogram};
+    }
+    CHECK(histogram.count() == 1);
+
+    ostringstream out;
+    LatencyHistogram::report(out);
+    CHECK(out.str().find("check_report") != string::npos);
+    CHECK(out.str().find("check_unused") == string::npos);
+
+    const auto json = LatencyHistogram::json();
+    CHECK(json.front() == '{');
+    CHECK(json.back() == '}');
+    CHECK(json.find("\"check_report\": {\"count\": 1, ") != string::npos);
+    CHECK(json.find("check_unused") == string::npos);
+}
+
+TEST_CASE("latency origin") {
+    const auto now = LatencyHistogram::Clock::now();
+    latency_origin(now);
+    CHECK(latency_origin() == now);
+}
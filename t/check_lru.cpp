@@ -0,0 +1,37 @@
+#include "../src/utility/lru.h"
+#include "doctest.h"
+
+#include <string>
+
+using namespace std;
+
+TEST_CASE("lru forgets the least recently used") {
+    LRU<int, string> cache{2};
+    CHECK(cache.capacity() == 2);
+    CHECK(!cache.find(1));
+
+    cache.put(1, "one");
+    cache.put(2, "two");
+    CHECK(cache.size() == 2);
+
+    // Finding 1 makes 2 the least recent
+    REQUIRE(cache.find(1));
+    CHECK(*cache.find(1) == "one");
+    cache.put(3, "three");
+    CHECK(cache.size() == 2);
+    CHECK(!cache.find(2));
+    CHECK(*cache.find(1) == "one");
+    CHECK(*cache.find(3) == "three");
+
+    // Replacing a value makes it the most recent, without growing
+    cache.put(1, "uno");
+    cache.put(4, "four");
+    CHECK(cache.size() == 2);
+    CHECK(!cache.find(3));
+    CHECK(*cache.find(1) == "uno");
+    CHECK(*cache.find(4) == "four");
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+    CHECK(!cache.find(1));
+}
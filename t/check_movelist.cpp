@@ -0,0 +1,37 @@
+#include "../src/thc/MoveList.h"
+#include "doctest.h"
+
+#include <stdexcept>
+
+using namespace std;
+using namespace thc;
+
+TEST_CASE("move list") {
+    MoveList moves;
+    CHECK(moves.empty());
+    CHECK(moves.capacity() == 256);
+
+    moves.push_back({e2, e4});
+    moves.push_back({g1, f3});
+    CHECK(moves.size() == 2);
+    CHECK(moves.front() == Move{e2, e4});
+    CHECK(moves.back()  == Move{g1, f3});
+    CHECK(moves.at(1)   == Move{g1, f3});
+    CHECK_THROWS_AS(moves.at(2), out_of_range);
+
+    const MoveList copy{moves};
+    CHECK(copy == moves);
+    CHECK(copy == MoveList{{e2, e4}, {g1, f3}});
+    CHECK(copy != MoveList{{e2, e4}});
+
+    moves.pop_back();
+    CHECK(moves.size() == 1);
+    moves.clear();
+    CHECK(moves.empty());
+    CHECK(moves.begin() == moves.end());
+
+    for (auto i = 0u; i < moves.capacity(); ++i) {
+        moves.push_back({a2, a3});
+    }
+    CHECK_THROWS_AS(moves.push_back({a2, a3}), length_error);
+}
@@ -0,0 +1,102 @@
+#include "../src/replay/boardserial.h"
+#include "../src/utility/packetlog.h"
+#include "doctest.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+static vector<uint8_t> fields(vector<uint8_t> events) {
+    vector<uint8_t> packet{133, 0, uint8_t(6 + events.size()), 0x12, 0x34};
+    packet.insert(packet.end(), events.begin(), events.end());
+    packet.push_back(0);
+    return packet;
+}
+
+// Pieces on the first n fields
+static vector<uint8_t> boardstate(int n) {
+    vector<uint8_t> packet{240, 1, 7, 0x12, 0x34, 0};
+    for (auto i = 0; i < 64; ++i) {
+        packet.push_back(i < n ? 3 : 0);
+        packet.push_back(0);
+    }
+    packet.push_back(0);
+    return packet;
+}
+
+struct Log {
+    char path[32] = "/tmp/check_packetlogXXXXXX";
+
+    Log() { close(mkstemp(path)); }
+    ~Log() { unlink(path); }
+};
+
+TEST_CASE("packets read back as recorded") {
+    Log log;
+    {
+        PacketRecorder recorder{log.path};
+        const uint8_t request[4] = {131, 0x12, 0x34, 0};
+        recorder.record(packetlog::TO_BOARD, request, sizeof request);
+        const auto reply = fields({64, 12});
+        recorder.record(packetlog::FROM_BOARD, reply.data(), reply.size());
+    }
+
+    const auto packets = read_packets(log.path);
+    REQUIRE(packets.size() == 2);
+    CHECK(packets[0].direction == packetlog::TO_BOARD);
+    CHECK(packets[0].data == vector<uint8_t>{131, 0x12, 0x34, 0});
+    CHECK(packets[1].direction == packetlog::FROM_BOARD);
+    CHECK(packets[1].data == fields({64, 12}));
+    CHECK(packets[0].at <= packets[1].at);
+
+    // Cut short, as by a crash, it's good up to the last whole packet
+    REQUIRE(truncate(log.path, 8 + 7 + 4 + 7 + 3) == 0);
+    CHECK(read_packets(log.path).size() == 1);
+
+    // Not a log at all
+    FILE* file = fopen(log.path, "wb");
+    fputs("not a log", file);
+    fclose(file);
+    CHECK_THROWS_AS(read_packets(log.path), domain_error);
+    unlink(log.path);
+    CHECK_THROWS_AS(read_packets(log.path), runtime_error);
+}
+
+TEST_CASE("replay flat out") {
+    Log log;
+    {
+        PacketRecorder recorder{log.path};
+        const auto record = [&](const vector<uint8_t>& packet) {
+            recorder.record(packetlog::FROM_BOARD, packet.data(), packet.size());
+        };
+        record(boardstate(16));
+        record(fields({}));
+        record(fields({64, 12, 65, 28}));
+        record(boardstate(17));
+        record(fields({}));
+        record(fields({64, 13}));
+    }
+
+    BoardSerial board{log.path, 0};
+    CHECK(board.boardstate() == 0xffff);
+
+    // Each read gets the next events, with the boardstate read after them
+    uint8_t buf[256];
+    REQUIRE(board.readdata(buf, sizeof buf) == 10);
+    CHECK(buf[5] == 64);
+    CHECK(buf[6] == 12);
+    CHECK(buf[7] == 65);
+    CHECK(buf[8] == 28);
+    CHECK(board.boardstate() == 0x1ffff);
+
+    REQUIRE(board.readdata(buf, sizeof buf) == 8);
+    CHECK(buf[5] == 64);
+    CHECK(buf[6] == 13);
+
+    // Then the board goes quiet
+    CHECK(board.readdata(buf, sizeof buf) == 6);
+    CHECK(board.boardstate() == 0x1ffff);
+}
@@ -55,3 +55,98 @@ TEST_CASE("Steinitz") {
     g2.pgn(g1.pgn());
     CHECK(short_pgn(g2) == "1. e4 e5 2. Nf3 Nc6 3. Bb5 d6 4. d4");
 }
+
+TEST_CASE("move text is kept with the moves played") {
+    Game g;
+    play_san_moves(g, "e4", "e5", "Nf3", "Nc6", "Bb5", "Nf6", "O-O", nullptr);
+
+    auto before = g.start();
+    auto& first = before->moves_played.front();
+    CHECK(first.san == "e4");
+    CHECK(first.uci == "e2e4");
+
+    auto position = first.second;
+    while (!position->moves_played.empty()) {
+        before = position;
+        position = position->moves_played.front().second;
+    }
+    CHECK(before->moves_played.front().san == "O-O");
+    CHECK(before->moves_played.front().uci == "e1g1");
+}
+
+TEST_CASE("transpositions share positions") {
+    Game g;
+    play_san_moves(g, "d4", "Nf6", "c4", nullptr);
+    const auto mainline = g.current();
+    g.play_takeback(); g.play_takeback(); g.play_takeback();
+    play_san_moves(g, "c4", "Nf6", "d4", "e6", nullptr);
+    CHECK(g.previous() == mainline);
+    CHECK(mainline->moves_played.size() == 1);
+    CHECK(short_pgn(g) == "1. d4 (1. c4 Nf6 2. d4 e6) 1... Nf6 2. c4 e6");
+
+    Game copy;
+    copy.pgn(g.pgn());
+    CHECK(short_pgn(copy) == short_pgn(g));
+
+    // But only when the same positions could still be repeated
+    Game h;
+    play_san_moves(h, "e4", "e5", "Nf3", "Nc6", "Ng1", "Nb8", nullptr);
+    const auto repeated = h.current();
+    for (auto i = 0; i < 4; ++i) {
+        h.play_takeback();
+    }
+    play_san_moves(h, "Nc3", "Nc6", "Nb1", "Nb8", nullptr);
+    CHECK(h.current() != repeated);
+    CHECK(*h.current() == *repeated);
+}
+
+TEST_CASE("recover position from FEN") {
+    Game g1;
+    play_san_moves(g1, "e4", "e5", "Nf3", "Nc6", "Bb5", "a6", nullptr);
+    g1.play_takeback(); g1.play_takeback();
+    play_san_moves(g1, "Bc4", "Bc5", nullptr);
+    const auto fen = g1.fen();
+    play_san_moves(g1, "c3", nullptr);
+
+    Game g2{g1.pgn(), fen};
+    CHECK(g2.fen() == fen);
+    CHECK(g2.history.size() == 7);
+    CHECK(g2.history.front() == g2.start());
+    CHECK(g2.previous()->find_move_played(g2.current()).has_value());
+
+    CHECK_THROWS_AS(Game(g1.pgn(), "4k3/8/8/8/8/8/8/4K3 w - - 0 1"), domain_error);
+}
+
+TEST_CASE("restoring PGN keeps its date") {
+    Game g;
+    g.pgn("[Date \"1858.10.21\"]\n\n1. e4 e5");
+    CHECK(g.tags["Date"] == "1858.10.21");
+}
+
+TEST_CASE("movetext cache follows the graph") {
+    Game g;
+    const auto reloaded = [&g]() {
+        Game copy;
+        copy.pgn(g.pgn());
+        return copy.pgn();
+    };
+
+    // Appending to the main line patches the cached movetext
+    play_san_moves(g, "e4", "e5", "Nf3", "Nc6", "Bb5", nullptr);
+    CHECK(short_pgn(g) == "1. e4 e5 2. Nf3 Nc6 3. Bb5");
+
+    // Which a variation or a transposition can't do
+    g.play_takeback(); g.play_takeback();
+    play_san_moves(g, "Bc5", "Bc4", "Nc6", nullptr);
+    CHECK(short_pgn(g) == "1. e4 e5 2. Nf3 Nc6 (2... Bc5 3. Bc4 Nc6) 3. Bb5");
+    CHECK(g.pgn() == reloaded());
+
+    g.play_takeback(); g.play_takeback(); g.play_takeback(); g.play_takeback();
+    play_san_moves(g, "Bc4", "Nc6", "Nf3", "Bc5", nullptr);
+
+    // A copy shares the graph, so its moves show up here too
+    Game copy{g};
+    play_san_moves(copy, "c3", nullptr);
+    CHECK(g.pgn() == copy.pgn());
+    CHECK(g.pgn() == reloaded());
+}
@@ -0,0 +1,121 @@
+#include "../src/chess/chess_game.h"
+#include "doctest.h"
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+using namespace std;
+
+static const char* collection =
+    "[Event \"First\"]\n"
+    "[White \"A \\\"Quoted\\\" Name\"]\n"
+    "\n"
+    "1. e4 {best by test} e5 2. Nf3 $1 Nc6 (2... d6 3. d4) 3. Bb5! a6 1-0\n"
+    "\n"
+    "[Event \"Second\"]\n"
+    "\n"
+    "1. d4 d5 ; 1-0 in a comment\n"
+    "2. c4 *\n"
+    "\n"
+    "[Event \"Third\"]\n"
+    "[Result \"1/2-1/2\"]\n"
+    "\n"
+    "1. f3 e6 2. g4 Qh4#\n"
+    "\n"
+    "[Event \"Fourth\"]\n"
+    "\n"
+    "1/2-1/2\n";
+
+static string short_pgn(const Game& game) {
+    const auto pgn = game.pgn();
+    const auto begin = pgn.find("\n\n");
+    return begin == string::npos ? pgn : pgn.substr(begin + 2);
+}
+
+static void check_collection(PgnReader& reader) {
+    PgnGame pgn;
+    Game    game;
+
+    REQUIRE(reader.next(pgn));
+    REQUIRE(pgn.tags.size() == 2);
+    CHECK(pgn.tags[0].first == "Event");
+    CHECK(pgn.tags[0].second == "First");
+    CHECK(pgn.tags[1].second == "A \\\"Quoted\\\" Name");
+    game.pgn(pgn);
+    CHECK(game.tags["White"] == "A \"Quoted\" Name");
+    CHECK(short_pgn(game) == "1. e4 e5 2. Nf3 Nc6 (2... d6 3. d4) 3. Bb5 a6");
+
+    REQUIRE(reader.next(pgn));
+    CHECK(pgn.tags.size() == 1);
+    CHECK(pgn.movetext == "1. d4 d5 ; 1-0 in a comment\n2. c4 *");
+    game.pgn(pgn);
+    CHECK(short_pgn(game) == "1. d4 d5 2. c4");
+
+    REQUIRE(reader.next(pgn));
+    game.pgn(pgn);
+    CHECK(game.tags["Result"] == "1/2-1/2");
+    CHECK(short_pgn(game) == "1. f3 e6 2. g4 Qh4#");
+
+    REQUIRE(reader.next(pgn));
+    CHECK(pgn.movetext == "1/2-1/2");
+    game.pgn(pgn);
+    CHECK(short_pgn(game) == "");
+
+    CHECK(!reader.next(pgn));
+    CHECK(!reader.next(pgn));
+    CHECK(reader.count() == 4);
+}
+
+TEST_CASE("read games from memory") {
+    PgnReader reader{string_view{collection}};
+    check_collection(reader);
+}
+
+TEST_CASE("read games from a stream through a small buffer") {
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    const string text{collection};
+    REQUIRE(write(fds[1], text.data(), text.size()) == ssize_t(text.size()));
+    close(fds[1]);
+
+    // Smaller than any one game, so the buffer has to grow
+    PgnReader reader{fds[0], 16};
+    check_collection(reader);
+}
+
+TEST_CASE("read games from a mapped file") {
+    char path[] = "/tmp/check_pgnreaderXXXXXX";
+    const auto fd = mkstemp(path);
+    REQUIRE(fd >= 0);
+    const string text{collection};
+    REQUIRE(write(fd, text.data(), text.size()) == ssize_t(text.size()));
+    close(fd);
+
+    auto reader = PgnReader::open(path);
+    check_collection(*reader);
+    unlink(path);
+
+    CHECK_THROWS_AS(PgnReader::open(path), runtime_error);
+}
+
+TEST_CASE("games without a result are split at the next tags") {
+    PgnReader reader{string_view{"[Event \"A\"]\n1. e4\n[Event \"B\"]\n1. d4\n"}};
+    PgnGame pgn;
+    REQUIRE(reader.next(pgn));
+    CHECK(pgn.movetext == "1. e4\n");
+    REQUIRE(reader.next(pgn));
+    CHECK(pgn.movetext == "1. d4\n");
+    CHECK(!reader.next(pgn));
+}
+
+TEST_CASE("invalid PGN") {
+    PgnGame pgn;
+    PgnReader bad_tag{string_view{"[Event First]\n1. e4 *"}};
+    CHECK_THROWS_AS(bad_tag.next(pgn), domain_error);
+
+    Game game;
+    CHECK_THROWS_AS(game.pgn("1. e4 {unterminated"), domain_error);
+    CHECK_THROWS_AS(game.pgn("1. e4 e4"), domain_error);
+    CHECK_THROWS_AS(game.pgn("1. e4 )"), domain_error);
+}
@@ -0,0 +1,59 @@
+#include "../src/chess/chess_position.h"
+#include "../src/utility/pool.h"
+#include "doctest.h"
+
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+TEST_CASE("pool recycles blocks by size") {
+    Pool pool;
+    auto a = pool.allocate(40);
+    auto b = pool.allocate(48);
+    CHECK(a != b);
+    CHECK(pool.reserved() == Pool::CHUNK_SIZE);
+
+    pool.deallocate(a, 40);
+    CHECK(pool.allocate(33) == a);  // Same 48 byte bin
+    CHECK(pool.allocate(40) != a);
+
+    // Too big to pool
+    auto big = pool.allocate(Pool::MAX_SIZE + 1);
+    pool.deallocate(big, Pool::MAX_SIZE + 1);
+    CHECK(pool.reserved() == Pool::CHUNK_SIZE);
+}
+
+TEST_CASE("pool outlives its allocations") {
+    weak_ptr<Pool> weak;
+    shared_ptr<int> value;
+    {
+        auto pool = make_shared<Pool>();
+        weak  = pool;
+        value = allocate_shared<int>(PoolAllocator<int>{pool}, 42);
+
+        vector<int, PoolAllocator<int>> numbers{PoolAllocator<int>{pool}};
+        for (auto i = 0; i < 1000; ++i) {
+            numbers.push_back(i);
+        }
+    }
+    CHECK(!weak.expired());
+    CHECK(*value == 42);
+    value.reset();
+    CHECK(weak.expired());
+}
+
+TEST_CASE("positions played come from the same pool") {
+    Position p;
+    const auto e4 = p.san_move("e4");
+
+    auto pool  = make_shared<Pool>();
+    auto start = make_position({}, pool);
+    auto after = start->play_move(e4);
+    CHECK(after->moves_played.get_allocator().pool.get() == pool.get());
+    CHECK(start->moves_played.size() == 1);
+    CHECK(after->moves_played.empty());
+
+    // Without a pool it's business as usual
+    CHECK(!p.play_move(e4)->moves_played.get_allocator().pool);
+}
@@ -0,0 +1,76 @@
+#include "../src/utility/reactor.h"
+#include "doctest.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+using namespace std;
+
+TEST_CASE("reactors call the handlers of whatever's ready") {
+    Reactor reactor;
+    const auto a = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    const auto b = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    REQUIRE(a >= 0);
+    REQUIRE(b >= 0);
+
+    auto woken_a = 0, woken_b = 0;
+    CHECK(reactor.watch(a, [&] {
+        uint64_t count;
+        REQUIRE(read(a, &count, sizeof count) == sizeof count);
+        ++woken_a;
+    }));
+    CHECK(reactor.watch(b, [&] { ++woken_b; }));
+
+    const uint64_t one = 1;
+    REQUIRE(write(a, &one, sizeof one) == sizeof one);
+    CHECK(reactor.wait() == 1);
+    CHECK(woken_a == 1);
+    CHECK(woken_b == 0);
+
+    // Read, so it's no longer ready
+    CHECK(reactor.wait(Reactor::Clock::now()) == 0);
+    CHECK(woken_a == 1);
+
+    // Unread, so it's ready again and again
+    REQUIRE(write(b, &one, sizeof one) == sizeof one);
+    CHECK(reactor.wait() == 1);
+    CHECK(reactor.wait() == 1);
+    CHECK(woken_b == 2);
+
+    reactor.unwatch(b);
+    CHECK(reactor.wait(Reactor::Clock::now()) == 0);
+    CHECK(woken_b == 2);
+
+    close(a);
+    close(b);
+}
+
+TEST_CASE("reactors wait no later than the deadline") {
+    Reactor reactor;
+    const auto fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    REQUIRE(fd >= 0);
+    CHECK(reactor.watch(fd, [] {}));
+
+    const auto start = Reactor::Clock::now();
+    CHECK(reactor.wait(start + chrono::milliseconds(20)) == 0);
+    const auto waited = Reactor::Clock::now() - start;
+    CHECK(waited >= chrono::milliseconds(20));
+    CHECK(waited < chrono::seconds(1));
+
+    // Long past, it's no wait at all
+    CHECK(reactor.wait(start - chrono::hours(1)) == 0);
+    close(fd);
+}
+
+TEST_CASE("reactors don't watch what can't be waited on") {
+    Reactor reactor;
+    auto file = tmpfile();
+    REQUIRE(file);
+    CHECK(!reactor.watch(fileno(file), [] {}));
+    CHECK(!reactor.watch(-1, [] {}));
+    fclose(file);
+}
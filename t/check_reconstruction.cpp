@@ -0,0 +1,141 @@
+#include "../src/chess/chess_reconstruction.h"
+#include "doctest.h"
+
+using namespace std;
+using namespace thc;
+
+static const Bitmap START = 0xFFFF00000000FFFF;
+
+static Bitmap after(Bitmap boardstate, const ActionList& actions) {
+    for (const auto& action : actions) {
+        if (action.lift != SQUARE_INVALID) {
+            boardstate &= ~(1ULL << action.lift);
+        }
+        else {
+            boardstate |= 1ULL << action.place;
+        }
+    }
+    return boardstate;
+}
+
+static Action lift(Square square) {
+    return Action{square, SQUARE_INVALID};
+}
+
+static Action place(Square square) {
+    return Action{SQUARE_INVALID, square};
+}
+
+// 1. e4 e5, neither of which was read
+static const ActionList missed{lift(e2), place(e4), lift(e7), place(e5)};
+
+TEST_CASE("sandbox leaves the game alone") {
+    Game game;
+    game.play_uci_move("d2d4");
+
+    auto sandbox = game.sandbox();
+    CHECK(sandbox->fen() == game.fen());
+    CHECK(sandbox->history.size() == 2);
+
+    sandbox->play_uci_move("d7d5");
+    sandbox->play_takeback();
+    sandbox->play_takeback();
+    CHECK(sandbox->current()->moves_played.size() == 1);
+    CHECK(game.current()->moves_played.empty());
+    CHECK(game.history.size() == 2);
+}
+
+TEST_CASE("reconstruct missed moves") {
+    Game game;
+    const auto boardstate = after(START, missed);
+
+    Reconstruction reconstruction;
+    Reconstructed  reconstructed;
+    REQUIRE(reconstruction.find_tail(game, missed, boardstate, reconstructed));
+    CHECK(reconstructed.begin == 0);
+    CHECK(reconstructed.end == 2);
+    REQUIRE(reconstructed.move.has_value());
+    CHECK(reconstructed.move->uci() == "e2e4");
+    CHECK(!reconstructed.takeback.has_value());
+
+    // Simulations ran on their own graphs
+    CHECK(game.current()->moves_played.empty());
+}
+
+TEST_CASE("reconstruction follows actions as they arrive") {
+    Game game;
+
+    // A piece that never was, so tails from the start make no sense
+    ActionList actions{place(h5)};
+    actions.insert(actions.end(), missed.begin(), missed.end());
+    const auto boardstate = after(START, missed);
+
+    Reconstruction incremental;
+    Reconstructed  reconstructed;
+    ActionList arriving;
+    for (const auto& action : actions) {
+        arriving.push_back(action);
+        incremental.find_tail(game, arriving, after(START, arriving), reconstructed);
+    }
+    REQUIRE(incremental.find_tail(game, actions, boardstate, reconstructed));
+    CHECK(reconstructed.begin == 1);
+
+    Reconstruction fresh;
+    Reconstructed  again;
+    REQUIRE(fresh.find_tail(game, actions, boardstate, again));
+    CHECK(again.begin == reconstructed.begin);
+    CHECK(again.end == reconstructed.end);
+
+    // Nothing explains a piece that's simply gone
+    const auto missing = boardstate & ~(1ULL << a1);
+    CHECK(!fresh.find_tail(game, actions, missing, again));
+    CHECK(!fresh.busy());
+}
+
+TEST_CASE("reconstruction looks back a limited number of actions") {
+    Game game;
+
+    ActionList actions;
+    for (size_t i = 0; i < Reconstruction::WINDOW; ++i) {
+        actions.push_back(lift(h7));
+        actions.push_back(place(h7));
+    }
+    actions.insert(actions.end(), missed.begin(), missed.end());
+    const auto boardstate = after(START, missed);
+
+    Reconstruction reconstruction;
+    Reconstructed  reconstructed;
+    REQUIRE(reconstruction.find_tail(game, actions, boardstate, reconstructed));
+    CHECK(reconstructed.begin >= actions.size() - Reconstruction::WINDOW);
+}
+
+TEST_CASE("reconstruction tries every promotion") {
+    Game game{"", "8/4P3/8/8/8/8/k7/4K3 w - - 0 1"};
+
+    // Underpromotion, only given away by the knight's next move
+    const ActionList actions{
+        lift(e7), place(e8), lift(a2), place(b2), lift(e8), place(f6)};
+    const auto boardstate = after(game.bitmap(), actions);
+
+    Reconstruction reconstruction;
+    Reconstructed  reconstructed;
+    REQUIRE(reconstruction.find_tail(game, actions, boardstate, reconstructed));
+    CHECK(reconstructed.begin == 0);
+    CHECK(reconstructed.end == 2);
+    REQUIRE(reconstructed.move.has_value());
+    CHECK(reconstructed.move->uci() == "e7e8n");
+}
+
+TEST_CASE("reconstruction picks up where its budget ran out") {
+    Game game;
+    const auto boardstate = after(START, missed);
+
+    Reconstruction reconstruction;
+    Reconstructed  reconstructed;
+    CHECK(!reconstruction.find_tail(game, missed, boardstate, reconstructed, chrono::microseconds{0}));
+    CHECK(reconstruction.busy());
+
+    REQUIRE(reconstruction.find_tail(game, missed, boardstate, reconstructed));
+    CHECK(reconstructed.begin == 0);
+    CHECK(!reconstruction.busy());
+}
@@ -0,0 +1,156 @@
+#include "../src/chess/chess_archive.h"
+#include "../src/chess/chess_review.h"
+#include "doctest.h"
+
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using namespace thc;
+
+// Finds every position a little better for whoever's to move
+struct ReviewEngine {
+    char path[32] = "/tmp/check_review_XXXXXX";
+
+    ReviewEngine() {
+        const auto fd = mkstemp(path);
+        REQUIRE(fd >= 0);
+        const string script =
+            "#!/bin/sh\n"
+            "while read command rest; do\n"
+            "    case $command in\n"
+            "    uci) echo uciok ;;\n"
+            "    isready) echo readyok ;;\n"
+            "    go)  echo 'info depth 5 score cp 20 pv d2d4'; echo 'bestmove d2d4' ;;\n"
+            "    esac\n"
+            "done\n";
+        REQUIRE(write(fd, script.data(), script.size()) == ssize_t(script.size()));
+        REQUIRE(fchmod(fd, 0700) == 0);
+        close(fd);
+    }
+
+    ~ReviewEngine() {
+        unlink(path);
+    }
+};
+
+// Kept in memory, as the database would keep them
+struct MemoryReviews : ReviewStore {
+    map<int64_t, string>            pgn;
+    map<int64_t, ReviewGame>        players;
+    map<int64_t, vector<ReviewRow>> rows;
+
+    bool next_review(int64_t before, ReviewGame& game) override {
+        for (auto it = pgn.rbegin(); it != pgn.rend(); ++it) {
+            const auto& kept = rows[it->first];
+            if ((before && it->first >= before) || (!kept.empty() && !kept.back().move)) {
+                continue;
+            }
+            game       = players[it->first];
+            game.rowid = it->first;
+            game.plies = kept.size();
+            game.loss  = kept.empty() ? 0 : kept.back().loss;
+            return true;
+        }
+        return false;
+    }
+
+    unique_ptr<Game> review_game(int64_t rowid) override {
+        if (pgn[rowid].empty()) {
+            return nullptr;
+        }
+        return make_unique<Game>(pgn[rowid]);
+    }
+
+    void review(const ReviewRow& row) override {
+        auto& kept = rows[row.game];
+        REQUIRE(row.ply == kept.size());
+        kept.push_back(row);
+    }
+};
+
+// For as long as there's anything to review
+static void review_all(Review& review, Engine& engine) {
+    for (auto i = 0; i < 20000 && review.step(engine, true); ++i) {
+        usleep(500);
+        if (auto analysis = engine.analysis()) {
+            review.found(*analysis);
+        }
+    }
+}
+
+static const char* const MATED = "1. e4 e5 2. Qh5 Nc6 3. Bc4 Nf6 4. Qxf7# 1-0";
+
+TEST_CASE("reviews flag each ply by the players' thresholds") {
+    ReviewEngine  script;
+    MemoryReviews store;
+    Engine engine{script.path, {.processes = 1}};
+
+    store.pgn[7]     = MATED;
+    store.players[7] = {.error = {30, 0}, .opportunity = {0, 10}};
+
+    Review review{store, 100};
+    CHECK_FALSE(review.step(engine, false));
+    CHECK(store.rows[7].empty());
+
+    review_all(review, engine);
+    const auto& rows = store.rows[7];
+    REQUIRE(rows.size() == 8);
+
+    Game game{MATED};
+    for (auto ply = 0; ply < 6; ++ply) {
+        CHECK(rows[ply].key == static_cast<int64_t>(game.history[ply]->key()));
+        CHECK(rows[ply].score == 20);
+        CHECK(rows[ply].depth == 5);
+        CHECK(rows[ply].best == archive::encode(Move{d2, d4}));
+        CHECK(rows[ply].loss == 40);
+    }
+    CHECK(rows[0].move == archive::encode(Move{e2, e4, SPECIAL_WPAWN_2SQUARES}));
+
+    // White's are all errors, Black's all missed what White gave away,
+    // bar the first
+    CHECK(rows[0].flag == ReviewRow::ERROR);
+    CHECK(rows[1].flag == ReviewRow::OPPORTUNITY);
+    CHECK(rows[2].flag == ReviewRow::ERROR);
+    CHECK(rows[5].flag == ReviewRow::OPPORTUNITY);
+
+    // Mate costs nothing, and isn't searched
+    CHECK(rows[6].loss == 0);
+    CHECK(rows[6].flag == ReviewRow::NONE);
+    CHECK(rows[7].move == 0);
+    CHECK(rows[7].mate);
+    CHECK(rows[7].score == 0);
+    CHECK(rows[7].depth == 0);
+}
+
+TEST_CASE("reviews resume where they left off, newest game first") {
+    ReviewEngine  script;
+    MemoryReviews store;
+    Engine engine{script.path, {.processes = 1}};
+
+    store.pgn[1] = "1. d4 d5 *";
+    store.pgn[2] = MATED;
+    store.pgn[3] = "";  // Won't load
+    store.players[2] = {.opportunity = {0, 10}};
+    for (uint32_t ply = 0; ply < 3; ++ply) {
+        store.rows[2].push_back({.game = 2, .ply = ply, .move = 1, .depth = 99, .loss = 40});
+    }
+
+    Review review{store, 100};
+    review_all(review, engine);
+
+    REQUIRE(store.rows[3].size() == 1);
+    CHECK(store.rows[3][0].move == 0);
+
+    const auto& rows = store.rows[2];
+    REQUIRE(rows.size() == 8);
+    CHECK(rows[2].depth == 99);
+    CHECK(rows[3].depth == 5);
+    CHECK(rows[3].flag == ReviewRow::OPPORTUNITY);
+
+    REQUIRE(store.rows[1].size() == 3);
+    CHECK(store.rows[1][2].score == 20);
+}
@@ -0,0 +1,59 @@
+#include "../src/utility/ring.h"
+#include "doctest.h"
+
+#include <cstdint>
+#include <thread>
+
+using namespace std;
+
+TEST_CASE("ring fills and drains in order") {
+    Ring<int, 4> ring;
+    int value = -1;
+
+    CHECK(ring.empty());
+    CHECK(!ring.pop(value));
+
+    for (auto i = 0; i < 4; ++i) {
+        CHECK(ring.push(i));
+    }
+    CHECK(!ring.push(4));
+
+    CHECK(ring.pop(value));
+    CHECK(value == 0);
+    CHECK(ring.push(4));
+
+    for (auto i = 1; i <= 4; ++i) {
+        REQUIRE(ring.pop(value));
+        CHECK(value == i);
+    }
+    CHECK(ring.empty());
+}
+
+TEST_CASE("ring passes everything between threads") {
+    Ring<uint64_t, 64> ring;
+    const uint64_t count = 100000;
+
+    thread producer([&ring, count]() {
+        for (uint64_t i = 0; i < count; ++i) {
+            while (!ring.push(i)) {
+                this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    auto in_order = true;
+    while (expected < count) {
+        uint64_t value;
+        if (!ring.pop(value)) {
+            this_thread::yield();
+            continue;
+        }
+        in_order = in_order && value == expected;
+        ++expected;
+    }
+    producer.join();
+
+    CHECK(in_order);
+    CHECK(ring.empty());
+}
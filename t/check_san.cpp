@@ -0,0 +1,70 @@
+#include "../src/thc/ChessRules.h"
+#include "doctest.h"
+
+#include <cstdint>
+#include <stdexcept>
+
+using namespace std;
+using namespace thc;
+
+TEST_CASE("masked move generation") {
+    ChessRules p;
+    CHECK(p.Forsyth("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"));
+
+    const auto all = p.GenLegalMoveList();
+    for (auto src_mask : {file_bb(4), rank_bb(0), p.bitboards.knights, ~Bitboard{0}}) {
+        for (auto dst_mask : {BB(g1), BB(d5), file_bb(2), rank_bb(5), ~Bitboard{0}}) {
+            MoveList expected;
+            for (auto move : all) {
+                if ((src_mask & BB(move.src)) && (dst_mask & BB(move.dst))) {
+                    expected.push_back(move);
+                }
+            }
+            MoveList moves;
+            p.GenLegalMoveList(moves, src_mask, dst_mask);
+            CHECK(moves == expected);
+        }
+    }
+}
+
+TEST_CASE("san moves round trip") {
+    auto seed = uint32_t{11};
+    for (auto game = 0; game < 20; ++game) {
+        ChessRules p;
+        for (auto ply = 0; ply < 120; ++ply) {
+            const auto moves = p.GenLegalMoveList();
+            if (moves.empty()) {
+                break;
+            }
+            for (auto move : moves) {
+                CHECK(p.san_move(p.move_san(move)) == move);
+                CHECK(p.san_move(move.uci()) == move);
+            }
+            seed = seed * 1103515245 + 12345;
+            p.PlayMove(moves[(seed >> 16) % moves.size()]);
+        }
+    }
+}
+
+TEST_CASE("san move quirks") {
+    ChessRules p;
+    CHECK(p.Forsyth("1r2k3/P1P5/8/3pP3/8/8/8/R3K2R w KQ d6 0 1"));
+
+    CHECK(p.san_move("O-O").special == SPECIAL_WK_CASTLING);
+    CHECK(p.san_move("ooo").special == SPECIAL_WQ_CASTLING);
+    CHECK(p.san_move("Kg1").special == SPECIAL_WK_CASTLING);
+    CHECK(p.san_move("ed").special == SPECIAL_WEN_PASSANT);
+    CHECK(p.san_move("exd6ep").special == SPECIAL_WEN_PASSANT);
+    CHECK(p.san_move("cxb8=N").special == SPECIAL_PROMOTION_KNIGHT);
+    CHECK(p.san_move("cb8Q").special == SPECIAL_PROMOTION_QUEEN);
+    CHECK(p.san_move("c8").special == SPECIAL_PROMOTION_QUEEN);
+
+    // The first of several candidates wins, as it always has
+    CHECK(p.san_move("Rd1").src == a1);
+
+    CHECK_THROWS_AS(p.san_move("Nf3"), domain_error);
+    CHECK_THROWS_AS(p.san_move("e3"), domain_error);
+    CHECK_THROWS_AS(p.san_move("Ra8"), domain_error);
+    CHECK_THROWS_AS(p.san_move("a8=K"), domain_error);
+    CHECK_THROWS_AS(p.san_move("e9"), domain_error);
+}
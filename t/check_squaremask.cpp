@@ -0,0 +1,50 @@
+#include "../src/thc/ChessRules.h"
+#include "../src/thc/SquareMask.h"
+#include "doctest.h"
+
+#include <cstdint>
+
+using namespace std;
+using namespace thc;
+
+TEST_CASE("occupancy mask") {
+    ChessRules p;
+    CHECK(occupancy_mask(p.squares) == p.bitboards.occupied());
+    CHECK(scalar::occupancy_mask(p.squares) == p.bitboards.occupied());
+
+    for (auto san : {"e4", "d5", "exd5", "Qxd5", "Nc3"}) {
+        p.play_san_move(san);
+        CHECK(occupancy_mask(p.squares) == p.bitboards.occupied());
+    }
+}
+
+TEST_CASE("difference mask") {
+    ChessRules a, b;
+    CHECK(difference_mask(a.squares, b.squares) == 0);
+
+    b.play_san_move("e4");
+    CHECK(difference_mask(a.squares, b.squares) == (BB(e2) | BB(e4)));
+    CHECK(difference_mask(a.squares, b.squares) == a.bitboards.difference(b.bitboards));
+
+    // A different piece on the same square is a difference too
+    a.Forsyth("4k3/8/8/8/8/8/8/4K2R w - - 0 1");
+    b.Forsyth("4k3/8/8/8/8/8/8/4K2Q w - - 0 1");
+    CHECK(difference_mask(a.squares, b.squares) == BB(h1));
+}
+
+TEST_CASE("square mask kernels agree with scalar") {
+    // Not necessarily pieces, any bytes at all, and deliberately unaligned
+    char lhs[64 + 1], rhs[64 + 1];
+    auto seed = uint32_t{7};
+    for (auto trial = 0; trial < 1000; ++trial) {
+        for (auto i = 0; i < 65; ++i) {
+            seed = seed * 1103515245 + 12345;
+            lhs[i] = (seed >> 16) & 1 ? ' ' : char(seed >> 24);
+            rhs[i] = (seed >> 17) & 1 ? lhs[i] : char(seed >> 8);
+        }
+        const auto offset = trial & 1;
+        CHECK(occupancy_mask(lhs + offset) == scalar::occupancy_mask(lhs + offset));
+        CHECK(difference_mask(lhs + offset, rhs + offset) ==
+              scalar::difference_mask(lhs + offset, rhs + offset));
+    }
+}
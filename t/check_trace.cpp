@@ -0,0 +1,50 @@
+#include "../src/utility/trace.h"
+#include "doctest.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+static size_t count_of(const string& haystack, const string& needle) {
+    size_t n = 0;
+    for (auto i = haystack.find(needle); i != string::npos; i = haystack.find(needle, i + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+TEST_CASE("trace spans from every thread") {
+    const auto start = TraceClock::now();
+    thread([start] {
+        trace_thread("check_trace_worker");
+        trace_record("check_trace_span", start, start + chrono::microseconds(1500));
+    }).join();
+
+    const auto json = trace_json();
+    CHECK(json.find("{\"traceEvents\": [") == 0);
+    CHECK(json.find("\"args\": {\"name\": \"check_trace_worker\"}") != string::npos);
+    CHECK(json.find("\"name\": \"check_trace_span\"") != string::npos);
+    CHECK(json.find("\"dur\": 1500.000}") != string::npos);
+}
+
+TEST_CASE("trace keeps the latest spans") {
+    thread([] {
+        const auto now = TraceClock::now();
+        for (size_t i = 0; i != TRACE_SPANS + 10; ++i) {
+            trace_record(i < 10 ? "check_trace_old" : "check_trace_new", now, now);
+        }
+    }).join();
+
+    const auto json = trace_json();
+    CHECK(count_of(json, "\"check_trace_old\"") == 0);
+    CHECK(count_of(json, "\"check_trace_new\"") == TRACE_SPANS - 1);
+}
+
+TEST_CASE("trace span records its scope") {
+    thread([] {
+        TraceSpan span{"check_trace_scope"};
+    }).join();
+    CHECK(trace_json().find("\"check_trace_scope\"") != string::npos);
+}
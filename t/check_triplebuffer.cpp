@@ -0,0 +1,67 @@
+#include "../src/utility/triplebuffer.h"
+#include "doctest.h"
+
+#include <cstdint>
+#include <thread>
+
+using namespace std;
+
+TEST_CASE("triple buffer hands over the newest value") {
+    TripleBuffer<int> buffer{-1};
+
+    CHECK(!buffer.fresh());
+    CHECK(!buffer.take());
+    CHECK(buffer.front() == -1);
+
+    buffer.back() = 1;
+    CHECK(buffer.publish());
+    CHECK(buffer.fresh());
+
+    // Not taken, so overwritten
+    buffer.back() = 2;
+    CHECK(!buffer.publish());
+
+    CHECK(buffer.take());
+    CHECK(buffer.front() == 2);
+    CHECK(!buffer.take());
+    CHECK(buffer.front() == 2);
+
+    buffer.back() = 3;
+    CHECK(buffer.publish());
+    CHECK(buffer.take());
+    CHECK(buffer.front() == 3);
+}
+
+TEST_CASE("triple buffer values are whole and in order between threads") {
+    struct Value {
+        uint64_t a;
+        uint64_t b;
+    };
+    TripleBuffer<Value> buffer{Value{0, 0}};
+    const uint64_t count = 100000;
+
+    thread producer([&buffer, count]() {
+        for (uint64_t i = 1; i <= count; ++i) {
+            buffer.back() = Value{i, ~i};
+            buffer.publish();
+        }
+    });
+
+    uint64_t last  = 0;
+    auto     whole = true;
+    auto     in_order = true;
+    while (last < count) {
+        if (!buffer.take()) {
+            this_thread::yield();
+            continue;
+        }
+        const auto value = buffer.front();
+        whole    = whole && value.b == ~value.a;
+        in_order = in_order && value.a > last;
+        last     = value.a;
+    }
+    producer.join();
+
+    CHECK(whole);
+    CHECK(in_order);
+}
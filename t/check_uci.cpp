@@ -0,0 +1,471 @@
+#include "../src/chess/chess.h"
+#include "doctest.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace thc;
+
+TEST_CASE("uci info lines parse into their fields") {
+    UCIInfo info;
+    REQUIRE(uci_parse_info(
+        "info depth 18 seldepth 24 multipv 2 score cp -35 nodes 1234567 nps 456789 "
+        "hashfull 312 tbhits 0 time 2703 pv e7e5 g1f3 b8c6",
+        info));
+    CHECK(info.depth    == 18);
+    CHECK(info.seldepth == 24);
+    CHECK(info.multipv  == 2);
+    CHECK_FALSE(info.mate);
+    CHECK(info.score == -35);
+    CHECK(info.bound == UCIInfo::EXACT);
+    CHECK(info.nodes == 1234567);
+    CHECK(info.nps   == 456789);
+    CHECK(info.time  == 2703);
+    REQUIRE(info.pv_length == 3);
+    CHECK(info.pv[0] == archive::encode(Move{e7, e5}));
+    CHECK(info.pv[2] == archive::encode(Move{b8, c6}));
+
+    REQUIRE(uci_parse_info("info depth 30 score mate -3 lowerbound wdl 0 0 1000 pv h7h8n", info));
+    CHECK(info.mate);
+    CHECK(info.score == -3);
+    CHECK(info.bound == UCIInfo::LOWER);
+    CHECK(info.multipv == 1);
+    REQUIRE(info.pv_length == 1);
+    CHECK(info.pv[0] == archive::encode(Move{h7, h8, SPECIAL_PROMOTION_KNIGHT}));
+
+    // Nothing to score
+    CHECK_FALSE(uci_parse_info("info depth 5 currmove e2e4 currmovenumber 1", info));
+    CHECK_FALSE(uci_parse_info("info string NNUE evaluation using nn-5af11540bbfe.nnue", info));
+    CHECK_FALSE(uci_parse_info("bestmove e2e4 ponder e7e5", info));
+    CHECK_FALSE(uci_parse_info("info depth x score cp 10", info));
+    CHECK_FALSE(uci_parse_info("info score cp 10 pv e2e9", info));
+
+    // Longer lines keep as much as fits
+    string pv = "info score cp 0 pv";
+    for (size_t i = 0; i != UCIInfo::MAX_PV + 4; ++i) {
+        pv += i % 2 ? " g8f6 " : " g1f3 ";
+        pv += i % 2 ? "f6g8" : "f3g1";
+    }
+    REQUIRE(uci_parse_info(pv, info));
+    CHECK(info.pv_length == UCIInfo::MAX_PV);
+}
+
+TEST_CASE("uci lines split into fields without copying") {
+    const string_view line = "bestmove\te2e4  ponder e7e5\r";
+    UCITokens tokens{line};
+
+    const auto command = tokens.next();
+    CHECK(command == "bestmove");
+    CHECK(command.data() == line.data());
+    CHECK(tokens.next() == "e2e4");
+    CHECK(tokens.rest() == "  ponder e7e5\r");
+    CHECK(tokens.next() == "ponder");
+    CHECK(tokens.next() == "e7e5");
+    CHECK(tokens.next().empty());
+    CHECK(tokens.next().empty());
+
+    UCITokens numbers{"depth 12 nodes x"};
+    unsigned depth = 0, nodes = 0;
+    CHECK(numbers.next() == "depth");
+    CHECK(numbers.next(depth));
+    CHECK(depth == 12);
+    CHECK(numbers.next() == "nodes");
+    CHECK(!numbers.next(nodes));
+    CHECK(!numbers.next(nodes));
+}
+
+TEST_CASE("uci moves convert to and from tokens") {
+    char text[6];
+    for (auto move : {"e2e4", "a8h1", "h1a8", "e7e8q", "b2a1r", "c7c8b", "g2g1n"}) {
+        const auto token = uci_token(move);
+        REQUIRE(token != 0);
+        CHECK(uci_text(token, text) == string(move).size());
+        CHECK(string(text) == move);
+    }
+    CHECK(uci_token("e2e4") == archive::encode(Move{e2, e4}));
+
+    CHECK(uci_token("")       == 0);
+    CHECK(uci_token("e2")     == 0);
+    CHECK(uci_token("i2e4")   == 0);
+    CHECK(uci_token("e7e8k")  == 0);
+    CHECK(uci_token("e7e8qq") == 0);
+}
+
+static int make_pipe(int (&fds)[2]) {
+    REQUIRE(pipe(fds) == 0);
+    return fds[0];
+}
+
+// Play the engine's side of a UCI engine's pipes
+struct FakeEngine {
+    int    to_engine[2];
+    int    from_engine[2];
+    Buffer buffer;
+    unique_ptr<UCIEngine> uci;
+
+    FakeEngine()
+        : to_engine{-1, -1},
+          from_engine{-1, -1},
+          buffer{4096, make_pipe(to_engine)}
+    {
+        make_pipe(from_engine);
+        uci = make_unique<UCIEngine>(from_engine[0], to_engine[1]);
+    }
+
+    ~FakeEngine() {
+        uci.reset();
+        close(from_engine[1]);
+    }
+
+    // The next line the engine's sent that starts with startswith
+    string expect(const char* startswith) {
+        for (;;) {
+            auto line = buffer.getline(1000);
+            REQUIRE(line);
+            if (line->substr(0, strlen(startswith)) == startswith) {
+                return string{*line};
+            }
+        }
+    }
+
+    void say(const char* line) {
+        REQUIRE(write(from_engine[1], line, strlen(line)) == ssize_t(strlen(line)));
+    }
+};
+
+TEST_CASE("a new request stops analysis without waiting") {
+    FakeEngine engine;
+    engine.expect("uci");
+    engine.say("id name fake\nuciok\n");
+    engine.expect("setoption name Hash");
+
+    Game game;
+    game.play_uci_move("e2e4");
+    engine.uci->send(make_unique<UCIAnalyseMessage>(game, 2, 0));
+    engine.expect("ucinewgame");
+    engine.expect("isready");
+    engine.say("readyok\n");
+    CHECK(engine.expect("setoption") == "setoption name UCI_LimitStrength value false");
+    CHECK(engine.expect("setoption") == "setoption name MultiPV value 2");
+    CHECK(engine.expect("position") == "position startpos moves e2e4");
+    engine.expect("go infinite");
+    engine.say("info depth 12 multipv 1 score cp 31 nodes 500 pv e7e5 g1f3\n");
+
+    // Waits, if at all, on the line getting here
+    const UCIAnalysis* analysis = nullptr;
+    for (auto i = 0; i < 1000 && !analysis; ++i) {
+        usleep(1000);
+        analysis = engine.uci->analysis.take() ? &engine.uci->analysis.front() : nullptr;
+    }
+    REQUIRE(analysis);
+    CHECK(analysis->key == game.current()->key());
+    CHECK(analysis->lines == 1);
+    CHECK(analysis->line[0].score == 31);
+    CHECK_FALSE(analysis->done);
+
+    const auto started = chrono::steady_clock::now();
+    engine.uci->send(make_unique<UCIAnalyseMessage>(game, 1, 500));
+    engine.expect("stop");
+    CHECK(chrono::steady_clock::now() - started < chrono::milliseconds(250));
+
+    engine.say("bestmove e7e5 ponder g1f3\n");
+
+    // The same game, so only what's changed
+    CHECK(engine.expect("") == "setoption name MultiPV value 1");
+    CHECK(engine.expect("") == "position startpos moves e2e4");
+    CHECK(engine.expect("go") == "go movetime 500");
+    engine.say("bestmove d7d5\n");
+
+    // The first analysis is done, and so's the second
+    for (auto done = 0; done < 2;) {
+        if (auto response = engine.uci->receive()) {
+            // Past the uci handshake's
+            done += dynamic_cast<UCIAnalyseMessage*>(response.get()) != nullptr;
+        }
+        else {
+            usleep(1000);
+        }
+    }
+    REQUIRE(engine.uci->analysis.take());
+    CHECK(engine.uci->analysis.front().done);
+}
+
+TEST_CASE("the computer's move is read in the position it was asked about") {
+    FakeEngine engine;
+    engine.expect("uci");
+    engine.say("id name fake\nuciok\n");
+    engine.expect("setoption name Hash");
+
+    auto game = make_unique<Game>();
+    game->play_uci_move("e2e4");
+    const auto asked = game->current()->key();
+    engine.uci->send(make_unique<UCIPlayMessage>(*game, 1400));
+    engine.expect("ucinewgame");
+    engine.expect("isready");
+    engine.say("readyok\n");
+    CHECK(engine.expect("position") == "position startpos moves e2e4");
+    engine.expect("go");
+
+    // Taken back while the engine thinks, then a new game started
+    game->play_takeback();
+    game.reset();
+    engine.say("bestmove e7e5\n");
+
+    UCIPlayMessage* play = nullptr;
+    unique_ptr<UCIMessage> response;
+    for (auto i = 0; i < 1000 && !play; ++i) {
+        response = engine.uci->receive();
+        play = dynamic_cast<UCIPlayMessage*>(response.get());
+        if (!play) {
+            usleep(1000);
+        }
+    }
+    REQUIRE(play);
+    CHECK(play->key == asked);
+    REQUIRE(play->move);
+    Game before;
+    before.play_uci_move("e2e4");
+    CHECK(*play->move == before.uci_move("e7e5"));
+}
+
+// An engine that answers any search at once, with a line and a move
+struct ScriptedEngine {
+    char path[32] = "/tmp/check_uci_XXXXXX";
+
+    ScriptedEngine() {
+        const auto fd = mkstemp(path);
+        REQUIRE(fd >= 0);
+        const string script =
+            "#!/bin/sh\n"
+            "while read command rest; do\n"
+            "    case $command in\n"
+            "    uci) echo uciok ;;\n"
+            "    isready) echo readyok ;;\n"
+            "    go)  echo 'info depth 1 score cp 20 pv d2d4'; echo 'bestmove d2d4' ;;\n"
+            "    esac\n"
+            "done\n";
+        REQUIRE(write(fd, script.data(), script.size()) == ssize_t(script.size()));
+        REQUIRE(fchmod(fd, 0700) == 0);
+        close(fd);
+    }
+
+    ~ScriptedEngine() {
+        unlink(path);
+    }
+};
+
+TEST_CASE("engines play, hint and analyse, the computer's move first") {
+    ScriptedEngine script;
+    Engine engine{script.path, {.processes = 2, .threads = 2, .hash = 32}};
+    CHECK(engine.size() >= 1);
+    CHECK(engine.size() <= 2);
+
+    Game game;
+    engine.play(game, 1500);
+    engine.hint(game);
+    engine.analyse(game, 1);
+
+    optional<Move> move, hint;
+    const UCIAnalysis* analysis = nullptr;
+    for (auto i = 0; i < 5000 && !(move && hint && analysis); ++i) {
+        usleep(1000);
+        if (!move) {
+            move = engine.move();
+        }
+        if (!hint) {
+            hint = engine.hint_move();
+        }
+        if (!analysis) {
+            analysis = engine.analysis();
+        }
+    }
+    REQUIRE(move);
+    CHECK(move->src == d2);
+    CHECK(move->dst == d4);
+    REQUIRE(hint);
+    CHECK(hint->dst == d4);
+    REQUIRE(analysis);
+    CHECK(analysis->line[0].score == 20);
+}
+
+// Ready to read within timeout_ms
+static bool readable(int fd, int timeout_ms) {
+    struct pollfd pollfd{fd, POLLIN, 0};
+    return poll(&pollfd, 1, timeout_ms) == 1;
+}
+
+TEST_CASE("engines wake whoever's waiting once there's a move to take") {
+    ScriptedEngine script;
+    Engine engine{script.path, {.processes = 1}};
+    engine.reuse_depth = 1;
+
+    Game game;
+    engine.play(game, 0);
+
+    // Woken for the engine's handshake too, and never just waiting
+    optional<Move> move;
+    for (auto i = 0; i < 10 && !move; ++i) {
+        REQUIRE(readable(engine.wakeup_fd(), 5000));
+        move = engine.move();
+    }
+    REQUIRE(move);
+    CHECK(move->dst == d4);
+
+    // Taken, so there's nothing more
+    CHECK(!readable(engine.wakeup_fd(), 0));
+
+    // Answered from the cache, there's no waiting at all
+    engine.play(game, 0);
+    CHECK(readable(engine.wakeup_fd(), 0));
+    CHECK(engine.move());
+}
+
+// Kept in memory, as the database would keep them
+struct MemoryStore : EvalStore {
+    map<pair<zobrist::Key, int>, Evaluation> kept;
+
+    bool recall(zobrist::Key key, int strength, Evaluation& evaluation) override {
+        const auto found = kept.find({key, strength});
+        if (found == kept.end()) {
+            return false;
+        }
+        evaluation = found->second;
+        return true;
+    }
+
+    void remember(const Evaluation& evaluation) override {
+        kept[{evaluation.key, evaluation.strength}] = evaluation;
+    }
+};
+
+TEST_CASE("positions searched deep enough are answered from the cache") {
+    ScriptedEngine script;
+    MemoryStore    store;
+    Game           game;
+
+    {
+        Engine engine{script.path, {.processes = 1}, &store};
+        engine.reuse_depth = 1;
+
+        engine.play(game, 0);
+        optional<Move> move;
+        for (auto i = 0; i < 5000 && !move; ++i) {
+            usleep(1000);
+            move = engine.move();
+        }
+        REQUIRE(move);
+        REQUIRE(store.kept.size() == 1);
+        const auto& kept = store.kept.begin()->second;
+        CHECK(kept.key == game.current()->key());
+        CHECK(kept.strength == 0);
+        CHECK(kept.move == archive::encode(Move{d2, d4}));
+        CHECK(kept.info.depth == 1);
+
+        // Again, with no waiting on the engine
+        engine.play(game, 0);
+        move = engine.move();
+        REQUIRE(move);
+        CHECK(move->dst == d4);
+    }
+
+    // From the store, in a cache too small to hold much, for as long as
+    // what's kept is deep enough
+    Engine engine{script.path, {.processes = 1, .cache = 1}, &store};
+    engine.reuse_depth = 1;
+    engine.play(game, 0);
+    const auto move = engine.move();
+    REQUIRE(move);
+    CHECK(move->src == d2);
+    CHECK(move->special == SPECIAL_WPAWN_2SQUARES);
+
+    // A hint's the same, at full strength
+    engine.hint(game);
+    const auto hint = engine.hint_move();
+    REQUIRE(hint);
+    CHECK(hint->dst == d4);
+}
+
+TEST_CASE("weakened, the computer searches every time, and nothing's kept") {
+    ScriptedEngine script;
+    MemoryStore    store;
+    Game           game;
+
+    // Kept, deep, at full strength and weakened, as if from before, and
+    // not what the engine plays
+    for (auto strength : {0, 1500}) {
+        Evaluation kept{game.current()->key(), strength, archive::encode(Move{e2, e4}), {}};
+        kept.info.depth = 20;
+        store.remember(kept);
+    }
+
+    Engine engine{script.path, {.processes = 1}, &store};
+    engine.reuse_depth = 1;
+    for (auto round = 0; round < 2; ++round) {
+        engine.play(game, 1500);
+        optional<Move> move;
+        for (auto i = 0; i < 5000 && !move; ++i) {
+            usleep(1000);
+            move = engine.move();
+        }
+        REQUIRE(move);
+        CHECK(move->dst == d4);
+    }
+    REQUIRE(store.kept.size() == 2);
+    for (const auto& kept : store.kept) {
+        CHECK(kept.second.move == archive::encode(Move{e2, e4}));
+    }
+}
+
+TEST_CASE("searches are allowed what the machine can spare") {
+    const Engine::Budget budget{.processes = 2, .threads = 4, .hash = 256};
+
+    Resources pi;
+    pi.cores    = 4;
+    pi.memory   = 300;
+    pi.charging = 1;
+    pi.battery  = 20;
+
+    // A core kept back, a quarter of memory, and weak play quick
+    auto allowance = Engine::allow(budget, 2, pi, 1400);
+    CHECK(allowance.threads == 1);
+    CHECK(allowance.hash == 32);
+    CHECK(allowance.movetime < 500);
+
+    // Stronger takes longer, full strength longest, though not a minute
+    const auto stronger = Engine::allow(budget, 2, pi, 2200).movetime;
+    const auto full     = Engine::allow(budget, 2, pi, 0).movetime;
+    CHECK(stronger > allowance.movetime);
+    CHECK(full > stronger);
+    CHECK(full <= 10000);
+
+    // More memory, the budget; one process, all the threads there are
+    pi.memory = 4096;
+    allowance = Engine::allow(budget, 1, pi, 0);
+    CHECK(allowance.threads == 3);
+    CHECK(allowance.hash == 256);
+
+    // Off charge, one thread and less time, and less on a low battery
+    pi.charging = 0;
+    allowance = Engine::allow(budget, 1, pi, 0);
+    CHECK(allowance.threads == 1);
+    CHECK(allowance.movetime == full / 2);
+    pi.battery = 2;
+    CHECK(Engine::allow(budget, 1, pi, 0).movetime == full / 4);
+
+    // Nothing known, nothing held back but the time
+    allowance = Engine::allow(budget, 2, Resources{}, 1400);
+    CHECK(allowance.threads == 1);
+    CHECK(allowance.hash == 128);
+    CHECK(allowance.movetime >= 100);
+}
@@ -0,0 +1,111 @@
+#include "../src/utility/websocket.h"
+#include "doctest.h"
+
+#include <string>
+
+using namespace std;
+
+// Masked as a client would, with the key from RFC 6455
+static string client_frame(uint8_t first, const string& payload) {
+    const uint8_t mask[4] = {0x37, 0xfa, 0x21, 0x3d};
+    string out;
+    out += static_cast<char>(first);
+    if (payload.size() < 126) {
+        out += static_cast<char>(0x80 | payload.size());
+    } else {
+        out += static_cast<char>(0x80 | 126);
+        out += static_cast<char>(payload.size() >> 8);
+        out += static_cast<char>(payload.size());
+    }
+    out.append(reinterpret_cast<const char*>(mask), 4);
+    for (size_t i = 0; i < payload.size(); ++i) {
+        out += static_cast<char>(payload[i] ^ mask[i % 4]);
+    }
+    return out;
+}
+
+TEST_CASE("websocket handshake answers the key") {
+    // RFC 6455, section 1.3
+    CHECK(websocket::accept("dGhlIHNhbXBsZSBub25jZQ==") == "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+}
+
+TEST_CASE("websocket frames lengths") {
+    CHECK(websocket::frame(websocket::TEXT, "Hello") == string("\x81\x05Hello"));
+
+    const auto medium = websocket::frame(websocket::BINARY, string(300, 'x'));
+    CHECK(medium.size() == 4 + 300);
+    CHECK(medium.substr(0, 4) == string("\x82\x7e\x01\x2c", 4));
+
+    const auto large = websocket::frame(websocket::BINARY, string(70000, 'x'));
+    CHECK(large.size() == 10 + 70000);
+    CHECK(large.substr(0, 10) == string("\x82\x7f\x00\x00\x00\x00\x00\x01\x11\x70", 10));
+}
+
+TEST_CASE("websocket reader unmasks messages as they arrive") {
+    WebSocketReader reader;
+    websocket::Opcode opcode;
+    string payload;
+
+    // RFC 6455, section 5.7, a byte at a time
+    const string hello = "\x81\x85\x37\xfa\x21\x3d\x7f\x9f\x4d\x51\x58";
+    for (size_t i = 0; i + 1 < hello.size(); ++i) {
+        reader.feed(&hello[i], 1);
+        CHECK(!reader.next(opcode, payload));
+    }
+    reader.feed(&hello.back(), 1);
+    REQUIRE(reader.next(opcode, payload));
+    CHECK(opcode == websocket::TEXT);
+    CHECK(payload == "Hello");
+    CHECK(!reader.next(opcode, payload));
+    CHECK(!reader.failed());
+}
+
+TEST_CASE("websocket reader reassembles fragments around control frames") {
+    WebSocketReader reader;
+    websocket::Opcode opcode;
+    string payload;
+
+    const auto frames = client_frame(0x01, "Hel") + client_frame(0x89, "ping") +
+        client_frame(0x80, "lo") + client_frame(0x82, string(200, 'b'));
+    reader.feed(frames.data(), frames.size());
+
+    REQUIRE(reader.next(opcode, payload));
+    CHECK(opcode == websocket::PING);
+    CHECK(payload == "ping");
+
+    REQUIRE(reader.next(opcode, payload));
+    CHECK(opcode == websocket::TEXT);
+    CHECK(payload == "Hello");
+
+    REQUIRE(reader.next(opcode, payload));
+    CHECK(opcode == websocket::BINARY);
+    CHECK(payload == string(200, 'b'));
+}
+
+TEST_CASE("websocket reader fails clients that break the protocol") {
+    websocket::Opcode opcode;
+    string payload;
+
+    SUBCASE("unmasked") {
+        WebSocketReader reader;
+        reader.feed("\x81\x05Hello", 7);
+        CHECK(!reader.next(opcode, payload));
+        CHECK(reader.failed());
+    }
+
+    SUBCASE("continuation without a start") {
+        WebSocketReader reader;
+        const auto frame = client_frame(0x80, "lo");
+        reader.feed(frame.data(), frame.size());
+        CHECK(!reader.next(opcode, payload));
+        CHECK(reader.failed());
+    }
+
+    SUBCASE("too big") {
+        WebSocketReader reader;
+        const string header("\x82\xff\x00\x00\x00\x00\x01\x00\x00\x00", 10);
+        reader.feed(header.data(), header.size());
+        CHECK(!reader.next(opcode, payload));
+        CHECK(reader.failed());
+    }
+}
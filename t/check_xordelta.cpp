@@ -0,0 +1,59 @@
+#include "../src/utility/xordelta.h"
+#include "doctest.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+TEST_CASE("xordelta of identical images is empty") {
+    vector<uint8_t> image(4736, 0x5a);
+    CHECK(xordelta::encode(image.data(), image.data(), image.size()).empty());
+
+    auto copy = image;
+    CHECK(xordelta::apply(copy.data(), copy.size(), ""));
+    CHECK(copy == image);
+}
+
+TEST_CASE("xordelta encodes runs") {
+    vector<uint8_t> from(300, 0), to(300, 0);
+    to[200] = 0x81;
+    to[201] = 0x42;
+    to[203] = 0xff;  // One unchanged byte between, kept in the literals
+
+    const auto delta = xordelta::encode(from.data(), to.data(), from.size());
+    CHECK(delta == string("\xc8\x01\x04\x81\x42\x00\xff", 7));
+
+    CHECK(xordelta::apply(from.data(), from.size(), delta));
+    CHECK(from == to);
+}
+
+TEST_CASE("xordelta round trips") {
+    vector<uint8_t> from(4736), to(4736);
+    uint32_t x = 12345;
+    for (size_t i = 0; i != from.size(); ++i) {
+        x = x * 1103515245 + 12345;
+        from[i] = uint8_t(x >> 16);
+        to[i]   = (x >> 8) % 7 ? from[i] : uint8_t(x >> 24);
+    }
+
+    const auto original = from;
+    const auto delta = xordelta::encode(from.data(), to.data(), from.size());
+    CHECK(delta.size() < from.size());
+    CHECK(xordelta::apply(from.data(), from.size(), delta));
+    CHECK(from == to);
+
+    // And back again
+    CHECK(xordelta::encode(to.data(), original.data(), to.size()) == delta);
+    CHECK(xordelta::apply(from.data(), from.size(), delta));
+    CHECK(from == original);
+}
+
+TEST_CASE("xordelta rejects overruns") {
+    vector<uint8_t> image(16, 0);
+    CHECK_FALSE(xordelta::apply(image.data(), image.size(), string("\x10\x01\x01", 3)));
+    CHECK_FALSE(xordelta::apply(image.data(), image.size(), string("\x00\x11", 2)));
+    CHECK_FALSE(xordelta::apply(image.data(), image.size(), string("\x00\x02\x01", 3)));
+    CHECK_FALSE(xordelta::apply(image.data(), image.size(), string("\x80", 1)));
+}
@@ -0,0 +1,93 @@
+#include "../src/thc/ChessRules.h"
+#include "doctest.h"
+
+using namespace std;
+using namespace thc;
+
+static zobrist::Key rebuilt_key(const ChessPosition& cp) {
+    ChessPosition copy{cp};
+    copy.rebuild_bitboards();
+    return copy.key();
+}
+
+TEST_CASE("zobrist key is incremental") {
+    ChessRules p;
+    const auto start = p.key();
+    CHECK(start == rebuilt_key(p));
+
+    for (auto san : {"e4", "d5", "exd5", "Nf6", "Bb5+", "c6", "dxc6", "Qb6", "cxb7+", "Kd8"}) {
+        p.play_san_move(san);
+        CHECK(p.key() == rebuilt_key(p));
+    }
+
+    const auto before = p.key();
+    for (auto move : p.GenLegalMoveList()) {
+        p.PushMove(move);
+        CHECK(p.key() == rebuilt_key(p));
+        p.PopMove(move);
+        CHECK(p.key() == before);
+    }
+}
+
+TEST_CASE("zobrist key identifies transpositions") {
+    ChessRules a, b;
+    for (auto san : {"e4", "e5", "Nf3", "Nc6"}) a.play_san_move(san);
+    for (auto san : {"Nf3", "Nc6", "e4", "e5"}) b.play_san_move(san);
+    CHECK(a.key() == b.key());
+
+    // Same pieces, other side to move
+    ChessRules c, d;
+    c.Forsyth("4k3/8/8/8/8/8/8/4K3 w - - 0 1");
+    d.Forsyth("4k3/8/8/8/8/8/8/4K3 b - - 0 1");
+    CHECK(c.key() != d.key());
+}
+
+TEST_CASE("zobrist key only sees real en passant and castling") {
+    ChessRules a, b;
+
+    // No black pawn can take en passant, so the target doesn't matter
+    a.Forsyth("4k3/8/8/8/4P3/8/8/4K3 b - e3 0 1");
+    b.Forsyth("4k3/8/8/8/4P3/8/8/4K3 b - - 0 1");
+    CHECK(a.key() == b.key());
+
+    // But here it does
+    a.Forsyth("4k3/8/8/8/3pP3/8/8/4K3 b - e3 0 1");
+    b.Forsyth("4k3/8/8/8/3pP3/8/8/4K3 b - - 0 1");
+    CHECK(a.key() != b.key());
+
+    // No rook, so the castling flag doesn't matter
+    a.Forsyth("4k3/8/8/8/8/8/8/4K3 w K - 0 1");
+    b.Forsyth("4k3/8/8/8/8/8/8/4K3 w - - 0 1");
+    CHECK(a.key() == b.key());
+
+    a.Forsyth("4k3/8/8/8/8/8/8/4K2R w K - 0 1");
+    b.Forsyth("4k3/8/8/8/8/8/8/4K2R w - - 0 1");
+    CHECK(a.key() != b.key());
+}
+
+TEST_CASE("repetition count") {
+    ChessRules p;
+    DRAWTYPE draw;
+    CHECK(p.GetRepetitionCount() == 1);
+
+    for (auto i = 0; i < 2; ++i) {
+        for (auto san : {"Nf3", "Nf6", "Ng1", "Ng8"}) {
+            CHECK(!p.IsDraw(true, draw));
+            p.play_san_move(san);
+        }
+        CHECK(p.GetRepetitionCount() == i + 2);
+    }
+    CHECK(p.IsDraw(true, draw));
+    CHECK(draw == DRAWTYPE_REPITITION);
+
+    // A pawn move makes earlier positions unreachable
+    p.play_san_move("e4");
+    CHECK(p.GetRepetitionCount() == 1);
+
+    // Castling rights lost by moving the rook and back make a new position
+    ChessRules q;
+    for (auto san : {"Nf3", "Nf6", "Rg1", "Ng8", "Rh1", "Nf6", "Ng1", "Ng8"}) {
+        q.play_san_move(san);
+    }
+    CHECK(q.GetRepetitionCount() == 1);
+}
@@ -0,0 +1,111 @@
+// Count leaf nodes of the move generation tree, to check the move generator
+// against well known totals and to measure how fast it is.
+//
+//     perft [depth [fen]]
+//
+// Without a FEN, walks the standard perft positions to the given depth (or
+// as deep as we have published totals for) and fails on any mismatch.
+#include "../src/thc/ChessRules.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace thc;
+
+struct PerftPosition {
+    const char*      name;
+    const char*      fen;
+    vector<uint64_t> nodes;  // by depth, from 1
+};
+
+static const PerftPosition positions[] = {
+    {"initial", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+     {20, 400, 8902, 197281, 4865609, 119060324}},
+    {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+     {48, 2039, 97862, 4085603, 193690690}},
+    {"position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+     {14, 191, 2812, 43238, 674624, 11030083}},
+    {"position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+     {6, 264, 9467, 422333, 15833292}},
+    {"position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+     {44, 1486, 62379, 2103487, 89941194}},
+    {"position 6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+     {46, 2079, 89890, 3894594, 164075551}},
+};
+
+static uint64_t perft(ChessRules& cr, int depth) {
+    MoveList moves;
+    cr.GenLegalMoveList(moves);
+    if (depth <= 1) {
+        return depth == 1 ? moves.size() : 1;
+    }
+
+    uint64_t nodes = 0;
+    for (auto move : moves) {
+        cr.PushMove(move);
+        nodes += perft(cr, depth - 1);
+        cr.PopMove(move);
+    }
+    return nodes;
+}
+
+// Run perft at each depth up to max_depth, return false on any mismatch
+static bool run(const char* name, const char* fen, int max_depth, const vector<uint64_t>& expected) {
+    ChessRules cr;
+    if (!cr.Forsyth(fen)) {
+        fprintf(stderr, "%s: invalid FEN: %s\n", name, fen);
+        return false;
+    }
+
+    auto okay = true;
+    for (auto depth = 1; depth <= max_depth; ++depth) {
+        const auto t0    = chrono::steady_clock::now();
+        const auto nodes = perft(cr, depth);
+        const auto t1    = chrono::steady_clock::now();
+        const auto secs  = chrono::duration<double>(t1 - t0).count();
+
+        printf("%-12s depth %d %12llu nodes %9.3f s %12.0f nodes/s",
+               name, depth, (unsigned long long)nodes, secs, secs > 0 ? nodes / secs : 0.0);
+        if (depth <= int(expected.size())) {
+            const auto want = expected[depth - 1];
+            if (nodes == want) {
+                printf("  ok");
+            }
+            else {
+                printf("  FAILED (expected %llu)", (unsigned long long)want);
+                okay = false;
+            }
+        }
+        printf("\n");
+    }
+    return okay;
+}
+
+int main(int argc, char* argv[]) {
+    const auto depth = argc > 1 ? atoi(argv[1]) : 4;
+    if (depth < 1) {
+        fprintf(stderr, "usage: %s [depth [fen]]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (argc > 2) {
+        string fen;
+        for (auto i = 2; i < argc; ++i) {
+            fen += (i > 2 ? " " : "");
+            fen += argv[i];
+        }
+        return run("fen", fen.c_str(), depth, {}) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    auto okay = true;
+    for (const auto& p : positions) {
+        const auto max_depth = min(depth, int(p.nodes.size()));
+        okay = run(p.name, p.fen, max_depth, p.nodes) && okay;
+    }
+    return okay ? EXIT_SUCCESS : EXIT_FAILURE;
+}